@@ -0,0 +1,325 @@
+// Functions for the <see cref="BatchCalculator"/> class to calculate
+// cases from a multi-record pia file without the user interface.
+
+#include <sstream>
+#include "BatchCalculator.h"
+#include "CaseCache.h"
+#include "PiaInputFile.h"
+#include "PiaException.h"
+#include "StageTimes.h"
+#include "Trace.h"
+#include "Resource.h"
+#include "oactcnst.h"
+
+using namespace std;
+
+/// <summary>Initializes the calculation and output objects for one
+/// snapshot.</summary>
+///
+/// <param name="calculator">Owner of the case data.</param>
+/// <param name="snapshot">Pia calculation parameters.</param>
+/// <param name="lawChange">Law change parameters used to project the
+/// snapshot.</param>
+BatchCalculator::CalcSet::CalcSet( BatchCalculator& calculator,
+const boost::shared_ptr< const PiaParamsAny >& snapshot,
+const LawChangeArray& lawChange ) :
+arena(), piaCal(calculator.workerData, calculator.piaData,
+calculator.widowDataArray, calculator.widowArray, snapshot,
+calculator.userAssumptions, calculator.secondaryArray,
+lawChange, calculator.pebs, calculator.earnProject),
+piaOut(piaCal, calculator.taxes),
+pebsOut(calculator.workerData, calculator.piaData, calculator.foInfo,
+calculator.pebs, *snapshot, calculator.taxes, calculator.earnProject),
+anypiaOut()
+{
+  piaCal.setArena(&arena);
+  anypiaOut.setWorkerData(&calculator.workerData);
+  anypiaOut.setPiaData(&calculator.piaData);
+  anypiaOut.setPiaCal(&piaCal);
+  anypiaOut.setPiaOut(&piaOut);
+  anypiaOut.setPebsOut(&pebsOut);
+}
+
+/// <summary>Initializes all the piadata library objects for one thread.
+/// </summary>
+///
+/// <remarks>This follows the initialization done by the interactive program
+/// when a new document is opened. <see cref="setStatics"/> must already have
+/// been called.</remarks>
+///
+/// <param name="newPiaParamsCache">Shared parameter snapshots.</param>
+/// <param name="baseYear">First year of projections.</param>
+/// <param name="newLongOutput">True for long output, false for one-page
+/// output.</param>
+BatchCalculator::BatchCalculator( PiaParamsCache& newPiaParamsCache,
+int baseYear, bool newLongOutput ) :
+workerData(), widowDataArray(), piaData(), widowArray(), secondaryArray(),
+userAssumptions(WorkerData::getMaxyear()), earnProject(YEAR2090), pebs(),
+piaRead(workerData, widowDataArray, widowArray, userAssumptions,
+secondaryArray, earnProject, pebs),
+lawChange(baseYear, WorkerData::getMaxyear(), ""),
+taxes(WorkerData::getMaxyear()), taxRates(WorkerData::getMaxyear()),
+foInfo(), piaParamsCache(newPiaParamsCache), calcSets(), calcSet(0),
+longOutput(newLongOutput), stageTimes(0), methodCounters(),
+methodCounting(false), methodPool(), caseCache(0), caseKey(0u),
+caseToSave(false), caseArchive()
+{
+  userAssumptions.setIstart(baseYear);
+  userAssumptions.setIaltbi(AssumptionType::FLAT);
+  userAssumptions.setIaltaw(AssumptionType::FLAT);
+  userAssumptions.setIbasch(1);
+  foInfo.setData();
+}
+
+/// <summary>Destructor.</summary>
+BatchCalculator::~BatchCalculator()
+{
+  deleteCalcSets(calcSets);
+}
+
+/// <summary>Sets the number of threads used to calculate the methods of
+/// each case at the same time.</summary>
+///
+/// <remarks>The results are the same as when the methods are calculated
+/// one at a time. This helps only when the worker threads of a run do not
+/// already use all processors, such as for a few expensive cases.
+/// </remarks>
+///
+/// <param name="threads">Number of threads, in addition to the thread
+/// calculating the case, or 0 to calculate the methods one at a time.
+/// </param>
+void BatchCalculator::setMethodThreads( unsigned threads )
+{
+  methodPool.reset((threads > 0u) ? new MethodPool(threads) : 0);
+}
+
+/// <summary>Sets the static values used by the piadata library.</summary>
+///
+/// <remarks>These values are shared by every instance, so this must be called
+/// once, from one thread, before any <see cref="BatchCalculator"/> is
+/// created.</remarks>
+void BatchCalculator::setStatics()
+{
+  WorkerData::setQcLumpYear(1977);
+  WorkerDataGeneral::setMaxyear(YEAR2090);
+}
+
+/// <summary>Reads, calculates, and prints one case.</summary>
+///
+/// <remarks>A case that cannot be read or calculated produces a single line
+/// with the Social Security number (if read) and the error number, so that
+/// one bad record does not stop the run. The same line is written to the
+/// <see cref="Trace"/> listeners, if any.</remarks>
+///
+/// <param name="in">Input file with the case.</param>
+/// <param name="index">Index of the case in the input file.</param>
+/// <param name="result">Printed output for the case (returned).</param>
+void BatchCalculator::calculate( const PiaInputFile& in, unsigned index,
+std::string& result )
+{
+  ostringstream out;
+  deleteContents();
+  try {
+    readCase(in, index);
+    compute();
+    StageTimes::Timer timer(stageTimes, StageTimes::PRINT);
+    print(out);
+  } catch (PiaException& e) {
+    ostringstream error;
+    error << workerData.ssn.toString() << ": error " << e.getNumber();
+    if (e.getNumber() == 0)
+      error << " " << e.what();
+    out << error.str() << endl;
+    Trace::writeLine(error.str());
+  } catch (exception& e) {
+    const string error = workerData.ssn.toString() + ": error " + e.what();
+    out << error << endl;
+    Trace::writeLine(error);
+  }
+  result = out.str();
+}
+
+/// <summary>Reads one case.</summary>
+///
+/// <remarks>With saved cases (see <see cref="setCaseCache"/>), a case whose
+/// text is unchanged since it was saved is restored without parsing it. A
+/// new case is saved once it passes the data checks (see
+/// <see cref="calculateBenefits"/>). A saved case that cannot be restored
+/// is parsed instead, and saved again.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// cannot be read.</exception>
+///
+/// <param name="in">Input file with the case.</param>
+/// <param name="index">Index of the case in the input file.</param>
+void BatchCalculator::readCase( const PiaInputFile& in, unsigned index )
+{
+  StageTimes::Timer timer(stageTimes, StageTimes::READ);
+  caseToSave = false;
+  if (caseCache != 0 && in.getRecordKey(index, caseKey)) {
+    const char *begin = 0;
+    const char *end = 0;
+    if (caseCache->find(caseKey, begin, end)) {
+      try {
+        piaRead.loadCase(begin, end);
+        return;
+      } catch (PiaException&) {
+        // parse the case, and save it over the copy that cannot be restored
+        deleteContents();
+        caseToSave = true;
+      }
+    }
+    else {
+      caseToSave = true;
+    }
+  }
+  const unsigned int ret = in.read(piaRead, index);
+  if (ret != 0 && ret != PIA_IDS_READEOF)
+    throw PiaException(static_cast<int>(ret));
+  if (caseToSave)
+    piaRead.saveCase(caseArchive);
+}
+
+/// <summary>Calculates the case that has been read.</summary>
+///
+/// <remarks>This follows the calculation done by the interactive program.
+/// </remarks>
+void BatchCalculator::compute()
+{
+  setAssumptions();
+  calcSet = findCalcSet(calcSets, piaParamsCache, lawChange);
+  calculateBenefits(calcSet->piaCal, false);
+  StageTimes::Timer timer(stageTimes, StageTimes::OUTPUT);
+  if (workerData.getJoasdi() == WorkerDataGeneral::PEBS_CALC) {
+    calcSet->pebsOut.setPageNum();
+    calcSet->pebsOut.prepareStrings();
+  }
+  else {
+    calcSet->piaOut.setPageNum(calcSet->piaCal);
+    calcSet->piaOut.prepareStrings();
+    // the one-page summary is not prepared with the other pages
+    if (!longOutput)
+      calcSet->piaOut.onePage.prepareStrings();
+  }
+}
+
+/// <summary>Replaces the assumptions of the case that has been read that
+/// are not available in a batch run.</summary>
+void BatchCalculator::setAssumptions()
+{
+  if (userAssumptions.getIaltaw() == AssumptionType::ALTERN_IIA ||
+    userAssumptions.getIaltaw() == AssumptionType::PEBS_ASSUM) {
+    userAssumptions.setIaltaw(AssumptionType::FLAT);
+  }
+  if (userAssumptions.getIaltbi() == AssumptionType::ALTERN_IIA ||
+    userAssumptions.getIaltbi() == AssumptionType::PEBS_ASSUM) {
+    userAssumptions.setIaltbi(AssumptionType::FLAT);
+  }
+}
+
+/// <summary>Calculates the benefits of the case that has been read, with
+/// one set of calculation objects.</summary>
+///
+/// <param name="piaCal">Pia calculation functions, bound to the case data
+/// of this instance.</param>
+/// <param name="projected">True if the earnings of the case have already
+/// been projected by another set of calculation objects (see
+/// <see cref="PiaCalAny::calculate2Projected"/>).</param>
+void BatchCalculator::calculateBenefits( PiaCalAny& piaCal, bool projected )
+{
+  piaCal.setStageTimes(stageTimes);
+  piaCal.setMethodCounters(methodCounting ? &methodCounters : 0);
+  piaCal.setMethodPool(methodPool.get());
+  // find the date of entitlement to use to calculate the pia
+  const DateMoyr entDate =
+    (workerData.getJoasdi() == WorkerDataGeneral::SURVIVOR) ?
+    secondaryArray.secondary[0]->entDate : workerData.getEntDate();
+  {
+    StageTimes::Timer timer(stageTimes, StageTimes::DATA_CHECK);
+    // check primary data and set primary factors
+    piaCal.dataCheck(entDate);
+    // check auxiliary data and set auxiliary factors
+    piaCal.dataCheckAux(widowDataArray, widowArray, secondaryArray);
+  }
+  if (caseToSave) {
+    caseCache->insert(caseKey, caseArchive);
+    caseToSave = false;
+  }
+  {
+    StageTimes::Timer timer(stageTimes, StageTimes::CALCULATION);
+    // compute regular pias and primary benefit
+    if (projected)
+      piaCal.calculate2Projected(entDate);
+    else
+      piaCal.calculate2(entDate);
+    // compute any re-indexed widow(er) pias
+    piaCal.reindWidCalAll(widowDataArray, widowArray, secondaryArray);
+    // compute secondary benefits
+    piaCal.piaCal3(widowArray, secondaryArray);
+    taxes.taxCal(taxRates, piaData.earnOasdiLimited, piaData.earnHiLimited,
+      workerData.getTaxTypeArray());
+  }
+}
+
+/// <summary>Finds the calculation objects for the assumptions of the case
+/// that has been read, creating them if necessary.</summary>
+///
+/// <remarks>Only a limited number of sets are kept for each cache; when
+/// there are too many, all are released and rebuilt as needed.</remarks>
+///
+/// <returns>The calculation objects.</returns>
+///
+/// <param name="sets">Calculation objects for the snapshots of the cache.
+/// </param>
+/// <param name="cache">Shared parameter snapshots.</param>
+/// <param name="setLawChange">Law change parameters of the cache.</param>
+BatchCalculator::CalcSet *BatchCalculator::findCalcSet( CalcSetMap& sets,
+PiaParamsCache& cache, const LawChangeArray& setLawChange )
+{
+  const PiaParamsCache::Key key = PiaParamsCache::makeKey(userAssumptions);
+  CalcSetMap::const_iterator it = sets.find(key);
+  if (it != sets.end())
+    return(it->second);
+  if (sets.size() >= MAX_CALC_SETS)
+    deleteCalcSets(sets);
+  CalcSet *set =
+    new CalcSet(*this, cache.get(key, userAssumptions), setLawChange);
+  sets[key] = set;
+  return(set);
+}
+
+/// <summary>Releases a group of sets of calculation objects.</summary>
+///
+/// <param name="sets">Sets to release.</param>
+void BatchCalculator::deleteCalcSets( CalcSetMap& sets )
+{
+  for (CalcSetMap::iterator it = sets.begin(); it != sets.end(); ++it) {
+    delete it->second;
+  }
+  sets.clear();
+}
+
+/// <summary>Clears the data from the previous case.</summary>
+void BatchCalculator::deleteContents()
+{
+  workerData.deleteContents();
+  piaData.deleteContents();
+  earnProject.deleteContents();
+  widowArray.deleteContents();
+  widowDataArray.deleteContents();
+  secondaryArray.deleteContents();
+  userAssumptions.setIaltaw(AssumptionType::FLAT);
+  userAssumptions.setIaltbi(AssumptionType::FLAT);
+}
+
+/// <summary>Prints the pages of output for the case.</summary>
+///
+/// <param name="out">Stream to print to.</param>
+void BatchCalculator::print( std::ostream& out )
+{
+  AnypiaOut& anypiaOut = calcSet->anypiaOut;
+  anypiaOut.fillPageSlots(true, longOutput);
+  for (unsigned i = 0; i < anypiaOut.getPageCount(); i++) {
+    anypiaOut.getPage(static_cast<int>(i))->print(out);
+  }
+}
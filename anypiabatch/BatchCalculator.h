@@ -0,0 +1,199 @@
+// Declarations for the <see cref="BatchCalculator"/> class to calculate
+// cases from a multi-record pia file without the user interface.
+
+#pragma once
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include "boost/cstdint.hpp"
+#include "boost/scoped_ptr.hpp"
+#include "boost/shared_ptr.hpp"
+#include "wrkrdata.h"
+#include "WorkerDataArray.h"
+#include "piadata.h"
+#include "PiadataArray.h"
+#include "SecondaryArray.h"
+#include "UserAssumptions.h"
+#include "EarnProject.h"
+#include "pebs.h"
+#include "piareadAny.h"
+#include "LawChangeArray.h"
+#include "piaparmsAny.h"
+#include "PiaParamsCache.h"
+#include "TaxData.h"
+#include "TaxRatesPL.h"
+#include "PiaCalAny.h"
+#include "FieldOfficeInfoNonFile.h"
+#include "PiaOut.h"
+#include "PebsOut.h"
+#include "AnypiaOut.h"
+#include "MethodCounters.h"
+#include "CalcArena.h"
+#include "MethodPool.h"
+class CaseCache;
+class PiaInputFile;
+class StageTimes;
+
+/// <summary>Manages one complete set of the objects required to read,
+/// calculate, and print a Social Security benefit case.</summary>
+///
+/// <remarks>This is the batch counterpart of the document class in the
+/// interactive Anypia program. None of the case data is shared with any
+/// other instance, so each worker thread of a <see cref="BatchDriver"/>
+/// owns one instance and uses it for every case it calculates.
+///
+/// The static settings of the piadata library (the maximum projection
+/// year and the quarter of coverage lump year) must be set by calling
+/// <see cref="BatchCalculator::setStatics"/> once, before any instance is
+/// created. The constructors also set static values (the first year of
+/// projections), so all instances must be created from one thread before
+/// any worker thread is started.
+///
+/// The parameters are not owned by an instance: every instance reads the
+/// read-only snapshots of one <see cref="PiaParamsCache"/>, so the
+/// parameters for a set of assumptions are projected only once for the
+/// whole run. Since the calculation and output objects are bound to their
+/// parameters when constructed, an instance keeps one set of them for each
+/// snapshot it has used.</remarks>
+///
+/// <seealso cref="BatchDriver"/>
+/// <seealso cref="ScenarioCalculator"/>
+class BatchCalculator
+{
+protected:
+  /// <summary>Calculation and output objects bound to one parameter
+  /// snapshot and set of law changes.</summary>
+  struct CalcSet
+  {
+    /// <summary>Memory for the methods of each case, reused for the next
+    /// case.</summary>
+    CalcArena arena;
+    /// <summary>Pia calculation functions.</summary>
+    PiaCalAny piaCal;
+    /// <summary>Output pages for a non-Statement calculation.</summary>
+    PiaOut piaOut;
+    /// <summary>Output pages for a Statement calculation.</summary>
+    PebsOut pebsOut;
+    /// <summary>List of pages to print.</summary>
+    AnypiaOut anypiaOut;
+    CalcSet( BatchCalculator& calculator,
+      const boost::shared_ptr< const PiaParamsAny >& snapshot,
+      const LawChangeArray& lawChange );
+  };
+  /// <summary>Calculation objects for each snapshot of one cache.</summary>
+  typedef std::map< PiaParamsCache::Key, CalcSet* > CalcSetMap;
+  /// <summary>Maximum number of sets of calculation objects kept at once.
+  /// </summary>
+  static const unsigned MAX_CALC_SETS = 16u;
+  /// <summary>Worker's basic data.</summary>
+  WorkerData workerData;
+  /// <summary>Family members' basic data.</summary>
+  WorkerDataArray widowDataArray;
+  /// <summary>Worker's calculation data.</summary>
+  PiaData piaData;
+  /// <summary>Family members' calculation data.</summary>
+  PiaDataArray widowArray;
+  /// <summary>Benefits for all family members.</summary>
+  SecondaryArray secondaryArray;
+  /// <summary>User-specified assumptions.</summary>
+  UserAssumptions userAssumptions;
+  /// <summary>Projected earnings.</summary>
+  EarnProject earnProject;
+  /// <summary>Statement data.</summary>
+  Pebs pebs;
+  /// <summary>Reader for one case.</summary>
+  PiaReadAny piaRead;
+  /// <summary>Law change parameters.</summary>
+  LawChangeArray lawChange;
+  /// <summary>Taxes paid.</summary>
+  TaxData taxes;
+  /// <summary>Tax rates.</summary>
+  TaxRatesPL taxRates;
+  /// <summary>Field office information (used for Statement output).
+  /// </summary>
+  FieldOfficeInfoNonFile foInfo;
+  /// <summary>Shared parameter snapshots.</summary>
+  PiaParamsCache& piaParamsCache;
+  /// <summary>Calculation objects for each snapshot used so far.</summary>
+  CalcSetMap calcSets;
+  /// <summary>Calculation objects for the current case.</summary>
+  CalcSet *calcSet;
+  /// <summary>True for long output, false for one-page output.</summary>
+  bool longOutput;
+  /// <summary>Where to add the time spent in each stage, or null if not
+  /// timing.</summary>
+  StageTimes *stageTimes;
+  /// <summary>Calls of each pia calculation method in the cases calculated
+  /// so far.</summary>
+  MethodCounters methodCounters;
+  /// <summary>True if the calls of each method are counted.</summary>
+  bool methodCounting;
+  /// <summary>Threads to calculate the methods of each case at the same
+  /// time, or null to calculate them one at a time.</summary>
+  boost::scoped_ptr< MethodPool > methodPool;
+  /// <summary>Saved cases to read from and add to, or null to parse every
+  /// case.</summary>
+  CaseCache *caseCache;
+  /// <summary>Key of the case that has been read.</summary>
+  boost::uint64_t caseKey;
+  /// <summary>True if the case that has been read is to be added to the
+  /// saved cases once it passes the data checks.</summary>
+  bool caseToSave;
+  /// <summary>Archive of the case that has been read, if it is to be
+  /// added to the saved cases.</summary>
+  std::string caseArchive;
+public:
+  BatchCalculator( PiaParamsCache& newPiaParamsCache, int baseYear,
+    bool newLongOutput );
+  virtual ~BatchCalculator();
+  virtual void calculate( const PiaInputFile& in, unsigned index,
+    std::string& result );
+  /// <summary>Returns the calls of each pia calculation method in the
+  /// cases calculated so far.</summary>
+  ///
+  /// <returns>The calls of each pia calculation method.</returns>
+  const MethodCounters& getMethodCounters() const
+  { return(methodCounters); }
+  /// <summary>Returns true if the calls of each method are counted.
+  /// </summary>
+  ///
+  /// <returns>True if the calls of each method are counted.</returns>
+  bool isMethodCounting() const { return(methodCounting); }
+  /// <summary>Starts or stops counting the calls of each pia calculation
+  /// method.</summary>
+  ///
+  /// <param name="newMethodCounting">True to count the calls of each
+  /// method.</param>
+  void setMethodCounting( bool newMethodCounting )
+  { methodCounting = newMethodCounting; }
+  /// <summary>Sets the saved cases to read unchanged cases from, and to
+  /// add new cases to.</summary>
+  ///
+  /// <param name="newCaseCache">Saved cases, shared by all instances, or
+  /// null to parse every case.</param>
+  void setCaseCache( CaseCache *newCaseCache )
+  { caseCache = newCaseCache; }
+  void setMethodThreads( unsigned threads );
+  /// <summary>Sets where to add the time spent in each stage of the
+  /// following cases.</summary>
+  ///
+  /// <param name="newStageTimes">Where to add the time spent in each
+  /// stage, or null to stop timing.</param>
+  void setStageTimes( StageTimes *newStageTimes )
+  { stageTimes = newStageTimes; }
+  static void setStatics();
+protected:
+  void calculateBenefits( PiaCalAny& piaCal, bool projected );
+  CalcSet *findCalcSet( CalcSetMap& sets, PiaParamsCache& cache,
+    const LawChangeArray& setLawChange );
+  void deleteContents();
+  void readCase( const PiaInputFile& in, unsigned index );
+  static void deleteCalcSets( CalcSetMap& sets );
+  void setAssumptions();
+private:
+  void compute();
+  void print( std::ostream& out );
+  BatchCalculator( const BatchCalculator& );
+  BatchCalculator& operator=( const BatchCalculator& );
+};
@@ -0,0 +1,196 @@
+// Functions for the <see cref="BatchDriver"/> class to calculate the
+// cases in a multi-record pia file on several threads.
+
+#include <algorithm>
+#include <ostream>
+#include "boost/bind.hpp"
+#include "boost/thread/thread.hpp"
+#include "BatchDriver.h"
+#include "BatchCalculator.h"
+#include "PiaInputFile.h"
+
+using namespace std;
+
+volatile std::sig_atomic_t BatchDriver::countersRequested = 0;
+
+/// <summary>Initializes the driver.</summary>
+///
+/// <remarks>One worker thread is started for each calculator when
+/// <see cref="run"/> is called.</remarks>
+///
+/// <param name="newCalculators">One calculator per worker thread.</param>
+/// <param name="newBlockSize">Number of records handed to a worker thread
+/// at a time.</param>
+BatchDriver::BatchDriver(
+const std::vector< BatchCalculator* >& newCalculators,
+unsigned newBlockSize ) :
+calculators(newCalculators), blockSize(max(newBlockSize, 1u)),
+maxInFlight(4u * static_cast<unsigned>(newCalculators.size())),
+input(0), mutex(), workAvailable(),
+blockDone(), spaceAvailable(), pending(), done(), inFlight(0u),
+blocksRead(0ul), endOfInput(false),
+threadCounters(newCalculators.size()), countersOut(0)
+{ }
+
+/// <summary>Destructor.</summary>
+BatchDriver::~BatchDriver()
+{ }
+
+/// <summary>Requests that the writer thread write the calls of each pia
+/// calculation method after the next block.</summary>
+///
+/// <remarks>This only sets a flag, so it may be called from a signal
+/// handler.</remarks>
+void BatchDriver::requestCounters()
+{
+  countersRequested = 1;
+}
+
+/// <summary>Writes the calls of each pia calculation method, summed over
+/// worker threads and then for each thread.</summary>
+///
+/// <remarks>During a run, the counts are as of the last block finished on
+/// each thread.</remarks>
+///
+/// <param name="out">Stream to write to.</param>
+void BatchDriver::writeCounters( std::ostream& out )
+{
+  vector< MethodCounters > counters;
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    counters = threadCounters;
+  }
+  MethodCounters total;
+  for (size_t i = 0; i < counters.size(); i++) {
+    total += counters[i];
+  }
+  out << "All threads" << endl;
+  total.write(out);
+  for (size_t i = 0; i < counters.size(); i++) {
+    out << "Thread " << i << endl;
+    counters[i].write(out);
+  }
+  out.flush();
+}
+
+/// <summary>Calculates every case in the input and writes the results.
+/// </summary>
+///
+/// <returns>Number of cases read.</returns>
+///
+/// <param name="in">Input file with one or more cases.</param>
+/// <param name="out">Output stream for the results.</param>
+unsigned long BatchDriver::run( const PiaInputFile& in, std::ostream& out )
+{
+  input = &in;
+  endOfInput = false;
+  blocksRead = 0ul;
+  boost::thread_group workers;
+  for (size_t i = 0; i < calculators.size(); i++) {
+    workers.create_thread(boost::bind(&BatchDriver::work, this,
+      static_cast<unsigned>(i)));
+  }
+  boost::thread writer(boost::bind(&BatchDriver::write, this, &out));
+  const unsigned cases = in.getRecordCount();
+  for (unsigned first = 0; first < cases; first += blockSize) {
+    Block* block = new Block;
+    block->first = first;
+    block->results.resize(min(blockSize, cases - first));
+    queueBlock(block);
+  }
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    endOfInput = true;
+  }
+  workAvailable.notify_all();
+  blockDone.notify_all();
+  workers.join_all();
+  writer.join();
+  input = 0;
+  return cases;
+}
+
+/// <summary>Passes a block of records to the worker threads.</summary>
+///
+/// <remarks>Waits first if too many blocks are already in memory.</remarks>
+///
+/// <param name="block">Block to queue.</param>
+void BatchDriver::queueBlock( Block* block )
+{
+  boost::mutex::scoped_lock lock(mutex);
+  while (inFlight >= maxInFlight)
+    spaceAvailable.wait(lock);
+  block->sequence = blocksRead++;
+  inFlight++;
+  pending.push_back(block);
+  workAvailable.notify_one();
+}
+
+/// <summary>Calculates blocks until all input has been read and
+/// calculated.</summary>
+///
+/// <param name="thread">Number of this thread, which is also the number
+/// of the calculator it owns.</param>
+void BatchDriver::work( unsigned thread )
+{
+  BatchCalculator* calculator = calculators[thread];
+  for (;;) {
+    Block* block;
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      while (pending.empty() && !endOfInput)
+        workAvailable.wait(lock);
+      if (pending.empty())
+        return;
+      block = pending.front();
+      pending.pop_front();
+    }
+    for (unsigned i = 0; i < block->results.size(); i++) {
+      const unsigned index = block->first + i;
+      calculator->calculate(*input, index, block->results[i]);
+    }
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      done[block->sequence] = block;
+      if (calculator->isMethodCounting())
+        threadCounters[thread] = calculator->getMethodCounters();
+    }
+    blockDone.notify_one();
+  }
+}
+
+/// <summary>Writes calculated blocks in input order.</summary>
+///
+/// <param name="out">Output stream for the results.</param>
+void BatchDriver::write( std::ostream* out )
+{
+  unsigned long next = 0ul;  // sequence number of next block to write
+  for (;;) {
+    Block* block;
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      map< unsigned long, Block* >::iterator it;
+      while ((it = done.find(next)) == done.end()) {
+        if (endOfInput && next == blocksRead)
+          return;
+        blockDone.wait(lock);
+      }
+      block = it->second;
+      done.erase(it);
+    }
+    for (size_t i = 0; i < block->results.size(); i++) {
+      *out << block->results[i];
+    }
+    delete block;
+    next++;
+    if (countersRequested != 0 && countersOut != 0) {
+      countersRequested = 0;
+      writeCounters(*countersOut);
+    }
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      inFlight--;
+    }
+    spaceAvailable.notify_one();
+  }
+}
@@ -0,0 +1,110 @@
+// Declarations for the <see cref="BatchDriver"/> class to calculate the
+// cases in a multi-record pia file on several threads.
+
+#pragma once
+
+#include <csignal>
+#include <deque>
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/condition.hpp"
+#include "MethodCounters.h"
+class BatchCalculator;
+class PiaInputFile;
+
+/// <summary>Calculates the cases in a multi-record pia file on a pool of
+/// worker threads, and writes the results in input order.</summary>
+///
+/// <remarks>The input file is mapped into memory and indexed by
+/// <see cref="PiaMappedFile"/> or <see cref="PiaColumnFile"/>, and the
+/// calling thread groups its records
+/// into blocks of consecutive record numbers. Each worker thread owns one
+/// <see cref="BatchCalculator"/> and takes whole blocks from a queue, so
+/// the only locking is once per block. A writer thread prints the finished
+/// blocks in sequence. The number of blocks in memory at once is bounded, so
+/// a file of any size can be run.
+///
+/// If the calculators count the calls of the pia calculation methods (see
+/// <see cref="BatchCalculator::setMethodCounting"/>), each worker thread
+/// copies its counts to the driver after each block, while it holds the
+/// lock it takes anyway, so <see cref="BatchDriver::writeCounters"/> can
+/// be called from any thread during a run. A dump can also be requested
+/// with <see cref="BatchDriver::requestCounters"/>, which is safe to call
+/// from a signal handler; the writer thread then writes the counts after
+/// the next block.</remarks>
+///
+/// <seealso cref="BatchCalculator"/>
+class BatchDriver
+{
+private:
+  /// <summary>A group of consecutive records and their results.</summary>
+  struct Block
+  {
+    /// <summary>Sequence number of this block in the input.</summary>
+    unsigned long sequence;
+    /// <summary>Number of first record in this block.</summary>
+    unsigned first;
+    /// <summary>Printed output for each record.</summary>
+    std::vector< std::string > results;
+  };
+  /// <summary>One calculator per worker thread.</summary>
+  const std::vector< BatchCalculator* >& calculators;
+  /// <summary>Number of records per block.</summary>
+  const unsigned blockSize;
+  /// <summary>Maximum number of blocks read but not yet written.</summary>
+  const unsigned maxInFlight;
+  /// <summary>Input file, while running.</summary>
+  const PiaInputFile *input;
+  /// <summary>Protects all of the following members.</summary>
+  boost::mutex mutex;
+  /// <summary>Signaled when a block is queued or input is finished.
+  /// </summary>
+  boost::condition workAvailable;
+  /// <summary>Signaled when a block has been calculated.</summary>
+  boost::condition blockDone;
+  /// <summary>Signaled when a block has been written.</summary>
+  boost::condition spaceAvailable;
+  /// <summary>Blocks waiting to be calculated.</summary>
+  std::deque< Block* > pending;
+  /// <summary>Calculated blocks waiting to be written, by sequence number.
+  /// </summary>
+  std::map< unsigned long, Block* > done;
+  /// <summary>Number of blocks read but not yet written.</summary>
+  unsigned inFlight;
+  /// <summary>Total number of blocks queued so far.</summary>
+  unsigned long blocksRead;
+  /// <summary>True when all blocks have been queued.</summary>
+  bool endOfInput;
+  /// <summary>Calls of each pia calculation method on each worker thread,
+  /// as of the last block it finished.</summary>
+  std::vector< MethodCounters > threadCounters;
+  /// <summary>Stream for the counts requested by
+  /// <see cref="requestCounters"/>, or null to ignore requests.</summary>
+  std::ostream *countersOut;
+  /// <summary>Nonzero if a dump of the counts has been requested.
+  /// </summary>
+  static volatile std::sig_atomic_t countersRequested;
+public:
+  BatchDriver( const std::vector< BatchCalculator* >& newCalculators,
+    unsigned newBlockSize );
+  ~BatchDriver();
+  unsigned long run( const PiaInputFile& in, std::ostream& out );
+  /// <summary>Sets the stream for the counts requested by
+  /// <see cref="requestCounters"/>.</summary>
+  ///
+  /// <param name="newCountersOut">Stream for the counts, or null to ignore
+  /// requests.</param>
+  void setCountersOut( std::ostream *newCountersOut )
+  { countersOut = newCountersOut; }
+  void writeCounters( std::ostream& out );
+  static void requestCounters();
+private:
+  void queueBlock( Block* block );
+  void work( unsigned thread );
+  void write( std::ostream* out );
+  BatchDriver( const BatchDriver& );
+  BatchDriver& operator=( const BatchDriver& );
+};
@@ -0,0 +1,466 @@
+// Functions to mimic AfxFormatString using Standard C++ Library strings,
+// for the batch program.
+//
+// The interactive Macintosh program reads its strings from the STR#
+// resources in AppResources.r. The same strings are compiled in here, keyed
+// by resource number, so the batch program needs no resource file.
+
+#include <algorithm>
+#include <cstring>
+#include "FormatString.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>One string from the string table.</summary>
+struct StringEntry
+{
+  /// <summary>Resource number of the string.</summary>
+  unsigned int rsc;
+  /// <summary>Text of the string.</summary>
+  const char *text;
+};
+
+/// <summary>String table, sorted by resource number.</summary>
+const StringEntry stringTable[] = {
+  { 61204, "Month in %1 that this case is being or was processed" },
+  { 61205, "Must choose month of PEBES processing" },
+  { 61206, "Planned age of retirement must be from 0 to 99" },
+  { 61207, "First year of earnings must not be less than year of birth" },
+  { 61208, "Inconsistent period of backward projection" },
+  { 61209, "Worker's month of birth must be from 1 to 12" },
+  { 61210, "Worker's day of birth must be from 1 to 31" },
+  { 61211, "Must choose type of benefit" },
+  { 61212, "Year of birth must be at least 1800" },
+  { 61213, "Year of birth in PEBES case must be before current year" },
+  { 61214, "Year of birth is too large" },
+  { 61215, "Must choose sex of worker" },
+  { 61216, "Month of entitlement must be from 1 to 12" },
+  { 61217, "Year of entitlement is too early" },
+  { 61218, "First year of earnings is too early" },
+  { 61219, "First year of earnings must not be after last year" },
+  { 61220, "Number of periods of disability must be 0, 1, or 2" },
+  { 61221, "Number of periods of disability must be 1 or 2" },
+  { 61222, "Backward earnings projection indicator must be 0, 1, or 2" },
+  { 61223, "Last year of earnings is too late" },
+  { 61224, "Forward earnings projection indicator must be 0, 1, or 2" },
+  { 61225, "Inconsistent period of forward projection" },
+  { 61226, "Year of entitlement is too late" },
+  { 61227, "Must choose type of backward earnings projection" },
+  { 61228, "Backward projection percentage must be between 0.0 and 9.9" },
+  { 61229, "Must choose type of forward earnings projection" },
+  { 61230, "Forward projection percentage must be between 0.0 and 9.9" },
+  { 61231, "Benefit date must be at or after entitlement" },
+  { 61232, "Month of benefit must be from 1 to 12" },
+  { 61233, "Year of benefit is too early" },
+  { 61234, "Year of benefit is too late" },
+  { 61235, "First year of earnings must be before current year" },
+  { 61236, "First year of earnings is too late" },
+  { 61237, "Last year of earnings is too late" },
+  { 61238, "Month of disability onset must be from 1 to 12" },
+  { 61239, "Day of disability onset must be from 1 to 31" },
+  { 61240, "Disability onset is too late" },
+  { 61241, "Disability onset must be at least 1937" },
+  { 61242, "First year of projection must be at least 1979" },
+  { 61243, "First year of projection is too late" },
+  { 61244, "Month of disability cessation must be from 1 to 12" },
+  { 61245, "Disability cessation must be at least 1937" },
+  { 61246, "Disability cessation is too late" },
+  { 61247, "Month of death must be from 1 to 12" },
+  { 61248, "Catch-up Increases Set %1" },
+  { 61249, "Month of prior entitlement to disability must be from 1 to 12" },
+  { 61250, "Year of prior entitlement to disability must be at least 1940" },
+  { 61251, "Year of prior entitlement to disability is too late" },
+  { 61252, "Death must precede entitlement" },
+  { 61253, "Birth must precede death" },
+  { 61254, "Year of death must be at least 1937" },
+  { 61255, "Disability onset must precede entitlement" },
+  { 61256, "Disability onset must be after birth" },
+  { 61257, "Disability onset must precede death" },
+  { 61258, "Disability onset must precede cessation" },
+  { 61259, "Disability cessation must precede current entitlement" },
+  { 61260, "Disability cessation must precede death" },
+  { 61261, "Disability onsets out of order" },
+  { 61262, "Prior cessation must precede current onset" },
+  { 61263, "Must set type of survivor" },
+  { 61264, "Widow(er)'s month of birth must be from 1 to 12" },
+  { 61265, "Widow(er)'s day of birth must be from 1 to 31" },
+  { 61266, "Disabled widow(er)'s month of disability must be from 1 to 12" },
+  { 61267,
+    "Disabled widow(er)'s day of disability onset must be from 1 to 31" },
+  { 61268,
+    "Disabled widow(er)'s year of disability onset must be at least 1940" },
+  { 61269, "Disabled widow(er)'s year of disability onset is too late" },
+  { 61270, "Month of disability waiting period must be from 1 to 12" },
+  { 61271, "Year of disability waiting period must be at least 1940" },
+  { 61272, "Year of disability waiting period is too late" },
+  { 61273, "Widow(er)'s disability onset must precede entitlement" },
+  { 61274, "Widow(er)'s year of birth must be at least 1800" },
+  { 61275, "Widow(er)'s year of birth is too late" },
+  { 61276, "Widow(er)'s birth must precede disability onset" },
+  { 61277, "Waiting period must be after disability onset" },
+  { 61278, "Waiting period must precede entitlement" },
+  { 61279, "Prior disability entitlement must be after disability onset" },
+  { 61280, "Prior disability entitlement must be before second entitlement" },
+  { 61281, "Waiting period must precede cessation" },
+  { 61282, "Must be flat or 1% assumption for PEBES" },
+  { 61283, "Noncovered pension must be between $0 and $999,999.99" },
+  { 61284, "QCs from 1937 to 1977 must be from 0 to 164" },
+  { 61285, "QCs from 1951 to 1977 must be from 0 to 108" },
+  { 61286, "Annual quarters of coverage must be from 0 to 4" },
+  { 61287,
+    "QCs from 1951 to 1977 cannot be more than QCs from 1937 to 1977" },
+  { 61288, "Inconsistent data (impossible age)" },
+  { 61289, "Retirement before earliest possible retirement age" },
+  { 61290, "No disabled widow(er) benefit until February 1968" },
+  { 61291, "Earliest possible age is 50 for disabled widow(er)" },
+  { 61292, "Cannot handle disabled widow(er) over age 60" },
+  { 61293, "Aged widow(er) before earliest possible age" },
+  { 61294, "No disability benefits until 1957" },
+  { 61295, "Disability beneficiary before earliest possible age" },
+  { 61296, "Disability beneficiary after latest possible age" },
+  { 61297, "Cannot open the average wage increase assumption file" },
+  { 61298, "Cannot open the historical amounts file" },
+  { 61299, "Historical amounts file is in error" },
+  { 61300, "Average wage increase assumption file is in error" },
+  { 61301, "Cannot save the historical amounts file" },
+  { 61302, "Cannot store the average wage increase file" },
+  { 61303, "Cannot open the base year file" },
+  { 61304, "Base year file is in error" },
+  { 61305, "Cannot save the base year file" },
+  { 61306, "Average wage increase must be between -10% and 100%" },
+  { 61307, "Must be from 1979 to 2020, and historical data must exist" },
+  { 61308, "Must choose benefit increase assumption" },
+  { 61309, "Must choose average wage increase assumption" },
+  { 61310, "Must choose wage base assumption" },
+  { 61311, "Cannot open the benefit increase assumption file" },
+  { 61312, "Benefit Increases Set %1" },
+  { 61313, "Stored case is in error" },
+  { 61314, "Benefit increase assumption file is in error" },
+  { 61315, "Year%1Year%2" },
+  { 61316, "Cannot store the benefit increase file" },
+  { 61317, "Year%1" },
+  { 61318, "Benefit increase must be less than 100% and nonnegative" },
+  { 61319, "Must choose PEBES benefit increase assumption" },
+  { 61320, "Must choose PEBES average wage increase assumption" },
+  { 61321, "Catch-up increase must be less than 100% and nonnegative" },
+  { 61322, "%1 and later" },
+  { 61323, "Historical Amounts for %1" },
+  { 61324, "Average Wage Increases Set %1" },
+  { 61325, "Must choose type of earnings" },
+  { 61326, "Annual earnings must be between $0 and $999,999.99" },
+  { 61327, "Must choose catch-up benefit increase response" },
+  { 61328, "Annual Medicare earnings must be between $0 and $999,999.99" },
+  { 61329, "Maximum wage base must be between $0 and $999,999.99" },
+  { 61330, "Must choose type of taxes" },
+  { 61331, "Cannot open the catch-up benefit increase file" },
+  { 61332, "Cannot store the catch-up benefit increase file" },
+  { 61333, "Year of change in law must be current year or later" },
+  { 61334, "Law change proportion must be between 0.00 and 1.00" },
+  { 61335, "Alternative percentage must be between 0.00% and 99.99%" },
+  { 61336, "Alternative bend point must be between $0 and $99,999" },
+  { 61337, "Percentage decline must be between 0.00% and 9.99%" },
+  { 61338, "Invalid disability onset date" },
+  { 61339, "Invalid prior disability onset date" },
+  { 61340, "Invalid widow(er) date of birth" },
+  { 61341, "Invalid widow(er)'s disability onset date" },
+  { 61342, "Invalid date of birth" },
+  { 61343, "Invalid prior disability entitlement date" },
+  { 61344, "Invalid disability cessation date" },
+  { 61345, "Invalid date of death" },
+  { 61346, "Invalid first month of waiting period" },
+  { 61347, "Cannot open the assumption titles file" },
+  { 61348, "Cannot read a title from assumption titles file" },
+  { 61349, "Cannot store the assumption titles file" },
+  { 61350, "Invalid date of initial entitlement" },
+  { 61351, "Cannot open the field office file" },
+  { 61352, "Field office file is in error" },
+  { 61353, "Cannot save the field office file" },
+  { 61354, "Cannot open the law change file" },
+  { 61355, "Law change file is in error" },
+  { 61356, "Cannot save the law change file" },
+  { 61357, "Invalid date of benefit" },
+  { 61358, "Disability onset must precede full retirement age" },
+  { 61359, "Prior disability entitlement must precede full retirement age" },
+  { 61360, "Cannot open old-start table file" },
+  { 61361, "Old-start table file is in error" },
+  { 61362, "Maximum: $%1" },
+  { 61363, "Average: $%1" },
+  { 61364, "Low: $%1" },
+  { 61365, "Unable to store file %1" },
+  { 61366, "Unexpected end of file reading stored case" },
+  { 61367, "More data available for this case" },
+  { 61368, "Sex: %1" },
+  { 61369, "Date of birth: %1" },
+  { 61370, "Retired in %1 at age %2" },
+  { 61371, "Benefit as of %1 at age %2" },
+  { 61372, "Full retirement age: %1" },
+  { 61373, "Early retirement age: %1" },
+  { 61374, "Died on %1" },
+  { 61375, "Benefits started in %1" },
+  { 61376, "Benefit as of %1" },
+  { 61377, "Type of beneficiary: %1" },
+  { 61378, "Widow(er)'s full retirement age: %1" },
+  { 61379, "Disabled on %1" },
+  { 61380, "Prior disability onset on %1" },
+  { 61381, "Prior disability cessation in %1" },
+  { 61382, "Benefits started in %1 at age %2" },
+  { 61383, "   PIA = %1" },
+  { 61384, "   MFB = %1" },
+  { 61385, "Benefit increase assumptions:" },
+  { 61386, "Average wage increase assumptions:" },
+  { 61387, "Name: %1" },
+  { 61388, "Social Security number: %1" },
+  { 61389, "Noncovered monthly pension: %1" },
+  { 61390, "Relative earnings position: %1" },
+  { 61391, "Projected wage bases: %1" },
+  { 61392, "   Required quarters of coverage: %1" },
+  { 61393, "   Actual quarters of coverage: %1" },
+  { 61394, "   Insured status: %1" },
+  { 61395, "   Period after disability: %1 to %2" },
+  { 61396, "   Period before disability: %1 to %2" },
+  { 61397, "   Period before prior disability: %1 to %2" },
+  { 61398, "   Elapsed quarters of coverage: %1" },
+  { 61399, "Previous disability entitlement in %1" },
+  { 61400, "Second prior disability onset on %1" },
+  { 61401, "Second prior disability cessation in %1" },
+  { 61402, "   Years of coverage: %1" },
+  { 61403, "Previous disability onset on %1" },
+  { 61404, "Widow(er) born on %1" },
+  { 61405, "Widow(er) disabled on %1" },
+  { 61406, "Average Monthly Earnings   = %1" },
+  { 61407, "Indexed Monthly Earnings   = %1" },
+  { 61408, "Spec Min years of coverage = %1" },
+  { 61409, "Primary Insurance Amount   = %1" },
+  { 61410, "Number of months increment = %1" },
+  { 61411, "Delayed increment factor   = %1" },
+  { 61412, "Number of months reduction = %1" },
+  { 61413, "Benefit factor             = %1" },
+  { 61414, "Actuarial reduction factor = %1" },
+  { 61415, "Benefit before rounding    = %1" },
+  { 61416, "Maximum Family Benefit     = %1" },
+  { 61417, "Support PIA                = %1" },
+  { 61418, "Benefit after rounding     = %1" },
+  { 61419, "Not insured for totalization benefits" },
+  { 61420, "Insured for regular benefits" },
+  { 61421, "Not fully insured based on input data" },
+  { 61422, "Earnings after last possible year not used" },
+  { 61423, "Earnings limited to $999,999.99" },
+  { 61424, "Not fully or totalization insured" },
+  { 61425, "   (based on Special Minimum PIA)" },
+  { 61426, "   (based on support PIA)" },
+  { 61427, "Warning! Worker is not disability-insured." },
+  { 61428, "Cannot open %1 for input" },
+  { 61429, "High: $%1" },
+  { 61430, "Must choose benefit increase assumption" },
+  { 61431, "Must choose average wage increase assumption" },
+  { 61432, "Amounts for %1 computations:" },
+  { 61433, "Benefit increase for December %1 (percent)" },
+  { 61434, "Average wage for %1" },
+  { 61435, "Wage base for %1" },
+  { 61436, "Old-law wage base for %1" },
+  { 61437, "Must have some quarters of coverage" },
+  { 61438, "Benefit increase for June %1 (percent)" },
+  { 61439, "Wage bases for %1" },
+  { 62000, "Out of range error in PiaCal::calculate" },
+  { 62001, "Out of range error in PiaCalPL::piacal" },
+  { 62002, "Out of range error in OldStart::calculate" },
+  { 62003, "Out of range error in OldStart::c_os50" },
+  { 62004, "Denominator out of range in Rtgeneral::project1" },
+  { 62005, "Quarter out of range in QtrYear" },
+  { 62006, "Year out of range in QtrYear" },
+  { 62007, "Error opening file in Genfile::openout" },
+  { 62008, "Error opening file in Genfile::openapp" },
+  { 62009, "Error opening file in Genfile::openin" },
+  { 62010, "Year out of bounds in QcArray::QcArray" },
+  { 62011, "Year out of bounds in QcArray::SetAt" },
+  { 62012, "Year out of bounds in QcArray::sum using years" },
+  { 62013, "Year out of bounds in QcArray::sum using QtrYears" },
+  { 62014, "Year out of bounds in FloatAnnual" },
+  { 62015, "Error in FloatAnnual::read" },
+  { 62016, "Year out of bounds in DoubleAnnual" },
+  { 62017, "Error in DoubleAnnual::read" },
+  { 62018, "Year out of bounds in IntAnnual" },
+  { 62019, "Error in IntAnnual::read" },
+  { 62020, "Year out of bounds in FloatMonth" },
+  { 62021, "Error in FloatMonth::read" },
+  { 62022, "Year out of bounds in FloatQuarter" },
+  { 62023, "Error in FloatQuarter::read" },
+  { 62024, "Index out of bounds in Pib50Mfb" },
+  { 62025, "Index out of bounds in Pib50Pib" },
+  { 62026, "Index out of bounds in Pib52Mfb" },
+  { 62027, "Index out of bounds in Pib54Mfb" },
+  { 62028, "Index out of bounds in Pib54Pia" },
+  { 62029, "Index out of bounds in Pib58Ame" },
+  { 62030, "Index out of bounds in Pib58Pib" },
+  { 62031, "Index out of bounds in Wage Base" },
+  { 62032, "Error in bicchp" },
+  { 62033, "Error in round" },
+  { 62034, "Error in setnoch" },
+  { 62035, "Error in updatefq" },
+  { 62036, "Error in unbicchp" },
+  { 62037, "Year out of bounds in earntype" },
+  { 62038, "Year out of bounds in taxtype" },
+  { 62039, "Error in need_aw" },
+  { 62040, "Error in earnmal" },
+  { 62041, "Error in needbases" },
+  { 62042, "Error in need_bi" },
+  { 62043, "Error in atofloat" },
+  { 62044, "Error in atoint" },
+  { 62045, "Error in atolong" },
+  { 62046, "Error in atodouble" },
+  { 62047, "Error in floatqtr - 3" },
+  { 62048, "Error in floatqtr - 4" },
+  { 62049, "Error in titlepro - 4" },
+  { 62050, "Error in relernpos" },
+  { 62051, "Error in lawchange - 9" },
+  { 62052, "Error in cachup - 4" },
+  { 62053, "Error in modtc" },
+  { 62054, "Error in avgwg" },
+  { 62055, "Error in Date - month" },
+  { 62056, "Error in Date - year" },
+  { 62057, "Error in Date - day" },
+  { 62058, "Error in Date::read" },
+  { 62059, "Error in Date::diff" },
+  { 62060, "Error in BenefitAmountArray - 1" },
+  { 62061, "Error in BenefitAmountArray - 2" },
+  { 62062, "Error in Onepage::prepareStrings" },
+  { 62063, "Error in InsuredPage::prepareStrings" },
+  { 62064, "Error in EarningsPage::prepareStrings" },
+  { 62065, "Error in Summary1Page::prepareStrings" },
+  { 62066, "Error in Summary2Page::prepareStrings" },
+  { 62067, "Error in Summary3Page::prepareStrings" },
+  { 62068, "Error in OldStart1Page::prepareStrings" },
+  { 62069, "Error in PiaTable1Page::prepareStrings" },
+  { 62070, "Error in WageInd1Page::prepareStrings" },
+  { 62071, "Error in TransGuar1Page::prepareStrings" },
+  { 62072, "Error in SpecMin1Page::prepareStrings" },
+  { 62073, "Error in ReindWid1Page::prepareStrings" },
+  { 62074, "Error in FrozMinPage::prepareStrings" },
+  { 62075, "Error in TaxesPage::prepareStrings" },
+  { 62076, "Year of death is too late" },
+  { 62077, "Unable to open configuration file for input" },
+  { 62078, "Unable to open configuration file for output" },
+  { 62079, "Error reading configuration file" },
+  { 62080, "Starting and ending dates are out of order" },
+  { 62081, "Number of military service periods must be between 0 and 15" },
+  { 62082, "Number of military service periods must be between 1 and 15" },
+  { 62083, "Invalid starting date (use mo/year format)" },
+  { 62084, "Invalid ending date (use mo/year format)" },
+  { 62085, "Full benefit               = %1" },
+  { 62086, "Number of family members must be between 0 and 15" },
+  { 62087, "Benefit after MFB          = %1" },
+  { 62088, "Aged spouse before earliest possible age" },
+  { 62089, "Spouse's full retirement age: %1" },
+  { 62090, "Incorrect last year of data in AwbiDataNonFile" },
+  { 62091, "Incorrect data for secondary benefit" },
+  { 62092, "Full SSN must have 9 digits" },
+  { 62093, "Incorrect date in qcDisCal" },
+  { 62094, "Currently insured only" },
+  { 62095,
+    "Benefit date must be at or after family member's date of entitlement" },
+  { 62096, "Months out of range in age class" },
+  { 62097, "Quarter out of range in FloatMonth::qaverage" },
+  { 62098, "Number out of range in PiaMethod::order" },
+  { 62099, "Entitlement date not set in OldStart::calculate" },
+  { 62100, "Entitlement date not set in OldStart::calculate" },
+  { 62101, "Benefit date not set in PiaTable::calculate" },
+  { 62102, "Entitlement date not set in PiaTable::calculate" },
+  { 62103,
+    "Miltary service qcs 1937-50 out of range in MilServDates::getQc3750" },
+  { 62104, "Number of months out of range in MilServDates::getEarn3750" },
+  { 62105, "QcdisDate1.year out of range in PiaData::qcDisReqCal" },
+  { 62106, "QcdisDate6.year out of range in PiaData::qcDisReqCal" },
+  { 62107, "Qcamt not set in PiaData::qcCal" },
+  { 62108, "Last year of earnings out of range in PiaData::earnProject" },
+  { 62109, "First year of earnings out of range in PiaWrite::writeEarnType" },
+  { 62110, "First year of earnings out of range in PiaWrite::writeEarn" },
+  { 62111, "Average wages not set in Qcamt::project" },
+  { 62112, "Year out of range in BitAnnual" },
+  { 62113, "Qclumpyear is out of range" },
+  { 62114, "Index out of range in Qcpacked::get" },
+  { 62115, "Index out of range in Qcpacked::set" },
+  { 62116,
+    "Must have regular OASDI earnings, railroad, or military service." },
+  { 62120, "" },
+  { 62121, "" },
+  { 62122, "" },
+  { 62123, "Noncovered pension date must not be before date of birth." },
+  { 62124, "Noncovered pension entitlement date must not be after death." },
+  { 62125,
+    "Noncovered pension entitlement date is invalid. (Use Month/Year "
+    "format.)" },
+  { 62126, "Noncovered pension entitlement date: %1" },
+  { 62127, "" },
+};
+
+/// <summary>Number of entries in string table.</summary>
+const size_t stringCount = sizeof(stringTable) / sizeof(stringTable[0]);
+
+/// <summary>Compares a string table entry to a resource number.</summary>
+bool lessRsc( const StringEntry& entry, unsigned int rsc )
+{
+  return entry.rsc < rsc;
+}
+
+/// <summary>Returns the string with the specified resource number.
+/// </summary>
+///
+/// <remarks>As in the interactive program, a resource number below the
+/// first string is replaced by the first string.</remarks>
+///
+/// <returns>The string, or an empty string if there is no string with the
+/// specified number.</returns>
+///
+/// <param name="rsc">Resource number of the string.</param>
+string loadString( unsigned int rsc )
+{
+  if (rsc < stringTable[0].rsc)
+    rsc = stringTable[0].rsc;
+  const StringEntry *entry =
+    lower_bound(stringTable, stringTable + stringCount, rsc, lessRsc);
+  if (entry == stringTable + stringCount || entry->rsc != rsc)
+    return string();
+  return string(entry->text);
+}
+
+}  // namespace
+
+void AfxFormatString1(string& result, unsigned int rsc,
+                      const string& filler)
+{
+   const string theString = loadString(rsc);
+   string::size_type index = theString.find("%1");
+   // if no "%1" found, return
+   if (index == string::npos) {
+      result = theString;
+      return;
+   }
+   result = theString.substr(0, index);
+   result += filler;
+   result += theString.substr(index + 2);
+}
+
+void AfxFormatString2(string& result, unsigned int rsc,
+   const string& filler1, const string& filler2)
+{
+   const string theString = loadString(rsc);
+   string::size_type index1 = theString.find("%1");
+   string::size_type index2 = theString.find("%2");
+   // if no "%1" found, return
+   if (index1 == string::npos) {
+      result = theString;
+      return;
+   }
+   result = theString.substr(0, index1);
+   result += filler1;
+   // if no "%2" found, return
+   if (index2 == string::npos) {
+      result += theString.substr(index1 + 2);
+      return;
+   }
+   result += theString.substr(index1 + 2, index2 - index1 - 2);
+   result += filler2;
+   result += theString.substr(index2 + 2);
+}
@@ -0,0 +1,175 @@
+// Functions for the <see cref="LawChangeScenario"/> class to hold one
+// set of law changes to be compared with present law.
+
+#include <algorithm>
+#include <fstream>
+#include "LawChangeScenario.h"
+#include "LawChangeRead.h"
+#include "LawChangeCOLACHANGE.h"
+#include "piaparms.h"
+#include "wrkrdata.h"
+#include "PiaException.h"
+#include "Resource.h"
+#include "oactcnst.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Returns the first year in which two annual series differ.
+/// </summary>
+///
+/// <returns>The first year, in the years of both series, in which the
+/// values differ, or lastYear + 1 if there is none.</returns>
+///
+/// <param name="series1">First series.</param>
+/// <param name="series2">Second series.</param>
+/// <param name="lastYear">Last year to compare.</param>
+int firstDifference( const DoubleAnnual& series1,
+const DoubleAnnual& series2, int lastYear )
+{
+  const int firstYear = max(series1.getBaseYear(), series2.getBaseYear());
+  lastYear = min(lastYear,
+    min(series1.getLastYear(), series2.getLastYear()));
+  for (int year = firstYear; year <= lastYear; year++) {
+    if (series1[year] != series2[year])
+      return(year);
+  }
+  return(lastYear + 1);
+}
+
+}  // namespace
+
+/// <summary>Reads the law changes of a scenario.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_LAWCHG7"/> if the file cannot be opened; of type
+/// <see cref="PIA_IDS_LAWCHG6"/> if it cannot be parsed.</exception>
+///
+/// <param name="filename">Name of the law-change file.</param>
+/// <param name="baseYear">First year of projections.</param>
+LawChangeScenario::LawChangeScenario( const std::string& filename,
+int baseYear ) :
+name(filename), awbiData(baseYear, WorkerData::getMaxyear()),
+assumptions(baseYear, WorkerData::getMaxyear()),
+lawChange(baseYear, WorkerData::getMaxyear(), ""),
+piaParamsCache(baseYear, WorkerData::getMaxyear(), awbiData, lawChange,
+assumptions), parametric(true)
+{
+  ifstream in(filename.c_str(), ios::in);
+  if (!in.is_open())
+    throw PiaException(PIA_IDS_LAWCHG7);
+  read(in);
+}
+
+/// <summary>Reads the law changes of a scenario from an open stream.
+/// </summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_LAWCHG6"/> if the stream cannot be parsed.
+/// </exception>
+///
+/// <param name="newName">Name of the scenario.</param>
+/// <param name="in">Open stream in the format of a law-change file.</param>
+/// <param name="baseYear">First year of projections.</param>
+LawChangeScenario::LawChangeScenario( const std::string& newName,
+std::istream& in, int baseYear ) :
+name(newName), awbiData(baseYear, WorkerData::getMaxyear()),
+assumptions(baseYear, WorkerData::getMaxyear()),
+lawChange(baseYear, WorkerData::getMaxyear(), ""),
+piaParamsCache(baseYear, WorkerData::getMaxyear(), awbiData, lawChange,
+assumptions), parametric(true)
+{
+  read(in);
+}
+
+/// <summary>Reads the law changes and notes whether they act only on the
+/// parameters.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_LAWCHG6"/> if the stream cannot be parsed.
+/// </exception>
+///
+/// <param name="in">Open stream in the format of a law-change file.</param>
+void LawChangeScenario::read( std::istream& in )
+{
+  LawChangeRead lawChangeRead(lawChange);
+  lawChangeRead.read(in);
+  for (int i = 0; i < LawChange::MAXLCH; i++) {
+    if (lawChange.lawChange[i]->getInd() == 0)
+      continue;
+    switch (i) {
+    case LawChange::BPFRACWAGE:
+    case LawChange::BPCPI:
+    case LawChange::EARNINDCPI:
+    case LawChange::NEWFORMULA:
+    case LawChange::BPSPECRATE:
+    case LawChange::BPMINCONST:
+    case LawChange::DECLINEPERC:
+    case LawChange::WAGEBASECHG:
+    case LawChange::COLACHANGE:
+      break;
+    default:
+      parametric = false;
+    }
+  }
+}
+
+/// <summary>Returns the first year in which the law changes can change a
+/// benefit.</summary>
+///
+/// <remarks>For a scenario with only changes to the parameters, this is
+/// the first year of any of the series of average wages used for bend
+/// points or indexing, benefit increases, wage bases, bend points, or
+/// formula percentages that differs from present law, or the first year of
+/// a limit on the benefit increases. Comparing the series themselves allows
+/// for any change that starts before its nominal first year. A case whose
+/// calculation uses no year from this one on has the same benefits as
+/// under present law.</remarks>
+///
+/// <returns>The first year the law changes can change a benefit; the first
+/// year of the parameters if they can change any benefit; or one more than
+/// the maximum projected year if they change none.</returns>
+///
+/// <param name="presentLaw">Parameters of present law.</param>
+/// <param name="params">Parameters of this scenario, for the same
+/// assumptions.</param>
+int LawChangeScenario::firstYearChanged( const PiaParams& presentLaw,
+const PiaParams& params ) const
+{
+  const int lastYear = WorkerData::getMaxyear();
+  if (lawChange.getIndTotal() == 0)
+    return(lastYear + 1);
+  if (!parametric)
+    return(YEAR37);
+  int year = lastYear + 1;
+  if (lawChange.lawChangeCOLACHANGE->getInd() == 2)
+    year = lawChange.lawChangeCOLACHANGE->getStartYear();
+  year = min(year, firstDifference(presentLaw.getFqBppia(),
+    params.getFqBppia(), lastYear));
+  year = min(year, firstDifference(presentLaw.getFqIndex(),
+    params.getFqIndex(), lastYear));
+  year = min(year, firstDifference(presentLaw.getCpiincArray(),
+    params.getCpiincArray(), lastYear));
+  year = min(year, firstDifference(presentLaw.getBaseOasdiArray(),
+    params.getBaseOasdiArray(), lastYear));
+  year = min(year, firstDifference(presentLaw.getBase77Array(),
+    params.getBase77Array(), lastYear));
+  for (int yr = YEAR79; yr < year; yr++) {
+    bool same = (presentLaw.bpPiaOut.getNumBend(yr) ==
+      params.bpPiaOut.getNumBend(yr) &&
+      presentLaw.percPiaOut.getNumPercs(yr) ==
+      params.percPiaOut.getNumPercs(yr));
+    for (int i = 1; same && i <= 4; i++) {
+      same = (presentLaw.bpPiaOut.getBppia(yr, i) ==
+        params.bpPiaOut.getBppia(yr, i));
+    }
+    for (int i = 1; same && i <= 5; i++) {
+      same = (presentLaw.percPiaOut.getPercPia(yr, i) ==
+        params.percPiaOut.getPercPia(yr, i));
+    }
+    if (!same)
+      return(yr);
+  }
+  return(year);
+}
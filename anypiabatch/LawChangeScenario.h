@@ -0,0 +1,73 @@
+// Declarations for the <see cref="LawChangeScenario"/> class to hold one
+// set of law changes to be compared with present law.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include "AwbiDataNonFile.h"
+#include "AssumptionsNonFile.h"
+#include "LawChangeArray.h"
+#include "PiaParamsCache.h"
+class PiaParams;
+
+/// <summary>Holds one set of law changes, read from a law-change file or
+/// stream, and the parameters projected with them.</summary>
+///
+/// <remarks>Each scenario has its own <see cref="PiaParamsCache"/>, with
+/// its own historical data and assumptions, so the snapshots of different
+/// scenarios can be built on different threads at the same time. Like the
+/// cache of present law, a scenario is shared by every worker thread of a
+/// run, and must be created before any of them is started.
+///
+/// Most changes in the benefit formula, the benefit increases, and the wage
+/// bases change the parameters only from some year on, and nothing else.
+/// For a scenario with only such changes, <see cref="firstYearChanged"/>
+/// finds the first year in which its parameters differ from those of
+/// present law, so a case that uses no later year need not be calculated
+/// again. Any other change may affect a case in ways that the parameters do
+/// not show, so every case is calculated with it.</remarks>
+///
+/// <seealso cref="ScenarioCalculator"/>
+class LawChangeScenario
+{
+private:
+  /// <summary>Name of the scenario (the name of its file).</summary>
+  const std::string name;
+  /// <summary>Historical average wages and benefit increases.</summary>
+  AwbiDataNonFile awbiData;
+  /// <summary>Stored benefit increase and average wage assumptions.
+  /// </summary>
+  AssumptionsNonFile assumptions;
+  /// <summary>Law change parameters.</summary>
+  LawChangeArray lawChange;
+  /// <summary>Parameter snapshots projected with the law changes.
+  /// </summary>
+  PiaParamsCache piaParamsCache;
+  /// <summary>True if every law change acts only on the parameters.
+  /// </summary>
+  bool parametric;
+public:
+  LawChangeScenario( const std::string& filename, int baseYear );
+  LawChangeScenario( const std::string& newName, std::istream& in,
+    int baseYear );
+  int firstYearChanged( const PiaParams& presentLaw,
+    const PiaParams& params ) const;
+  /// <summary>Returns the law change parameters.</summary>
+  ///
+  /// <returns>The law change parameters.</returns>
+  const LawChangeArray& getLawChange() const { return(lawChange); }
+  /// <summary>Returns the name of the scenario.</summary>
+  ///
+  /// <returns>The name of the scenario.</returns>
+  const std::string& getName() const { return(name); }
+  /// <summary>Returns the parameter snapshots projected with the law
+  /// changes.</summary>
+  ///
+  /// <returns>The parameter snapshots.</returns>
+  PiaParamsCache& getPiaParamsCache() { return(piaParamsCache); }
+private:
+  void read( std::istream& in );
+  LawChangeScenario( const LawChangeScenario& );
+  LawChangeScenario& operator=( const LawChangeScenario& );
+};
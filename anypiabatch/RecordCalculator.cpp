@@ -0,0 +1,318 @@
+// Functions for the <see cref="RecordCalculator"/> class to calculate
+// cases and write their results as comma-separated or JSON records.
+
+#include <cstdio>
+#include <ostream>
+#include <sstream>
+#include "boost/math/special_functions/fpclassify.hpp"
+#include "RecordCalculator.h"
+#include "PiaException.h"
+#include "StageTimes.h"
+#include "Trace.h"
+#include "WageInd.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Names of the pia calculation methods, by
+/// <see cref="PiaMethod::pia_type"/>.</summary>
+const char *const METHOD_NAMES[] = {
+  "old-start", "pia-table", "wage-indexed", "transitional-guarantee",
+  "special-minimum", "reindexed-widow", "frozen-minimum", "child-care",
+  "disability-guarantee", "wage-indexed-non-freeze", "none"
+};
+
+/// <summary>Names of the types of benefit, by
+/// <see cref="WorkerDataGeneral::ben_type"/>.</summary>
+const char *const TYPE_NAMES[] = {
+  "none", "old-age", "survivor", "disability", "statement"
+};
+
+/// <summary>Header line of the comma-separated records.</summary>
+const char CSV_HEADER[] =
+  "ssn,beneficiary,type,method,pia,mfb,aime,bendpoint1,bendpoint2,benefit";
+
+/// <summary>Returns the name of the method giving the highest pia.
+/// </summary>
+///
+/// <returns>The name of the method.</returns>
+///
+/// <param name="piaCal">Pia calculation functions of the case.</param>
+const char *methodName( const PiaCalAny& piaCal )
+{
+  return(METHOD_NAMES[(piaCal.highPiaMethod != 0) ?
+    piaCal.highPiaMethod->getMethod() : PiaMethod::NO_PIA_TYPE]);
+}
+
+/// <summary>Returns the beneficiary identification code of a family
+/// member, without trailing blanks.</summary>
+///
+/// <returns>The beneficiary identification code.</returns>
+///
+/// <param name="bic">Beneficiary identification code.</param>
+string bicCode( const Bic& bic )
+{
+  string code(1, bic.getMajorBic());
+  if (bic.getMinorBic() != ' ')
+    code += bic.getMinorBic();
+  return(code);
+}
+
+}  // namespace
+
+/// <summary>Initializes the calculation objects for one thread.</summary>
+///
+/// <remarks>See <see cref="BatchCalculator::BatchCalculator"/>.</remarks>
+///
+/// <param name="newPiaParamsCache">Shared parameter snapshots.</param>
+/// <param name="baseYear">First year of projections.</param>
+/// <param name="newFormat">Format of the records.</param>
+RecordCalculator::RecordCalculator( PiaParamsCache& newPiaParamsCache,
+int baseYear, format_type newFormat ) :
+BatchCalculator(newPiaParamsCache, baseYear, false), format(newFormat)
+{ }
+
+/// <summary>Destructor.</summary>
+RecordCalculator::~RecordCalculator()
+{ }
+
+/// <summary>Reads and calculates one case, and writes its records.
+/// </summary>
+///
+/// <param name="in">Input file with the case.</param>
+/// <param name="index">Index of the case in the input file.</param>
+/// <param name="result">Records for the case (returned).</param>
+void RecordCalculator::calculate( const PiaInputFile& in, unsigned index,
+std::string& result )
+{
+  result.clear();
+  deleteContents();
+  try {
+    readCase(in, index);
+    setAssumptions();
+    calcSet = findCalcSet(calcSets, piaParamsCache, lawChange);
+    calculateBenefits(calcSet->piaCal, false);
+    StageTimes::Timer timer(stageTimes, StageTimes::PRINT);
+    if (format == JSON)
+      writeJson(result);
+    else
+      writeCsv(result);
+  } catch (PiaException& e) {
+    ostringstream error;
+    error << e.getNumber();
+    if (e.getNumber() == 0)
+      error << " " << e.what();
+    result.clear();
+    writeError(result, error.str());
+  } catch (exception& e) {
+    result.clear();
+    writeError(result, e.what());
+  }
+}
+
+/// <summary>Appends a number with a fixed number of decimals.</summary>
+///
+/// <remarks>A number that is not finite, such as the benefit of a family
+/// member of an uninsured worker, is written as null in JSON format and
+/// left empty in comma-separated format.</remarks>
+///
+/// <param name="result">String to append to.</param>
+/// <param name="number">Number to append.</param>
+/// <param name="decimals">Number of decimals.</param>
+void RecordCalculator::appendNumber( std::string& result, double number,
+int decimals ) const
+{
+  if (!boost::math::isfinite(number)) {
+    if (format == JSON)
+      result += "null";
+    return;
+  }
+  char buffer[32];
+  const int length =
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, number);
+  result.append(buffer, static_cast<size_t>(length));
+}
+
+/// <summary>Appends a string as a JSON string, with quotes.</summary>
+///
+/// <param name="result">String to append to.</param>
+/// <param name="text">String to append.</param>
+void RecordCalculator::appendString( std::string& result,
+const std::string& text )
+{
+  result += '"';
+  for (string::const_iterator it = text.begin(); it != text.end(); ++it) {
+    const unsigned char c = static_cast<unsigned char>(*it);
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += *it;
+    }
+    else if (c < 0x20u) {
+      char buffer[8];
+      snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+      result += buffer;
+    }
+    else {
+      result += *it;
+    }
+  }
+  result += '"';
+}
+
+/// <summary>Appends a string as a comma-separated field, with quotes.
+/// </summary>
+///
+/// <remarks>Quotes in the string are doubled, so a field with commas,
+/// quotes, or line breaks is read back as one field.</remarks>
+///
+/// <param name="result">String to append to.</param>
+/// <param name="text">String to append.</param>
+void RecordCalculator::appendCsvString( std::string& result,
+const std::string& text )
+{
+  result += '"';
+  for (string::const_iterator it = text.begin(); it != text.end(); ++it) {
+    if (*it == '"')
+      result += '"';
+    result += *it;
+  }
+  result += '"';
+}
+
+/// <summary>Writes the comma-separated lines of the case.</summary>
+///
+/// <param name="result">String to append to.</param>
+void RecordCalculator::writeCsv( std::string& result ) const
+{
+  const PiaCalAny& piaCal = calcSet->piaCal;
+  // the amounts of the case, repeated on the line of each beneficiary
+  string amounts(",");
+  amounts += TYPE_NAMES[workerData.getJoasdi()];
+  amounts += ',';
+  amounts += methodName(piaCal);
+  amounts += ',';
+  appendNumber(amounts, piaData.highPia.get(), 2);
+  amounts += ',';
+  appendNumber(amounts, piaData.highMfb.get(), 2);
+  amounts += ',';
+  if (piaCal.wageInd != 0) {
+    appendNumber(amounts, piaCal.wageInd->getAme(), 2);
+    amounts += ',';
+    appendNumber(amounts, piaCal.wageInd->bendPia[1], 0);
+    amounts += ',';
+    appendNumber(amounts, piaCal.wageInd->bendPia[2], 0);
+  }
+  else {
+    amounts += ",,";
+  }
+  amounts += ',';
+  const string ssn = workerData.ssn.toString();
+  result += ssn;
+  result += ",worker";
+  result += amounts;
+  appendNumber(result,
+    (workerData.getJoasdi() == WorkerDataGeneral::SURVIVOR) ? 0.0 :
+    piaData.roundedBenefit.get(), 2);
+  result += '\n';
+  for (int i = 0; i < widowArray.getFamSize(); i++) {
+    const Secondary& secondary = *secondaryArray.secondary[i];
+    result += ssn;
+    result += ',';
+    result += bicCode(secondary.bic);
+    result += amounts;
+    appendNumber(result, secondary.getRoundedBenefit(), 2);
+    result += '\n';
+  }
+}
+
+/// <summary>Writes the record for a case in error.</summary>
+///
+/// <remarks>The same line is written to the <see cref="Trace"/>
+/// listeners, if any.</remarks>
+///
+/// <param name="result">String to append to.</param>
+/// <param name="error">Error number or message.</param>
+void RecordCalculator::writeError( std::string& result,
+const std::string& error ) const
+{
+  const string ssn = workerData.ssn.toString();
+  if (format == JSON) {
+    result += "{\"ssn\":";
+    appendString(result, ssn);
+    result += ",\"error\":";
+    appendString(result, error);
+    result += "}\n";
+  }
+  else {
+    result += ssn;
+    result += ",error,";
+    appendCsvString(result, error);
+    // leave the columns of the header after the type empty
+    int commas = 0;
+    for (const char *c = CSV_HEADER; *c != '\0'; c++) {
+      if (*c == ',' && ++commas > 2)
+        result += ',';
+    }
+    result += '\n';
+  }
+  Trace::writeLine(ssn + ": error " + error);
+}
+
+/// <summary>Writes the JSON object of the case.</summary>
+///
+/// <param name="result">String to append to.</param>
+void RecordCalculator::writeJson( std::string& result ) const
+{
+  const PiaCalAny& piaCal = calcSet->piaCal;
+  result += "{\"ssn\":";
+  appendString(result, workerData.ssn.toString());
+  result += ",\"type\":\"";
+  result += TYPE_NAMES[workerData.getJoasdi()];
+  result += "\",\"method\":\"";
+  result += methodName(piaCal);
+  result += "\",\"pia\":";
+  appendNumber(result, piaData.highPia.get(), 2);
+  result += ",\"mfb\":";
+  appendNumber(result, piaData.highMfb.get(), 2);
+  if (piaCal.wageInd != 0) {
+    result += ",\"aime\":";
+    appendNumber(result, piaCal.wageInd->getAme(), 2);
+    result += ",\"bendPoints\":[";
+    appendNumber(result, piaCal.wageInd->bendPia[1], 0);
+    result += ',';
+    appendNumber(result, piaCal.wageInd->bendPia[2], 0);
+    result += ']';
+  }
+  else {
+    result += ",\"aime\":null,\"bendPoints\":null";
+  }
+  result += ",\"benefit\":";
+  appendNumber(result,
+    (workerData.getJoasdi() == WorkerDataGeneral::SURVIVOR) ? 0.0 :
+    piaData.roundedBenefit.get(), 2);
+  result += ",\"family\":[";
+  for (int i = 0; i < widowArray.getFamSize(); i++) {
+    const Secondary& secondary = *secondaryArray.secondary[i];
+    if (i > 0)
+      result += ',';
+    result += "{\"bic\":";
+    appendString(result, bicCode(secondary.bic));
+    result += ",\"benefit\":";
+    appendNumber(result, secondary.getRoundedBenefit(), 2);
+    result += '}';
+  }
+  result += "]}\n";
+}
+
+/// <summary>Writes the header line of the records, if the format has one.
+/// </summary>
+///
+/// <param name="out">Stream to write to.</param>
+/// <param name="format">Format of the records.</param>
+void RecordCalculator::writeHeader( std::ostream& out, format_type format )
+{
+  if (format == CSV) {
+    out << CSV_HEADER << endl;
+  }
+}
@@ -0,0 +1,62 @@
+// Declarations for the <see cref="RecordCalculator"/> class to calculate
+// cases and write their results as comma-separated or JSON records.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include "BatchCalculator.h"
+
+/// <summary>Calculates each case and writes its results as records for
+/// other programs to read, instead of the printed pages.</summary>
+///
+/// <remarks>The amounts are taken directly from the calculation objects
+/// and appended to the result of the case, with no output pages, so the
+/// output of a case costs much less than its printed pages (see
+/// <see cref="BatchCalculator::compute"/>).
+///
+/// In comma-separated format, a case has one line for the worker and one
+/// line for each family member, each with the amounts of the case (see
+/// <see cref="writeHeader"/>); the line of the worker has "worker" in place
+/// of the beneficiary identification code, and the benefit of the worker (0
+/// for a survivor case). In JSON format, a case is one object on one line,
+/// with the benefits of the family members in an array.
+///
+/// The AIME and bend points are those of the wage-indexed method, and are
+/// empty (or null) if it does not apply. The method is the one giving the
+/// highest pia. A case that cannot be read or calculated has a single line
+/// with "error" in place of the beneficiary identification code, the
+/// quoted error number in place of the type, and the other columns empty.
+/// </remarks>
+///
+/// <seealso cref="BatchCalculator"/>
+class RecordCalculator : public BatchCalculator
+{
+public:
+  /// <summary>Formats of the records.</summary>
+  enum format_type {
+    CSV,  // One comma-separated line per beneficiary.
+    JSON  // One JSON object per case, one per line.
+  };
+private:
+  /// <summary>Format of the records.</summary>
+  const format_type format;
+public:
+  RecordCalculator( PiaParamsCache& newPiaParamsCache, int baseYear,
+    format_type newFormat );
+  ~RecordCalculator();
+  void calculate( const PiaInputFile& in, unsigned index,
+    std::string& result );
+  static void writeHeader( std::ostream& out, format_type format );
+private:
+  void appendNumber( std::string& result, double number, int decimals )
+    const;
+  static void appendCsvString( std::string& result,
+    const std::string& text );
+  static void appendString( std::string& result, const std::string& text );
+  void writeCsv( std::string& result ) const;
+  void writeError( std::string& result, const std::string& error ) const;
+  void writeJson( std::string& result ) const;
+  RecordCalculator( const RecordCalculator& );
+  RecordCalculator& operator=( const RecordCalculator& );
+};
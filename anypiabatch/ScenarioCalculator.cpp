@@ -0,0 +1,229 @@
+// Functions for the <see cref="ScenarioCalculator"/> class to calculate
+// cases under present law and under several sets of law changes.
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include "ScenarioCalculator.h"
+#include "LawChangeScenario.h"
+#include "PiaInputFile.h"
+#include "PiaException.h"
+#include "Trace.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Name of the present-law calculation in the results.</summary>
+const char *const PRESENT_LAW = "present law";
+
+}  // namespace
+
+/// <summary>Initializes the calculation objects for one thread.</summary>
+///
+/// <remarks>See <see cref="BatchCalculator::BatchCalculator"/>.</remarks>
+///
+/// <param name="newPiaParamsCache">Shared parameter snapshots of present
+/// law.</param>
+/// <param name="baseYear">First year of projections.</param>
+/// <param name="newScenarios">Scenarios to calculate.</param>
+ScenarioCalculator::ScenarioCalculator( PiaParamsCache& newPiaParamsCache,
+int baseYear, const std::vector< LawChangeScenario* >& newScenarios ) :
+BatchCalculator(newPiaParamsCache, baseYear, false),
+scenarios(newScenarios), scenarioCalcSets(newScenarios.size()),
+firstYears()
+{ }
+
+/// <summary>Destructor.</summary>
+ScenarioCalculator::~ScenarioCalculator()
+{
+  for (size_t i = 0; i < scenarioCalcSets.size(); i++) {
+    deleteCalcSets(scenarioCalcSets[i]);
+  }
+}
+
+/// <summary>Calculates one case under present law and under each
+/// scenario.</summary>
+///
+/// <param name="in">Input file with the case.</param>
+/// <param name="index">Index of the case in the input file.</param>
+/// <param name="result">Lines of results for the case (returned).</param>
+void ScenarioCalculator::calculate( const PiaInputFile& in, unsigned index,
+std::string& result )
+{
+  ostringstream out;
+  out << fixed << setprecision(2);
+  deleteContents();
+  Amounts presentLaw;
+  try {
+    readCase(in, index);
+    setAssumptions();
+    calcSet = findCalcSet(calcSets, piaParamsCache, lawChange);
+    calculateBenefits(calcSet->piaCal, false);
+    presentLaw = getAmounts();
+  } catch (PiaException& e) {
+    ostringstream error;
+    error << e.getNumber();
+    if (e.getNumber() == 0)
+      error << " " << e.what();
+    writeError(out, PRESENT_LAW, error.str());
+    result = out.str();
+    return;
+  } catch (exception& e) {
+    writeError(out, PRESENT_LAW, e.what());
+    result = out.str();
+    return;
+  }
+  const string ssn = workerData.ssn.toString();
+  out << ssn << "," << PRESENT_LAW << "," << presentLaw.pia << ","
+    << presentLaw.mfb << "," << presentLaw.benefit << ","
+    << presentLaw.family << ",0.00,0.00,0.00,0.00" << endl;
+  const vector< int >& first = getFirstYears();
+  const int lastYear = lastYearUsed();
+  bool projected = (workerData.getJoasdi() != WorkerDataGeneral::PEBS_CALC);
+  for (size_t i = 0; i < scenarios.size(); i++) {
+    const string& name = scenarios[i]->getName();
+    try {
+      Amounts amounts = presentLaw;
+      if (first[i] <= lastYear) {
+        calculateScenario(in, index, i, projected);
+        amounts = getAmounts();
+      }
+      out << ssn << "," << name << "," << amounts.pia << "," << amounts.mfb
+        << "," << amounts.benefit << "," << amounts.family << ","
+        << (amounts.pia - presentLaw.pia) << ","
+        << (amounts.mfb - presentLaw.mfb) << ","
+        << (amounts.benefit - presentLaw.benefit) << ","
+        << (amounts.family - presentLaw.family) << endl;
+    } catch (PiaException& e) {
+      ostringstream error;
+      error << e.getNumber();
+      if (e.getNumber() == 0)
+        error << " " << e.what();
+      writeError(out, name, error.str());
+      // the case data may have been left part way through a calculation
+      projected = false;
+    } catch (exception& e) {
+      writeError(out, name, e.what());
+      projected = false;
+    }
+  }
+  result = out.str();
+}
+
+/// <summary>Calculates one scenario for the case.</summary>
+///
+/// <param name="in">Input file with the case.</param>
+/// <param name="index">Index of the case in the input file.</param>
+/// <param name="scenario">Index of the scenario.</param>
+/// <param name="projected">True to use the earnings projection already in
+/// the case data; false to read and calculate the case in full.</param>
+void ScenarioCalculator::calculateScenario( const PiaInputFile& in,
+unsigned index, size_t scenario, bool projected )
+{
+  if (!projected) {
+    deleteContents();
+    readCase(in, index);
+    setAssumptions();
+  }
+  LawChangeScenario& lawChangeScenario = *scenarios[scenario];
+  CalcSet *set = findCalcSet(scenarioCalcSets[scenario],
+    lawChangeScenario.getPiaParamsCache(),
+    lawChangeScenario.getLawChange());
+  calculateBenefits(set->piaCal, projected);
+}
+
+/// <summary>Returns the amounts of the last calculation.</summary>
+///
+/// <returns>The amounts of the last calculation.</returns>
+ScenarioCalculator::Amounts ScenarioCalculator::getAmounts() const
+{
+  Amounts amounts;
+  amounts.pia = piaData.highPia.get();
+  amounts.mfb = piaData.highMfb.get();
+  amounts.benefit =
+    (workerData.getJoasdi() == WorkerDataGeneral::SURVIVOR) ? 0.0 :
+    piaData.roundedBenefit.get();
+  amounts.family = 0.0;
+  for (size_t i = 0; i < secondaryArray.secondary.size(); i++) {
+    amounts.family += secondaryArray.secondary[i]->getRoundedBenefit();
+  }
+  return(amounts);
+}
+
+/// <summary>Returns the first year each scenario can change a benefit,
+/// for the assumptions of the case that has been read.</summary>
+///
+/// <returns>The first year for each scenario.</returns>
+const std::vector< int >& ScenarioCalculator::getFirstYears()
+{
+  const PiaParamsCache::Key key = PiaParamsCache::makeKey(userAssumptions);
+  map< PiaParamsCache::Key, vector< int > >::const_iterator it =
+    firstYears.find(key);
+  if (it != firstYears.end())
+    return(it->second);
+  const boost::shared_ptr< const PiaParamsAny > presentLaw =
+    piaParamsCache.get(key, userAssumptions);
+  vector< int >& first = firstYears[key];
+  for (size_t i = 0; i < scenarios.size(); i++) {
+    const boost::shared_ptr< const PiaParamsAny > params =
+      scenarios[i]->getPiaParamsCache().get(key, userAssumptions);
+    first.push_back(scenarios[i]->firstYearChanged(*presentLaw, *params));
+  }
+  return(first);
+}
+
+/// <summary>Returns the last year used by the calculation of the case.
+/// </summary>
+///
+/// <remarks>This is the latest of the benefit date, the dates of
+/// entitlement of the worker and the family members, the date of death
+/// of a deceased worker, and the last year of earnings. A Statement case
+/// projects benefits to future ages, so it uses every year.</remarks>
+///
+/// <returns>The last year used by the calculation of the case.</returns>
+int ScenarioCalculator::lastYearUsed() const
+{
+  if (workerData.getJoasdi() == WorkerDataGeneral::PEBS_CALC)
+    return(WorkerData::getMaxyear());
+  int year = workerData.getBenefitDate().getYear();
+  if (workerData.getJoasdi() == WorkerDataGeneral::SURVIVOR) {
+    year = max(year, static_cast<int>(workerData.getDeathDate().year()));
+  }
+  else {
+    year = max(year, static_cast<int>(workerData.getEntDate().getYear()));
+  }
+  if (workerData.getIndearn())
+    year = max(year, workerData.getIend());
+  for (size_t i = 0; i < secondaryArray.secondary.size(); i++) {
+    year = max(year,
+      static_cast<int>(secondaryArray.secondary[i]->entDate.getYear()));
+  }
+  return(year);
+}
+
+/// <summary>Writes the result line for a calculation in error.</summary>
+///
+/// <remarks>The same line is written to the <see cref="Trace"/>
+/// listeners, if any.</remarks>
+///
+/// <param name="out">Stream to write to.</param>
+/// <param name="name">Name of the calculation.</param>
+/// <param name="error">Error number or message.</param>
+void ScenarioCalculator::writeError( std::ostream& out,
+const std::string& name, const std::string& error )
+{
+  const string line =
+    workerData.ssn.toString() + "," + name + ",error " + error;
+  out << line << endl;
+  Trace::writeLine(line);
+}
+
+/// <summary>Writes the header line of the results.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+void ScenarioCalculator::writeHeader( std::ostream& out )
+{
+  out << "ssn,scenario,pia,mfb,benefit,family,piachange,mfbchange,"
+    << "benefitchange,familychange" << endl;
+}
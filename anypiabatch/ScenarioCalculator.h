@@ -0,0 +1,85 @@
+// Declarations for the <see cref="ScenarioCalculator"/> class to calculate
+// cases under present law and under several sets of law changes.
+
+#pragma once
+
+#include <iosfwd>
+#include <map>
+#include <string>
+#include <vector>
+#include "BatchCalculator.h"
+class LawChangeScenario;
+
+/// <summary>Calculates each case under present law and under each of a
+/// list of scenarios of law changes, giving the change in its benefits
+/// under each scenario.</summary>
+///
+/// <remarks>The result for a case is one line for present law and one line
+/// for each scenario, in the order given, with the Social Security number,
+/// the name of the scenario, the pia, the mfb, the benefit of the worker,
+/// the total benefits of the family members, and the change in each from
+/// present law (see <see cref="writeHeader"/>).
+/// A line for a calculation in error has the error number in place of the
+/// amounts; if present law is in error, the case has no other lines.
+///
+/// The work that does not depend on the law changes is done once per case:
+/// the case is read once, and its earnings are projected once, under
+/// present law. Each scenario then checks the data, limits the earnings to
+/// its own wage bases with its own child care credits, and calculates the
+/// quarters of coverage, insured status, pias, and benefits with its own
+/// calculation objects (see
+/// <see cref="PiaCalAny::calculate2Projected"/>). A Statement case, whose
+/// projection differs for each of its calculations, is read and calculated
+/// in full for each scenario.
+///
+/// A scenario that changes only the parameters, starting in a year after
+/// every year the case uses (its benefit date, dates of entitlement and
+/// death, and last year of earnings), cannot change its benefits, so the
+/// present-law results are used for it without calculating it (see
+/// <see cref="LawChangeScenario::firstYearChanged"/>). Scenarios usually
+/// start in the future, so the time per case grows more slowly than the
+/// number of scenarios.</remarks>
+///
+/// <seealso cref="LawChangeScenario"/>
+class ScenarioCalculator : public BatchCalculator
+{
+private:
+  /// <summary>Amounts compared across scenarios.</summary>
+  struct Amounts
+  {
+    /// <summary>Highest pia.</summary>
+    double pia;
+    /// <summary>Highest mfb.</summary>
+    double mfb;
+    /// <summary>Worker's benefit, rounded (0 for a survivor case).
+    /// </summary>
+    double benefit;
+    /// <summary>Total of family members' benefits, rounded.</summary>
+    double family;
+  };
+  /// <summary>Scenarios to calculate.</summary>
+  const std::vector< LawChangeScenario* >& scenarios;
+  /// <summary>Calculation objects for each snapshot of each scenario.
+  /// </summary>
+  std::vector< CalcSetMap > scenarioCalcSets;
+  /// <summary>First year each scenario can change a benefit, for each set
+  /// of assumptions.</summary>
+  std::map< PiaParamsCache::Key, std::vector< int > > firstYears;
+public:
+  ScenarioCalculator( PiaParamsCache& newPiaParamsCache, int baseYear,
+    const std::vector< LawChangeScenario* >& newScenarios );
+  ~ScenarioCalculator();
+  void calculate( const PiaInputFile& in, unsigned index,
+    std::string& result );
+  static void writeHeader( std::ostream& out );
+private:
+  void calculateScenario( const PiaInputFile& in, unsigned index,
+    size_t scenario, bool projected );
+  const std::vector< int >& getFirstYears();
+  Amounts getAmounts() const;
+  int lastYearUsed() const;
+  void writeError( std::ostream& out, const std::string& name,
+    const std::string& error );
+  ScenarioCalculator( const ScenarioCalculator& );
+  ScenarioCalculator& operator=( const ScenarioCalculator& );
+};
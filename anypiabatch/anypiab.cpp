@@ -0,0 +1,299 @@
+// Batch version of Anypia: calculates every case in a multi-record pia
+// file, using all available processors.
+//
+// Usage: anypiab [-l] [-t threads] [-b blocksize] [-p methodthreads]
+//                [-m countfile] [-g tracefile | -G tracefile]
+//                [-k cachefile] [-a awbifile]
+//                [-o format | -s lawchangefile...] infile [outfile]
+//        anypiab -c infile outfile
+//
+//   -l            long output (all pages) instead of one page per case
+//   -t threads    number of worker threads (default: number of processors)
+//   -b blocksize  number of cases handed to a thread at a time (default 64)
+//   -p methodthreads
+//                 number of extra threads each worker uses to calculate
+//                 the pia methods of a case at the same time (default 0;
+//                 the results are the same)
+//   -m countfile  count the calls of each pia calculation method, with
+//                 their time, and write the counts to countfile at the end
+//                 of the run (on systems with SIGUSR1, sending it writes the
+//                 counts so far to standard error)
+//   -g tracefile  write trace output, and a line for each case in error,
+//                 to tracefile as text, on a background thread
+//   -G tracefile  the same, in binary format (see anypiatrace to decode)
+//   -k cachefile  restore the cases whose text is unchanged since the last
+//                 run with this cache file without parsing them, and save
+//                 the cases of this run to it (see CaseCache.h)
+//   -a awbifile   change the historical benefit increases, average wages,
+//                 and wage bases stored in the program to the values in
+//                 awbifile, one per line as parameter, year, and value (see
+//                 AwbiData::readChanges)
+//   -o format     write the results of each case as records instead of the
+//                 printed output: csv for comma-separated lines, or json
+//                 for one JSON object per line (see RecordCalculator.h)
+//   -s lawchangefile
+//                 calculate each case under present law and under the law
+//                 changes in lawchangefile, writing comma-separated lines of
+//                 the pia, mfb, and benefits and their changes from present
+//                 law instead of the printed output; may be given more than
+//                 once, for several scenarios (see ScenarioCalculator.h)
+//   -c            convert infile to the other format, without calculating:
+//                 a pia file to a columnar population file, or a columnar
+//                 population file to a pia file
+//
+// The input may be a pia file or a columnar population file (see
+// PiaColumnFile.h). If outfile is omitted, the results are written to
+// standard output.
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "boost/scoped_ptr.hpp"
+#include "boost/thread/thread.hpp"
+#include "BatchCalculator.h"
+#include "BatchDriver.h"
+#include "CaseCache.h"
+#include "RecordCalculator.h"
+#include "ScenarioCalculator.h"
+#include "LawChangeScenario.h"
+#include "BaseYearNonFile.h"
+#include "AwbiDataNonFile.h"
+#include "AssumptionsNonFile.h"
+#include "LawChangeArray.h"
+#include "PiaParamsCache.h"
+#include "PiaMappedFile.h"
+#include "PiaColumnFile.h"
+#include "PiaColumnWrite.h"
+#include "PiaColumnConvert.h"
+#include "PiaException.h"
+#include "AsyncTraceListener.h"
+#include "Trace.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Prints usage message.</summary>
+void usage()
+{
+  cerr << "Usage: anypiab [-l] [-t threads] [-b blocksize]"
+    << " [-p methodthreads] [-m countfile]" << endl;
+  cerr << "               [-g tracefile | -G tracefile] [-k cachefile]"
+    << " [-a awbifile]" << endl;
+  cerr << "               [-o format | -s lawchangefile...] infile [outfile]"
+    << endl;
+  cerr << "       anypiab -c infile outfile" << endl;
+}
+
+#if defined(SIGUSR1)
+/// <summary>Requests a dump of the method counts.</summary>
+void countersSignal( int )
+{
+  BatchDriver::requestCounters();
+}
+#endif
+
+}  // namespace
+
+int main( int argc, char *argv[] )
+{
+  bool longOutput = false;
+  bool convert = false;
+  unsigned threads = boost::thread::hardware_concurrency();
+  unsigned blockSize = 64u;
+  unsigned methodThreads = 0u;
+  const char *countFile = 0;
+  const char *traceFile = 0;
+  bool traceBinary = false;
+  const char *cacheFile = 0;
+  const char *awbiFile = 0;
+  const char *recordFormat = 0;
+  vector< const char * > scenarioFiles;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-l") == 0) {
+      longOutput = true;
+    }
+    else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+      threads = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+      blockSize = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      methodThreads = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-c") == 0) {
+      convert = true;
+    }
+    else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc) {
+      countFile = argv[++i];
+    }
+    else if ((strcmp(argv[i], "-g") == 0 || strcmp(argv[i], "-G") == 0) &&
+      i + 1 < argc) {
+      traceBinary = (argv[i][1] == 'G');
+      traceFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+      cacheFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+      awbiFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc &&
+      (strcmp(argv[i + 1], "csv") == 0 || strcmp(argv[i + 1], "json") == 0)) {
+      recordFormat = argv[++i];
+    }
+    else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+      scenarioFiles.push_back(argv[++i]);
+    }
+    else {
+      usage();
+      return 1;
+    }
+  }
+  if (i >= argc || argc - i > 2 || (convert && argc - i != 2) ||
+    (recordFormat != 0 && !scenarioFiles.empty())) {
+    usage();
+    return 1;
+  }
+  if (threads == 0u)
+    threads = 1u;
+  ofstream outfile;
+  if (i + 1 < argc) {
+    // a columnar population file is binary
+    outfile.open(argv[i + 1], convert ? ios::out | ios::binary : ios::out);
+    if (!outfile) {
+      cerr << "anypiab: cannot open " << argv[i + 1] << endl;
+      return 1;
+    }
+  }
+  ostream& out = (i + 1 < argc) ? outfile : cout;
+  int retval = 0;
+  try {
+    BatchCalculator::setStatics();
+    BaseYearNonFile baseYear;
+    if (convert) {
+      PiaColumnConvert converter(baseYear.getYear());
+      unsigned long cases;
+      if (PiaColumnFile::isColumnFile(argv[i])) {
+        const PiaColumnFile in(argv[i]);
+        cases = converter.toText(in, out);
+      }
+      else {
+        const PiaMappedFile in(argv[i]);
+        PiaColumnWrite columns(out);
+        cases = converter.toColumns(in, columns);
+      }
+      cerr << "anypiab: " << cases << " cases converted" << endl;
+      return retval;
+    }
+    AwbiDataNonFile awbiData(baseYear.getYear(), WorkerData::getMaxyear());
+    if (awbiFile != 0) {
+      ifstream awbiIn(awbiFile);
+      if (!awbiIn)
+        throw PiaException(string("Cannot open ") + awbiFile);
+      const unsigned changes = awbiData.readChanges(awbiIn);
+      cerr << "anypiab: " << changes << " historical parameters changed"
+        << endl;
+    }
+    AssumptionsNonFile assumptions(baseYear.getYear(),
+      WorkerData::getMaxyear());
+    LawChangeArray lawChange(baseYear.getYear(), WorkerData::getMaxyear(),
+      "");
+    // parameters are projected once per set of assumptions, for all threads
+    PiaParamsCache piaParamsCache(baseYear.getYear(),
+      WorkerData::getMaxyear(), awbiData, lawChange, assumptions);
+    vector< LawChangeScenario* > scenarios;
+    for (size_t j = 0; j < scenarioFiles.size(); j++) {
+      scenarios.push_back(new LawChangeScenario(scenarioFiles[j],
+        baseYear.getYear()));
+    }
+    boost::scoped_ptr< CaseCache > caseCache(
+      (cacheFile != 0) ? new CaseCache(cacheFile, baseYear.getYear()) : 0);
+    const RecordCalculator::format_type format =
+      (recordFormat != 0 && strcmp(recordFormat, "json") == 0) ?
+      RecordCalculator::JSON : RecordCalculator::CSV;
+    // all calculators are created here, before any thread is started
+    vector< BatchCalculator* > calculators;
+    for (unsigned j = 0; j < threads; j++) {
+      if (!scenarios.empty()) {
+        calculators.push_back(new ScenarioCalculator(piaParamsCache,
+          baseYear.getYear(), scenarios));
+      }
+      else if (recordFormat != 0) {
+        calculators.push_back(new RecordCalculator(piaParamsCache,
+          baseYear.getYear(), format));
+      }
+      else {
+        calculators.push_back(new BatchCalculator(piaParamsCache,
+          baseYear.getYear(), longOutput));
+      }
+      calculators.back()->setMethodCounting(countFile != 0);
+      calculators.back()->setMethodThreads(methodThreads);
+      calculators.back()->setCaseCache(caseCache.get());
+    }
+    boost::scoped_ptr< const PiaInputFile > in(
+      PiaColumnFile::isColumnFile(argv[i]) ?
+      static_cast< PiaInputFile* >(new PiaColumnFile(argv[i])) :
+      static_cast< PiaInputFile* >(new PiaMappedFile(argv[i])));
+    ofstream traceOut;
+    boost::scoped_ptr< AsyncTraceListener > listener;
+    if (traceFile != 0) {
+      traceOut.open(traceFile, traceBinary ? ios::out | ios::binary :
+        ios::out);
+      if (!traceOut)
+        throw PiaException(string("Cannot open ") + traceFile);
+      listener.reset(new AsyncTraceListener(&traceOut, traceBinary));
+      Trace::getListeners().push_back(listener.get());
+    }
+    BatchDriver driver(calculators, blockSize);
+    if (!scenarios.empty())
+      ScenarioCalculator::writeHeader(out);
+    else if (recordFormat != 0)
+      RecordCalculator::writeHeader(out, format);
+    if (countFile != 0) {
+      driver.setCountersOut(&cerr);
+#if defined(SIGUSR1)
+      signal(SIGUSR1, countersSignal);
+#endif
+    }
+    const unsigned long cases = driver.run(*in, out);
+    cerr << "anypiab: " << cases << " cases calculated on " << threads
+      << " threads" << endl;
+    if (caseCache) {
+      cerr << "anypiab: " << caseCache->getHitCount()
+        << " cases restored from " << cacheFile << ", "
+        << caseCache->getAddedCount() << " added" << endl;
+      caseCache->save();
+    }
+    if (listener) {
+      listener->close();
+      Trace::getListeners().clear();
+      if (listener->getDropped() > 0ul) {
+        cerr << "anypiab: " << listener->getDropped()
+          << " trace records dropped" << endl;
+      }
+    }
+    if (countFile != 0) {
+      ofstream counts(countFile);
+      if (!counts)
+        throw PiaException(string("Cannot open ") + countFile);
+      driver.writeCounters(counts);
+    }
+    for (size_t j = 0; j < calculators.size(); j++) {
+      delete calculators[j];
+    }
+    for (size_t j = 0; j < scenarios.size(); j++) {
+      delete scenarios[j];
+    }
+  } catch (PiaException& e) {
+    cerr << "anypiab: error " << e.getNumber() << " " << e.what() << endl;
+    retval = 1;
+  }
+  return retval;
+}
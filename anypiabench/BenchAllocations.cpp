@@ -0,0 +1,54 @@
+// Functions for the <see cref="BenchAllocations"/> class to count the
+// memory allocations of the benchmark program.
+
+#include <cstdlib>
+#include <new>
+#include "BenchAllocations.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Number of allocations made so far.</summary>
+unsigned long allocationCount = 0ul;
+
+}  // namespace
+
+/// <summary>Returns the number of allocations made so far.</summary>
+///
+/// <returns>The number of allocations made so far.</returns>
+unsigned long BenchAllocations::getCount()
+{
+  return(allocationCount);
+}
+
+/// <summary>Allocates memory, counting the allocation.</summary>
+///
+/// <returns>The memory allocated.</returns>
+///
+/// <param name="size">Number of bytes.</param>
+void *operator new( std::size_t size )
+{
+  allocationCount++;
+  void *p = malloc((size > 0) ? size : 1);
+  if (p == 0)
+    throw std::bad_alloc();
+  return(p);
+}
+
+/// <summary>Releases memory allocated by operator new.</summary>
+///
+/// <param name="p">Memory to release.</param>
+void operator delete( void *p ) throw()
+{
+  free(p);
+}
+
+/// <summary>Releases memory allocated by operator new, of a known size.
+/// </summary>
+///
+/// <param name="p">Memory to release.</param>
+void operator delete( void *p, std::size_t ) throw()
+{
+  free(p);
+}
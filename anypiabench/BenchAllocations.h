@@ -0,0 +1,19 @@
+// Declarations for the <see cref="BenchAllocations"/> class to count the
+// memory allocations of the benchmark program.
+
+#pragma once
+
+/// <summary>Counts the memory allocations of the benchmark program.
+/// </summary>
+///
+/// <remarks>The global operator new is replaced in this program only, and
+/// counts each allocation; operator delete is replaced in both its unsized
+/// and sized forms to match. The replacements are in their own source file,
+/// so that they are not inlined into the new and delete expressions of the
+/// rest of the program. The count is not synchronized, since the benchmark
+/// runs on one thread.</remarks>
+class BenchAllocations
+{
+public:
+  static unsigned long getCount();
+};
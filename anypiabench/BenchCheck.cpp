@@ -0,0 +1,1441 @@
+// Functions for the <see cref="BenchCheck"/> class to check that the
+// faster calculations give the same results as the ones they replace.
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "boost/scoped_ptr.hpp"
+#include "BenchCheck.h"
+#include "BenchPopulation.h"
+#include "ClaimAgeBenefit.h"
+#include "CohortBatch.h"
+#include "CalcArena.h"
+#include "DateIndex.h"
+#include "dbleann.h"
+#include "LawChange.h"
+#include "LawChangePSAACCT.h"
+#include "LawChangeScenario.h"
+#include "inscode.h"
+#include "piacal.h"
+#include "PiaException.h"
+#include "piaparms.h"
+#include "pibtable.h"
+#include "PsaSimulation.h"
+#include "QcBitset.h"
+#include "qtryear.h"
+#include "TaxBatch.h"
+#include "WageInd.h"
+#include "WageIndBatch.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Returns the text of a law-change file with one law change.
+/// </summary>
+///
+/// <remarks>The change is in effect for all persons for three years, with
+/// parameters that change benefits, where the change uses any.</remarks>
+///
+/// <returns>The text of the law-change file.</returns>
+///
+/// <param name="type">Type of the law change.</param>
+/// <param name="startYear">First year of the law change.</param>
+string lawChangeText( int type, int startYear )
+{
+  const int endYear = startYear + 2;
+  ostringstream out;
+  out << "law change " << type << endl;
+  for (int i = 0; i < LawChange::MAXLCH; i++) {
+    out << ((i == type) ? " 1" : " 0");
+  }
+  out << endl << startYear << " " << endYear << " 1";
+  switch (type) {
+  case LawChange::AGE65COMP:
+  case LawChange::DROPOUTCHG:
+    out << " 1" << endl;
+    break;
+  case LawChange::BPFRACWAGE:
+    out << " 0.9" << endl;
+    break;
+  case LawChange::BPMINCONST:
+    out << " 1.5" << endl;
+    break;
+  case LawChange::BPSPECRATE:
+    out << " 1.0 1.5 2.0" << endl;
+    break;
+  case LawChange::CHILDCARECREDIT:
+    out << " 0.5 6 5 0" << endl;
+    break;
+  case LawChange::CHILDCAREDROPOUT:
+    out << " 0.5 6 5" << endl;
+    break;
+  case LawChange::COLACHANGE:
+    out << " -0.5" << endl;
+    break;
+  case LawChange::DECLINEPERC:
+    out << " 1.0 1.0 1.0" << endl;
+    break;
+  case LawChange::MARRLENGTH:
+    out << " 5" << endl;
+    break;
+  case LawChange::NEWFORMULA:
+    out << endl << "2" << endl;
+    for (int year = startYear; year <= endYear; year++) {
+      out << "0.9 0.32 0.15 1000 6000" << endl;
+    }
+    break;
+  case LawChange::NEWSPECMIN:
+    out << endl << "20" << endl;
+    break;
+  case LawChange::PSAACCT:
+    out << " 0.5 0 0.03 0 0 0 0 0 22 0 0 0 0 0 0" << endl
+      << "0.03 0 0 0 0.07 0.17 0 0" << endl << startYear << " 2" << endl;
+    break;
+  case LawChange::TAXRATECHG:
+    out << " 1" << endl << startYear << " 5.0 1.0 6.0" << endl;
+    break;
+  case LawChange::WAGEBASECHG:
+    out << endl << "20000 21000 22000" << endl;
+    break;
+  default:
+    out << endl;
+  }
+  return(out.str());
+}
+
+/// <summary>Returns the total quarters of coverage of
+/// <see cref="PiaData::qcTotalCal"/>, summing the quarters of coverage of
+/// each year as before <see cref="QcBitset"/>.</summary>
+///
+/// <remarks>The quarters of coverage before 1951 are those set by the last
+/// call to <see cref="PiaData::qcTotalCal"/>.</remarks>
+///
+/// <returns>The total quarters of coverage through the quarter.</returns>
+///
+/// <param name="workerData">Worker's basic data.</param>
+/// <param name="piaData">Worker's calculated data.</param>
+/// <param name="qtrYear">Last quarter counted.</param>
+int qcTotalOld( const WorkerDataGeneral& workerData, const PiaData& piaData,
+const QtrYear& qtrYear )
+{
+  const int qcTotal50 =
+    max(piaData.getQcTotal50(), piaData.getQc3750simp());
+  if (workerData.hasQcsByYear()) {
+    return(qcTotal50 +
+      static_cast<int>(piaData.qcov.accumulate(QtrYear(0, 1951), qtrYear, 0u)));
+  }
+  const unsigned qcTotal51 = piaData.qcovMilServ.accumulate(1951, 1956,
+    workerData.getQctot51td()) + workerData.getQcovRR5177();
+  return(qcTotal50 + static_cast<int>(
+    piaData.qcov.accumulate(QtrYear(0, 1978), qtrYear, qcTotal51)));
+}
+
+/// <summary>Returns the quarters of coverage in the disability insured
+/// period of <see cref="PiaData::qcDisCal"/>, summing the quarters of
+/// coverage of each year as before <see cref="QcBitset"/>.</summary>
+///
+/// <returns>The quarters of coverage in the period set by the last call to
+/// <see cref="PiaData::qcDisReqCal"/>.</returns>
+///
+/// <param name="piaData">Worker's calculated data.</param>
+int qcTotalDisOld( const PiaData& piaData )
+{
+  unsigned qcTotalDis = 0u;
+  if (piaData.getQcDisDate1().getYear() > 0) {
+    qcTotalDis = piaData.qcov.accumulate(piaData.getQcDisDate1(),
+      piaData.getQcDisDate2(), qcTotalDis);
+  }
+  if (piaData.getQcDisDate3().getYear() > 0) {
+    qcTotalDis = piaData.qcov.accumulate(piaData.getQcDisDate3(),
+      piaData.getQcDisDate4(), qcTotalDis);
+  }
+  if (piaData.getQcDisDate5().getYear() > 0) {
+    qcTotalDis = piaData.qcov.accumulate(piaData.getQcDisDate5(),
+      piaData.getQcDisDate6(), qcTotalDis);
+  }
+  return(static_cast<int>(qcTotalDis));
+}
+
+/// <summary>Returns the quarters of coverage in the disability insured
+/// period finally used by <see cref="PiaCal::disInsCal"/>, trying the same
+/// periods in the same order but with <see cref="qcTotalDisOld"/>.
+/// </summary>
+///
+/// <remarks>The periods tried and the quarters of coverage required are
+/// left in <paramref name="piaData"/>.</remarks>
+///
+/// <returns>The quarters of coverage in the last period tried.</returns>
+///
+/// <param name="workerData">Worker's basic data.</param>
+/// <param name="piaData">Worker's calculated data.</param>
+/// <param name="dateMoyr">Date for which insured status is required.</param>
+int disInsOld( const WorkerDataGeneral& workerData, PiaData& piaData,
+const DateMoyr& dateMoyr )
+{
+  QtrYear qtrYear21(piaData.getBirthIndexMinus1().toDateMoyr());
+  qtrYear21.add(QtrYear(1, 21));
+  int trial = 0;
+  const DisabPeriod& disabPeriod = workerData.disabPeriod[0];
+  piaData.qcDisReq2Cal(workerData, dateMoyr);
+  if (piaData.getQcDisQtr2() < 40 && workerData.getValdi() > 0 &&
+    disabPeriod.getWaitperDate().getYear() > 0) {
+    trial = 4 * (disabPeriod.getWaitperDate().getYear() -
+      disabPeriod.getOnsetDate().year()) +
+      (disabPeriod.getWaitperDate().getMonth() + 2) / 3 -
+      (disabPeriod.getOnsetDate().month() + 2) / 3;
+  }
+  // the usual periods, then the special periods before age 21, then each
+  // of those using the freeze period in a previous disability
+  int qcTotalDis = 0;
+  for (int pass = 0; pass < 4; pass++) {
+    const bool dospecial = (pass % 2 == 1);
+    const bool dofreeze = (pass > 1);
+    if (pass > 0) {
+      const QtrYear& startQtrYear =
+        (piaData.getQcDisDate5().getYear() > 0) ?
+        piaData.getQcDisDate5() : piaData.getQcDisDate1();
+      if (qcTotalDis >= piaData.getQcDisReq() ||
+        (dofreeze && piaData.getQcDisDate5().getYear() == 0) ||
+        (dospecial && !(startQtrYear < qtrYear21)))
+        continue;
+    }
+    for (int i = 0; i <= trial; i++) {
+      piaData.qcDisReqCal(workerData, dateMoyr, dospecial ? i : trial - i,
+        dospecial, dofreeze);
+      qcTotalDis = qcTotalDisOld(piaData);
+      if (qcTotalDis >= piaData.getQcDisReq())
+        break;
+    }
+  }
+  return(qcTotalDis);
+}
+
+/// <summary>Returns the date fully insured status is first attained, from
+/// <see cref="PiaCal::fullInsDateCal"/> with <see cref="qcTotalOld"/>.
+/// </summary>
+///
+/// <returns>The first date of full insured status, starting with the date
+/// of full retirement age, or the first quarter not before the benefit
+/// date if never fully insured before it.</returns>
+///
+/// <param name="workerData">Worker's basic data.</param>
+/// <param name="piaData">Worker's calculated data.</param>
+/// <param name="ioasdi">Type of benefit.</param>
+DateMoyr fullInsDateOld( const WorkerDataGeneral& workerData,
+PiaData& piaData, WorkerDataGeneral::ben_type ioasdi )
+{
+  QtrYear qtrYear(piaData.getFullRetDate());
+  do {
+    piaData.setQcTotal(qcTotalOld(workerData, piaData, qtrYear));
+    if (InsCode(PiaCal::insCal(workerData, piaData, ioasdi, qtrYear,
+      1)).isFullyOrTotalInsured())
+      return(qtrYear.toDateMoyr());
+    qtrYear.add(1);
+  } while (qtrYear.toDateMoyr() < workerData.getBenefitDate());
+  return(qtrYear.toDateMoyr());
+}
+
+/// <summary>Returns the earliest retirement age for an old-age or aged
+/// spouse benefit, as <see cref="PiaParams::earlyAgeOabCalPL"/> found it
+/// from a <c>boost::gregorian::date</c>.</summary>
+///
+/// <returns>Earliest possible retirement age.</returns>
+///
+/// <param name="sex">Sex of the worker.</param>
+/// <param name="kbirth">The date of birth, adjusted to previous day.</param>
+Age earlyAgeOabOld( Sex::sex_type sex, const boost::gregorian::date& kbirth )
+{
+  using boost::gregorian::date;
+  const bool male = (sex == Sex::MALE);
+  const date first62 = male ? date(1899, 7, 31) : date(1894, 10, 31);
+  const date second62 = male ? date(1896, 8, 31) : date(1891, 11, 30);
+  if (first62 < kbirth) {
+    return((date(1919, 8, 31) < kbirth && kbirth.day() != 1) ?
+      PiaParams::age621 : PiaParams::age62);
+  }
+  else if (kbirth <= first62 && second62 < kbirth) {
+    return((male ? PiaParams::amend61 : PiaParams::amend56) -
+      DateMoyr(kbirth));
+  }
+  return(PiaParams::age65);
+}
+
+/// <summary>Returns the number of months of delayed retirement credit, as
+/// <see cref="PiaParams::monthsDriCal"/> found it from the month and year
+/// of a <c>boost::gregorian::date</c>.</summary>
+///
+/// <returns>Number of months of delayed retirement credit.</returns>
+///
+/// <param name="fullRetDate">The date of full retirement age.</param>
+/// <param name="eligYear">The year of eligibility.</param>
+/// <param name="dobadj">The date of birth, adjusted to previous day.
+/// </param>
+/// <param name="entDate">The date of entitlement.</param>
+/// <param name="benefitDate">The date of benefit.</param>
+/// <param name="fullInsDate">The date fully insured status is attained.
+/// </param>
+int monthsDriOld( const DateMoyr& fullRetDate, int eligYear,
+const boost::gregorian::date& dobadj, const DateMoyr& entDate,
+const DateMoyr& benefitDate, const DateMoyr& fullInsDate )
+{
+  const int i1 = max(max(fullRetDate.index(), fullInsDate.index()), 0);
+  int i4;
+  if (eligYear <= 1975) {
+    i4 = (DateMoyr(dobadj) + PiaParams::age72).index();
+    if (eligYear >= 1974 && i4 > PiaParams::amend83.index())
+      i4 = PiaParams::amend83.index();
+  }
+  else {
+    i4 = (DateMoyr(dobadj) + PiaParams::age70).index();
+  }
+  const int i5 = entDate.index();
+  const int i6 = max(max(fullRetDate.index(), fullInsDate.index()),
+    DateMoyr(boost::date_time::Jan, entDate.getYear()).index());
+  int i2;
+  if (i4 <= i5)
+    i2 = i4;
+  else if (i4 <= benefitDate.index() ||
+    benefitDate.getYear() > entDate.getYear())
+    i2 = i5;
+  else
+    i2 = i6;
+  if (entDate < PiaParams::amend722)
+    i2 = 0;
+  return(max(i2 - i1, 0));
+}
+
+}  // namespace
+
+/// <summary>Initializes the calculation objects.</summary>
+///
+/// <param name="newPiaParamsCache">Shared parameter snapshots.</param>
+/// <param name="newBaseYear">First year of projections.</param>
+BenchCheck::BenchCheck( PiaParamsCache& newPiaParamsCache,
+int newBaseYear ) :
+BatchCalculator(newPiaParamsCache, newBaseYear, false),
+baseYear(newBaseYear)
+{ }
+
+/// <summary>Destructor.</summary>
+BenchCheck::~BenchCheck()
+{ }
+
+/// <summary>Does every check.</summary>
+///
+/// <returns>The total number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result of each check to.</param>
+unsigned long BenchCheck::checkAll( const BenchPopulation& population,
+std::ostream& out )
+{
+  unsigned long differences = 0ul;
+  differences += checkClaimAgeSweep(population, out);
+  differences += checkCohortBatch(population, out);
+  differences += checkDateIndex(out);
+  differences += checkIncremental(population, out);
+  differences += checkPibTables(out);
+  differences += checkArenaReuse(population, out);
+  differences += checkTaxBatch(population, out);
+  differences += checkScenarios(population, out);
+  differences += checkPsaSimulation(population, out);
+  differences += checkQcBitset(population, out);
+  differences += checkWageIndBatch(population, out);
+  return(differences);
+}
+
+/// <summary>Checks that the heap allocations counted for arenas and
+/// annual arrays stay flat once the arenas have been reused.</summary>
+///
+/// <remarks>First, annual arrays are created in a small arena, which must
+/// take blocks from the heap and count them (see
+/// <see cref="CalcArena::getThreadAllocations"/>); after a reset, the same
+/// arrays must fit in the arena with no more blocks. Then every case is
+/// calculated twice, as in <see cref="BatchCalculator::calculate"/>: the
+/// first time grows the arenas (if earlier checks have not already), so
+/// the count must not change the second time. Each block taken when none
+/// should be, and a small arena that takes no block the first time, is a
+/// difference.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkArenaReuse(
+const BenchPopulation& population, std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  CalcArena arena(1024u);
+  for (int pass = 0; pass < 2; pass++) {
+    const unsigned long start = CalcArena::getThreadAllocations();
+    {
+      CalcArena::Scope scope(&arena);
+      DoubleAnnual earnings1(YEAR37, WorkerData::getMaxyear());
+      DoubleAnnual earnings2(YEAR37, WorkerData::getMaxyear());
+      DoubleAnnual earnings3(YEAR37, WorkerData::getMaxyear());
+    }
+    arena.reset();
+    const unsigned long allocations =
+      CalcArena::getThreadAllocations() - start;
+    compared++;
+    if ((pass == 0) ? (allocations == 0ul) : (allocations > 0ul))
+      differences++;
+  }
+  string result;
+  for (int pass = 0; pass < 2; pass++) {
+    const unsigned long start = CalcArena::getThreadAllocations();
+    for (unsigned i = 0; i < population.getRecordCount(); i++) {
+      calculate(population, i, result);
+    }
+    const unsigned long allocations =
+      CalcArena::getThreadAllocations() - start;
+    if (pass > 0) {
+      compared += population.getRecordCount();
+      differences += allocations;
+    }
+  }
+  writeResult(out, "arena reuse", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the benefits of a claim-age sweep against a full
+/// calculation for each month of entitlement.</summary>
+///
+/// <remarks>Up to <see cref="MAX_SWEEP_CASES"/> old-age cases are swept
+/// with <see cref="PiaCalAny::claimAgeSweep"/>. The pia, the benefit
+/// before and after rounding, the number of months of reduction or credit,
+/// and the factor for each month are compared with those of a calculation
+/// of the case with entitlement in that month. A sweep that fails, or that
+/// does not leave the dates of the case as they were, is also counted as a
+/// difference.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkClaimAgeSweep(
+const BenchPopulation& population, std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  unsigned cases = 0u;
+  vector< ClaimAgeBenefit > results;
+  for (unsigned i = 0; i < population.getRecordCount() &&
+    cases < MAX_SWEEP_CASES; i++) {
+    if (!readCheckCase(population, i) ||
+      workerData.getJoasdi() != WorkerDataGeneral::OLD_AGE)
+      continue;
+    cases++;
+    const DateMoyr entDate = workerData.getEntDate();
+    const DateMoyr benefitDate = workerData.getBenefitDate();
+    try {
+      calcSet->piaCal.claimAgeSweep(results);
+    } catch (PiaException&) {
+      differences++;
+      continue;
+    }
+    if (!(workerData.getEntDate() == entDate) ||
+      !(workerData.getBenefitDate() == benefitDate))
+      differences++;
+    for (vector< ClaimAgeBenefit >::const_iterator it = results.begin();
+      it != results.end(); ++it) {
+      if (!readCheckCase(population, i))
+        break;
+      PiaCalAny& piaCal = calcSet->piaCal;
+      try {
+        workerData.setEntDate(it->entDate);
+        workerData.setBenefitDate(it->entDate);
+        piaCal.dataCheck(it->entDate);
+        piaCal.calculate2(it->entDate);
+      } catch (PiaException&) {
+        continue;
+      }
+      compared++;
+      if (piaData.highPia.get() != it->pia.get() ||
+        piaData.unroundedBenefit.get() != it->unroundedBenefit.get() ||
+        piaData.roundedBenefit.get() != it->roundedBenefit.get() ||
+        piaData.getMonthsArdri() != it->monthsArdri ||
+        piaData.getArf() != it->arf)
+        differences++;
+    }
+  }
+  writeResult(out, "claim-age sweep months", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the pias of cohorts calculated in a batch against the
+/// pias of each worker calculated in turn.</summary>
+///
+/// <remarks>Each old-age case is made into a cohort of
+/// <see cref="COHORT_SIZE"/> workers with its dates, and its earnings by
+/// year (see <see cref="EarnProject::earnpebs"/>) multiplied by factors
+/// from a tenth to four. Each worker is calculated with
+/// <see cref="BatchCalculator::calculateBenefits"/> and added to a
+/// <see cref="CohortBatch"/>, with the earnings of the calculation. The
+/// quarters of coverage of each year from 1978 through entitlement, the
+/// total through the quarter of entitlement, and insured status are
+/// compared for every worker; the AIME and the wage-indexed pia at
+/// eligibility and at the benefit date are also compared for a worker who
+/// is fully insured and not marked for the per-worker calculation (see
+/// <see cref="CohortBatch::needsWorkerCalculation"/>).</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkCohortBatch(
+const BenchPopulation& population, std::ostream& out )
+{
+  static const double factors[COHORT_SIZE] =
+    { 0.1, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 4.0 };
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  vector< double > earnings;
+  // quarters of coverage and insured status, and pias (empty if the
+  // worker is not fully insured), of each worker calculated in turn
+  vector< vector< double > > expected(COHORT_SIZE);
+  vector< vector< double > > expectedPias(COHORT_SIZE);
+  vector< double > amounts;
+  vector< double > pias;
+  for (unsigned i = 0; i < population.getRecordCount(); i++) {
+    if (!readCheckCase(population, i) ||
+      workerData.getJoasdi() != WorkerDataGeneral::OLD_AGE)
+      continue;
+    PiaCalAny& piaCal = calcSet->piaCal;
+    const int entYear = workerData.getEntDate().getYear();
+    const int lastYear = WorkerData::getMaxyear();
+    CohortBatch batch(piaCal.piaParams, lastYear, COHORT_SIZE);
+    batch.clear(workerData.getBirthDate(), workerData.getEntDate(),
+      workerData.getBenefitDate());
+    earnings.clear();
+    for (int year = earnProject.getFirstYear();
+      year <= earnProject.getLastYear(); year++) {
+      earnings.push_back(earnProject.earnpebs[year]);
+    }
+    for (unsigned j = 0; j < COHORT_SIZE; j++) {
+      for (int year = earnProject.getFirstYear();
+        year <= earnProject.getLastYear(); year++) {
+        earnProject.earnpebs[year] =
+          factors[j] * earnings[year - earnProject.getFirstYear()];
+      }
+      try {
+        calculateBenefits(piaCal, false);
+      } catch (PiaException&) {
+        continue;
+      }
+      const unsigned worker = batch.add(piaData.earnOasdi,
+        workerData.getQctottd() - workerData.getQctot51td(),
+        workerData.getQctot51td());
+      vector< double >& workerAmounts = expected[worker];
+      workerAmounts.clear();
+      for (int year = CohortBatch::FIRST_QC_YEAR;
+        year <= min(entYear, lastYear); year++) {
+        workerAmounts.push_back(piaData.qcov.get(year));
+      }
+      workerAmounts.push_back(piaData.getQcTotal());
+      workerAmounts.push_back(piaData.finsCode.isFullyInsured() ? 1.0 : 0.0);
+      vector< double >& workerPias = expectedPias[worker];
+      workerPias.clear();
+      if (piaData.finsCode.isFullyInsured() && piaCal.wageInd != 0) {
+        workerPias.push_back(piaCal.wageInd->getAme());
+        workerPias.push_back(
+          piaCal.wageInd->piaElig[piaData.getEligYear() - 1]);
+        workerPias.push_back(piaCal.wageInd->piaEnt.get());
+      }
+    }
+    for (int year = earnProject.getFirstYear();
+      year <= earnProject.getLastYear(); year++) {
+      earnProject.earnpebs[year] = earnings[year - earnProject.getFirstYear()];
+    }
+    batch.calculate();
+    for (unsigned worker = 0; worker < batch.getWorkerCount(); worker++) {
+      amounts.clear();
+      for (int year = CohortBatch::FIRST_QC_YEAR;
+        year <= min(entYear, lastYear); year++) {
+        amounts.push_back(batch.getQcs(worker, year));
+      }
+      amounts.push_back(batch.getQcTotal(worker));
+      amounts.push_back(batch.isFullyInsured(worker) ? 1.0 : 0.0);
+      pias.clear();
+      if (batch.isFullyInsured(worker)) {
+        pias.push_back(batch.getAime(worker));
+        pias.push_back(batch.getPiaElig(worker));
+        pias.push_back(batch.getPiaBen(worker));
+      }
+      compared++;
+      // the pias are not compared if another method may apply
+      if (amounts != expected[worker] ||
+        (!batch.needsWorkerCalculation(worker) &&
+        pias != expectedPias[worker]))
+        differences++;
+    }
+  }
+  writeResult(out, "cohort batch workers", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks dates and ages found with <see cref="DateIndex"/>
+/// against those found from the <c>boost::gregorian::date</c> as before.
+/// </summary>
+///
+/// <remarks>Every day from January 1, 1880, through December 31, 2009, is
+/// taken as the day before a birth, so the last day of each month and
+/// February 29 of each leap year are all included. For each day, the year,
+/// month, day, and month and year of the <see cref="DateIndex"/> are
+/// compared with those of the boost date; the order and equality of the day
+/// and each of several later days, with the boost order; the month and
+/// year and the day at each of several ages (see
+/// <see cref="DateIndex::operator+"/>), with the month and year of the boost
+/// date plus the age; and the age at each of several later dates and at the
+/// 1956 and 1961 amendments (see <see cref="DateIndex::operator-"/>), with
+/// the difference of the months and years. Two dates in the wrong order
+/// must throw in both. The earliest retirement age of
+/// <see cref="PiaParams::earlyAgeOabCalPL"/> for each sex, and the months of
+/// delayed retirement credit of <see cref="PiaParams::monthsDriCal"/> for
+/// entitlement at several ages and benefits at entitlement and a year
+/// later, are compared with those found from the boost date.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkDateIndex( std::ostream& out )
+{
+  static const Age ages[] = { Age(0, 0), Age(0, 1), Age(0, 11),
+    PiaParams::age16, PiaParams::age18, Age(21, 0), PiaParams::age22,
+    PiaParams::age50, PiaParams::age60, PiaParams::age62,
+    PiaParams::age621, Age(62, 11), PiaParams::age65, PiaParams::age65_2,
+    PiaParams::age65_10, PiaParams::age66, PiaParams::age66_2,
+    PiaParams::age66_10, PiaParams::age67, PiaParams::age70,
+    PiaParams::age72, PiaParams::age75 };
+  static const int numAges = sizeof(ages) / sizeof(ages[0]);
+  static const int laterDays[] = { 0, 1, 28, 29, 30, 31, 365, 366, 20000 };
+  static const int numLaterDays = sizeof(laterDays) / sizeof(laterDays[0]);
+  static const Age entAges[] = { PiaParams::age62, PiaParams::age65,
+    PiaParams::age66_6, PiaParams::age67, Age(69, 11), PiaParams::age70,
+    Age(71, 6), PiaParams::age72 };
+  static const int numEntAges = sizeof(entAges) / sizeof(entAges[0]);
+  const boost::gregorian::date lastDate(2009, 12, 31);
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  for (boost::gregorian::date kbirth(1880, 1, 1); kbirth <= lastDate;
+    kbirth += boost::gregorian::days(1)) {
+    const DateIndex dateIndex(kbirth);
+    const DateMoyr dateMoyr(kbirth);
+    compared++;
+    if (dateIndex.getYear() != kbirth.year() ||
+      dateIndex.getMonth() != kbirth.month() ||
+      dateIndex.getDay() != kbirth.day() ||
+      !(dateIndex.toDateMoyr() == dateMoyr))
+      differences++;
+    for (int j = 0; j < numLaterDays; j++) {
+      const boost::gregorian::date later =
+        kbirth + boost::gregorian::days(laterDays[j]);
+      const DateIndex laterIndex(later);
+      compared++;
+      if ((dateIndex < laterIndex) != (kbirth < later) ||
+        (laterIndex < dateIndex) != (later < kbirth) ||
+        (dateIndex == laterIndex) != (kbirth == later))
+        differences++;
+      compared++;
+      if (!(laterIndex - dateIndex == DateMoyr(later) - dateMoyr))
+        differences++;
+      if (DateMoyr(later) == dateMoyr)
+        continue;
+      // dates in the wrong order
+      compared++;
+      try {
+        dateIndex - laterIndex;
+        differences++;
+      } catch (PiaException&) { }
+    }
+    for (int j = 0; j < numAges; j++) {
+      const DateIndex atAge = dateIndex + ages[j];
+      compared++;
+      if (!(atAge.toDateMoyr() == dateMoyr + ages[j]) ||
+        atAge.getDay() != kbirth.day())
+        differences++;
+    }
+    const DateMoyr amendDates[] = { PiaParams::amend56, PiaParams::amend61 };
+    for (int j = 0; j < 2; j++) {
+      if (amendDates[j] < dateMoyr)
+        continue;
+      compared++;
+      if (!(DateIndex(amendDates[j]) - dateIndex ==
+        amendDates[j] - dateMoyr))
+        differences++;
+    }
+    compared += 2ul;
+    if (!(PiaParams::earlyAgeOabCalPL(Sex::MALE, dateIndex) ==
+      earlyAgeOabOld(Sex::MALE, kbirth)))
+      differences++;
+    if (!(PiaParams::earlyAgeOabCalPL(Sex::FEMALE, dateIndex) ==
+      earlyAgeOabOld(Sex::FEMALE, kbirth)))
+      differences++;
+    const int eligYear =
+      static_cast<int>((dateMoyr + PiaParams::age62).getYear());
+    const DateMoyr fullRetDate = dateMoyr + PiaParams::age65;
+    const DateMoyr fullInsDate = dateMoyr + PiaParams::age62;
+    for (int j = 0; j < numEntAges; j++) {
+      const DateMoyr entDate = dateMoyr + entAges[j];
+      const DateMoyr benefitDates[] =
+        { entDate, entDate + Age(1, 0) };
+      for (int k = 0; k < 2; k++) {
+        compared++;
+        if (PiaParams::monthsDriCal(fullRetDate, eligYear, dateIndex,
+          entDate, benefitDates[k], fullInsDate) !=
+          monthsDriOld(fullRetDate, eligYear, kbirth, entDate,
+          benefitDates[k], fullInsDate))
+          differences++;
+      }
+    }
+  }
+  writeResult(out, "date indexes", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks calculations in incremental mode against full
+/// calculations, after changes to the earnings.</summary>
+///
+/// <remarks>For up to <see cref="MAX_INCREMENTAL_CASES"/> cases with
+/// earnings by year, the earnings entered for each year in turn (see
+/// <see cref="EarnProject::earnpebs"/>) are halved and then doubled. Each
+/// change is calculated with the methods kept from the calculation before
+/// it (see <see cref="PiaCal::setIncremental"/>), and
+/// the pia, mfb, benefits, and highest pia method are compared with those
+/// of a full calculation of the same data. Halving the earnings of a year
+/// that is not among the highest keeps the ordering of the earnings, so
+/// both ways of reusing it are checked. A change that can be calculated
+/// in full but not incrementally is counted as a difference.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkIncremental(
+const BenchPopulation& population, std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  unsigned cases = 0u;
+  for (unsigned i = 0; i < population.getRecordCount() &&
+    cases < MAX_INCREMENTAL_CASES; i++) {
+    if (!readCheckCase(population, i) || !workerData.getIndearn() ||
+      workerData.getJoasdi() == WorkerDataGeneral::PEBS_CALC)
+      continue;
+    // methods are not kept in an arena
+    PiaCalAny& piaCal = calcSet->piaCal;
+    piaCal.setArena(0);
+    piaCal.setIncremental(true);
+    Amounts amounts;
+    if (calculateAmounts(piaCal, amounts, false)) {
+      cases++;
+      for (int year = earnProject.getFirstYear();
+        year <= earnProject.getLastYear(); year++) {
+        const double earnings = earnProject.earnpebs[year];
+        if (earnings <= 0.0)
+          continue;
+        for (int change = 0; change < 2; change++) {
+          earnProject.earnpebs[year] =
+            (change == 0) ? 0.5 * earnings : 2.0 * earnings;
+          Amounts incremental;
+          const bool calculated = calculateAmounts(piaCal, incremental,
+            false);
+          // calculate in full, then again to keep the methods for the next
+          // change
+          piaCal.setIncremental(false);
+          Amounts full;
+          const bool fullCalculated = calculateAmounts(piaCal, full, false);
+          piaCal.setIncremental(true);
+          calculateAmounts(piaCal, amounts, false);
+          if (!fullCalculated)
+            continue;
+          compared++;
+          if (!calculated || !(incremental == full))
+            differences++;
+        }
+        earnProject.earnpebs[year] = earnings;
+      }
+    }
+    piaCal.setIncremental(false);
+    piaCal.setArena(&calcSet->arena);
+  }
+  writeResult(out, "incremental calculations", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the searches of the old-start conversion tables
+/// against a scan of each table from its first entry.</summary>
+///
+/// <remarks>For every entry of the 1950 and 1958 pib tables and the 1952
+/// and 1954 pia-ame tables, amounts at and around the entry (see
+/// <see cref="pibTableAmounts"/>) are found with the find function of the
+/// table, and compared with the index found by the loop that
+/// <see cref="OldStart"/> used before, which moves up from the first entry
+/// with the same comparison and margin. The 1958 table is searched from
+/// every starting index. The loops for the 1952 and 1954 tables had no
+/// upper bound, so they are stopped at the last entry, as find
+/// is.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkPibTables( std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  vector< double > amounts;
+  pibTableAmounts(amounts, Pib50Pib::getAt, Pib50Pib::LAST_INDEX);
+  for (size_t i = 0; i < amounts.size(); i++) {
+    int index = 0;
+    while (amounts[i] > Pib50Pib::getAt(index) + .005 &&
+      index < Pib50Pib::LAST_INDEX)
+      index++;
+    compared++;
+    if (Pib50Pib::find(amounts[i]) != index)
+      differences++;
+  }
+  pibTableAmounts(amounts, Pib52Ame::getAt, Pib52Ame::LAST_INDEX);
+  for (size_t i = 0; i < amounts.size(); i++) {
+    int index = 0;
+    while (amounts[i] - 0.005 > Pib52Ame::getAt(index) &&
+      index < Pib52Ame::LAST_INDEX)
+      index++;
+    compared++;
+    if (Pib52Ame::find(amounts[i]) != index)
+      differences++;
+  }
+  pibTableAmounts(amounts, Pib54Ame::getAt, Pib54Ame::LAST_INDEX);
+  for (size_t i = 0; i < amounts.size(); i++) {
+    int index = 0;
+    while (amounts[i] - 0.005 > Pib54Ame::getAt(index) &&
+      index < Pib54Ame::LAST_INDEX)
+      index++;
+    compared++;
+    if (Pib54Ame::find(amounts[i]) != index)
+      differences++;
+  }
+  pibTableAmounts(amounts, Pib58Pib::getAt, Pib58Pib::LAST_INDEX);
+  for (int first = 0; first <= Pib58Pib::LAST_INDEX; first++) {
+    for (size_t i = 0; i < amounts.size(); i++) {
+      int index = first;
+      while (amounts[i] > Pib58Pib::getAt(index) &&
+        index < Pib58Pib::LAST_INDEX)
+        index++;
+      compared++;
+      if (Pib58Pib::find(amounts[i], first) != index)
+        differences++;
+    }
+  }
+  writeResult(out, "pib table searches", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks that simulated psa annuities do not depend on the
+/// number of threads, and that returns with no standard deviation give the
+/// annuity with every return equal to its mean.</summary>
+///
+/// <remarks>For up to <see cref="MAX_PSA_CASES"/> cases, the account of a
+/// contribution of 2 percent of each year of earnings (see
+/// <see cref="EarnProject::earnpebs"/>), split 40-60 between bonds and
+/// stocks and rebalanced each year, is simulated over
+/// <see cref="PSA_PATHS"/> paths. The annuities of a simulation on
+/// <see cref="PSA_THREADS"/> threads are compared with those on one thread;
+/// then, with no standard deviation, the annuity of every path is compared
+/// with <see cref="PsaSimulation::getMeanReturnAnnuity"/>. The simulations
+/// use no annuity factor files, so a fixed annuity factor is used.
+/// </remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkPsaSimulation(
+const BenchPopulation& population, std::ostream& out )
+{
+  static const double investPerc[Psa::NUM_INVESTMENTS] = { 0.4, 0.6 };
+  static const double annuityFactor = 200.0;
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  LawChangePSAACCT lawChangePSAACCT;
+  lawChangePSAACCT.setInvestMean(Psa::BONDS, 3.0);
+  lawChangePSAACCT.setInvestMean(Psa::STOCKS, 7.0);
+  lawChangePSAACCT.setMngmtFee(Psa::BONDS, 0.003);
+  lawChangePSAACCT.setMngmtFee(Psa::STOCKS, 0.003);
+  lawChangePSAACCT.setAdminFee(Psa::BONDS, 2.0);
+  lawChangePSAACCT.setAdminFee(Psa::STOCKS, 2.0);
+  lawChangePSAACCT.setRebalanceAccounts(1);
+  PsaSimulation simulation(lawChangePSAACCT);
+  simulation.setPaths(PSA_PATHS);
+  vector< double > contribs;
+  vector< double > shares;
+  vector< double > annuities;
+  unsigned cases = 0u;
+  for (unsigned i = 0; i < population.getRecordCount() &&
+    cases < MAX_PSA_CASES; i++) {
+    if (!readCheckCase(population, i) || !workerData.getIndearn())
+      continue;
+    cases++;
+    const int firstYear = earnProject.getFirstYear();
+    const int years = earnProject.getLastYear() - firstYear + 1;
+    contribs.assign(Psa::NUM_INVESTMENTS * years, 0.0);
+    shares.assign(Psa::NUM_INVESTMENTS * years, 0.0);
+    for (int year = 0; year < years; year++) {
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+        contribs[type * years + year] = 0.02 * investPerc[type] *
+          earnProject.earnpebs[firstYear + year];
+        shares[type * years + year] = investPerc[type];
+      }
+    }
+    lawChangePSAACCT.setInvestStdDev(Psa::BONDS, 6.0);
+    lawChangePSAACCT.setInvestStdDev(Psa::STOCKS, 17.0);
+    simulation.setThreadCount(1u);
+    simulation.simulate(firstYear, contribs, shares, annuityFactor, i);
+    annuities = simulation.getAnnuities();
+    simulation.setThreadCount(PSA_THREADS);
+    simulation.simulate(firstYear, contribs, shares, annuityFactor, i);
+    for (size_t path = 0; path < annuities.size(); path++) {
+      compared++;
+      if (simulation.getAnnuities()[path] != annuities[path])
+        differences++;
+    }
+    lawChangePSAACCT.setInvestStdDev(Psa::BONDS, 0.0);
+    lawChangePSAACCT.setInvestStdDev(Psa::STOCKS, 0.0);
+    simulation.simulate(firstYear, contribs, shares, annuityFactor, i);
+    for (size_t path = 0; path < simulation.getAnnuities().size();
+      path++) {
+      compared++;
+      if (simulation.getAnnuities()[path] !=
+        simulation.getMeanReturnAnnuity())
+        differences++;
+    }
+  }
+  writeResult(out, "psa simulation paths", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the quarters of coverage counted by
+/// <see cref="QcBitset"/>, and the insured status found with them, against
+/// those summed year by year with <see cref="QcArray"/>.</summary>
+///
+/// <remarks>Each of the first <see cref="MAX_QC_CASES"/> cases that can be
+/// calculated is checked, after the calculation, as follows.
+///
+/// The quarters of coverage of the worker's <see cref="QcBitset"/> are
+/// compared with those of its <see cref="QcArray"/> for every period of
+/// years and of quarters starting in each year or quarter and lasting one
+/// of several lengths, up to all of the years, and for a period ending
+/// just before it starts.
+///
+/// For every quarter, the totals of <see cref="PiaData::qcTotalCal"/> and
+/// <see cref="PiaCal::qcCurrentCal"/> and the result of
+/// <see cref="PiaCal::deemedInsCal"/> are compared with those summed with
+/// the <see cref="QcArray"/>. For a disability case, the quarters of
+/// coverage and the quarters required in the period finally used by
+/// <see cref="PiaCal::disInsCal"/> are compared with those of the same
+/// search through the periods with <see cref="PiaData::qcDisCal"/> summed
+/// with the <see cref="QcArray"/>. The date from
+/// <see cref="PiaCal::fullInsDateCal"/> is compared with that of the same
+/// search with the totals summed with the <see cref="QcArray"/>.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkQcBitset( const BenchPopulation& population,
+std::ostream& out )
+{
+  static const int lengths[] =
+    { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 13, 19, 20, 39, 40, 79, 80, 159, 160 };
+  static const int numLengths = sizeof(lengths) / sizeof(lengths[0]);
+  const int lastYear = WorkerData::getMaxyear();
+  const unsigned lastQuarter = 4u * (lastYear - YEAR37) + 3u;
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  unsigned cases = 0u;
+  Amounts amounts;
+  for (unsigned i = 0; i < population.getRecordCount() &&
+    cases < MAX_QC_CASES; i++) {
+    if (!readCheckCase(population, i) ||
+      !calculateAmounts(calcSet->piaCal, amounts, false))
+      continue;
+    cases++;
+    const QcArray& qcov = piaData.qcov;
+    const QcBitset& qcovBits = piaData.qcovBits;
+    // periods of years, with a starting value that varies with the length
+    for (int year = YEAR37; year <= lastYear; year++) {
+      for (int j = 0; j < numLengths; j++) {
+        const int year2 = min(year + lengths[j], lastYear);
+        compared++;
+        if (qcovBits.accumulate(year, year2, static_cast<unsigned>(j)) !=
+          qcov.accumulate(year, year2, static_cast<unsigned>(j)))
+          differences++;
+      }
+      if (year < lastYear) {
+        compared++;
+        if (qcovBits.accumulate(year + 1, year, 1u) !=
+          qcov.accumulate(year + 1, year, 1u))
+          differences++;
+      }
+    }
+    // periods of quarters
+    for (unsigned quarter = 0u; quarter <= lastQuarter; quarter++) {
+      const QtrYear qtrYear1(quarter % 4u, YEAR37 + quarter / 4u);
+      for (int j = 0; j < numLengths; j++) {
+        const unsigned quarter2 = quarter +
+          min(static_cast<unsigned>(lengths[j]), lastQuarter - quarter);
+        const QtrYear qtrYear2(quarter2 % 4u, YEAR37 + quarter2 / 4u);
+        compared++;
+        if (qcovBits.accumulate(qtrYear1, qtrYear2,
+          static_cast<unsigned>(j)) !=
+          qcov.accumulate(qtrYear1, qtrYear2, static_cast<unsigned>(j)))
+          differences++;
+      }
+      if (quarter < lastQuarter) {
+        const QtrYear qtrYear2((quarter + 1u) % 4u,
+          YEAR37 + (quarter + 1u) / 4u);
+        compared++;
+        if (qcovBits.accumulate(qtrYear2, qtrYear1, 1u) !=
+          qcov.accumulate(qtrYear2, qtrYear1, 1u))
+          differences++;
+      }
+    }
+    // insured status for each quarter
+    for (unsigned quarter = 0u; quarter <= lastQuarter; quarter++) {
+      const QtrYear qtrYear(quarter % 4u, YEAR37 + quarter / 4u);
+      const unsigned startQuarter = quarter - min(quarter, 12u);
+      const QtrYear startQtrYear(startQuarter % 4u,
+        YEAR37 + startQuarter / 4u);
+      compared += 2ul;
+      if (PiaCal::qcCurrentCal(piaData, qtrYear) != static_cast<int>(
+        qcov.accumulate(startQtrYear, qtrYear, 0u)))
+        differences++;
+      const bool deemed = PiaCal::deemedInsCal(piaData, qtrYear);
+      if (deemed != (piaData.getDeemedQcReq() >= 0 &&
+        static_cast<int>(qcov.accumulate(PiaParams::qtr184, qtrYear, 0u)) >=
+        piaData.getDeemedQcReq()))
+        differences++;
+      if (qtrYear < QtrYear(0, 1951))
+        continue;
+      piaData.qcTotalCal(workerData, qtrYear);
+      compared++;
+      if (piaData.getQcTotal() != qcTotalOld(workerData, piaData, qtrYear))
+        differences++;
+    }
+    const PiaCalAny& piaCal = calcSet->piaCal;
+    const DateMoyr& entDate = workerData.getEntDate();
+    if (workerData.getJoasdi() == WorkerData::DISABILITY &&
+      !workerData.isdead(entDate)) {
+      piaData.qcTotalCal(workerData, QtrYear(entDate));
+      if (piaData.getQcTotal() > 0) {
+        try {
+          const int qcTotalDis = disInsOld(workerData, piaData, entDate);
+          const int qcDisReq = piaData.getQcDisReq();
+          PiaCal::disInsCal(workerData, piaData, entDate, 1);
+          compared++;
+          if (piaData.getQcTotalDis() != qcTotalDis ||
+            piaData.getQcDisReq() != qcDisReq)
+            differences++;
+        } catch (PiaException&) {
+          compared++;
+          differences++;
+        }
+      }
+    }
+    const DateMoyr fullInsDate = piaCal.fullInsDateCal();
+    compared++;
+    if (fullInsDate != fullInsDateOld(workerData, piaData,
+      piaCal.getIoasdi()))
+      differences++;
+  }
+  writeResult(out, "quarters of coverage", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the benefits of each type of law change calculated
+/// from the earnings projected under present law against a full
+/// calculation.</summary>
+///
+/// <remarks>For each type of law change, a scenario with only that change
+/// is read (see <see cref="LawChangeScenario"/>), starting in the base
+/// year. Up to <see cref="MAX_SCENARIO_CASES"/> cases that are not
+/// Statement cases are calculated under present law and then under the
+/// scenario with the earnings already projected, as in
+/// <see cref="ScenarioCalculator"/>; the amounts are compared with those of
+/// the case read again and calculated in full under the scenario. A
+/// scenario that cannot be read is also counted as a difference.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkScenarios(
+const BenchPopulation& population, std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  for (int type = 0; type < LawChange::MAXLCH; type++) {
+    boost::scoped_ptr< LawChangeScenario > scenario;
+    try {
+      istringstream in(lawChangeText(type, baseYear));
+      scenario.reset(new LawChangeScenario("check", in, baseYear));
+    } catch (PiaException&) {
+      compared++;
+      differences++;
+      continue;
+    }
+    CalcSetMap scenarioCalcSets;
+    unsigned cases = 0u;
+    for (unsigned i = 0; i < population.getRecordCount() &&
+      cases < MAX_SCENARIO_CASES; i++) {
+      Amounts presentLaw;
+      if (!readCheckCase(population, i) ||
+        workerData.getJoasdi() == WorkerDataGeneral::PEBS_CALC ||
+        !calculateAmounts(calcSet->piaCal, presentLaw, false))
+        continue;
+      cases++;
+      CalcSet *set = findCalcSet(scenarioCalcSets,
+        scenario->getPiaParamsCache(), scenario->getLawChange());
+      Amounts projected;
+      const bool calculated =
+        calculateAmounts(set->piaCal, projected, true);
+      if (!readCheckCase(population, i))
+        continue;
+      set = findCalcSet(scenarioCalcSets, scenario->getPiaParamsCache(),
+        scenario->getLawChange());
+      Amounts full;
+      if (!calculateAmounts(set->piaCal, full, false))
+        continue;
+      compared++;
+      if (!calculated || !(projected == full))
+        differences++;
+    }
+    deleteCalcSets(scenarioCalcSets);
+  }
+  writeResult(out, "law-change scenarios", compared, differences);
+  return(differences);
+}
+
+/// <summary>Checks the payroll taxes calculated in one pass, and in
+/// batches, against the taxes of each trust fund calculated in turn.
+/// </summary>
+///
+/// <remarks>The taxes of each case calculated by
+/// <see cref="BatchCalculator::calculateBenefits"/> (see
+/// <see cref="TaxData::taxCal(const TaxRates&, const DoubleAnnual&,
+/// const DoubleAnnual&, const BitAnnual&)"/>) are compared with those of
+/// <see cref="TaxRates::taxCalAllYears"/> for the OASI, DI, and HI trust
+/// funds, followed by <see cref="TaxData::oasdhiTaxCal"/> and
+/// <see cref="TaxData::totalTaxCal"/>. The same earnings are then added to
+/// a <see cref="TaxBatch"/> of <see cref="TAX_BATCH_SIZE"/> workers, and
+/// the taxes of each worker in the batch are compared the same way. Every
+/// tax of every year, and every total, must be identical.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkTaxBatch( const BenchPopulation& population,
+std::ostream& out )
+{
+  unsigned long compared = 0ul;
+  unsigned long batchCompared = 0ul;
+  unsigned long differences = 0ul;
+  unsigned long batchDifferences = 0ul;
+  const int maxyear = WorkerData::getMaxyear();
+  TaxBatch batch(maxyear, TAX_BATCH_SIZE);
+  batch.clear(taxRates);
+  TaxData fromBatch(maxyear);
+  // taxes of each case by trust fund in turn, and those of the workers in
+  // the batch
+  vector< double > expected;
+  vector< double > batchExpected;
+  vector< double > amounts;
+  for (unsigned i = 0; i <= population.getRecordCount(); i++) {
+    if (i == population.getRecordCount() ||
+      batch.getWorkerCount() == batch.getCapacity()) {
+      if (batch.getWorkerCount() > 0u) {
+        batch.calculate();
+        const size_t size = batchExpected.size() / batch.getWorkerCount();
+        for (unsigned worker = 0; worker < batch.getWorkerCount(); worker++) {
+          fromBatch.taxCal(batch, worker);
+          amounts.clear();
+          appendTaxes(amounts, fromBatch);
+          batchCompared++;
+          if (amounts.size() != size || !equal(amounts.begin(),
+            amounts.end(), batchExpected.begin() + worker * size))
+            batchDifferences++;
+        }
+        batch.clear(taxRates);
+        batchExpected.clear();
+      }
+      if (i == population.getRecordCount())
+        break;
+    }
+    if (!readCheckCase(population, i))
+      continue;
+    try {
+      calculateBenefits(calcSet->piaCal, false);
+    } catch (PiaException&) {
+      continue;
+    }
+    TaxData reference(maxyear);
+    const BitAnnual& taxType = workerData.getTaxTypeArray();
+    taxRates.taxCalAllYears(piaData.earnOasdiLimited, taxType,
+      reference.taxesOasi, TaxRates::OASITF);
+    taxRates.taxCalAllYears(piaData.earnOasdiLimited, taxType,
+      reference.taxesDi, TaxRates::DITF);
+    taxRates.taxCalAllYears(piaData.earnHiLimited, taxType,
+      reference.taxesHi, TaxRates::HITF);
+    reference.oasdhiTaxCal();
+    reference.totalTaxCal();
+    expected.clear();
+    appendTaxes(expected, reference);
+    amounts.clear();
+    appendTaxes(amounts, taxes);
+    compared++;
+    if (amounts != expected)
+      differences++;
+    batch.add(piaData.earnOasdiLimited, piaData.earnHiLimited, taxType);
+    batchExpected.insert(batchExpected.end(), expected.begin(),
+      expected.end());
+  }
+  writeResult(out, "one-pass taxes", compared, differences);
+  writeResult(out, "batch taxes", batchCompared, batchDifferences);
+  return(differences + batchDifferences);
+}
+
+/// <summary>Checks the wage-indexed pias calculated from earnings indexed
+/// in a batch against those of each worker indexed in turn.</summary>
+///
+/// <remarks>Each case is made into <see cref="COHORT_SIZE"/> workers, as in
+/// <see cref="checkCohortBatch"/>. The earnings of each worker who is fully
+/// insured with a wage-indexed pia are added to a
+/// <see cref="WageIndBatch"/> with the average wages of the parameters
+/// (see <see cref="WageInd::addToBatch"/>), and to a second batch whose
+/// average wages before the indexing year are a percent higher. After the
+/// batches are indexed, the worker is calculated again, and the AIME and
+/// the pias at eligibility and at the benefit date from
+/// <see cref="WageInd::calculate(const WageIndBatch&amp;, unsigned)"/> are
+/// compared with those of the usual calculation for each batch; the second
+/// batch must not be used.</remarks>
+///
+/// <returns>The number of differences found.</returns>
+///
+/// <param name="population">Cases to check.</param>
+/// <param name="out">Stream to write the result to.</param>
+unsigned long BenchCheck::checkWageIndBatch(
+const BenchPopulation& population, std::ostream& out )
+{
+  static const double factors[COHORT_SIZE] =
+    { 0.1, 0.25, 0.5, 0.75, 1.0, 1.5, 2.0, 4.0 };
+  const int lastYear = WorkerData::getMaxyear();
+  unsigned long compared = 0ul;
+  unsigned long differences = 0ul;
+  WageIndBatch batch(YEAR37, lastYear, COHORT_SIZE);
+  WageIndBatch otherBatch(YEAR37, lastYear, COHORT_SIZE);
+  vector< double > earnings;
+  // AIME and pias of each worker (empty if not added to the batches)
+  vector< vector< double > > expected(COHORT_SIZE);
+  unsigned workers[COHORT_SIZE];
+  vector< double > pias;
+  for (unsigned i = 0; i < population.getRecordCount(); i++) {
+    if (!readCheckCase(population, i) ||
+      workerData.getJoasdi() == WorkerDataGeneral::PEBS_CALC)
+      continue;
+    PiaCalAny& piaCal = calcSet->piaCal;
+    const int firstYear = earnProject.getFirstYear();
+    earnings.clear();
+    for (int year = firstYear; year <= earnProject.getLastYear(); year++) {
+      earnings.push_back(earnProject.earnpebs[year]);
+    }
+    bool cleared = false;
+    for (unsigned j = 0; j < COHORT_SIZE; j++) {
+      expected[j].clear();
+      for (int year = firstYear; year <= earnProject.getLastYear(); year++) {
+        earnProject.earnpebs[year] = factors[j] * earnings[year - firstYear];
+      }
+      try {
+        calculateBenefits(piaCal, false);
+      } catch (PiaException&) {
+        continue;
+      }
+      if (!piaData.finsCode.isFullyInsured() || piaCal.wageInd == 0 ||
+        !WageInd::isApplicable(workerData, piaData))
+        continue;
+      const int baseYear = piaData.getEligYear() - 2;
+      if (!cleared) {
+        const AverageWage& avgWage = piaCal.piaParams.getFqIndex();
+        DoubleAnnual otherAvgWage(avgWage.getBaseYear(),
+          avgWage.getLastYear());
+        for (int year = avgWage.getBaseYear(); year <= avgWage.getLastYear();
+          year++) {
+          otherAvgWage[year] =
+            (year < baseYear) ? 1.01 * avgWage[year] : avgWage[year];
+        }
+        batch.clear(baseYear, avgWage);
+        otherBatch.clear(baseYear, otherAvgWage);
+        cleared = true;
+      }
+      else if (baseYear != batch.getBaseYear())
+        continue;
+      workers[j] = piaCal.wageInd->addToBatch(batch);
+      piaCal.wageInd->addToBatch(otherBatch);
+      expected[j].push_back(piaCal.wageInd->getAme());
+      expected[j].push_back(
+        piaCal.wageInd->piaElig[piaData.getEligYear() - 1]);
+      expected[j].push_back(piaCal.wageInd->piaEnt.get());
+    }
+    if (cleared) {
+      batch.index();
+      otherBatch.index();
+    }
+    for (unsigned j = 0; j < COHORT_SIZE; j++) {
+      if (expected[j].empty())
+        continue;
+      for (int year = firstYear; year <= earnProject.getLastYear(); year++) {
+        earnProject.earnpebs[year] = factors[j] * earnings[year - firstYear];
+      }
+      calculateBenefits(piaCal, false);
+      for (int pass = 0; pass < 2; pass++) {
+        compared++;
+        try {
+          piaCal.wageInd->calculate((pass == 0) ? batch : otherBatch,
+            workers[j]);
+        } catch (PiaException&) {
+          differences++;
+          continue;
+        }
+        pias.clear();
+        pias.push_back(piaCal.wageInd->getAme());
+        pias.push_back(piaCal.wageInd->piaElig[piaData.getEligYear() - 1]);
+        pias.push_back(piaCal.wageInd->piaEnt.get());
+        if (pias != expected[j])
+          differences++;
+      }
+    }
+    for (int year = firstYear; year <= earnProject.getLastYear(); year++) {
+      earnProject.earnpebs[year] = earnings[year - firstYear];
+    }
+  }
+  writeResult(out, "wage-indexed batch pias", compared, differences);
+  return(differences);
+}
+
+/// <summary>Appends the taxes of each trust fund in each year, and their
+/// totals, to a list of amounts.</summary>
+///
+/// <param name="amounts">List to append to.</param>
+/// <param name="taxData">Taxes to append.</param>
+void BenchCheck::appendTaxes( std::vector< double >& amounts,
+const TaxData& taxData )
+{
+  const DoubleAnnual *const funds[TaxRates::NUMTRUSTFUNDTYPES] = {
+    &taxData.taxesOasi, &taxData.taxesDi, &taxData.taxesOasdi,
+    &taxData.taxesHi, &taxData.taxesOasdhi
+  };
+  for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++) {
+    const DoubleAnnual& fundTaxes = *funds[fund];
+    for (int yr = YEAR37; yr <= fundTaxes.getLastYear(); yr++) {
+      amounts.push_back(fundTaxes[yr]);
+    }
+    const TaxRates::trustfundType trustfund =
+      static_cast<TaxRates::trustfundType>(fund);
+    amounts.push_back(taxData.getTaxesTotal(trustfund, TaxData::YEARS1937_50));
+    amounts.push_back(
+      taxData.getTaxesTotal(trustfund, TaxData::YEARS1937PLUS));
+  }
+}
+
+/// <summary>Calculates the benefits of the case that has been read.
+/// </summary>
+///
+/// <returns>True if the case was calculated, false if it is in error.
+/// </returns>
+///
+/// <param name="piaCal">Pia calculation functions.</param>
+/// <param name="amounts">The amounts calculated (output).</param>
+/// <param name="projected">True to use the earnings already projected by
+/// another set of calculation objects (see
+/// <see cref="BatchCalculator::calculateBenefits"/>).</param>
+bool BenchCheck::calculateAmounts( PiaCalAny& piaCal, Amounts& amounts,
+bool projected )
+{
+  try {
+    calculateBenefits(piaCal, projected);
+  } catch (PiaException&) {
+    return(false);
+  }
+  amounts.pia = piaData.highPia.get();
+  amounts.mfb = piaData.highMfb.get();
+  amounts.benefit = piaData.roundedBenefit.get();
+  amounts.family = 0.0;
+  for (size_t i = 0; i < secondaryArray.secondary.size(); i++) {
+    amounts.family += secondaryArray.secondary[i]->getRoundedBenefit();
+  }
+  amounts.method = piaData.getIappn();
+  return(true);
+}
+
+/// <summary>Lists the amounts to find in one of the pib-pia conversion
+/// tables.</summary>
+///
+/// <remarks>The amounts are each entry of the table, the entry plus and
+/// minus a tenth of a cent, half a cent, and a cent, and amounts a dollar
+/// below the first entry and above the last.</remarks>
+///
+/// <param name="amounts">The amounts to find (output).</param>
+/// <param name="getAt">Function returning an entry of the table.</param>
+/// <param name="lastIndex">Index of the last entry of the table.</param>
+void BenchCheck::pibTableAmounts( std::vector< double >& amounts,
+double (*getAt)( int ), int lastIndex )
+{
+  static const double offsets[] =
+    { -0.01, -0.005, -0.001, 0.0, 0.001, 0.005, 0.01 };
+  amounts.clear();
+  amounts.push_back(getAt(0) - 1.0);
+  for (int index = 0; index <= lastIndex; index++) {
+    for (size_t i = 0; i < sizeof(offsets) / sizeof(offsets[0]); i++) {
+      amounts.push_back(getAt(index) + offsets[i]);
+    }
+  }
+  amounts.push_back(getAt(lastIndex) + 1.0);
+}
+
+/// <summary>Reads one case and finds the calculation objects for its
+/// assumptions.</summary>
+///
+/// <returns>True if the case was read, false if it is in error.</returns>
+///
+/// <param name="population">Cases to read from.</param>
+/// <param name="index">Number of the case (starting at 0).</param>
+bool BenchCheck::readCheckCase( const BenchPopulation& population,
+unsigned index )
+{
+  deleteContents();
+  try {
+    readCase(population, index);
+    setAssumptions();
+    calcSet = findCalcSet(calcSets, piaParamsCache, lawChange);
+  } catch (PiaException&) {
+    return(false);
+  }
+  return(true);
+}
+
+/// <summary>Writes the result of one check.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+/// <param name="name">Name of the check.</param>
+/// <param name="compared">Number of cases or values compared.</param>
+/// <param name="differences">Number that differ.</param>
+void BenchCheck::writeResult( std::ostream& out, const char *name,
+unsigned long compared, unsigned long differences )
+{
+  out << "check " << name << ": " << compared << " compared, "
+    << differences << ((differences == 1ul) ? " difference" : " differences")
+    << endl;
+}
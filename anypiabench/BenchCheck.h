@@ -0,0 +1,122 @@
+// Declarations for the <see cref="BenchCheck"/> class to check that the
+// faster calculations give the same results as the ones they replace.
+
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+#include "BatchCalculator.h"
+class BenchPopulation;
+
+/// <summary>Checks, on a synthetic population, that calculations done a
+/// faster way give the same results as the calculations they replace.
+/// </summary>
+///
+/// <remarks>Each check calculates cases of the population both ways and
+/// writes one line with the number of cases or values compared and the
+/// number that differ. A case that cannot be calculated the usual way is
+/// skipped; a case that can be calculated the usual way but not the faster
+/// way is counted as a difference.
+///
+/// The cases are read and calculated with the same objects as in
+/// <see cref="BatchCalculator"/>, on one thread.</remarks>
+///
+/// <seealso cref="BenchPopulation"/>
+class BenchCheck : public BatchCalculator
+{
+public:
+  /// <summary>Maximum number of old-age cases swept by
+  /// <see cref="checkClaimAgeSweep"/>, each of which is compared with a
+  /// full calculation for each of 97 months.</summary>
+  static const unsigned MAX_SWEEP_CASES = 100u;
+  /// <summary>Maximum number of cases checked by
+  /// <see cref="checkIncremental"/>, each of which is calculated again for
+  /// two changes to each year of earnings.</summary>
+  static const unsigned MAX_INCREMENTAL_CASES = 100u;
+  /// <summary>Number of workers in each batch of
+  /// <see cref="checkTaxBatch"/>.</summary>
+  static const unsigned TAX_BATCH_SIZE = 64u;
+  /// <summary>Number of workers in each cohort of
+  /// <see cref="checkCohortBatch"/>.</summary>
+  static const unsigned COHORT_SIZE = 8u;
+  /// <summary>Maximum number of cases checked by
+  /// <see cref="checkScenarios"/> for each type of law change.</summary>
+  static const unsigned MAX_SCENARIO_CASES = 100u;
+  /// <summary>Maximum number of cases whose psa accounts are simulated by
+  /// <see cref="checkPsaSimulation"/>.</summary>
+  static const unsigned MAX_PSA_CASES = 10u;
+  /// <summary>Number of paths of each simulation of
+  /// <see cref="checkPsaSimulation"/>.</summary>
+  static const unsigned PSA_PATHS = 1000u;
+  /// <summary>Number of threads of the threaded simulations of
+  /// <see cref="checkPsaSimulation"/>.</summary>
+  static const unsigned PSA_THREADS = 4u;
+  /// <summary>Maximum number of cases checked by
+  /// <see cref="checkQcBitset"/>.</summary>
+  static const unsigned MAX_QC_CASES = 100u;
+private:
+  /// <summary>Amounts compared between two calculations.</summary>
+  struct Amounts
+  {
+    /// <summary>Worker's pia.</summary>
+    double pia;
+    /// <summary>Worker's mfb.</summary>
+    double mfb;
+    /// <summary>Worker's benefit.</summary>
+    double benefit;
+    /// <summary>Total benefits of the family members.</summary>
+    double family;
+    /// <summary>Highest pia method.</summary>
+    int method;
+    Amounts() : pia(0.0), mfb(0.0), benefit(0.0), family(0.0), method(0) { }
+    /// <summary>Compares the amounts with those of another calculation.
+    /// </summary>
+    ///
+    /// <returns>True if all of the amounts are the same.</returns>
+    ///
+    /// <param name="amounts">The amounts to compare to.</param>
+    bool operator==( const Amounts& amounts ) const
+    { return(pia == amounts.pia && mfb == amounts.mfb &&
+      benefit == amounts.benefit && family == amounts.family &&
+      method == amounts.method); }
+  };
+  /// <summary>First year of projections.</summary>
+  const int baseYear;
+public:
+  BenchCheck( PiaParamsCache& newPiaParamsCache, int baseYear );
+  ~BenchCheck();
+  unsigned long checkAll( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkArenaReuse( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkClaimAgeSweep( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkCohortBatch( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkDateIndex( std::ostream& out );
+  unsigned long checkIncremental( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkPibTables( std::ostream& out );
+  unsigned long checkPsaSimulation( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkQcBitset( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkScenarios( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkTaxBatch( const BenchPopulation& population,
+    std::ostream& out );
+  unsigned long checkWageIndBatch( const BenchPopulation& population,
+    std::ostream& out );
+private:
+  static void appendTaxes( std::vector< double >& amounts,
+    const TaxData& taxData );
+  bool calculateAmounts( PiaCalAny& piaCal, Amounts& amounts,
+    bool projected );
+  static void pibTableAmounts( std::vector< double >& amounts,
+    double (*getAt)( int ), int lastIndex );
+  bool readCheckCase( const BenchPopulation& population, unsigned index );
+  static void writeResult( std::ostream& out, const char *name,
+    unsigned long compared, unsigned long differences );
+  BenchCheck( const BenchCheck& );
+  BenchCheck& operator=( const BenchCheck& );
+};
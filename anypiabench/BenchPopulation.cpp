@@ -0,0 +1,362 @@
+// Functions for the <see cref="BenchPopulation"/> class to generate a
+// reproducible synthetic population of benefit cases.
+
+#include <cmath>
+#include <cstdio>
+#include <sstream>
+#include <algorithm>
+#include "boost/random/uniform_int_distribution.hpp"
+#include "BenchPopulation.h"
+#include "piaread.h"
+#include "piawriteAny.h"
+#include "avgwg.h"
+#include "oactcnst.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Names of the types of case.</summary>
+const char *caseNames[BenchPopulation::NUM_CASE_TYPES] = {
+  "oldAge", "disability", "survivor"
+};
+
+/// <summary>Career-average earnings, as a ratio to the average wage, of
+/// each level of scaled earnings.</summary>
+const double careerLevel[ScaledEarnFactors::SCALEHIGH + 1] = {
+  0.25, 0.40, 1.00, 1.60
+};
+
+/// <summary>Returns the number of a month, counting from January of year
+/// 0.</summary>
+///
+/// <returns>The number of a month.</returns>
+///
+/// <param name="year">Year.</param>
+/// <param name="month">Month of year (1-12).</param>
+int monthNumber( int year, int month )
+{
+  return(year * 12 + month - 1);
+}
+
+/// <summary>Returns the month and year of a month number.</summary>
+///
+/// <returns>The month and year of a month number.</returns>
+///
+/// <param name="number">Number of month, counting from January of year 0.
+/// </param>
+DateMoyr toDateMoyr( int number )
+{
+  return(DateMoyr(static_cast<unsigned>(number % 12 + 1),
+    static_cast<unsigned>(number / 12)));
+}
+
+}  // namespace
+
+/// <summary>Initializes the generator.</summary>
+///
+/// <remarks>Call <see cref="BatchCalculator::setStatics"/> and set the
+/// first year of projections in <see cref="UserAssumptions"/> before
+/// creating an instance.</remarks>
+///
+/// <param name="newFactors">Scaled earnings factors.</param>
+/// <param name="newAverageWage">Average wage series, through at least the
+/// year before the base year.</param>
+/// <param name="newBaseYear">First year of projections.</param>
+/// <param name="seed">Seed for the random number generator.</param>
+BenchPopulation::BenchPopulation( const ScaledEarnFactors& newFactors,
+const AverageWage& newAverageWage, int newBaseYear, unsigned seed ) :
+cases(), factors(newFactors), averageWage(newAverageWage),
+baseYear(newBaseYear), generator(seed), workerData(), widowDataArray(),
+widowArray(), secondaryArray(),
+userAssumptions(WorkerData::getMaxyear()), earnProject(YEAR2090), pebs()
+{
+  fill(caseCount, caseCount + NUM_CASE_TYPES, 0u);
+  fill(scaleCount, scaleCount + ScaledEarnFactors::SCALEHIGH + 1, 0u);
+  userAssumptions.setIaltbi(AssumptionType::FLAT);
+  userAssumptions.setIaltaw(AssumptionType::FLAT);
+  userAssumptions.setIbasch(1);
+}
+
+/// <summary>Destructor.</summary>
+BenchPopulation::~BenchPopulation()
+{ }
+
+/// <summary>Generates cases and adds them to the population.</summary>
+///
+/// <remarks>About 60 percent of the cases are old-age cases, and 20
+/// percent each are disability and survivor cases. The four levels of
+/// earnings and the two sexes are equally likely.</remarks>
+///
+/// <param name="count">Number of cases to add.</param>
+void BenchPopulation::generate( unsigned count )
+{
+  cases.reserve(cases.size() + count);
+  PiaWriteAny piaWrite(workerData, widowDataArray, widowArray,
+    userAssumptions, secondaryArray, earnProject, pebs);
+  for (unsigned i = 0; i < count; i++) {
+    deleteContents();
+    const int draw = uniform(0, 9);
+    const case_type caseType =
+      (draw < 6) ? OLD_AGE : (draw < 8) ? DISABILITY : SURVIVOR;
+    const ScaledEarnFactors::scaleType scaleType =
+      static_cast<ScaledEarnFactors::scaleType>(
+      uniform(ScaledEarnFactors::SCALEVERYLOW, ScaledEarnFactors::SCALEHIGH));
+    char ssn[10];
+    sprintf(ssn, "%09u", 100000000u + static_cast<unsigned>(cases.size()));
+    workerData.ssn.setSsnFull(ssn);
+    workerData.setSex(static_cast<Sex::sex_type>(uniform(Sex::MALE,
+      Sex::FEMALE)));
+    const int birthMonth = uniform(1, 12);
+    // born after the 1st, so age 62 is first attained throughout the
+    // month after the month of birth
+    const int birthDay = uniform(2, 28);
+    int birthYear;
+    switch (caseType) {
+    case OLD_AGE:
+      birthYear = uniform(baseYear - 85, baseYear - 55);
+      break;
+    case DISABILITY:
+      birthYear = uniform(baseYear - 62, baseYear - 28);
+      break;
+    default:
+      birthYear = uniform(baseYear - 95, baseYear - 36);
+      break;
+    }
+    workerData.setBirthDate(boost::gregorian::date(
+      static_cast<unsigned short>(birthYear),
+      static_cast<unsigned short>(birthMonth),
+      static_cast<unsigned short>(birthDay)));
+    workerData.setIndearn(true);
+    workerData.setIbegin(max(YEAR51, birthYear + factors.getFirstAge() +
+      uniform(0, 4)));
+    switch (caseType) {
+    case OLD_AGE:
+      setOldAge(birthYear, birthMonth);
+      break;
+    case DISABILITY:
+      setDisability(birthYear);
+      break;
+    default:
+      setSurvivor(birthYear, birthMonth, birthDay);
+      break;
+    }
+    setEarnings(birthYear, scaleType);
+    ostringstream out;
+    out.setf(ios::fixed, ios::floatfield);
+    piaWrite.write(out);
+    cases.push_back(out.str());
+    caseCount[caseType]++;
+    scaleCount[scaleType]++;
+  }
+}
+
+/// <summary>Reads one case.</summary>
+///
+/// <returns>The value returned by <see cref="PiaRead::read(const char*,
+/// const char*)"/>.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// number is out of range.</exception>
+///
+/// <param name="piaRead">Reader to use.</param>
+/// <param name="index">Number of case (starting at 0).</param>
+unsigned int BenchPopulation::read( PiaRead& piaRead, unsigned index ) const
+{
+  if (index >= cases.size())
+    throw PiaException("Case number out of range in BenchPopulation::read");
+  const string& text = cases[index];
+  return(piaRead.read(text.data(), text.data() + text.size()));
+}
+
+/// <summary>Writes all of the cases as a pia file.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+void BenchPopulation::write( std::ostream& out ) const
+{
+  for (vector< string >::const_iterator it = cases.begin();
+    it != cases.end(); ++it) {
+    out << *it;
+  }
+}
+
+/// <summary>Returns the name of a type of case, for reports.</summary>
+///
+/// <returns>The name of a type of case.</returns>
+///
+/// <param name="caseType">Type of case.</param>
+const char *BenchPopulation::getCaseName( case_type caseType )
+{
+  return(caseNames[caseType]);
+}
+
+/// <summary>Sets synthetic scaled earnings factors.</summary>
+///
+/// <remarks>These are not the factors published by the Office of the Chief
+/// Actuary. They follow a smooth career profile that rises to a peak at
+/// about age 50, scaled so that the average factor over the ages covered
+/// is the career level of each type of earner (25, 40, 100, and 160
+/// percent of the average wage). The factors are passed through
+/// <see cref="ScaledEarnFactors::read"/>, so they are stored exactly as
+/// factors read from a file.</remarks>
+///
+/// <param name="scaledEarnFactors">Factors to set.</param>
+void BenchPopulation::setSyntheticFactors(
+ScaledEarnFactors& scaledEarnFactors )
+{
+  const int firstAge = scaledEarnFactors.getFirstAge();
+  const int lastAge = scaledEarnFactors.getLastAge();
+  vector< double > profile;
+  double total = 0.0;
+  for (int age = firstAge; age <= lastAge; age++) {
+    const double x = (age - 50) / 14.0;
+    profile.push_back(0.45 + 0.85 * exp(-x * x));
+    total += profile.back();
+  }
+  const double mean = total / static_cast<double>(profile.size());
+  ostringstream strm;
+  strm.setf(ios::fixed, ios::floatfield);
+  strm.precision(6);
+  for (int age = firstAge; age <= lastAge; age++) {
+    strm << age;
+    for (int j = ScaledEarnFactors::SCALEVERYLOW;
+      j <= ScaledEarnFactors::SCALEHIGH; j++) {
+      strm << " " << careerLevel[j] * profile[age - firstAge] / mean;
+    }
+    strm << endl;
+  }
+  istringstream in(strm.str());
+  scaledEarnFactors.read(in, firstAge, lastAge, false);
+}
+
+/// <summary>Clears the data from the previous case.</summary>
+void BenchPopulation::deleteContents()
+{
+  workerData.deleteContents();
+  earnProject.deleteContents();
+  widowArray.deleteContents();
+  widowDataArray.deleteContents();
+  secondaryArray.deleteContents();
+}
+
+/// <summary>Sets the earnings of the worker, from the first year of
+/// earnings through the last year of earnings.</summary>
+///
+/// <remarks>Earnings are entered through the year before the base year,
+/// and projected with the average wage after that.</remarks>
+///
+/// <param name="birthYear">Year of birth.</param>
+/// <param name="scaleType">Level of earnings.</param>
+void BenchPopulation::setEarnings( int birthYear,
+ScaledEarnFactors::scaleType scaleType )
+{
+  const int ibegin = workerData.getIbegin();
+  const int iend = workerData.getIend();
+  const int lastEntered = max(ibegin, min(iend, baseYear - 1));
+  earnProject.setFirstYear(ibegin);
+  earnProject.setLastYear(lastEntered);
+  if (iend > lastEntered) {
+    earnProject.setProjfwrd(EarnProject::AVGWAGE_PROJ);
+    earnProject.setPercfwrd(0.0);
+  }
+  factors.setScaledEarnings(earnProject, averageWage, birthYear,
+    factors.getFirstAge(), factors.getLastAge(), scaleType);
+}
+
+/// <summary>Sets the data for a disability case.</summary>
+///
+/// <remarks>Onset is at ages 27 to 61, no earlier than 1980 and no later
+/// than the year before the base year. The waiting period starts the month
+/// after onset, and entitlement is 5 months later. Earnings stop the year
+/// before onset.</remarks>
+///
+/// <param name="birthYear">Year of birth.</param>
+void BenchPopulation::setDisability( int birthYear )
+{
+  const int onsetYear = uniform(max(1980, birthYear + 27),
+    min(birthYear + 61, baseYear - 1));
+  const int onsetMonth = uniform(1, 12);
+  const int waitper = monthNumber(onsetYear, onsetMonth) + 1;
+  const DateMoyr entDate = toDateMoyr(waitper + 5);
+  workerData.setJoasdi(WorkerData::DISABILITY);
+  workerData.setEntDate(entDate);
+  workerData.setBenefitDate();
+  workerData.setValdi(1);
+  workerData.setOnsetDate(0, boost::gregorian::date(
+    static_cast<unsigned short>(onsetYear),
+    static_cast<unsigned short>(onsetMonth), 15));
+  workerData.setPriorentDate(0, entDate);
+  workerData.setWaitperDate(0, toDateMoyr(waitper));
+  workerData.setIend(max(workerData.getIbegin(), onsetYear - 1));
+}
+
+/// <summary>Sets the data for an old-age case.</summary>
+///
+/// <remarks>Entitlement is at ages 62 and 1 month through 70, possibly
+/// after the base year. Earnings stop the year before entitlement, and no
+/// later than the last age with a scaled factor.</remarks>
+///
+/// <param name="birthYear">Year of birth.</param>
+/// <param name="birthMonth">Month of birth.</param>
+void BenchPopulation::setOldAge( int birthYear, int birthMonth )
+{
+  const DateMoyr entDate = toDateMoyr(monthNumber(birthYear + 62,
+    birthMonth) + 1 + uniform(0, 95));
+  workerData.setJoasdi(WorkerData::OLD_AGE);
+  workerData.setEntDate(entDate);
+  workerData.setBenefitDate();
+  workerData.setIend(max(workerData.getIbegin(),
+    min(static_cast<int>(entDate.getYear()) - 1,
+    birthYear + factors.getLastAge())));
+}
+
+/// <summary>Sets the data for a survivor case, with one aged widow(er).
+/// </summary>
+///
+/// <remarks>The worker dies at ages 35 to 80, no earlier than 1980 and no
+/// later than the year before the base year. The widow(er) is up to 4
+/// years older or younger than the worker, and is entitled at age 60 or
+/// the month after the worker's death, if later. Earnings stop the year
+/// before death.</remarks>
+///
+/// <param name="birthYear">Year of birth.</param>
+/// <param name="birthMonth">Month of birth.</param>
+/// <param name="birthDay">Day of birth.</param>
+void BenchPopulation::setSurvivor( int birthYear, int birthMonth,
+int birthDay )
+{
+  const int deathYear = uniform(max(1980, birthYear + 35),
+    min(birthYear + 80, baseYear - 1));
+  const int deathMonth = uniform(1, 12);
+  const int widowBirthYear = birthYear + uniform(-4, 4);
+  const DateMoyr entDate = toDateMoyr(max(
+    monthNumber(deathYear, deathMonth) + 1,
+    monthNumber(widowBirthYear + 60, birthMonth) + 1));
+  workerData.setJoasdi(WorkerData::SURVIVOR);
+  workerData.setDeathDate(boost::gregorian::date(
+    static_cast<unsigned short>(deathYear),
+    static_cast<unsigned short>(deathMonth), 10));
+  workerData.setBenefitDate(entDate);
+  workerData.setIend(max(workerData.getIbegin(), deathYear - 1));
+  widowArray.setFamSize(1);
+  Secondary *secondaryptr = secondaryArray.secondary[0];
+  secondaryptr->bic.set("D ");
+  secondaryptr->entDate = entDate;
+  widowDataArray.workerData[0]->setBirthDate(boost::gregorian::date(
+    static_cast<unsigned short>(widowBirthYear),
+    static_cast<unsigned short>(birthMonth),
+    static_cast<unsigned short>(birthDay)));
+}
+
+/// <summary>Returns a random integer.</summary>
+///
+/// <returns>A random integer from low to high, inclusive.</returns>
+///
+/// <param name="low">Lowest value.</param>
+/// <param name="high">Highest value.</param>
+int BenchPopulation::uniform( int low, int high )
+{
+  boost::random::uniform_int_distribution< int > distribution(low, high);
+  return(distribution(generator));
+}
@@ -0,0 +1,116 @@
+// Declarations for the <see cref="BenchPopulation"/> class to generate a
+// reproducible synthetic population of benefit cases.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "boost/random/mersenne_twister.hpp"
+#include "PiaInputFile.h"
+#include "ScaledEarnFactors.h"
+#include "wrkrdata.h"
+#include "WorkerDataArray.h"
+#include "PiadataArray.h"
+#include "SecondaryArray.h"
+#include "UserAssumptions.h"
+#include "EarnProject.h"
+#include "pebs.h"
+class AverageWage;
+
+/// <summary>Generates a synthetic population of benefit cases, and holds
+/// the cases in memory in the format of a pia file.</summary>
+///
+/// <remarks>Each case is an old-age, disability, or survivor case for a
+/// worker with very low, low, average, or high scaled earnings (see
+/// <see cref="ScaledEarnFactors"/>). The earnings through the year before
+/// the base year are the scaled factors times the average wage; an old-age
+/// case with entitlement after the base year has its later earnings
+/// projected with the average wage (see <see cref="EarnProject"/>). Birth
+/// years span the cohorts eligible for each type of benefit.
+///
+/// The cases are built in the piadata objects and written with
+/// <see cref="PiaWriteAny"/>, so they are read back exactly as a pia file
+/// would be. The population depends only on the seed, the factors, the
+/// average wages, and the base year, so the same arguments always give the
+/// same cases.</remarks>
+///
+/// <seealso cref="ScaledEarnFactors"/>
+class BenchPopulation : public PiaInputFile
+{
+public:
+  /// <summary>Types of case generated.</summary>
+  enum case_type {
+    OLD_AGE,  // Old-age benefit.
+    DISABILITY,  // Disability benefit.
+    SURVIVOR,  // Aged widow(er) benefit.
+    NUM_CASE_TYPES  // Number of types of case.
+  };
+private:
+  /// <summary>Text of each case.</summary>
+  std::vector< std::string > cases;
+  /// <summary>Number of cases of each type.</summary>
+  unsigned caseCount[NUM_CASE_TYPES];
+  /// <summary>Number of cases of each earnings level.</summary>
+  unsigned scaleCount[ScaledEarnFactors::SCALEHIGH + 1];
+  /// <summary>Scaled earnings factors.</summary>
+  const ScaledEarnFactors& factors;
+  /// <summary>Average wage series.</summary>
+  const AverageWage& averageWage;
+  /// <summary>First year of projections.</summary>
+  const int baseYear;
+  /// <summary>Random number generator.</summary>
+  boost::random::mt19937 generator;
+  /// <summary>Worker's basic data.</summary>
+  WorkerData workerData;
+  /// <summary>Family members' basic data.</summary>
+  WorkerDataArray widowDataArray;
+  /// <summary>Family members' calculation data.</summary>
+  PiaDataArray widowArray;
+  /// <summary>Benefits for all family members.</summary>
+  SecondaryArray secondaryArray;
+  /// <summary>User-specified assumptions.</summary>
+  UserAssumptions userAssumptions;
+  /// <summary>Projected earnings.</summary>
+  EarnProject earnProject;
+  /// <summary>Statement data (not used).</summary>
+  Pebs pebs;
+public:
+  BenchPopulation( const ScaledEarnFactors& newFactors,
+    const AverageWage& newAverageWage, int newBaseYear, unsigned seed );
+  ~BenchPopulation();
+  void generate( unsigned count );
+  /// <summary>Returns the number of cases of one type.</summary>
+  ///
+  /// <returns>The number of cases of one type.</returns>
+  ///
+  /// <param name="caseType">Type of case.</param>
+  unsigned getCaseCount( case_type caseType ) const
+  { return(caseCount[caseType]); }
+  /// <summary>Returns the number of cases.</summary>
+  ///
+  /// <returns>The number of cases.</returns>
+  unsigned getRecordCount() const
+  { return(static_cast<unsigned>(cases.size())); }
+  /// <summary>Returns the number of cases with one level of earnings.
+  /// </summary>
+  ///
+  /// <returns>The number of cases with one level of earnings.</returns>
+  ///
+  /// <param name="scaleType">Level of earnings.</param>
+  unsigned getScaleCount( ScaledEarnFactors::scaleType scaleType ) const
+  { return(scaleCount[scaleType]); }
+  unsigned int read( PiaRead& piaRead, unsigned index ) const;
+  void write( std::ostream& out ) const;
+  static const char *getCaseName( case_type caseType );
+  static void setSyntheticFactors( ScaledEarnFactors& scaledEarnFactors );
+private:
+  void deleteContents();
+  void setEarnings( int birthYear, ScaledEarnFactors::scaleType scaleType );
+  void setDisability( int birthYear );
+  void setOldAge( int birthYear, int birthMonth );
+  void setSurvivor( int birthYear, int birthMonth, int birthDay );
+  int uniform( int low, int high );
+  BenchPopulation( const BenchPopulation& );
+  BenchPopulation& operator=( const BenchPopulation& );
+};
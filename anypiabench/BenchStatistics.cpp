@@ -0,0 +1,188 @@
+// Functions for the <see cref="BenchStatistics"/> class to summarize the
+// time spent in each stage of a benchmark run.
+
+#include <cmath>
+#include <algorithm>
+#include <iomanip>
+#include <ostream>
+#include "BenchStatistics.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Percentiles reported, as fractions.</summary>
+const double fractions[] = { 0.50, 0.90, 0.99 };
+
+/// <summary>Names of the percentiles reported.</summary>
+const char *fractionNames[] = { "p50", "p90", "p99" };
+
+/// <summary>Number of percentiles reported.</summary>
+const int NUM_FRACTIONS = 3;
+
+}  // namespace
+
+/// <summary>Adds the sample for one case.</summary>
+///
+/// <param name="newSeconds">Seconds spent in the case.</param>
+/// <param name="newAllocations">Allocations made in the case.</param>
+/// <param name="newCalls">Number of times timed in the case.</param>
+void BenchStatistics::Series::add( double newSeconds,
+unsigned long newAllocations, unsigned newCalls )
+{
+  seconds.push_back(newSeconds);
+  allocations += newAllocations;
+  calls += newCalls;
+}
+
+/// <summary>Writes the summary of the samples.</summary>
+///
+/// <remarks>Times are written in microseconds. The JSON form is one member
+/// of an object, without a trailing comma; the text form is one line of a
+/// table.</remarks>
+///
+/// <param name="out">Stream to write to.</param>
+/// <param name="name">Name of the stage or method.</param>
+/// <param name="json">True for JSON, false for text.</param>
+void BenchStatistics::Series::write( std::ostream& out, const char *name,
+bool json ) const
+{
+  vector< double > sorted(seconds);
+  sort(sorted.begin(), sorted.end());
+  double sum = 0.0;
+  for (vector< double >::const_iterator it = sorted.begin();
+    it != sorted.end(); ++it) {
+    sum += *it;
+  }
+  const size_t count = sorted.size();
+  const double mean = (count > 0) ? sum / count : 0.0;
+  const double maximum = (count > 0) ? sorted.back() : 0.0;
+  const double perCase = (count > 0) ?
+    static_cast<double>(allocations) / count : 0.0;
+  if (json) {
+    out << "\"" << name << "\": { \"cases\": " << count
+      << ", \"calls\": " << calls << ", \"total_us\": " << sum * 1.0e6
+      << ", \"mean_us\": " << mean * 1.0e6;
+    for (int i = 0; i < NUM_FRACTIONS; i++) {
+      out << ", \"" << fractionNames[i] << "_us\": "
+        << percentile(sorted, fractions[i]) * 1.0e6;
+    }
+    out << ", \"max_us\": " << maximum * 1.0e6
+      << ", \"allocations\": " << allocations
+      << ", \"allocations_per_case\": " << perCase << " }";
+  }
+  else {
+    out << left << setw(17) << name << right << setw(9) << count
+      << setw(10) << mean * 1.0e6;
+    for (int i = 0; i < NUM_FRACTIONS; i++) {
+      out << setw(10) << percentile(sorted, fractions[i]) * 1.0e6;
+    }
+    out << setw(10) << maximum * 1.0e6 << setw(10) << perCase << endl;
+  }
+}
+
+/// <summary>Initializes an empty set of samples.</summary>
+BenchStatistics::BenchStatistics() : total()
+{ }
+
+/// <summary>Adds the samples for one case.</summary>
+///
+/// <param name="stageTimes">Times of the stages of the case.</param>
+/// <param name="seconds">Seconds spent in the whole case.</param>
+/// <param name="allocations">Allocations made in the whole case.</param>
+void BenchStatistics::add( const StageTimes& stageTimes, double seconds,
+unsigned long allocations )
+{
+  total.add(seconds, allocations, 1u);
+  for (int i = 0; i < StageTimes::NUM_STAGES; i++) {
+    const StageTimes::stage_type stage =
+      static_cast<StageTimes::stage_type>(i);
+    stages[i].add(stageTimes.getStageSeconds(stage),
+      stageTimes.getStageAllocations(stage),
+      stageTimes.getStageCalls(stage));
+  }
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    const PiaMethod::pia_type method = static_cast<PiaMethod::pia_type>(i);
+    if (stageTimes.getMethodCalls(method) > 0u) {
+      methods[i].add(stageTimes.getMethodSeconds(method),
+        stageTimes.getMethodAllocations(method),
+        stageTimes.getMethodCalls(method));
+    }
+  }
+}
+
+/// <summary>Returns a percentile of sorted samples.</summary>
+///
+/// <returns>The nearest-rank percentile, or zero if there are no samples.
+/// </returns>
+///
+/// <param name="sorted">Samples, in increasing order.</param>
+/// <param name="fraction">Percentile, as a fraction (0.5 for the median).
+/// </param>
+double BenchStatistics::percentile( const std::vector< double >& sorted,
+double fraction )
+{
+  if (sorted.empty())
+    return(0.0);
+  const size_t rank = static_cast<size_t>(ceil(fraction * sorted.size()));
+  return(sorted[(rank > 0) ? min(rank, sorted.size()) - 1 : 0]);
+}
+
+/// <summary>Writes the summaries as the members "case", "stages", and
+/// "methods" of a JSON object.</summary>
+///
+/// <remarks>The members are written without the enclosing braces or a
+/// trailing comma, so the caller can add other members.</remarks>
+///
+/// <param name="out">Stream to write to.</param>
+void BenchStatistics::writeJson( std::ostream& out ) const
+{
+  out << "  ";
+  total.write(out, "case", true);
+  out << ",\n  \"stages\": {";
+  for (int i = 0; i < StageTimes::NUM_STAGES; i++) {
+    out << ((i > 0) ? ",\n    " : "\n    ");
+    stages[i].write(out,
+      StageTimes::getStageName(static_cast<StageTimes::stage_type>(i)),
+      true);
+  }
+  out << "\n  },\n  \"methods\": {";
+  bool first = true;
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    if (methods[i].seconds.empty())
+      continue;
+    out << (first ? "\n    " : ",\n    ");
+    methods[i].write(out,
+      StageTimes::getMethodName(static_cast<PiaMethod::pia_type>(i)), true);
+    first = false;
+  }
+  out << "\n  }";
+}
+
+/// <summary>Writes the summaries as a table.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+void BenchStatistics::writeText( std::ostream& out ) const
+{
+  out << left << setw(17) << "stage (us)" << right << setw(9) << "cases"
+    << setw(10) << "mean";
+  for (int i = 0; i < NUM_FRACTIONS; i++) {
+    out << setw(10) << fractionNames[i];
+  }
+  out << setw(10) << "max" << setw(10) << "allocs" << endl;
+  out.setf(ios::fixed, ios::floatfield);
+  out.precision(1);
+  total.write(out, "case", false);
+  for (int i = 0; i < StageTimes::NUM_STAGES; i++) {
+    stages[i].write(out,
+      StageTimes::getStageName(static_cast<StageTimes::stage_type>(i)),
+      false);
+  }
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    if (!methods[i].seconds.empty()) {
+      methods[i].write(out,
+        StageTimes::getMethodName(static_cast<PiaMethod::pia_type>(i)),
+        false);
+    }
+  }
+}
@@ -0,0 +1,53 @@
+// Declarations for the <see cref="BenchStatistics"/> class to summarize
+// the time spent in each stage of a benchmark run.
+
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+#include "StageTimes.h"
+
+/// <summary>Collects the time spent in each stage of each case of a
+/// benchmark run, and reports percentiles of the times.</summary>
+///
+/// <remarks>One sample is kept per case for the whole case and for each
+/// stage, and per case that uses it for each pia calculation method. The
+/// percentiles are the nearest-rank percentiles of the samples.</remarks>
+///
+/// <seealso cref="StageTimes"/>
+class BenchStatistics
+{
+private:
+  /// <summary>Samples for one stage or method.</summary>
+  struct Series
+  {
+    /// <summary>Seconds spent in each case.</summary>
+    std::vector< double > seconds;
+    /// <summary>Total allocations in all cases.</summary>
+    unsigned long allocations;
+    /// <summary>Total number of times timed in all cases.</summary>
+    unsigned long calls;
+    Series() : seconds(), allocations(0ul), calls(0ul) { }
+    void add( double newSeconds, unsigned long newAllocations,
+      unsigned newCalls );
+    void write( std::ostream& out, const char *name, bool json ) const;
+  };
+  /// <summary>Samples for whole cases.</summary>
+  Series total;
+  /// <summary>Samples for each stage.</summary>
+  Series stages[StageTimes::NUM_STAGES];
+  /// <summary>Samples for each pia calculation method.</summary>
+  Series methods[PiaMethod::NO_PIA_TYPE];
+public:
+  BenchStatistics();
+  void add( const StageTimes& stageTimes, double seconds,
+    unsigned long allocations );
+  /// <summary>Returns the number of cases added.</summary>
+  ///
+  /// <returns>The number of cases added.</returns>
+  unsigned long getCaseCount() const { return(total.seconds.size()); }
+  void writeJson( std::ostream& out ) const;
+  void writeText( std::ostream& out ) const;
+  static double percentile( const std::vector< double >& sorted,
+    double fraction );
+};
@@ -0,0 +1,299 @@
+// Benchmark for the batch calculation of benefits: generates a reproducible
+// synthetic population, calculates every case, and reports the time spent
+// in each stage of the calculation.
+//
+// Usage: anypiabench [-n cases] [-s seed] [-r repeats] [-w warmup]
+//                    [-l | -o format] [-f factorfile] [-p piafile]
+//                    [-v label] [-c] [jsonfile]
+//
+//   -n cases       number of cases to generate (default 10000)
+//   -s seed        seed for the random number generator (default 1)
+//   -r repeats     number of times to calculate the population (default 1)
+//   -w warmup      number of cases to calculate before timing (default 100)
+//   -l             long output (all pages) instead of one page per case
+//   -o format      records (csv or json) instead of the printed output
+//                  (see RecordCalculator.h)
+//   -f factorfile  scaled earnings factors, in the format read by
+//                  ScaledEarnFactors::read with a label line, for ages 21
+//                  to 64 (default: built-in synthetic factors)
+//   -p piafile     also write the population as a pia file
+//   -v label       label to identify this run in the results
+//   -c             check that the faster calculations give the same
+//                  results as the ones they replace, instead of timing
+//                  (see BenchCheck.h); the exit code is 1 if any differ
+//
+// A summary is written to standard output. If jsonfile is given, the
+// results are also written to it as JSON, so that runs of different
+// versions can be compared. No input files or network access are needed.
+//
+// The benchmark runs on one thread, so that the times of the stages are
+// not disturbed by other threads. Allocations are counted by replacing the
+// global operator new in this program only (see BenchAllocations.h).
+// Blocks taken from the heap for annual arrays and pia calculation methods
+// are also counted separately, by CalcArena; in steady state there should
+// be none.
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "boost/scoped_ptr.hpp"
+#include "boost/shared_ptr.hpp"
+#include "BatchCalculator.h"
+#include "RecordCalculator.h"
+#include "BenchPopulation.h"
+#include "BenchStatistics.h"
+#include "BenchAllocations.h"
+#include "BenchCheck.h"
+#include "StageTimes.h"
+#include "CalcArena.h"
+#include "ScaledEarnFactors.h"
+#include "BaseYearNonFile.h"
+#include "AwbiDataNonFile.h"
+#include "AssumptionsNonFile.h"
+#include "LawChangeArray.h"
+#include "PiaParamsCache.h"
+#include "piaparmsAny.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Version of the format of the results file.</summary>
+const int RESULTS_VERSION = 1;
+
+/// <summary>First age with scaled earnings factors.</summary>
+const int FIRST_AGE = 21;
+
+/// <summary>Last age with scaled earnings factors.</summary>
+const int LAST_AGE = 64;
+
+/// <summary>Prints usage message.</summary>
+void usage()
+{
+  cerr << "Usage: anypiabench [-n cases] [-s seed] [-r repeats]"
+    << " [-w warmup]" << endl;
+  cerr << "                   [-l | -o format] [-f factorfile] [-p piafile]"
+    << endl;
+  cerr << "                   [-v label] [-c] [jsonfile]" << endl;
+}
+
+/// <summary>Writes a string as a JSON string.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+/// <param name="text">String to write.</param>
+void writeJsonString( std::ostream& out, const std::string& text )
+{
+  out << '"';
+  for (string::const_iterator it = text.begin(); it != text.end(); ++it) {
+    if (*it == '"' || *it == '\\')
+      out << '\\' << *it;
+    else if (static_cast<unsigned char>(*it) >= 0x20)
+      out << *it;
+  }
+  out << '"';
+}
+
+}  // namespace
+
+int main( int argc, char *argv[] )
+{
+  unsigned cases = 10000u;
+  unsigned seed = 1u;
+  unsigned repeats = 1u;
+  unsigned warmup = 100u;
+  bool longOutput = false;
+  const char *recordFormat = 0;
+  const char *factorFile = 0;
+  const char *piaFile = 0;
+  string label;
+  bool check = false;
+  int i = 1;
+  for (; i < argc && argv[i][0] == '-'; i++) {
+    if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+      cases = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+      seed = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+      repeats = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc) {
+      warmup = static_cast<unsigned>(atoi(argv[++i]));
+    }
+    else if (strcmp(argv[i], "-l") == 0) {
+      longOutput = true;
+    }
+    else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc &&
+      (strcmp(argv[i + 1], "csv") == 0 || strcmp(argv[i + 1], "json") == 0)) {
+      recordFormat = argv[++i];
+    }
+    else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+      factorFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+      piaFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "-v") == 0 && i + 1 < argc) {
+      label = argv[++i];
+    }
+    else if (strcmp(argv[i], "-c") == 0) {
+      check = true;
+    }
+    else {
+      usage();
+      return 1;
+    }
+  }
+  if (argc - i > 1 || cases == 0u || repeats == 0u ||
+    (longOutput && recordFormat != 0)) {
+    usage();
+    return 1;
+  }
+  const char *jsonFile = (i < argc) ? argv[i] : 0;
+  int retval = 0;
+  try {
+    BatchCalculator::setStatics();
+    BaseYearNonFile baseYear;
+    AwbiDataNonFile awbiData(baseYear.getYear(), WorkerData::getMaxyear());
+    AssumptionsNonFile assumptions(baseYear.getYear(),
+      WorkerData::getMaxyear());
+    LawChangeArray lawChange(baseYear.getYear(), WorkerData::getMaxyear(),
+      "");
+    PiaParamsCache piaParamsCache(baseYear.getYear(),
+      WorkerData::getMaxyear(), awbiData, lawChange, assumptions);
+    // the calculator sets the first year of projections, which the
+    // population uses
+    boost::scoped_ptr< BatchCalculator > calculator((recordFormat != 0) ?
+      new RecordCalculator(piaParamsCache, baseYear.getYear(),
+      (strcmp(recordFormat, "json") == 0) ? RecordCalculator::JSON :
+      RecordCalculator::CSV) :
+      new BatchCalculator(piaParamsCache, baseYear.getYear(), longOutput));
+    UserAssumptions userAssumptions(WorkerData::getMaxyear());
+    userAssumptions.setIaltbi(AssumptionType::FLAT);
+    userAssumptions.setIaltaw(AssumptionType::FLAT);
+    userAssumptions.setIbasch(1);
+    const boost::shared_ptr< const PiaParamsAny > piaParams =
+      piaParamsCache.get(userAssumptions);
+    ScaledEarnFactors factors(FIRST_AGE, LAST_AGE);
+    if (factorFile != 0) {
+      ifstream in(factorFile);
+      if (!in)
+        throw PiaException(string("Cannot open ") + factorFile);
+      factors.read(in, FIRST_AGE, LAST_AGE, true);
+      if (!in)
+        throw PiaException(string("Error reading ") + factorFile);
+    }
+    else {
+      BenchPopulation::setSyntheticFactors(factors);
+    }
+    const double generateStart = StageTimes::now();
+    BenchPopulation population(factors, piaParams->getFqArray(),
+      baseYear.getYear(), seed);
+    population.generate(cases);
+    const double generateSeconds = StageTimes::now() - generateStart;
+    if (piaFile != 0) {
+      ofstream out(piaFile);
+      if (!out)
+        throw PiaException(string("Cannot open ") + piaFile);
+      population.write(out);
+    }
+    if (check) {
+      BenchCheck benchCheck(piaParamsCache, baseYear.getYear());
+      const unsigned long differences =
+        benchCheck.checkAll(population, cout);
+      cout << "anypiabench: " << differences
+        << ((differences == 1ul) ? " difference" : " differences") << endl;
+      return((differences > 0ul) ? 1 : 0);
+    }
+    string result;
+    for (unsigned j = 0; j < warmup && j < cases; j++) {
+      calculator->calculate(population, j, result);
+    }
+    StageTimes::setAllocationCounter(BenchAllocations::getCount);
+    StageTimes stageTimes;
+    BenchStatistics statistics;
+    unsigned long errors = 0ul;
+    calculator->setStageTimes(&stageTimes);
+    const unsigned long arenaStart = CalcArena::getThreadAllocations();
+    const double runStart = StageTimes::now();
+    for (unsigned k = 0; k < repeats; k++) {
+      for (unsigned j = 0; j < cases; j++) {
+        stageTimes.clear();
+        const unsigned long allocations = BenchAllocations::getCount();
+        const double start = StageTimes::now();
+        calculator->calculate(population, j, result);
+        statistics.add(stageTimes, StageTimes::now() - start,
+          BenchAllocations::getCount() - allocations);
+        if (result.find(": error") != string::npos ||
+          result.find(",error ") != string::npos ||
+          result.find("\"error\":") != string::npos)
+          errors++;
+      }
+    }
+    const double runSeconds = StageTimes::now() - runStart;
+    const unsigned long arenaAllocations =
+      CalcArena::getThreadAllocations() - arenaStart;
+    calculator->setStageTimes(0);
+    StageTimes::setAllocationCounter(0);
+    const double casesPerSecond = (runSeconds > 0.0) ?
+      statistics.getCaseCount() / runSeconds : 0.0;
+    cout << "anypiabench: " << statistics.getCaseCount()
+      << " cases calculated in " << runSeconds << " seconds ("
+      << casesPerSecond << " cases/second), " << errors << " errors"
+      << endl;
+    cout << "population: " << cases << " cases generated in "
+      << generateSeconds << " seconds (seed " << seed << ")";
+    for (int j = 0; j < BenchPopulation::NUM_CASE_TYPES; j++) {
+      const BenchPopulation::case_type caseType =
+        static_cast<BenchPopulation::case_type>(j);
+      cout << ", " << population.getCaseCount(caseType) << " "
+        << BenchPopulation::getCaseName(caseType);
+    }
+    cout << endl;
+    cout << "annual arrays and methods: " << arenaAllocations
+      << " heap allocations" << endl;
+    statistics.writeText(cout);
+    if (jsonFile != 0) {
+      ofstream out(jsonFile);
+      if (!out)
+        throw PiaException(string("Cannot open ") + jsonFile);
+      out << "{\n  \"version\": " << RESULTS_VERSION << ",\n  \"label\": ";
+      writeJsonString(out, label);
+      out << ",\n  \"base_year\": " << baseYear.getYear()
+        << ",\n  \"seed\": " << seed << ",\n  \"population\": " << cases
+        << ",\n  \"factors\": ";
+      writeJsonString(out, (factorFile != 0) ? factorFile : "synthetic");
+      out << ",\n  \"population_mix\": {";
+      for (int j = 0; j < BenchPopulation::NUM_CASE_TYPES; j++) {
+        const BenchPopulation::case_type caseType =
+          static_cast<BenchPopulation::case_type>(j);
+        out << ((j > 0) ? ", \"" : " \"")
+          << BenchPopulation::getCaseName(caseType) << "\": "
+          << population.getCaseCount(caseType);
+      }
+      out << " },\n  \"repeats\": " << repeats << ",\n  \"warmup\": "
+        << warmup << ",\n  \"long_output\": "
+        << (longOutput ? "true" : "false") << ",\n  \"record_format\": ";
+      writeJsonString(out, (recordFormat != 0) ? recordFormat : "");
+      out << ",\n  \"cases\": "
+        << statistics.getCaseCount() << ",\n  \"errors\": " << errors
+        << ",\n  \"generate_seconds\": " << generateSeconds
+        << ",\n  \"seconds\": " << runSeconds
+        << ",\n  \"cases_per_second\": " << casesPerSecond
+        << ",\n  \"arena_heap_allocations\": " << arenaAllocations
+        << ",\n";
+      statistics.writeJson(out);
+      out << "\n}" << endl;
+      if (!out)
+        throw PiaException(string("Error writing ") + jsonFile);
+    }
+  } catch (PiaException& e) {
+    cerr << "anypiabench: error " << e.getNumber() << " " << e.what() << endl;
+    retval = 1;
+  }
+  return retval;
+}
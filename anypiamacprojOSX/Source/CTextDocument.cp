@@ -2373,6 +2373,9 @@ void CTextDocument::NewPIA()
    piacal = new PiaCalAny(*workerData, *piadata, *widowDataArray, *widowArray,
       *piaparms, *userAssumptions, *secondaryArray, *lawChange, *pebs,
       *earnProject);
+   // keep the pia methods from one calculation to the next, so a change to
+   // a few years of earnings is recalculated quickly
+   piacal->setIncremental(true);
    piacal->calculate1(*assumptions);
    foinfo = new FieldOfficeInfoNonFile();
    foinfo->setData();
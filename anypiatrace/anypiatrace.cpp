@@ -0,0 +1,44 @@
+// Converts trace output written in binary format by AsyncTraceListener
+// (for example by anypiab -G) to text.
+//
+// Usage: anypiatrace infile [outfile]
+//
+// Each record is written on one line, with the seconds since tracing
+// started and the number of the thread that traced it before its text. If
+// outfile is omitted, the text is written to standard output.
+
+#include <fstream>
+#include <iostream>
+#include "AsyncTraceListener.h"
+#include "PiaException.h"
+
+using namespace std;
+
+int main( int argc, char *argv[] )
+{
+  if (argc < 2 || argc > 3) {
+    cerr << "Usage: anypiatrace infile [outfile]" << endl;
+    return 1;
+  }
+  ifstream in(argv[1], ios::in | ios::binary);
+  if (!in) {
+    cerr << "anypiatrace: cannot open " << argv[1] << endl;
+    return 1;
+  }
+  ofstream outfile;
+  if (argc > 2) {
+    outfile.open(argv[2]);
+    if (!outfile) {
+      cerr << "anypiatrace: cannot open " << argv[2] << endl;
+      return 1;
+    }
+  }
+  ostream& out = (argc > 2) ? outfile : cout;
+  try {
+    AsyncTraceListener::decode(in, out);
+  } catch (PiaException& e) {
+    cerr << "anypiatrace: " << e.what() << endl;
+    return 1;
+  }
+  return 0;
+}
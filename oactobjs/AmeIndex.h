@@ -0,0 +1,77 @@
+// Declarations for the <see cref="AmeIndex"/> class to find the AME giving
+// a pia in the old pia tables without searching every AME.
+
+#pragma once
+
+#include <map>
+#include <vector>
+#include "boost/shared_ptr.hpp"
+#include "boost/thread/mutex.hpp"
+
+/// <summary>Holds, for each old pia table and benefit date, the highest pia
+/// for each AME from $76 to $1000, so the lowest AME giving a pia can be
+/// found by a binary search.</summary>
+///
+/// <remarks><see cref="OldPia::mfbOldCal"/> looks for the lowest AME whose
+/// pia in the 1972 Act table, or the 1973 Act table with the later benefit
+/// increases, is at least a given pia. A pia in the table is the same for
+/// every worker with the same table, last benefit increase, year of
+/// eligibility for catch-up increases, and special 1999 increase (see
+/// <see cref="AmeIndex::Key"/>), so the pias of all the AMEs are calculated
+/// once for each of those combinations and saved here. The pias of the
+/// table are not quite in increasing order (some were set ad hoc), so the
+/// highest pia up to each AME is saved instead; the lowest AME with such a
+/// highest pia at least the given pia is the lowest AME with a pia at least
+/// that pia, so the result is the same as searching every AME.
+///
+/// An index is kept in each <see cref="PiaParams"/>, and is cleared when its
+/// benefit increases or wage bases change. The lists of pias are added
+/// under a lock, and never change once added, so any number of threads may
+/// use the same index.</remarks>
+///
+/// <seealso cref="OldPia"/>
+/// <seealso cref="PiaParams"/>
+class AmeIndex
+{
+public:
+  /// <summary>Lowest AME searched.</summary>
+  static const int FIRST_AME = 76;
+  /// <summary>Highest AME searched.</summary>
+  static const int LAST_AME = 1000;
+  /// <summary>Identifies the pias of one table.</summary>
+  struct Key
+  {
+    /// <summary>Pia table (see <see cref="PiaMethod::table_type"/>).
+    /// </summary>
+    int table;
+    /// <summary>Year of the last benefit increase applied (0 for the 1972
+    /// Act table).</summary>
+    int lastYear;
+    /// <summary>Year of eligibility, if it has catch-up benefit increases
+    /// (0 otherwise).</summary>
+    int eligYear;
+    /// <summary>Dates of the benefit affecting the table: for the 1972 Act
+    /// table, 1 if on or after August 1961 plus 2 if in the temporary
+    /// increase of March to May 1974; otherwise 1 if the special 1999
+    /// increase applies.</summary>
+    int dates;
+    bool operator<( const Key& key ) const;
+  };
+private:
+  /// <summary>Protects the lists of pias.</summary>
+  boost::mutex mutex;
+  /// <summary>Highest pia up to each AME, by table.</summary>
+  std::map< Key, boost::shared_ptr< const std::vector< double > > > pias;
+public:
+  AmeIndex();
+  ~AmeIndex();
+  void clear();
+  boost::shared_ptr< const std::vector< double > > find( const Key& key );
+  unsigned getSize();
+  boost::shared_ptr< const std::vector< double > > insert( const Key& key,
+    const std::vector< double >& tablePias );
+  static int search( const std::vector< double >& maxPias, double pia );
+private:
+  AmeIndex( const AmeIndex& );
+  AmeIndex& operator=( const AmeIndex& );
+};
@@ -0,0 +1,151 @@
+// Declarations for the <see cref="AsyncTraceListener"/> class that listens
+// for <see cref="Trace"/> output and writes it to an ostream on a
+// background thread.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "boost/atomic.hpp"
+#include "boost/cstdint.hpp"
+#include "boost/lockfree/spsc_queue.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+#include "boost/thread/tss.hpp"
+#include "TraceListener.h"
+
+/// <summary>A class that listens for <see cref="Trace"/> output from any
+/// number of threads, and writes it to an output stream on a background
+/// thread.</summary>
+///
+/// <remarks>Each thread that traces gets its own ring buffer of fixed size
+/// the first time it writes, and each line is added to the ring of its
+/// thread as one record, without locking. A background thread drains the
+/// rings and writes the records to the stream, so tracing threads never
+/// wait for the stream. If a ring is full, the record is dropped and
+/// counted; the drain thread reports the number dropped on each thread,
+/// and <see cref="getDropped"/> returns the total. The memory used is at
+/// most the size of a ring for each thread that has traced.
+///
+/// Text written with <see cref="write"/> is kept by its thread until the
+/// next <see cref="writeLine"/> or <see cref="flush"/>, so the lines of
+/// different threads are never mixed. The lines of one thread are written
+/// in order; lines of different threads are written in the order they are
+/// drained, and each record carries the time it was traced.
+///
+/// In text format, the lines are written as they were traced, as by
+/// <see cref="TextWriterTraceListener"/>. In binary format, the stream
+/// starts with a header, and each record has its length, thread number,
+/// kind, and time in nanoseconds since the listener was created, followed
+/// by its text; all values are stored in the byte order of the machine
+/// that wrote them. Binary output is smaller and cheaper to write, and is
+/// converted to text by <see cref="decode"/> (see the anypiatrace
+/// program).</remarks>
+///
+/// <seealso cref="TextWriterTraceListener"/>
+/// <seealso cref="Trace"/>
+class AsyncTraceListener : public TraceListener
+{
+public:
+  /// <summary>Kinds of records in binary format.</summary>
+  enum record_kind {
+    LINE,  // A line of text.
+    TEXT,  // Text without a newline.
+    DROPPED  // Count of records dropped on a thread.
+  };
+  /// <summary>Default size of each ring buffer, in bytes.</summary>
+  static const unsigned DEFAULT_RING_SIZE = 1u << 20;
+  /// <summary>Size of the header of a binary stream, in bytes.</summary>
+  static const unsigned HEADER_SIZE = 16u;
+  /// <summary>Size of the header of a binary record, in bytes.</summary>
+  static const unsigned RECORD_HEADER_SIZE = 16u;
+  /// <summary>Version of the binary format.</summary>
+  static const boost::uint32_t VERSION = 1u;
+  /// <summary>Value used to check the byte order of a binary stream.
+  /// </summary>
+  static const boost::uint32_t ENDIAN_MARK = 0x01020304u;
+  /// <summary>First bytes of a binary stream.</summary>
+  static const char magic[];
+private:
+  /// <summary>Ring buffer of the records of one thread.</summary>
+  ///
+  /// <remarks>Only the tracing thread adds to the ring, and only the drain
+  /// thread removes from it.</remarks>
+  struct Ring
+  {
+    /// <summary>Records not yet drained.</summary>
+    boost::lockfree::spsc_queue< char > queue;
+    /// <summary>Number of the thread, in order of first use.</summary>
+    unsigned thread;
+    /// <summary>Number of records dropped because the ring was full.
+    /// </summary>
+    boost::atomic< unsigned long > dropped;
+    /// <summary>Number of dropped records already reported (used only by
+    /// the drain thread).</summary>
+    unsigned long reported;
+    /// <summary>Text written without a newline (used only by the tracing
+    /// thread).</summary>
+    std::string pending;
+    /// <summary>Record being built (used only by the tracing thread).
+    /// </summary>
+    std::vector< char > record;
+    Ring( unsigned size, unsigned newThread );
+  };
+  /// <summary>Stream to write to.</summary>
+  std::ostream *strm;
+  /// <summary>True to write the binary format, false to write text.
+  /// </summary>
+  bool binary;
+  /// <summary>Size of each ring buffer, in bytes.</summary>
+  unsigned ringSize;
+  /// <summary>Time when this instance was created, in nanoseconds.
+  /// </summary>
+  boost::uint64_t startTime;
+  /// <summary>Ring of the current thread.</summary>
+  boost::thread_specific_ptr< Ring > threadRing;
+  /// <summary>Rings of all threads that have traced.</summary>
+  std::vector< Ring* > rings;
+  /// <summary>Protects the vector of rings and the drain counts.</summary>
+  boost::mutex mutex;
+  /// <summary>Signals the drain thread, and threads waiting for it.
+  /// </summary>
+  boost::condition_variable drained;
+  /// <summary>Number of drain passes requested.</summary>
+  unsigned long requested;
+  /// <summary>Number of drain passes finished.</summary>
+  unsigned long finished;
+  /// <summary>True when the drain thread should stop.</summary>
+  bool stopping;
+  /// <summary>Records drained but not yet written.</summary>
+  std::vector< char > buffer;
+  /// <summary>Background thread that drains the rings.</summary>
+  boost::thread drainThread;
+public:
+  AsyncTraceListener( std::ostream *newStream, bool newBinary = false,
+    unsigned newRingSize = DEFAULT_RING_SIZE );
+  void close();
+  void flush();
+  unsigned long getDropped();
+  /// <summary>Returns true if the binary format is written.</summary>
+  ///
+  /// <returns>True if the binary format is written.</returns>
+  bool isBinary() const { return(binary); }
+  void write( const std::string& str );
+  void write( const char *str );
+  void writeLine( const std::string& str );
+  void writeLine( const char *str );
+  ~AsyncTraceListener();
+  static unsigned long decode( std::istream& in, std::ostream& out );
+private:
+  void add( record_kind kind, const char *str, size_t length );
+  bool drain();
+  void drainLoop();
+  Ring *getRing();
+  void writeBuffer();
+  static void noCleanup( Ring * );
+  static boost::uint64_t now();
+  AsyncTraceListener( const AsyncTraceListener& );
+  AsyncTraceListener& operator=( const AsyncTraceListener& );
+};
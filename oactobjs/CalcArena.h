@@ -0,0 +1,223 @@
+// Declarations for the <see cref="CalcArena"/> class to provide memory for
+// the objects of one calculation, and the <see cref="ArenaAllocator"/>
+// class to use it in containers.
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/// <summary>Provides memory for the objects of one pia calculation from a
+/// few large blocks, all released at once.</summary>
+///
+/// <remarks>Memory is taken from the end of the current block, and is not
+/// released until <see cref="reset"/> is called, after all the objects in
+/// it are destroyed. When a block is full, another is allocated; at the
+/// next reset the blocks are replaced by one block large enough for all of
+/// them, so once a calculator has seen its largest case no more memory is
+/// allocated.
+///
+/// An instance is made current for a thread with a
+/// <see cref="CalcArena::Scope"/>. An <see cref="ArenaAllocator"/> takes
+/// its memory from the arena that was current when the allocator was
+/// created, so the arrays of <see cref="DoubleAnnual"/>,
+/// <see cref="IntAnnual"/>, <see cref="QcArray"/>, and
+/// <see cref="AverageWage"/> created in a scope are in the arena, and those
+/// created with no current arena are on the heap as usual. A copy of an
+/// array takes its memory from the arena current when it is copied.
+///
+/// An instance is not locked, so it must be used by one thread at a time.
+/// Each thread counts the blocks of memory it takes from the heap for
+/// arenas and for arrays with no arena (see
+/// <see cref="getThreadAllocations"/>), so that a batch run can check
+/// that these arrays no longer allocate.</remarks>
+///
+/// <seealso cref="ArenaAllocator"/>
+/// <seealso cref="PiaCal"/>
+class CalcArena
+{
+public:
+  /// <summary>Makes an arena current for the thread, from its
+  /// construction until its destruction or <see cref="leave"/>.</summary>
+  ///
+  /// <remarks>Scopes may be nested; the arena that was current before is
+  /// restored. A null arena makes no arena current.</remarks>
+  class Scope
+  {
+  private:
+    /// <summary>Arena current before this scope.</summary>
+    CalcArena *previous;
+    /// <summary>True until the previous arena is restored.</summary>
+    bool active;
+  public:
+    explicit Scope( CalcArena *arena );
+    ~Scope();
+    void leave();
+  private:
+    Scope( const Scope& );
+    Scope& operator=( const Scope& );
+  };
+  /// <summary>Default size of a block, in bytes.</summary>
+  static const size_t DEFAULT_BLOCK_SIZE = 64u * 1024u;
+  /// <summary>Alignment of all memory provided, in bytes.</summary>
+  static const size_t ALIGNMENT = 16u;
+private:
+  /// <summary>One block of memory.</summary>
+  struct Block
+  {
+    /// <summary>Start of the block.</summary>
+    char *data;
+    /// <summary>Size of the block, in bytes.</summary>
+    size_t size;
+  };
+  /// <summary>Blocks of memory, the current one last.</summary>
+  std::vector< Block > blocks;
+  /// <summary>Bytes used in the current block.</summary>
+  size_t used;
+  /// <summary>Bytes used in the blocks before the current one.</summary>
+  size_t usedBefore;
+  /// <summary>Most bytes used between resets.</summary>
+  size_t highWater;
+  /// <summary>Size of a new block, in bytes.</summary>
+  size_t blockSize;
+public:
+  explicit CalcArena( size_t newBlockSize = DEFAULT_BLOCK_SIZE );
+  ~CalcArena();
+  void *allocate( size_t size );
+  /// <summary>Returns the number of blocks.</summary>
+  ///
+  /// <returns>The number of blocks.</returns>
+  size_t getBlockCount() const { return(blocks.size()); }
+  size_t getCapacity() const;
+  /// <summary>Returns the most bytes used between resets.</summary>
+  ///
+  /// <returns>The most bytes used between resets.</returns>
+  size_t getHighWater() const { return(highWater); }
+  /// <summary>Returns the bytes used since the last reset.</summary>
+  ///
+  /// <returns>The bytes used since the last reset.</returns>
+  size_t getUsed() const { return(usedBefore + used); }
+  void reset();
+  static void *allocateObject( size_t size );
+  static void deallocateObject( void *p );
+  static void countAllocation();
+  static CalcArena *getCurrent();
+  static unsigned long getThreadAllocations();
+private:
+  void addBlock( size_t size );
+  void releaseBlocks();
+  static size_t roundUp( size_t size )
+  { return((size + ALIGNMENT - 1u) & ~(ALIGNMENT - 1u)); }
+  CalcArena( const CalcArena& );
+  CalcArena& operator=( const CalcArena& );
+};
+
+/// <summary>An allocator that takes memory from the
+/// <see cref="CalcArena"/> current when it was created, or from the heap
+/// if there was none.</summary>
+///
+/// <remarks>Memory from an arena is not released by
+/// <see cref="deallocate"/>; it is reused when the arena is reset. Copies
+/// of a container get the arena current at the time of the copy.
+/// </remarks>
+///
+/// <seealso cref="CalcArena"/>
+template< class T >
+class ArenaAllocator
+{
+  template< class U > friend class ArenaAllocator;
+public:
+  typedef T value_type;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T& reference;
+  typedef const T& const_reference;
+  typedef size_t size_type;
+  typedef ptrdiff_t difference_type;
+  /// <summary>The same allocator for another type.</summary>
+  template< class U > struct rebind { typedef ArenaAllocator< U > other; };
+private:
+  /// <summary>Arena to use (null to use the heap).</summary>
+  CalcArena *arena;
+public:
+  /// <summary>Creates an allocator using the current arena.</summary>
+  ArenaAllocator() : arena(CalcArena::getCurrent()) { }
+  /// <summary>Creates an allocator using the same arena as another.
+  /// </summary>
+  ///
+  /// <param name="allocator">Allocator to copy.</param>
+  ArenaAllocator( const ArenaAllocator& allocator ) :
+  arena(allocator.arena) { }
+  /// <summary>Creates an allocator using the same arena as an allocator
+  /// for another type.</summary>
+  ///
+  /// <param name="allocator">Allocator to copy.</param>
+  template< class U >
+  ArenaAllocator( const ArenaAllocator< U >& allocator ) :
+  arena(allocator.arena) { }
+  /// <summary>Returns the address of a value.</summary>
+  ///
+  /// <returns>The address of a value.</returns>
+  pointer address( reference x ) const { return(&x); }
+  /// <summary>Returns the address of a value.</summary>
+  ///
+  /// <returns>The address of a value.</returns>
+  const_pointer address( const_reference x ) const { return(&x); }
+  /// <summary>Allocates memory for values.</summary>
+  ///
+  /// <returns>The memory allocated.</returns>
+  ///
+  /// <param name="n">Number of values.</param>
+  pointer allocate( size_type n, const void * = 0 )
+  {
+    if (arena != 0)
+      return(static_cast<pointer>(arena->allocate(n * sizeof(T))));
+    CalcArena::countAllocation();
+    return(static_cast<pointer>(::operator new(n * sizeof(T))));
+  }
+  /// <summary>Releases memory for values, if it is not from an arena.
+  /// </summary>
+  ///
+  /// <param name="p">Memory to release.</param>
+  void deallocate( pointer p, size_type )
+  {
+    if (arena == 0)
+      ::operator delete(p);
+  }
+  /// <summary>Returns the largest number of values that can be allocated.
+  /// </summary>
+  ///
+  /// <returns>The largest number of values that can be allocated.
+  /// </returns>
+  size_type max_size() const
+  { return(static_cast<size_type>(-1) / sizeof(T)); }
+  /// <summary>Constructs a value.</summary>
+  ///
+  /// <param name="p">Where to construct the value.</param>
+  /// <param name="value">Value to copy.</param>
+  void construct( pointer p, const T& value ) { new(p) T(value); }
+  /// <summary>Destroys a value.</summary>
+  ///
+  /// <param name="p">Value to destroy.</param>
+  void destroy( pointer p ) { p->~T(); }
+  /// <summary>Returns the allocator for a copy of a container.</summary>
+  ///
+  /// <returns>An allocator using the current arena.</returns>
+  ArenaAllocator select_on_container_copy_construction() const
+  { return(ArenaAllocator()); }
+  /// <summary>Returns true if memory from one allocator can be released
+  /// by the other.</summary>
+  ///
+  /// <returns>True if both use the same arena.</returns>
+  template< class U >
+  bool operator==( const ArenaAllocator< U >& allocator ) const
+  { return(arena == allocator.arena); }
+  /// <summary>Returns true if memory from one allocator cannot be released
+  /// by the other.</summary>
+  ///
+  /// <returns>True if the allocators use different arenas.</returns>
+  template< class U >
+  bool operator!=( const ArenaAllocator< U >& allocator ) const
+  { return(arena != allocator.arena); }
+};
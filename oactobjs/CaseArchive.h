@@ -0,0 +1,311 @@
+// Declarations for the <see cref="CaseOArchive"/> and
+// <see cref="CaseIArchive"/> classes to save and restore the data of a case
+// with the serialize functions of its classes.
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/date_time/gregorian/greg_date.hpp"
+#include "boost/mpl/bool.hpp"
+#include "boost/serialization/access.hpp"
+#include "boost/serialization/extended_type_info_typeid.hpp"
+#include "boost/serialization/is_bitwise_serializable.hpp"
+#include "boost/serialization/void_cast.hpp"
+#include "boost/type_traits/is_enum.hpp"
+
+/// <summary>Saves objects to a compact binary string through their
+/// serialize functions.</summary>
+///
+/// <remarks>This is a minimal archive for the boost serialization hooks of
+/// the case data classes (see <see cref="PiaReadAny::saveCase"/>). Unlike
+/// the boost archives, it writes no class information, version numbers,
+/// or object tracking, so it can only be read by
+/// <see cref="CaseIArchive"/> in the same version of the program, and
+/// only for classes that are saved by value. Numbers, and classes marked
+/// with BOOST_IS_BITWISE_SERIALIZABLE, are written as their bytes, in the
+/// byte order of the machine. In arrays of them, runs of zeros are
+/// written as counts, since most of the years of an annual array are
+/// usually zero.</remarks>
+///
+/// <seealso cref="CaseIArchive"/>
+class CaseOArchive
+{
+public:
+  /// <summary>Indicates that this archive does not load.</summary>
+  typedef boost::mpl::bool_< false > is_loading;
+  /// <summary>Indicates that this archive saves.</summary>
+  typedef boost::mpl::bool_< true > is_saving;
+private:
+  /// <summary>Where to append the data.</summary>
+  std::string& buffer;
+public:
+  /// <summary>Starts an archive at the end of a string.</summary>
+  ///
+  /// <param name="newBuffer">Where to append the data.</param>
+  explicit CaseOArchive( std::string& newBuffer ) : buffer(newBuffer) { }
+  /// <summary>Saves one object.</summary>
+  ///
+  /// <returns>This archive.</returns>
+  ///
+  /// <param name="t">Object to save.</param>
+  template< class T >
+  CaseOArchive& operator&( const T& t ) { save(t); return(*this); }
+  /// <summary>Saves one object.</summary>
+  ///
+  /// <returns>This archive.</returns>
+  ///
+  /// <param name="t">Object to save.</param>
+  template< class T >
+  CaseOArchive& operator<<( const T& t ) { save(t); return(*this); }
+  /// <summary>Saves a number, an enum, or an object with a serialize
+  /// function.</summary>
+  ///
+  /// <param name="t">Object to save.</param>
+  template< class T >
+  void save( const T& t )
+  { saveValue(t, boost::mpl::bool_<
+    boost::serialization::is_bitwise_serializable< T >::value ||
+    boost::is_enum< T >::value >()); }
+  /// <summary>Saves an array.</summary>
+  ///
+  /// <param name="t">Array to save.</param>
+  template< class T, std::size_t N >
+  void save( const T (&t)[N] ) { saveArray(t, N); }
+  /// <summary>Saves a vector, with its size.</summary>
+  ///
+  /// <param name="t">Vector to save.</param>
+  template< class T, class A >
+  void save( const std::vector< T, A >& t )
+  { saveCount(t.size());
+    if (!t.empty())
+      saveArray(&t[0], t.size()); }
+  /// <summary>Saves a set of bits.</summary>
+  ///
+  /// <param name="t">Bits to save.</param>
+  template< std::size_t N >
+  void save( const std::bitset< N >& t )
+  { const std::size_t bits = std::numeric_limits< unsigned long >::digits;
+    const std::bitset< N > mask(~0ul);
+    for (std::size_t i = 0; i < N; i += bits) {
+      save(((t >> i) & mask).to_ulong());
+    } }
+  void save( const std::string& t );
+  void save( const boost::gregorian::date& t );
+  void saveCount( std::size_t count );
+private:
+  /// <summary>Saves an array of numbers or bitwise objects, writing runs
+  /// of zeros as counts.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void saveArray( const T *t, std::size_t count, boost::mpl::bool_< true > )
+  { const T zero = T();
+    std::size_t i = 0;
+    while (i < count) {
+      std::size_t zeros = 0;
+      while (i + zeros < count &&
+        std::memcmp(&t[i + zeros], &zero, sizeof(T)) == 0)
+        zeros++;
+      std::size_t values = 0;
+      while (i + zeros + values < count &&
+        std::memcmp(&t[i + zeros + values], &zero, sizeof(T)) != 0)
+        values++;
+      saveCount(zeros);
+      saveCount(values);
+      buffer.append(reinterpret_cast<const char *>(&t[i + zeros]),
+        values * sizeof(T));
+      i += zeros + values;
+    } }
+  /// <summary>Saves an array of objects one at a time.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void saveArray( const T *t, std::size_t count, boost::mpl::bool_< false > )
+  { for (std::size_t i = 0; i < count; i++)
+      save(t[i]); }
+  /// <summary>Saves an array.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void saveArray( const T *t, std::size_t count )
+  { saveArray(t, count, boost::mpl::bool_<
+    boost::serialization::is_bitwise_serializable< T >::value >()); }
+  /// <summary>Saves the bytes of a number, enum, or bitwise object.
+  /// </summary>
+  ///
+  /// <param name="t">Value to save.</param>
+  template< class T >
+  void saveValue( const T& t, boost::mpl::bool_< true > )
+  { buffer.append(reinterpret_cast<const char *>(&t), sizeof(T)); }
+  /// <summary>Saves an object with its serialize function.</summary>
+  ///
+  /// <param name="t">Object to save.</param>
+  template< class T >
+  void saveValue( const T& t, boost::mpl::bool_< false > )
+  { boost::serialization::access::serialize(*this, const_cast<T&>(t), 0u); }
+  CaseOArchive( const CaseOArchive& );
+  CaseOArchive& operator=( const CaseOArchive& );
+};
+
+/// <summary>Restores objects saved by <see cref="CaseOArchive"/> through
+/// their serialize functions.</summary>
+///
+/// <remarks>The objects must be restored in the same order and with the
+/// same types as they were saved.</remarks>
+///
+/// <seealso cref="CaseOArchive"/>
+class CaseIArchive
+{
+public:
+  /// <summary>Indicates that this archive loads.</summary>
+  typedef boost::mpl::bool_< true > is_loading;
+  /// <summary>Indicates that this archive does not save.</summary>
+  typedef boost::mpl::bool_< false > is_saving;
+private:
+  /// <summary>Next byte to read.</summary>
+  const char *next;
+  /// <summary>One past the last byte of the archive.</summary>
+  const char *end;
+public:
+  /// <summary>Starts reading an archive.</summary>
+  ///
+  /// <param name="begin">First byte of the archive.</param>
+  /// <param name="newEnd">One past the last byte of the archive.</param>
+  CaseIArchive( const char *begin, const char *newEnd ) :
+  next(begin), end(newEnd) { }
+  /// <summary>Restores one object.</summary>
+  ///
+  /// <returns>This archive.</returns>
+  ///
+  /// <param name="t">Object to restore.</param>
+  template< class T >
+  CaseIArchive& operator&( T& t ) { load(t); return(*this); }
+  /// <summary>Restores one object.</summary>
+  ///
+  /// <returns>This archive.</returns>
+  ///
+  /// <param name="t">Object to restore.</param>
+  template< class T >
+  CaseIArchive& operator>>( T& t ) { load(t); return(*this); }
+  /// <summary>Returns true if the whole archive has been read.</summary>
+  ///
+  /// <returns>True if the whole archive has been read.</returns>
+  bool atEnd() const { return(next == end); }
+  /// <summary>Restores a number, an enum, or an object with a serialize
+  /// function.</summary>
+  ///
+  /// <param name="t">Object to restore.</param>
+  template< class T >
+  void load( T& t )
+  { loadValue(t, boost::mpl::bool_<
+    boost::serialization::is_bitwise_serializable< T >::value ||
+    boost::is_enum< T >::value >()); }
+  /// <summary>Restores an array.</summary>
+  ///
+  /// <param name="t">Array to restore.</param>
+  template< class T, std::size_t N >
+  void load( T (&t)[N] ) { loadArray(t, N); }
+  /// <summary>Restores a vector, with its size.</summary>
+  ///
+  /// <param name="t">Vector to restore.</param>
+  template< class T, class A >
+  void load( std::vector< T, A >& t )
+  { t.resize(loadCount());
+    if (!t.empty())
+      loadArray(&t[0], t.size()); }
+  /// <summary>Restores a set of bits.</summary>
+  ///
+  /// <param name="t">Bits to restore.</param>
+  template< std::size_t N >
+  void load( std::bitset< N >& t )
+  { const std::size_t bits = std::numeric_limits< unsigned long >::digits;
+    t.reset();
+    for (std::size_t i = 0; i < N; i += bits) {
+      unsigned long word = 0ul;
+      load(word);
+      t |= std::bitset< N >(word) << i;
+    } }
+  void load( std::string& t );
+  void load( boost::gregorian::date& t );
+  /// <summary>Restores a count saved by
+  /// <see cref="CaseOArchive::saveCount"/>.</summary>
+  ///
+  /// <returns>The count.</returns>
+  std::size_t loadCount()
+  { if (next != end && static_cast<unsigned char>(*next) < 0x80u)
+      return(static_cast<unsigned char>(*next++));
+    return(loadLongCount()); }
+private:
+  static void fail();
+  std::size_t loadLongCount();
+  /// <summary>Takes the next bytes of the archive.</summary>
+  ///
+  /// <returns>The first of the bytes.</returns>
+  ///
+  /// <param name="size">Number of bytes.</param>
+  const char *take( std::size_t size )
+  { if (size > static_cast<std::size_t>(end - next))
+      fail();
+    const char *begin = next;
+    next += size;
+    return(begin); }
+  /// <summary>Restores an array of numbers or bitwise objects saved with
+  /// runs of zeros as counts.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void loadArray( T *t, std::size_t count, boost::mpl::bool_< true > )
+  { std::size_t i = 0;
+    while (i < count) {
+      const std::size_t zeros = loadCount();
+      const std::size_t values = loadCount();
+      if (zeros + values > count - i)
+        fail();
+      std::fill(t + i, t + i + zeros, T());
+      std::memcpy(&t[i + zeros], take(values * sizeof(T)),
+        values * sizeof(T));
+      i += zeros + values;
+    } }
+  /// <summary>Restores an array of objects one at a time.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void loadArray( T *t, std::size_t count, boost::mpl::bool_< false > )
+  { for (std::size_t i = 0; i < count; i++)
+      load(t[i]); }
+  /// <summary>Restores an array.</summary>
+  ///
+  /// <param name="t">First element of the array.</param>
+  /// <param name="count">Number of elements.</param>
+  template< class T >
+  void loadArray( T *t, std::size_t count )
+  { loadArray(t, count, boost::mpl::bool_<
+    boost::serialization::is_bitwise_serializable< T >::value >()); }
+  /// <summary>Restores the bytes of a number, enum, or bitwise object.
+  /// </summary>
+  ///
+  /// <param name="t">Value to restore.</param>
+  template< class T >
+  void loadValue( T& t, boost::mpl::bool_< true > )
+  { std::memcpy(&t, take(sizeof(T)), sizeof(T)); }
+  /// <summary>Restores an object with its serialize function.</summary>
+  ///
+  /// <param name="t">Object to restore.</param>
+  template< class T >
+  void loadValue( T& t, boost::mpl::bool_< false > )
+  { boost::serialization::access::serialize(*this, t, 0u); }
+  CaseIArchive( const CaseIArchive& );
+  CaseIArchive& operator=( const CaseIArchive& );
+};
@@ -0,0 +1,97 @@
+// Declarations for the <see cref="CaseCache"/> class to keep the cases of a
+// batch run in binary form from one run to the next.
+
+#pragma once
+
+#include <cstddef>
+#include <map>
+#include <string>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/iostreams/device/mapped_file.hpp"
+#include "boost/thread/mutex.hpp"
+
+/// <summary>Keeps the cases of a batch run in binary form in a file, so
+/// that a later run can restore the cases that have not changed without
+/// parsing them.</summary>
+///
+/// <remarks>Each case is found by the key of its text (see
+/// <see cref="PiaInputFile::getRecordKey"/>), so a case that changes gets
+/// a new key and is parsed again. A case is stored as the archive written
+/// by <see cref="PiaReadAny::saveCase"/>, and is added only after it has
+/// been read and has passed the data checks of the calculation.
+///
+/// The file is mapped into memory when the instance is created, and is
+/// only replaced by <see cref="save"/>, which writes the cases found or
+/// added in this run, so the file follows the input from one run to the
+/// next. Each archive has a checksum, and one that has been damaged is
+/// treated as not found. The file starts with a stamp of <see cref="ENGINE_VERSION"/> and
+/// of the settings that reading a case depends on; a file with another
+/// stamp, or that is not complete, is ignored and replaced, so a new
+/// version of the program never reads the cases of an old one.
+///
+/// Several threads may find and add cases at the same time.</remarks>
+///
+/// <seealso cref="PiaReadAny"/>
+class CaseCache
+{
+public:
+  /// <summary>Version of the stored cases.</summary>
+  ///
+  /// <remarks>Increase this when the data read from a case, or the
+  /// serialize function of any class it is stored in, changes.</remarks>
+  static const boost::uint32_t ENGINE_VERSION = 1u;
+private:
+  /// <summary>Where one case is stored in the file.</summary>
+  struct IndexEntry
+  {
+    /// <summary>Key of the case.</summary>
+    boost::uint64_t key;
+    /// <summary>Offset of the archive of the case from the start of the
+    /// file.</summary>
+    boost::uint64_t offset;
+    /// <summary>Size of the archive, in bytes.</summary>
+    boost::uint64_t size;
+    /// <summary>Checksum of the archive.</summary>
+    boost::uint64_t check;
+    /// <summary>Orders entries by key.</summary>
+    ///
+    /// <returns>True if this key is less than the other.</returns>
+    ///
+    /// <param name="other">Entry to compare to.</param>
+    bool operator<( const IndexEntry& other ) const
+    { return(key < other.key); }
+  };
+  /// <summary>Name of the file.</summary>
+  std::string fileName;
+  /// <summary>The mapped file, if it could be used.</summary>
+  boost::iostreams::mapped_file_source file;
+  /// <summary>Stamp of the version and settings of this run.</summary>
+  std::vector< boost::uint32_t > stamp;
+  /// <summary>Index of the cases in the file, sorted by key.</summary>
+  const IndexEntry *index;
+  /// <summary>Number of cases in the file.</summary>
+  std::size_t indexCount;
+  /// <summary>For each case in the file, nonzero if it was found in this
+  /// run.</summary>
+  std::vector< char > used;
+  /// <summary>Archives of the cases added in this run, by key.</summary>
+  std::map< boost::uint64_t, std::string > added;
+  /// <summary>Number of cases found in this run.</summary>
+  unsigned long hits;
+  /// <summary>Lock for the cases found and added.</summary>
+  boost::mutex mutex;
+public:
+  CaseCache( const std::string& newFileName, int baseYear );
+  ~CaseCache();
+  bool find( boost::uint64_t key, const char *& begin, const char *& end );
+  unsigned long getAddedCount();
+  unsigned long getHitCount();
+  void insert( boost::uint64_t key, const std::string& archive );
+  void save();
+private:
+  void open();
+  static boost::uint64_t checksum( const char *begin, const char *end );
+  CaseCache( const CaseCache& );
+  CaseCache& operator=( const CaseCache& );
+};
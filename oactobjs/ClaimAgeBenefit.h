@@ -0,0 +1,42 @@
+// Declarations for the <see cref="ClaimAgeBenefit"/> class to hold the
+// benefit for one month of entitlement in a claim-age sweep.
+
+#pragma once
+
+#include "datemoyr.h"
+#include "age.h"
+#include "BenefitAmount.h"
+
+/// <summary>Holds the old-age benefit for one month of entitlement, as
+/// calculated by <see cref="PiaCalAny::claimAgeSweep"/>.</summary>
+///
+/// <remarks>The benefit date is the same as the month of entitlement.
+/// </remarks>
+///
+/// <seealso cref="PiaCalAny"/>
+class ClaimAgeBenefit
+{
+public:
+  /// <summary>Month of entitlement.</summary>
+  DateMoyr entDate;
+  /// <summary>Age at entitlement.</summary>
+  Age ageEnt;
+  /// <summary>Number of months of actuarial reduction (if entitlement is
+  /// before full retirement age) or of delayed retirement credit (if
+  /// after).</summary>
+  int monthsArdri;
+  /// <summary>Actuarial reduction factor, or delayed retirement credit
+  /// increment factor.</summary>
+  double arf;
+  /// <summary>PIA at entitlement.</summary>
+  BenefitAmount pia;
+  /// <summary>Benefit before rounding to a whole dollar.</summary>
+  BenefitAmount unroundedBenefit;
+  /// <summary>Benefit rounded to a whole dollar (if June 1982 or later).
+  /// </summary>
+  BenefitAmount roundedBenefit;
+public:
+  /// <summary>Initializes all values to zero.</summary>
+  ClaimAgeBenefit() : entDate(), ageEnt(), monthsArdri(0), arf(0.0), pia(),
+    unroundedBenefit(), roundedBenefit() { }
+};
@@ -0,0 +1,238 @@
+// Declarations for the <see cref="CohortBatch"/> class to calculate the
+// old-age pias of a cohort of workers at once.
+
+#pragma once
+
+#include <vector>
+#include "boost/date_time/gregorian/greg_date.hpp"
+#include "datemoyr.h"
+class DoubleAnnual;
+class PiaParams;
+
+/// <summary>Calculates the quarters of coverage, insured status, AIME, and
+/// wage-indexed pia of a cohort of old-age workers, who have the same date
+/// of birth, date of entitlement, and benefit date.</summary>
+///
+/// <remarks>Everything about the calculation that depends only on those
+/// dates (year of eligibility, required quarters of coverage, computation
+/// years, bend points and percentages, average wages, and benefit
+/// increases) is found once for the cohort. The earnings and quarters of
+/// coverage are stored by year, with the amounts for all of the workers in
+/// one year side by side, so each step is done by one loop over the
+/// workers for each year, as in <see cref="WageIndBatch"/> (whose loop is
+/// used for the indexing). Each amount is calculated with the same
+/// operations, in the same order, as <see cref="PiaData::qcCal"/>,
+/// <see cref="PiaCal::insCal"/>, <see cref="PiaCal::nCal"/>, and
+/// <see cref="WageInd::calculate"/>, so the results are identical to those
+/// of the per-worker calculation.
+///
+/// The workers have OASDI earnings from 1951, and quarters of coverage
+/// before 1978 given as totals (as in
+/// <see cref="WorkerDataGeneral::getQctottd"/> and
+/// <see cref="WorkerDataGeneral::getQctot51td"/>); they have no earnings
+/// before 1951, period of disability, totalization, military service,
+/// railroad service, or noncovered pension. A worker whose pia may come from
+/// another method is marked (see <see cref="needsWorkerCalculation"/>), and
+/// should be calculated one at a time with <see cref="PiaCal"/>: that is
+/// every worker if the year of eligibility is before 1984 (the pia table,
+/// transitional guarantee, and frozen minimum), a worker with quarters of
+/// coverage before 1951 (old-start), and a worker whose special minimum pia
+/// is at least the wage-indexed pia.
+///
+/// To use a batch, call <see cref="CohortBatch::clear"/> with the dates of
+/// the cohort, <see cref="CohortBatch::add"/> for each worker (or for a
+/// block of workers), and <see cref="CohortBatch::calculate"/>; then the
+/// results of each worker may be read.</remarks>
+///
+/// <seealso cref="WageIndBatch"/>
+class CohortBatch
+{
+public:
+  /// <summary>First year of earnings stored.</summary>
+  static const int FIRST_YEAR = 1951;
+  /// <summary>First year of quarters of coverage calculated from earnings.
+  /// </summary>
+  static const int FIRST_QC_YEAR = 1978;
+private:
+  /// <summary>Benefit calculation parameters.</summary>
+  const PiaParams& piaParams;
+  /// <summary>Last year of earnings stored.</summary>
+  const int lastYear;
+  /// <summary>Maximum number of workers.</summary>
+  const unsigned capacity;
+  /// <summary>Number of amounts stored for each year (capacity rounded up
+  /// to a multiple of 8).</summary>
+  const unsigned stride;
+  /// <summary>Number of workers added.</summary>
+  unsigned workerCount;
+  /// <summary>Date of birth of the cohort.</summary>
+  boost::gregorian::date birthDate;
+  /// <summary>Date of entitlement of the cohort.</summary>
+  DateMoyr entDate;
+  /// <summary>Benefit date of the cohort.</summary>
+  DateMoyr benefitDate;
+  /// <summary>Year of eligibility.</summary>
+  int eligYear;
+  /// <summary>Quarters of coverage required for fully insured status.
+  /// </summary>
+  int qcReq;
+  /// <summary>Number of computation years.</summary>
+  int compYears;
+  /// <summary>OASDI earnings, by year and worker.</summary>
+  std::vector< double > earnings;
+  /// <summary>Indexed earnings limited to the wage base, by year and
+  /// worker.</summary>
+  std::vector< double > earnIndexed;
+  /// <summary>Quarters of coverage from 1978, by year and worker.</summary>
+  std::vector< unsigned char > qcs;
+  /// <summary>Quarters of coverage before 1951, by worker.</summary>
+  std::vector< int > qcTotal50;
+  /// <summary>Quarters of coverage from 1951 through 1977, by worker.
+  /// </summary>
+  std::vector< int > qcTotal5177;
+  /// <summary>Total quarters of coverage through the quarter of
+  /// entitlement, by worker.</summary>
+  std::vector< int > qcTotal;
+  /// <summary>AIME, by worker.</summary>
+  std::vector< double > aime;
+  /// <summary>Pia at eligibility, by worker.</summary>
+  std::vector< double > piaElig;
+  /// <summary>Pia at the benefit date, by worker.</summary>
+  std::vector< double > piaBen;
+  /// <summary>Years of coverage for the special minimum, by worker.
+  /// </summary>
+  std::vector< int > specMinYears;
+  /// <summary>1 if the worker needs the per-worker calculation, by worker.
+  /// </summary>
+  std::vector< unsigned char > fallback;
+  /// <summary>True if the workers added have been calculated.</summary>
+  bool calculated;
+public:
+  CohortBatch( const PiaParams& newPiaParams, int newLastYear,
+    unsigned newCapacity );
+  ~CohortBatch();
+  unsigned add( const DoubleAnnual& newEarnings, int newQcTotal50,
+    int newQcTotal5177 );
+  unsigned add( unsigned count, const double newEarnings[],
+    const int newQcTotal50[], const int newQcTotal5177[] );
+  void calculate();
+  void clear( const boost::gregorian::date& newBirthDate,
+    const DateMoyr& newEntDate, const DateMoyr& newBenefitDate );
+  /// <summary>Returns the AIME of one worker.</summary>
+  ///
+  /// <returns>The AIME of one worker.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  double getAime( unsigned worker ) const { return(aime[worker]); }
+  /// <summary>Returns the maximum number of workers.</summary>
+  ///
+  /// <returns>The maximum number of workers.</returns>
+  unsigned getCapacity() const { return(capacity); }
+  /// <summary>Returns the number of computation years.</summary>
+  ///
+  /// <returns>The number of computation years.</returns>
+  int getCompYears() const { return(compYears); }
+  /// <summary>Returns the year of eligibility.</summary>
+  ///
+  /// <returns>The year of eligibility.</returns>
+  int getEligYear() const { return(eligYear); }
+  /// <summary>Returns indexed earnings of one worker, limited to the wage
+  /// base.</summary>
+  ///
+  /// <returns>Indexed earnings of one worker (unindexed after the indexing
+  /// year).</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="year">Year of earnings (no later than the year before
+  /// the benefit date).</param>
+  double getEarnIndexed( unsigned worker, int year ) const
+  { return(earnIndexed[(year - FIRST_YEAR) * stride + worker]); }
+  /// <summary>Returns the last year of earnings stored.</summary>
+  ///
+  /// <returns>The last year of earnings stored.</returns>
+  int getLastYear() const { return(lastYear); }
+  /// <summary>Returns the pia at the benefit date of one worker.</summary>
+  ///
+  /// <returns>The wage-indexed pia at the benefit date.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  double getPiaBen( unsigned worker ) const { return(piaBen[worker]); }
+  /// <summary>Returns the pia at eligibility of one worker.</summary>
+  ///
+  /// <returns>The wage-indexed pia at eligibility.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  double getPiaElig( unsigned worker ) const { return(piaElig[worker]); }
+  /// <summary>Returns the quarters of coverage of one worker in one year.
+  /// </summary>
+  ///
+  /// <returns>The quarters of coverage of one worker in one year.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="year">Year of earnings (from 1978 through the year of
+  /// entitlement).</param>
+  unsigned getQcs( unsigned worker, int year ) const
+  { return(qcs[(year - FIRST_QC_YEAR) * stride + worker]); }
+  /// <summary>Returns the quarters of coverage required for fully insured
+  /// status.</summary>
+  ///
+  /// <returns>The quarters of coverage required for fully insured status.
+  /// </returns>
+  int getQcReq() const { return(qcReq); }
+  /// <summary>Returns the total quarters of coverage of one worker through
+  /// the quarter of entitlement.</summary>
+  ///
+  /// <returns>The total quarters of coverage of one worker.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  int getQcTotal( unsigned worker ) const { return(qcTotal[worker]); }
+  /// <summary>Returns the years of coverage of one worker for the special
+  /// minimum.</summary>
+  ///
+  /// <returns>The years of coverage of one worker.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  int getSpecMinYears( unsigned worker ) const
+  { return(specMinYears[worker]); }
+  /// <summary>Returns the number of workers added.</summary>
+  ///
+  /// <returns>The number of workers added.</returns>
+  unsigned getWorkerCount() const { return(workerCount); }
+  /// <summary>Returns true if the workers added have been calculated.
+  /// </summary>
+  ///
+  /// <returns>True if the workers have been calculated.</returns>
+  bool isCalculated() const { return(calculated); }
+  /// <summary>Returns true if one worker is fully insured at entitlement.
+  /// </summary>
+  ///
+  /// <returns>True if the worker is fully insured.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  bool isFullyInsured( unsigned worker ) const
+  { return(qcTotal[worker] >= qcReq); }
+  /// <summary>Returns true if one worker must be calculated by itself,
+  /// because another method may apply.</summary>
+  ///
+  /// <returns>True if the worker needs the per-worker calculation.
+  /// </returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  bool needsWorkerCalculation( unsigned worker ) const
+  { return(fallback[worker] != 0); }
+private:
+  void qcCal();
+  void piaCal();
+  void specMinCal();
+  CohortBatch( const CohortBatch& );
+  CohortBatch& operator=( const CohortBatch& );
+};
@@ -0,0 +1,78 @@
+// Declarations for the <see cref="ColaTable"/> class to apply a range of
+// benefit increases from precomputed factors.
+
+#pragma once
+
+#include <vector>
+#include "cachup.h"
+class DoubleAnnual;
+
+/// <summary>Holds the factors for the benefit increases of each year, so
+/// that a range of increases can be applied to a pia or mfb without looking
+/// up the increases again.</summary>
+///
+/// <remarks>Each benefit increase is rounded as it is applied, so the
+/// increases from one year to another cannot be combined into one factor
+/// without changing the result. This table holds, for each year, the
+/// factor for the increase, the factor for removing it, and the catch-up
+/// factor for each year of eligibility that has one, computed by the same
+/// expressions as <see cref="BenefitAmount::applyCola"/>,
+/// <see cref="BenefitAmount::unApplyCola"/>,
+/// <see cref="PiaParams::benincCatchUp"/>, and
+/// <see cref="PiaParams::unbiCatchUp"/>, so the amounts calculated from it
+/// are exactly the same as applying the increases one at a time.
+///
+/// The table is built by <see cref="PiaParams::updateCpiinc"/> and
+/// cleared by <see cref="PiaParams::setData"/>; it does not change between
+/// those calls, so any number of threads may read it.</remarks>
+///
+/// <seealso cref="PiaParams"/>
+class ColaTable
+{
+private:
+  /// <summary>First year in the table.</summary>
+  int firstYear;
+  /// <summary>Last year in the table (less than firstYear if empty).
+  /// </summary>
+  int lastYear;
+  /// <summary>First year of eligibility with catch-up increases.</summary>
+  int catchupStart;
+  /// <summary>Factor for the benefit increase of each year.</summary>
+  std::vector< double > factors;
+  /// <summary>Factor for removing the benefit increase of each year.
+  /// </summary>
+  std::vector< double > unFactors;
+  /// <summary>Catch-up factor for each year of eligibility (by row) and
+  /// year of increase (by column), or 0 if there is none.</summary>
+  std::vector< double > catchupFactors;
+  /// <summary>Factor for the special 1999 increase (with the extra 0.1
+  /// percent).</summary>
+  double factor99;
+  /// <summary>Factor for removing the special 1999 increase.</summary>
+  double unFactor99;
+public:
+  ColaTable();
+  double apply( DoubleAnnual& amounts, int year1, int year3, int eligYear,
+    bool cola99 ) const;
+  void build( const DoubleAnnual& cpiinc, const Catchup& catchup );
+  void clear();
+  /// <summary>Returns true if the table has been built.</summary>
+  ///
+  /// <returns>True if the table has been built.</returns>
+  bool isBuilt() const { return(lastYear >= firstYear); }
+  double unApply( double amount, int year1, int year3, int eligYear,
+    bool cola99 ) const;
+private:
+  /// <summary>Returns the catch-up factor for a year of eligibility and
+  /// year of increase.</summary>
+  ///
+  /// <returns>The catch-up factor, or 0 if there is none.</returns>
+  ///
+  /// <param name="eligYear">Year of eligibility.</param>
+  /// <param name="year">Year of increase.</param>
+  double getCatchupFactor( int eligYear, int year ) const
+  { const int row = eligYear - catchupStart;
+    return((row >= 0 && row < Catchup::NUM_CATCHUP_ELIG_YEARS) ?
+    catchupFactors[row * (lastYear - firstYear + 1) + year - firstYear] :
+    0.0); }
+};
@@ -0,0 +1,85 @@
+// Declarations for the <see cref="DateIndex"/> class to manage a date as a
+// month index and day of month.
+
+#pragma once
+
+#include "datemoyr.h"
+#include "boost/date_time/gregorian/greg_date.hpp"
+class Age;
+
+/// <summary>Manages a date as a count of months and a day of the month, so
+/// ages and dates at an age are found by integer arithmetic.</summary>
+///
+/// <remarks>Each call to the year, month, or day of a
+/// <c>boost::gregorian::date</c> converts its day number to a calendar
+/// date, and so do conversions to <see cref="DateMoyr"/>. A date that the
+/// calculation uses over and over (such as the day before a worker's birth,
+/// see <see cref="PiaData::getBirthIndexMinus1"/>) is converted once to a
+/// <see cref="DateIndex"/>; its year and month, the months between it and
+/// another date, and the month at which some age is attained are then found
+/// without converting again. The month index is 12 times the year plus the
+/// month less 1. The day of the month is zero for a date made from a
+/// <see cref="DateMoyr"/>, so it sorts before any day of that month. If the
+/// date is not set (tested by <see cref="DateIndex::isNotADate"/>), the
+/// month index and day are both zero.</remarks>
+///
+/// <seealso cref="DateMoyr"/>
+class DateIndex
+{
+private:
+  /// <summary>12 times the year plus the month less 1.</summary>
+  int monthIndex;
+  /// <summary>Day of the month (1-31, or 0 for a month and year).
+  /// </summary>
+  int dayOfMonth;
+public:
+  /// <summary>Initializes the month index and day to zero.</summary>
+  DateIndex() : monthIndex(0), dayOfMonth(0) { }
+  DateIndex( const boost::gregorian::date& date );
+  DateIndex( const DateMoyr& dateMoyr );
+  /// <summary>Initializes the date from specified values.</summary>
+  ///
+  /// <param name="newMonth">Month of year (1-12).</param>
+  /// <param name="newDay">Day of month (1-31).</param>
+  /// <param name="newYear">Year.</param>
+  DateIndex( int newMonth, int newDay, int newYear ) :
+    monthIndex(12 * newYear + newMonth - 1), dayOfMonth(newDay) { }
+  bool operator<( const DateIndex& dateIndex ) const;
+  /// <summary>Compares this date to another one.</summary>
+  ///
+  /// <returns>True if this date equals argument date.</returns>
+  ///
+  /// <param name="dateIndex">The date to compare to.</param>
+  bool operator==( const DateIndex& dateIndex ) const
+  { return(monthIndex == dateIndex.monthIndex &&
+    dayOfMonth == dateIndex.dayOfMonth); }
+  DateIndex operator+( const Age& age ) const;
+  Age operator-( const DateIndex& dateIndex ) const;
+  /// <summary>Returns the day of the month.</summary>
+  ///
+  /// <returns>The day of the month (1-31, or 0 for a month and year).
+  /// </returns>
+  int getDay() const { return(dayOfMonth); }
+  /// <summary>Returns the month of the year.</summary>
+  ///
+  /// <returns>The month of the year (1-12).</returns>
+  unsigned getMonth() const
+  { return(static_cast<unsigned>(monthIndex % 12) + 1u); }
+  /// <summary>Returns the month index.</summary>
+  ///
+  /// <returns>12 times the year plus the month less 1.</returns>
+  int getMonthIndex() const { return(monthIndex); }
+  /// <summary>Returns the year.</summary>
+  ///
+  /// <returns>The year.</returns>
+  int getYear() const { return(monthIndex / 12); }
+  /// <summary>Returns true if the date has never been set.</summary>
+  ///
+  /// <returns>True if the month index and day are both zero.</returns>
+  bool isNotADate() const { return(monthIndex == 0 && dayOfMonth == 0); }
+  /// <summary>Returns the month and year of this date.</summary>
+  ///
+  /// <returns>The month and year of this date.</returns>
+  DateMoyr toDateMoyr() const
+  { return(DateMoyr(getMonth(), static_cast<unsigned>(getYear()))); }
+};
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include "boost/serialization/access.hpp"
 #include "avgwg.h"
 #include "intann.h"
 #include "oactcnst.h"
@@ -18,6 +19,21 @@ class WorkerDataGeneral;
 /// </remarks>
 class EarnProject
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+  { ar & earnpebs & earntype & firstYear & lastYear & projback & percback;
+    ar & projfwrd & percfwrd; }
 public:
   /// <summary>Type of earnings.</summary>
   enum earn_type {
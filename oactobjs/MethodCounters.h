@@ -0,0 +1,119 @@
+// Declarations for the <see cref="MethodCounters"/> class to count the
+// calls of each pia calculation method and the time spent in them.
+
+#pragma once
+
+#include <iosfwd>
+#include "boost/cstdint.hpp"
+#include "PiaMethod.h"
+
+/// <summary>Counts the calls of each pia calculation method, how often each
+/// gives the highest pia, and the time spent in each, with a histogram of
+/// the times.</summary>
+///
+/// <remarks>The calculation classes count nothing unless they are given an
+/// instance of this class (see <see cref="PiaCal::setMethodCounters"/>), so
+/// the cost when counting is off is one test of a null pointer per method.
+/// When counting is on, each method costs two reads of the steady clock and
+/// a few additions; no strings are built and nothing is written.
+///
+/// An instance is not locked, so each thread must have its own. Instances
+/// for several threads are combined with operator+=.
+///
+/// A method is called only if it is applicable to the case, so the
+/// applicability rate of a method is its number of calls divided by the
+/// number of pia calculations. The re-indexed widow(er) method is called
+/// once for each applicable widow(er), so its rate can exceed 1.
+///
+/// The times are in nanoseconds. Bucket 0 of the histogram counts times
+/// under 256 nanoseconds, bucket i (for i from 1) counts times from 2^(i+7)
+/// up to 2^(i+8) nanoseconds, and the last bucket counts all longer times.
+/// </remarks>
+///
+/// <seealso cref="PiaCal"/>
+/// <seealso cref="StageTimes"/>
+class MethodCounters
+{
+public:
+  /// <summary>Number of buckets in each histogram.</summary>
+  static const int NUM_BUCKETS = 20;
+  /// <summary>Times one call of a pia calculation method, from its
+  /// construction to its destruction.</summary>
+  ///
+  /// <remarks>Nothing is timed if the <see cref="MethodCounters"/> pointer
+  /// is null.</remarks>
+  class Timer
+  {
+  private:
+    /// <summary>Where to add the call (may be null).</summary>
+    MethodCounters *methodCounters;
+    /// <summary>Method being timed.</summary>
+    PiaMethod::pia_type method;
+    /// <summary>Time at construction, in nanoseconds.</summary>
+    boost::uint64_t start;
+  public:
+    Timer( MethodCounters *newMethodCounters,
+      PiaMethod::pia_type newMethod );
+    ~Timer();
+  private:
+    Timer( const Timer& );
+    Timer& operator=( const Timer& );
+  };
+private:
+  /// <summary>Number of pia calculations.</summary>
+  unsigned long calculations;
+  /// <summary>Number of calls of each method.</summary>
+  unsigned long calls[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Number of times each method gave the highest pia.</summary>
+  unsigned long highPia[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Nanoseconds spent in each method.</summary>
+  boost::uint64_t nanoseconds[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Number of calls of each method, by bucket of time.</summary>
+  unsigned long histogram[PiaMethod::NO_PIA_TYPE][NUM_BUCKETS];
+public:
+  MethodCounters();
+  MethodCounters& operator+=( const MethodCounters& methodCounters );
+  void add( PiaMethod::pia_type method, boost::uint64_t time );
+  void addCalculation( const PiaMethod *highPiaMethod );
+  void clear();
+  /// <summary>Returns the number of calls of a method in one bucket of
+  /// time.</summary>
+  ///
+  /// <returns>The number of calls of a method in one bucket of time.
+  /// </returns>
+  ///
+  /// <param name="method">The method.</param>
+  /// <param name="bucket">Number of bucket.</param>
+  unsigned long getBucketCount( PiaMethod::pia_type method,
+    int bucket ) const { return(histogram[method][bucket]); }
+  /// <summary>Returns the number of pia calculations.</summary>
+  ///
+  /// <returns>The number of pia calculations.</returns>
+  unsigned long getCalculations() const { return(calculations); }
+  /// <summary>Returns the number of calls of a method.</summary>
+  ///
+  /// <returns>The number of calls of a method.</returns>
+  ///
+  /// <param name="method">The method.</param>
+  unsigned long getCalls( PiaMethod::pia_type method ) const
+  { return(calls[method]); }
+  /// <summary>Returns the number of times a method gave the highest pia.
+  /// </summary>
+  ///
+  /// <returns>The number of times a method gave the highest pia.</returns>
+  ///
+  /// <param name="method">The method.</param>
+  unsigned long getHighPia( PiaMethod::pia_type method ) const
+  { return(highPia[method]); }
+  /// <summary>Returns the nanoseconds spent in a method.</summary>
+  ///
+  /// <returns>The nanoseconds spent in a method.</returns>
+  ///
+  /// <param name="method">The method.</param>
+  boost::uint64_t getNanoseconds( PiaMethod::pia_type method ) const
+  { return(nanoseconds[method]); }
+  void write( std::ostream& out ) const;
+  static int bucketCal( boost::uint64_t time );
+  static boost::uint64_t getBucketLimit( int bucket );
+  static boost::uint64_t now();
+};
@@ -0,0 +1,84 @@
+// Declarations for the <see cref="MethodPool"/> class to calculate the pia
+// calculation methods of one case on several threads.
+
+#pragma once
+
+#include <stdexcept>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/shared_ptr.hpp"
+#include "boost/thread/condition_variable.hpp"
+#include "boost/thread/mutex.hpp"
+#include "boost/thread/thread.hpp"
+class PiaMethod;
+class PiaException;
+
+/// <summary>Calculates the pia calculation methods of one case at the same
+/// time, on a fixed set of threads.</summary>
+///
+/// <remarks>The methods applicable to a case read the worker's data and the
+/// parameters, which do not change during the calculation, and write only
+/// their own members, so they can be calculated in any order. The thread
+/// that calls <see cref="calculate"/> also calculates methods, and returns
+/// when all are done; the selection of the highest pia is then done by the
+/// caller as usual, so the results are the same as calculating the methods
+/// one at a time.
+///
+/// If any methods throw an exception, all methods are still calculated, and
+/// the exception of the first one in the order given is rethrown, so the
+/// error reported is the same as when the methods are calculated one at a
+/// time.
+///
+/// Handing a method to another thread costs a few microseconds, so this is
+/// worthwhile only when there are several expensive methods, such as a case
+/// with several re-indexed widow(er)s, and there are idle processors. An
+/// instance may be used by one calculation at a time.</remarks>
+///
+/// <seealso cref="PiaCal"/>
+class MethodPool
+{
+private:
+  /// <summary>Threads that calculate methods.</summary>
+  boost::thread_group threads;
+  /// <summary>Protects the fields of the current request.</summary>
+  boost::mutex mutex;
+  /// <summary>Signals the threads that there is work, or that they should
+  /// stop.</summary>
+  boost::condition_variable work;
+  /// <summary>Signals the caller that all methods are done.</summary>
+  boost::condition_variable done;
+  /// <summary>Methods of the current request (null if none).</summary>
+  const std::vector< PiaMethod* > *methods;
+  /// <summary>Nanoseconds spent in each method of the current request.
+  /// </summary>
+  std::vector< boost::uint64_t > *times;
+  /// <summary>Exception thrown by each method, if a
+  /// <see cref="PiaException"/>.</summary>
+  std::vector< boost::shared_ptr< PiaException > > piaErrors;
+  /// <summary>Exception thrown by each method, if of another type.
+  /// </summary>
+  std::vector< boost::shared_ptr< std::runtime_error > > otherErrors;
+  /// <summary>Index of the next method to calculate.</summary>
+  size_t next;
+  /// <summary>Number of methods not yet done.</summary>
+  size_t remaining;
+  /// <summary>Number of threads.</summary>
+  unsigned threadCount;
+  /// <summary>True when the threads should stop.</summary>
+  bool stopping;
+public:
+  explicit MethodPool( unsigned newThreadCount );
+  ~MethodPool();
+  void calculate( const std::vector< PiaMethod* >& newMethods,
+    std::vector< boost::uint64_t >& newTimes );
+  /// <summary>Returns the number of threads, not counting the caller.
+  /// </summary>
+  ///
+  /// <returns>The number of threads, not counting the caller.</returns>
+  unsigned getThreadCount() const { return(threadCount); }
+private:
+  void calculateOne( size_t index );
+  void workLoop();
+  MethodPool( const MethodPool& );
+  MethodPool& operator=( const MethodPool& );
+};
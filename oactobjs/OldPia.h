@@ -6,6 +6,7 @@
 #pragma once
 
 #include "PiaMethod.h"
+#include "AmeIndex.h"
 
 /// <summary>Parent of all methods using pia tables in the calculation of a
 /// Social Security benefit.</summary>
@@ -30,6 +31,7 @@ public:
     double amesub, bool saveInfo );
   double mfbOldCal( bool belowMin );
   table_type oldPiaCal();
+  void oldTablePia( int amesub );
   table_type pl1952( int amesub );
   table_type pl1954( int amesub );
   table_type pl1958( int amesub );
@@ -41,5 +43,6 @@ public:
   void pl1973( int amesub );
   void pl1973ext( int amesub );
 private:
+  AmeIndex::Key ameIndexKey() const;
   OldPia& operator=( OldPia& newOldPia );
 };
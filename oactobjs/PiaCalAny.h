@@ -5,18 +5,34 @@
 
 #pragma once
 
+#include <vector>
+#include "boost/shared_ptr.hpp"
 #include "PiaCalLC.h"
 #include "pebs.h"
 class PiaParamsAny;
 class EarnProject;
 class UserAssumptions;
 class Assumptions;
+class ClaimAgeBenefit;
 
 /// <summary>Manages the additional functions required for calculation of a
 /// Social Security benefit in the Anypia program.</summary>
 ///
 /// <remarks>An instance of this class is created in the Anypia program.
-/// </remarks>
+///
+/// An instance may also be created with a read-only snapshot of the
+/// parameters from a <see cref="PiaParamsCache"/>, which may be shared with
+/// instances on other threads. The snapshot is already projected for one set
+/// of assumptions, so <see cref="calculate1"/> does not change it.
+///
+/// <see cref="claimAgeSweep"/> calculates the old-age benefit for every
+/// month of entitlement from age 62 through age 70.
+///
+/// Several instances may be bound to the same case data with different law
+/// changes. Once one of them has called <see cref="calculate2"/>, the
+/// others can call <see cref="calculate2Projected"/>, which uses the
+/// projected earnings already in the case data instead of projecting them
+/// again.</remarks>
 class PiaCalAny : public PiaCalLC
 {
 public:
@@ -31,8 +47,14 @@ public:
   /// <summary>User-specified assumptions.</summary>
   UserAssumptions& userAssumptions;
 private:
+  /// <summary>Shared snapshot of the parameters, if any (held so that it
+  /// stays valid while this instance uses it).</summary>
+  boost::shared_ptr< const PiaParamsAny > snapshot;
   /// <summary>Pia calculation parameters.</summary>
-  PiaParamsAny& piaParamsAny;
+  const PiaParamsAny& piaParamsAny;
+  /// <summary>Pia calculation parameters to update with the assumptions;
+  /// null if the parameters are a shared snapshot.</summary>
+  PiaParamsAny *piaParamsUpdate;
   /// <summary>Statement data.</summary>
   Pebs& pebs;
 public:
@@ -41,14 +63,31 @@ public:
     PiaParamsAny& newPiaParamsAny, UserAssumptions& newUserAssumptions,
     SecondaryArray& newSecondary, const LawChangeArray& newLawChange,
     Pebs& newPebs, EarnProject& newEarnProject );
+  PiaCalAny( WorkerDataGeneral& newWorkerData, PiaData& newPiaData,
+    WorkerDataArray& newWidowDataArray, PiaDataArray& newWidowArray,
+    const boost::shared_ptr< const PiaParamsAny >& newSnapshot,
+    UserAssumptions& newUserAssumptions, SecondaryArray& newSecondary,
+    const LawChangeArray& newLawChange, Pebs& newPebs,
+    EarnProject& newEarnProject );
   ~PiaCalAny();
   void calculate1( Assumptions& assumptions );
   void calculate2( const DateMoyr& entDate );
+  void calculate2Projected( const DateMoyr& entDate );
+  void claimAgeSweep( std::vector< ClaimAgeBenefit >& results );
   void dataCheck( const DateMoyr& entDate );
   void earnProjection() const;
   void earnProSteady();
   void pebsOabCal();
   void pebsSetup( Pebs::pebes_type type, const DateMoyr& entDate );
 private:
+  void claimAgeBenefitCal( ClaimAgeBenefit& result,
+    std::vector< double >& piaEnt );
+  void claimAgeDatesRestore( const DateMoyr& entDate,
+    const DateMoyr& benefitDate );
+  int claimAgeGroup( const DateMoyr& entDate, int lastEarnYear,
+    bool reuseColas ) const;
+  void claimAgeGroupsCal( std::vector< ClaimAgeBenefit >& results,
+    int lastEarnYear, bool reuseColas, std::vector< double >& piaEnt );
+  static double piaInYear( const PiaMethod& method, int year );
   PiaCalAny operator=( PiaCalAny newPiaCalAny );
 };
@@ -0,0 +1,102 @@
+// Declarations for the <see cref="PiaColumnConvert"/> class to convert
+// between multi-record pia files and columnar population files.
+
+#pragma once
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "wrkrdata.h"
+#include "WorkerDataArray.h"
+#include "PiadataArray.h"
+#include "SecondaryArray.h"
+#include "UserAssumptions.h"
+#include "piaread.h"
+#include "PiaColumnRecord.h"
+class PiaMappedFile;
+class PiaColumnFile;
+class PiaColumnWrite;
+
+/// <summary>Converts cases between a multi-record pia file and a columnar
+/// population file.</summary>
+///
+/// <remarks>Each case of a pia file is first read with
+/// <see cref="PiaRead"/>, so the values stored in columns are the values
+/// that reading the text would set, and a case that cannot be read is left
+/// to report its error when it is calculated. Lines that are not stored in
+/// columns (military service dates, name and address, assumptions, and
+/// railroad data) are kept as text with the case. A case is kept entirely
+/// as text if it uses lines that only a subclass of <see cref="PiaRead"/>
+/// understands (such as Social Security Statement data), if its lines are
+/// not in increasing order, or if it cannot be read.
+///
+/// Converting a columnar file back to a pia file writes the lines stored
+/// in columns as <see cref="PiaWrite"/> does, and the lines kept as text
+/// unchanged.
+///
+/// <see cref="WorkerDataGeneral::setMaxyear"/> must have been called before
+/// an instance is created.</remarks>
+///
+/// <seealso cref="PiaColumnFile"/>
+/// <seealso cref="PiaColumnWrite"/>
+class PiaColumnConvert
+{
+private:
+  /// <summary>Worker data of the case being converted.</summary>
+  WorkerData workerData;
+  /// <summary>Family member worker data of the case being converted.
+  /// </summary>
+  WorkerDataArray widowDataArray;
+  /// <summary>Family member calculation data of the case being converted.
+  /// </summary>
+  PiaDataArray widowArray;
+  /// <summary>Family member benefit data of the case being converted.
+  /// </summary>
+  SecondaryArray secondaryArray;
+  /// <summary>User assumptions of the case being converted.</summary>
+  UserAssumptions userAssumptions;
+  /// <summary>Reader of the case being converted.</summary>
+  PiaRead piaRead;
+  /// <summary>Social Security number of the case being converted.
+  /// </summary>
+  std::string ssn;
+  /// <summary>Lines of the case kept as text.</summary>
+  std::string text;
+  /// <summary>OASDI earnings of the case being converted.</summary>
+  std::vector< double > earnOasdi;
+  /// <summary>Medicare earnings of the case being converted.</summary>
+  std::vector< double > earnHi;
+  /// <summary>Types of taxes of the case being converted.</summary>
+  std::vector< unsigned char > taxType;
+  /// <summary>Annual quarters of coverage of the case being converted.
+  /// </summary>
+  std::vector< unsigned char > qc;
+  /// <summary>Child care years of the case being converted.</summary>
+  std::vector< unsigned char > childCare;
+  /// <summary>Family members' bics of the case being converted.</summary>
+  std::string famBic;
+  /// <summary>Family members' dates of birth of the case being converted.
+  /// </summary>
+  std::vector< int > famBirthDate;
+  /// <summary>Family members' dates of entitlement of the case being
+  /// converted.</summary>
+  std::vector< int > famEntDate;
+  /// <summary>Family members' dates of disability onset of the case being
+  /// converted.</summary>
+  std::vector< int > famOnsetDate;
+public:
+  explicit PiaColumnConvert( int baseYear );
+  ~PiaColumnConvert();
+  void makeRecord( const char *begin, const char *end,
+    PiaColumnRecord& record );
+  unsigned long toColumns( const PiaMappedFile& in, PiaColumnWrite& out );
+  unsigned long toText( const PiaColumnFile& in, std::ostream& out );
+  void writeRecord( const PiaColumnRecord& record, std::ostream& out );
+private:
+  void deleteContents();
+  static unsigned lineFlag( int lineType );
+  static const char *writeText( const char *next, const char *end,
+    int lastLineType, std::ostream& out );
+  PiaColumnConvert( const PiaColumnConvert& );
+  PiaColumnConvert& operator=( const PiaColumnConvert& );
+};
@@ -0,0 +1,159 @@
+// Declarations for the <see cref="PiaColumnFile"/> class to read the cases
+// of a columnar population file mapped into memory.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "boost/iostreams/device/mapped_file.hpp"
+#include "PiaInputFile.h"
+class PiaColumnRecord;
+
+/// <summary>Maps a columnar population file into memory, and reads any of
+/// its cases without parsing text.</summary>
+///
+/// <remarks>A columnar file holds the same cases as a multi-record pia
+/// file, with each field stored in its own column of binary values (see
+/// <see cref="PiaColumnRecord"/> for the fields). The cases are stored in
+/// groups of up to <see cref="PiaColumnFile::DEFAULT_GROUP_SIZE"/> cases,
+/// so a file of any size can be written with a bounded amount of memory;
+/// within a group, each column is one contiguous array. Fields with a value
+/// for each year (the earnings, types of taxes, quarters of coverage, and
+/// child care years) and the family members are stored as one array of
+/// values for the group, with an index column giving the first value of
+/// each case. Lines of a pia file that are not stored in columns, and
+/// cases that use data that cannot be stored in columns, are kept as text
+/// and parsed by <see cref="PiaRead"/> as usual.
+///
+/// The file starts with a header, and ends with a directory giving the
+/// location of each column of each group, followed by the location of the
+/// directory. All values are stored in the byte order of the machine that
+/// wrote the file, and every column starts on an 8-byte boundary, so the
+/// columns are used in place. Files are written by
+/// <see cref="PiaColumnWrite"/>, and converted to and from pia files by
+/// <see cref="PiaColumnConvert"/>.
+///
+/// The mapped file is never changed, so several threads, each with its own
+/// <see cref="PiaRead"/>, may read cases from one instance at the same
+/// time.</remarks>
+///
+/// <seealso cref="PiaColumnRecord"/>
+/// <seealso cref="PiaColumnWrite"/>
+/// <seealso cref="PiaMappedFile"/>
+class PiaColumnFile : public PiaInputFile
+{
+public:
+  /// <summary>Columns of the file.</summary>
+  enum column_id {
+    FLAGS,  // Lines present.
+    SSN,  // Social Security number.
+    SEX,  // Sex.
+    BIRTH_DATE,  // Date of birth.
+    DEATH_DATE,  // Date of death.
+    JOASDI,  // Type of benefit.
+    ENT_DATE,  // Date of entitlement.
+    BENEFIT_DATE,  // Date of benefit.
+    IBEGIN,  // First year of earnings.
+    IEND,  // Last year of earnings.
+    ONSET_DATE,  // Dates of disability onset.
+    PRIORENT_DATE,  // Dates of prior entitlement to disability.
+    WAITPER_DATE,  // First months of waiting periods.
+    CESSATION_DATE,  // Dates of disability cessation.
+    CESSATION_PIA,  // Pias at disability cessation.
+    CESSATION_MFB,  // Mfbs at disability cessation.
+    PUBPEN,  // Noncovered pension.
+    PUBPEN_DATE,  // Date of noncovered pension.
+    PUBPEN_RESERVIST,  // Pension after reservist pension removal.
+    INDICATORS,  // Totalization, blind, and deemed insured indicators.
+    OABENT_DATE,  // Date of prior old-age entitlement.
+    OABCESS_DATE,  // Date of prior old-age cessation.
+    QCTD,  // Quarters of coverage, 1937-1977.
+    QC51TD,  // Quarters of coverage, 1951-1977.
+    EARN_OASDI_INDEX,  // Index of OASDI earnings.
+    EARN_OASDI,  // OASDI earnings.
+    EARN_HI_INDEX,  // Index of Medicare earnings.
+    EARN_HI,  // Medicare earnings.
+    TAX_TYPE_INDEX,  // Index of types of taxes.
+    TAX_TYPE,  // Types of taxes.
+    QC_INDEX,  // Index of annual quarters of coverage.
+    QC,  // Annual quarters of coverage.
+    CHILD_CARE_INDEX,  // Index of child care years.
+    CHILD_CARE,  // Child care years.
+    FAMILY_INDEX,  // Index of family members.
+    FAMILY_BIC,  // Family members' bics.
+    FAMILY_BIRTH_DATE,  // Family members' dates of birth.
+    FAMILY_ENT_DATE,  // Family members' dates of entitlement.
+    FAMILY_ONSET_DATE,  // Family members' dates of disability onset.
+    TEXT_INDEX,  // Index of text.
+    TEXT,  // Lines not stored in columns.
+    NUM_COLUMNS  // Number of columns.
+  };
+  /// <summary>Kinds of columns.</summary>
+  enum column_kind {
+    PER_CASE,  // A fixed number of elements for each case.
+    INDEX,  // An index into a column of values.
+    VALUES  // A variable number of elements for each case.
+  };
+  /// <summary>Description of one column.</summary>
+  struct ColumnInfo
+  {
+    /// <summary>Kind of column.</summary>
+    column_kind kind;
+    /// <summary>Size of one element, in bytes.</summary>
+    unsigned elementSize;
+    /// <summary>Number of elements for each case (or for each index entry,
+    /// for a column of values).</summary>
+    unsigned count;
+    /// <summary>Index column of a column of values.</summary>
+    column_id index;
+  };
+  /// <summary>Description of each column.</summary>
+  static const ColumnInfo columnInfo[NUM_COLUMNS];
+  /// <summary>Default number of cases in a group.</summary>
+  static const unsigned DEFAULT_GROUP_SIZE = 65536u;
+  /// <summary>Version of the file format.</summary>
+  static const boost::uint32_t VERSION = 1u;
+  /// <summary>Value written in the header to check the byte order.
+  /// </summary>
+  static const boost::uint32_t ENDIAN_MARK = 0x01020304u;
+  /// <summary>Size of the header, in bytes.</summary>
+  static const unsigned HEADER_SIZE = 32u;
+  /// <summary>Size of the end of the file after the directory, in bytes.
+  /// </summary>
+  static const unsigned TRAILER_SIZE = 24u;
+  /// <summary>Identifies a columnar file (8 characters).</summary>
+  static const char magic[];
+private:
+  /// <summary>Location of the columns of one group in the mapped file.
+  /// </summary>
+  struct Group
+  {
+    /// <summary>Number of cases in the group.</summary>
+    unsigned recordCount;
+    /// <summary>Start of each column.</summary>
+    const char *column[NUM_COLUMNS];
+  };
+  /// <summary>The mapped file.</summary>
+  boost::iostreams::mapped_file_source file;
+  /// <summary>Number of cases in each group but the last.</summary>
+  unsigned groupSize;
+  /// <summary>Total number of cases.</summary>
+  unsigned recordCount;
+  /// <summary>Location of each group.</summary>
+  std::vector< Group > groups;
+public:
+  explicit PiaColumnFile( const std::string& fileName );
+  ~PiaColumnFile();
+  void getRecord( unsigned index, PiaColumnRecord& record ) const;
+  /// <summary>Returns the number of cases in the file.</summary>
+  ///
+  /// <returns>The number of cases in the file.</returns>
+  unsigned getRecordCount() const { return(recordCount); }
+  unsigned int read( PiaRead& piaRead, unsigned index ) const;
+  static bool isColumnFile( const std::string& fileName );
+private:
+  void readDirectory();
+  PiaColumnFile( const PiaColumnFile& );
+  PiaColumnFile& operator=( const PiaColumnFile& );
+};
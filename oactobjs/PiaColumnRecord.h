@@ -0,0 +1,152 @@
+// Declarations for the <see cref="PiaColumnRecord"/> class to hold the
+// values of one case in a columnar population file.
+
+#pragma once
+
+#include "boost/date_time/gregorian/greg_date.hpp"
+#include "datemoyr.h"
+
+/// <summary>Holds the values of one case in a columnar population file, as
+/// they are stored in the file.</summary>
+///
+/// <remarks>The fields correspond to the lines of a pia file that are
+/// stored in columns (see <see cref="PiaColumnFile"/>); a bit in
+/// <see cref="PiaColumnRecord::flags"/> shows whether each kind of line was
+/// present. Lines that are not stored in columns are kept as text, and a
+/// case that cannot be stored in columns at all is kept entirely as text
+/// (with <see cref="PiaColumnRecord::TEXT_ONLY"/> set).
+///
+/// The arrays are not owned: they point into a mapped
+/// <see cref="PiaColumnFile"/> when reading, or into the buffers of a
+/// <see cref="PiaColumnWrite"/> when writing.
+///
+/// Full dates are stored as yyyymmdd, and months as yyyymm, with 0 for a
+/// date that has not been set.</remarks>
+///
+/// <seealso cref="PiaColumnFile"/>
+/// <seealso cref="PiaColumnWrite"/>
+class PiaColumnRecord
+{
+public:
+  /// <summary>Flags for the lines present in a case.</summary>
+  enum line_flags {
+    DEATH = 0x1,  // Date of death (line 2).
+    TOB = 0x2,  // Type of benefit (line 3).
+    BENDATE = 0x4,  // Date of benefit (line 4).
+    YEARS = 0x8,  // Years of earnings (line 6).
+    DISAB1 = 0x10,  // Most recent disability (line 9).
+    DISAB2 = 0x20,  // Second most recent disability (line 10).
+    PUBPEN = 0x40,  // Noncovered pension (line 12).
+    TOTALIZE = 0x80,  // Totalization indicator (line 13).
+    BLIND = 0x100,  // Blind indicator (line 14).
+    DEEMED = 0x200,  // Deemed insured indicator (line 15).
+    TAXTYPE = 0x400,  // Type of taxes (line 21).
+    EARN_OASDI = 0x800,  // OASDI earnings (lines 22-29).
+    EARN_HI = 0x1000,  // Medicare earnings (lines 30-37).
+    RESERVIST = 0x2000,  // Reservist pension (line 38).
+    OABENT = 0x4000,  // Prior old-age entitlement (line 39).
+    QC1 = 0x8000,  // Summary quarters of coverage (line 95).
+    QC2 = 0x10000,  // Annual quarters of coverage (line 96).
+    CHILDCARE = 0x20000,  // Child care years (line 97).
+    TEXT_ONLY = 0x80000000  // Whole case is in the text.
+  };
+  /// <summary>Lines present (a combination of
+  /// <see cref="line_flags"/>).</summary>
+  unsigned flags;
+  /// <summary>Social Security number (9 characters, not terminated).
+  /// </summary>
+  const char *ssn;
+  /// <summary>Sex.</summary>
+  int sex;
+  /// <summary>Date of birth.</summary>
+  int birthDate;
+  /// <summary>Date of death.</summary>
+  int deathDate;
+  /// <summary>Type of benefit.</summary>
+  int joasdi;
+  /// <summary>Date of entitlement.</summary>
+  int entDate;
+  /// <summary>Date of benefit.</summary>
+  int benefitDate;
+  /// <summary>First year of earnings.</summary>
+  int ibegin;
+  /// <summary>Last year of earnings.</summary>
+  int iend;
+  /// <summary>Dates of disability onset.</summary>
+  int onsetDate[2];
+  /// <summary>Dates of prior entitlement to disability.</summary>
+  int priorentDate[2];
+  /// <summary>First months of waiting periods.</summary>
+  int waitperDate[2];
+  /// <summary>Dates of disability cessation.</summary>
+  int cessationDate[2];
+  /// <summary>Pias at disability cessation.</summary>
+  float cessationPia[2];
+  /// <summary>Mfbs at disability cessation.</summary>
+  float cessationMfb[2];
+  /// <summary>Noncovered pension.</summary>
+  float pubpen;
+  /// <summary>Date of noncovered pension.</summary>
+  int pubpenDate;
+  /// <summary>Noncovered pension after reservist pension removal.
+  /// </summary>
+  float pubpenReservist;
+  /// <summary>True if totalized.</summary>
+  bool totalize;
+  /// <summary>True if blind.</summary>
+  bool blind;
+  /// <summary>True if deemed insured.</summary>
+  bool deemed;
+  /// <summary>Date of prior old-age entitlement.</summary>
+  int oabEntDate;
+  /// <summary>Date of prior old-age cessation.</summary>
+  int oabCessDate;
+  /// <summary>Quarters of coverage, 1937-1977.</summary>
+  int qctd;
+  /// <summary>Quarters of coverage, 1951-1977.</summary>
+  int qc51td;
+  /// <summary>OASDI earnings, from the first year of earnings.</summary>
+  const double *earnOasdi;
+  /// <summary>Number of years of OASDI earnings.</summary>
+  unsigned earnOasdiCount;
+  /// <summary>Medicare earnings, from the first year of Medicare
+  /// earnings.</summary>
+  const double *earnHi;
+  /// <summary>Number of years of Medicare earnings.</summary>
+  unsigned earnHiCount;
+  /// <summary>Type of taxes, from the first year of earnings.</summary>
+  const unsigned char *taxType;
+  /// <summary>Number of years of type of taxes.</summary>
+  unsigned taxTypeCount;
+  /// <summary>Annual quarters of coverage, from the first year of
+  /// earnings.</summary>
+  const unsigned char *qc;
+  /// <summary>Number of years of quarters of coverage.</summary>
+  unsigned qcCount;
+  /// <summary>Child care years, from the first year of earnings.</summary>
+  const unsigned char *childCare;
+  /// <summary>Number of years of child care years.</summary>
+  unsigned childCareCount;
+  /// <summary>Number of family members.</summary>
+  unsigned famSize;
+  /// <summary>Family members' bics (2 characters each).</summary>
+  const char *famBic;
+  /// <summary>Family members' dates of birth.</summary>
+  const int *famBirthDate;
+  /// <summary>Family members' dates of entitlement.</summary>
+  const int *famEntDate;
+  /// <summary>Family members' dates of disability onset.</summary>
+  const int *famOnsetDate;
+  /// <summary>Lines not stored in columns, or the whole case if
+  /// <see cref="TEXT_ONLY"/> is set.</summary>
+  const char *text;
+  /// <summary>Number of characters of text.</summary>
+  unsigned textLength;
+public:
+  PiaColumnRecord();
+  void deleteContents();
+  static int fromDate( const boost::gregorian::date& dateModyyr );
+  static int fromDateMoyr( const DateMoyr& dateMoyr );
+  static boost::gregorian::date toDate( int value );
+  static DateMoyr toDateMoyr( int value );
+};
@@ -0,0 +1,71 @@
+// Declarations for the <see cref="PiaColumnWrite"/> class to write a
+// columnar population file.
+
+#pragma once
+
+#include <iosfwd>
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "PiaColumnFile.h"
+class PiaColumnRecord;
+
+/// <summary>Writes cases to a columnar population file.</summary>
+///
+/// <remarks>The cases of one group are collected in memory, one buffer per
+/// column, and each group is written when it is full, so the memory used
+/// does not depend on the number of cases. The directory is written by
+/// <see cref="PiaColumnWrite::finish"/>, which must be called after the
+/// last case; the file cannot be read until then. See
+/// <see cref="PiaColumnFile"/> for the layout of the file.</remarks>
+///
+/// <seealso cref="PiaColumnFile"/>
+/// <seealso cref="PiaColumnConvert"/>
+class PiaColumnWrite
+{
+private:
+  /// <summary>Location of the columns of one group written.</summary>
+  struct GroupEntry
+  {
+    /// <summary>Number of cases in the group.</summary>
+    boost::uint64_t recordCount;
+    /// <summary>Offset of each column.</summary>
+    boost::uint64_t offset[PiaColumnFile::NUM_COLUMNS];
+    /// <summary>Size of each column, in bytes.</summary>
+    boost::uint64_t length[PiaColumnFile::NUM_COLUMNS];
+  };
+  /// <summary>Output stream (opened in binary mode).</summary>
+  std::ostream& out;
+  /// <summary>Number of cases in each group but the last.</summary>
+  const unsigned groupSize;
+  /// <summary>Columns of the group being collected.</summary>
+  std::vector< char > buffer[PiaColumnFile::NUM_COLUMNS];
+  /// <summary>Number of cases in the group being collected.</summary>
+  unsigned groupRecords;
+  /// <summary>Groups written so far.</summary>
+  std::vector< GroupEntry > groups;
+  /// <summary>Number of bytes written so far.</summary>
+  boost::uint64_t position;
+  /// <summary>Total number of cases written.</summary>
+  unsigned long recordCount;
+  /// <summary>True after the directory has been written.</summary>
+  bool finished;
+public:
+  explicit PiaColumnWrite( std::ostream& newOut,
+    unsigned newGroupSize = PiaColumnFile::DEFAULT_GROUP_SIZE );
+  ~PiaColumnWrite();
+  void finish();
+  /// <summary>Returns the number of cases written.</summary>
+  ///
+  /// <returns>The number of cases written.</returns>
+  unsigned long getRecordCount() const { return(recordCount); }
+  void write( const PiaColumnRecord& record );
+private:
+  void append( PiaColumnFile::column_id column, const void *data,
+    std::size_t length );
+  void appendIndex( PiaColumnFile::column_id column, unsigned count );
+  void startGroup();
+  void writeBytes( const void *data, std::size_t length );
+  void writeGroup();
+  PiaColumnWrite( const PiaColumnWrite& );
+  PiaColumnWrite& operator=( const PiaColumnWrite& );
+};
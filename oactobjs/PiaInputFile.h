@@ -0,0 +1,52 @@
+// Declarations for the <see cref="PiaInputFile"/> class, the interface to
+// a file of cases that can be read in any order.
+
+#pragma once
+
+#include "boost/cstdint.hpp"
+class PiaRead;
+
+/// <summary>Interface to a file of cases that can be read by number, in
+/// any order.</summary>
+///
+/// <remarks>An implementation must allow several threads, each with its
+/// own <see cref="PiaRead"/>, to read cases from one instance at the same
+/// time.</remarks>
+///
+/// <seealso cref="PiaMappedFile"/>
+/// <seealso cref="PiaColumnFile"/>
+class PiaInputFile
+{
+public:
+  /// <summary>Destructor.</summary>
+  virtual ~PiaInputFile() { }
+  /// <summary>Returns the number of cases in the file.</summary>
+  ///
+  /// <returns>The number of cases in the file.</returns>
+  virtual unsigned getRecordCount() const = 0;
+  /// <summary>Returns a key that identifies the contents of one case.
+  /// </summary>
+  ///
+  /// <remarks>Cases with the same contents have the same key, and a change
+  /// to a case almost always changes its key, so the key can be used to
+  /// find a saved copy of the case (see <see cref="CaseCache"/>). This
+  /// version has no key.</remarks>
+  ///
+  /// <returns>True if the case has a key, false otherwise.</returns>
+  ///
+  /// <param name="index">Number of case (starting at 0).</param>
+  /// <param name="key">Key of the case (returned).</param>
+  virtual bool getRecordKey( unsigned, boost::uint64_t& ) const
+  { return(false); }
+  /// <summary>Reads one case.</summary>
+  ///
+  /// <remarks>Call <see cref="WorkerDataGeneral::deleteContents"/> for the
+  /// worker and each family member before this function.</remarks>
+  ///
+  /// <returns>The same values as
+  /// <see cref="PiaRead::read(std::istream&)"/>.</returns>
+  ///
+  /// <param name="piaRead">Reader to use.</param>
+  /// <param name="index">Number of case (starting at 0).</param>
+  virtual unsigned int read( PiaRead& piaRead, unsigned index ) const = 0;
+};
@@ -0,0 +1,56 @@
+// Declarations for the <see cref="PiaMappedFile"/> class to read the cases
+// of a pia file mapped into memory.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "boost/iostreams/device/mapped_file.hpp"
+#include "PiaInputFile.h"
+class PiaRead;
+
+/// <summary>Maps a multi-record pia file into memory, and reads any of its
+/// cases.</summary>
+///
+/// <remarks>The file is scanned once when it is opened, to find where each
+/// case starts (at each line of type 1). After that, any case can be read
+/// directly by number, with <see cref="PiaRead::read(const char*,
+/// const char*)"/>, which gives the same results as reading the cases in
+/// order from a stream, without copying the file or allocating memory for
+/// each line.
+///
+/// As with a stream, the cases end at the first empty line or at a last
+/// line that has no newline character.
+///
+/// The mapped file is never changed, so several threads, each with its own
+/// <see cref="PiaRead"/>, may read cases from one instance at the same
+/// time.</remarks>
+///
+/// <seealso cref="PiaRead"/>
+/// <seealso cref="PiaColumnFile"/>
+class PiaMappedFile : public PiaInputFile
+{
+private:
+  /// <summary>The mapped file.</summary>
+  boost::iostreams::mapped_file_source file;
+  /// <summary>Offset of the start of each case, followed by the offset of
+  /// the end of the last case.</summary>
+  std::vector< std::size_t > recordStart;
+public:
+  explicit PiaMappedFile( const std::string& fileName );
+  ~PiaMappedFile();
+  const char *getRecordBegin( unsigned index ) const;
+  /// <summary>Returns the number of cases in the file.</summary>
+  ///
+  /// <returns>The number of cases in the file.</returns>
+  unsigned getRecordCount() const
+  { return(static_cast<unsigned>(recordStart.size() - 1)); }
+  const char *getRecordEnd( unsigned index ) const;
+  bool getRecordKey( unsigned index, boost::uint64_t& key ) const;
+  unsigned int read( PiaRead& piaRead, unsigned index ) const;
+private:
+  void indexRecords();
+  PiaMappedFile( const PiaMappedFile& );
+  PiaMappedFile& operator=( const PiaMappedFile& );
+};
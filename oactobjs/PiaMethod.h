@@ -5,11 +5,14 @@
 
 #pragma once
 
+#include <vector>
+#include <utility>  // for pair
 #include "piadata.h"
 #include "bendpia.h"
 #include "bendmfb.h"
 #include "PortionAime.h"
 #include "BenefitAmount.h"
+#include "CalcArena.h"
 class PiaParams;
 
 /// <summary>Parent of the various methods required for calculation of a
@@ -17,7 +20,11 @@ class PiaParams;
 ///
 /// <remarks>Child classes are <see cref="DibGuar"/>, <see cref="FrozMin"/>,
 /// <see cref="OldPia"/>, and <see cref="WageIndGeneral"/>, and their
-/// children.</remarks>
+/// children.
+///
+/// A method created while a <see cref="CalcArena"/> is current is placed
+/// in the arena, with its annual arrays, so no memory is allocated for it
+/// once the arena has grown to the size of a calculation.</remarks>
 ///
 /// <seealso cref="DibGuar"/>
 /// <seealso cref="FrozMin"/>
@@ -137,6 +144,20 @@ private:
   const std::string methodTitle;
   /// <summary>Indicator for values having been set (via setAt).</summary>
   bool dirty;
+  /// <summary>Earnings and years from the last call to orderEarnings,
+  /// with the highest years selected at the end.</summary>
+  ///
+  /// <remarks>Space for every year is reserved when the method is created,
+  /// so ordering the earnings does not allocate memory.</remarks>
+  std::vector< std::pair< double, int >,
+    ArenaAllocator< std::pair< double, int > > > orderBuffer;
+  /// <summary>First year of earnings in orderBuffer.</summary>
+  int orderFirst;
+  /// <summary>Last year of earnings in orderBuffer.</summary>
+  int orderLast;
+  /// <summary>Number of highest years at the end of orderBuffer that are
+  /// in ascending order.</summary>
+  int orderSorted;
 protected:
   /// <summary>Temporary pia.</summary>
   double piasub;
@@ -177,6 +198,20 @@ public:
     const PiaData& newPiaData, const PiaParams& newPiaParams,
     int newMaxyear, const std::string& newTitle, pia_type newMethod );
   virtual ~PiaMethod();
+  /// <summary>Allocates memory for a method, from the current arena if
+  /// there is one.</summary>
+  ///
+  /// <returns>The memory allocated.</returns>
+  ///
+  /// <param name="size">Number of bytes.</param>
+  static void *operator new( size_t size )
+  { return(CalcArena::allocateObject(size)); }
+  /// <summary>Releases memory for a method, unless it is in an arena.
+  /// </summary>
+  ///
+  /// <param name="p">Memory to release.</param>
+  static void operator delete( void *p )
+  { CalcArena::deallocateObject(p); }
   /// <summary>Applies benefit increases to 1977 Amendments PIA or MFB.
   /// </summary>
   ///
@@ -280,6 +315,7 @@ public:
   double mfbCal( const double portionPiaElig[], const PercMfb& percMfbTemp,
     int year );
   void orderEarnings( int first, int last, int number );
+  void orderEarnings( int number );
   void prorate();
   /// <summary>Sets ame or aime.</summary>
   ///
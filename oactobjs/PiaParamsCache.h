@@ -0,0 +1,88 @@
+// Declarations for the <see cref="PiaParamsCache"/> class to manage shared,
+// read-only Social Security parameters projected for one set of assumptions.
+
+#pragma once
+
+#include <map>
+#include <string>
+#include "boost/shared_ptr.hpp"
+#include "boost/thread/mutex.hpp"
+#include "AssumptionType.h"
+#include "BaseChangeType.h"
+class PiaParamsAny;
+class AwbiData;
+class LawChangeArray;
+class Assumptions;
+class UserAssumptions;
+
+/// <summary>Manages read-only snapshots of the Social Security parameters,
+/// each projected once for one set of assumptions.</summary>
+///
+/// <remarks>Each snapshot is a <see cref="PiaParamsAny"/> with the projected
+/// benefit increases, average wage increases, and wage bases for one
+/// combination of benefit increase alternative, average wage alternative,
+/// wage base choice, and (for user-specified assumptions) the user's
+/// values. A snapshot is built the first time its assumptions are requested,
+/// and is never changed after that, so any number of threads may read one
+/// snapshot at the same time. The snapshots are reference-counted, so a
+/// snapshot stays valid while a calculation still holds it, even after
+/// <see cref="PiaParamsCache::clear"/>.
+///
+/// A calculation uses a snapshot by constructing a <see cref="PiaCalAny"/>
+/// with it.</remarks>
+///
+/// <seealso cref="PiaCalAny"/>
+class PiaParamsCache
+{
+public:
+  /// <summary>Identifies the assumptions used to project a snapshot.
+  /// </summary>
+  struct Key
+  {
+    /// <summary>Benefit increase assumption indicator.</summary>
+    AssumptionType::assum_type altbi;
+    /// <summary>Average wage increase assumption indicator.</summary>
+    AssumptionType::assum_type altaw;
+    /// <summary>Wage base indicator.</summary>
+    BaseChangeType::change_type ibasch;
+    /// <summary>Hash of <see cref="Key::userData"/>.</summary>
+    std::size_t userHash;
+    /// <summary>The user-specified values that affect the projection
+    /// (empty if none are used).</summary>
+    std::string userData;
+    bool operator<( const Key& key ) const;
+    bool operator==( const Key& key ) const;
+  };
+private:
+  /// <summary>Year after last known benefit increase.</summary>
+  const int istart;
+  /// <summary>Maximum projected year.</summary>
+  const int maxyear;
+  /// <summary>Historical average wages and benefit increases.</summary>
+  AwbiData& awbiData;
+  /// <summary>Law change parameters.</summary>
+  const LawChangeArray& lawChange;
+  /// <summary>Stored benefit increase and average wage assumptions.
+  /// </summary>
+  Assumptions& assumptions;
+  /// <summary>Protects the snapshots, and the stored assumptions while a
+  /// snapshot is built.</summary>
+  boost::mutex mutex;
+  /// <summary>Snapshots built so far.</summary>
+  std::map< Key, boost::shared_ptr< const PiaParamsAny > > snapshots;
+public:
+  PiaParamsCache( int newIstart, int newMaxyear, AwbiData& newAwbiData,
+    const LawChangeArray& newLawChange, Assumptions& newAssumptions );
+  ~PiaParamsCache();
+  void clear();
+  boost::shared_ptr< const PiaParamsAny > get(
+    const UserAssumptions& userAssumptions );
+  boost::shared_ptr< const PiaParamsAny > get( const Key& key,
+    const UserAssumptions& userAssumptions );
+  unsigned getSize();
+  static Key makeKey( const UserAssumptions& userAssumptions );
+private:
+  PiaParamsAny *build( const UserAssumptions& userAssumptions );
+  PiaParamsCache( const PiaParamsCache& );
+  PiaParamsCache& operator=( const PiaParamsCache& );
+};
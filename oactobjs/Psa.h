@@ -132,6 +132,8 @@ public:
    ~Psa();
   double annuityCal( double amount, int year, Sex::sex_type sex,
     int workerAge, int spouseAge ) const;
+  double getAnnuityFactor( int year, Sex::sex_type sex, int workerAge,
+    int spouseAge ) const;
   double annuityRevCal( double annuity, int year, Sex::sex_type sex,
     int workerAge, int spouseAge ) const;
    double contribCal( int eligYear, int benYear, double earnings ) const;
@@ -0,0 +1,136 @@
+// Declarations for the <see cref="PsaSimulation"/> class to simulate the
+// distribution of psa annuities over random investment returns.
+
+#pragma once
+
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "Psa.h"
+#include "Sex.h"
+class DoubleAnnual;
+class LawChangePSAACCT;
+
+/// <summary>Simulates the psa account of one worker over many paths of
+/// random investment returns, giving the distribution of the annuity bought
+/// with the account.</summary>
+///
+/// <remarks>Each year the worker's contribution to each investment is
+/// added to it, and each investment earns a return drawn from a normal
+/// distribution with the mean and standard deviation of the law change
+/// (see <see cref="LawChangePSAACCT::getInvestMean"/> and
+/// <see cref="LawChangePSAACCT::getInvestStdDev"/>, in percent). The
+/// management fee is then taken as a fraction of the investment, and the
+/// administrative fee in dollars, and the investments are rebalanced to the
+/// contribution split if the law change calls for it. The annuity is the
+/// whole account divided by the annuity factor of the year it is converted.
+///
+/// The contributions and the annuity factor are given to
+/// <see cref="simulate"/>; the overload that takes a <see cref="Psa"/>
+/// finds them from the worker's earnings (see <see cref="Psa::contribCal"/>,
+/// <see cref="Psa::getInvestPerc"/>, and
+/// <see cref="Psa::getAnnuityFactor"/>).
+///
+/// The returns come from a counter-based random number generator
+/// (Philox4x32-10), keyed by the seed and a key for the worker, and
+/// indexed by path and year, so no generator state is shared between
+/// threads. The paths are divided into blocks that are run on
+/// <see cref="PsaSimulation::getThreadCount"/> threads; within a block the
+/// accounts of all paths are updated one year at a time, so the inner
+/// loops run over contiguous arrays.
+///
+/// An instance holds the annuities of the last simulation, sorted, so
+/// any number of percentiles can be read from it.</remarks>
+///
+/// <seealso cref="Psa"/>
+class PsaSimulation
+{
+public:
+  /// <summary>Number of paths in each block.</summary>
+  static const unsigned BLOCK_SIZE = 256u;
+private:
+  /// <summary>Psa law change parameters.</summary>
+  const LawChangePSAACCT& lawChangePSAACCT;
+  /// <summary>Number of paths.</summary>
+  unsigned paths;
+  /// <summary>Seed of the random returns.</summary>
+  boost::uint64_t seed;
+  /// <summary>Number of threads to use.</summary>
+  unsigned threadCount;
+  /// <summary>First year of contributions in the last simulation.
+  /// </summary>
+  int firstYear;
+  /// <summary>Number of years of contributions in the last simulation.
+  /// </summary>
+  int years;
+  /// <summary>Mean return of each investment in the last simulation.
+  /// </summary>
+  double mean[Psa::NUM_INVESTMENTS];
+  /// <summary>Standard deviation of the return of each investment in the
+  /// last simulation.</summary>
+  double stdDev[Psa::NUM_INVESTMENTS];
+  /// <summary>Fraction of each investment left after the management fee
+  /// in the last simulation.</summary>
+  double keep[Psa::NUM_INVESTMENTS];
+  /// <summary>Administrative fee of each investment in the last
+  /// simulation.</summary>
+  double adminFee[Psa::NUM_INVESTMENTS];
+  /// <summary>Contribution to each investment in each year of the last
+  /// simulation, by investment (by row) and year (by column).</summary>
+  std::vector< double > contribs;
+  /// <summary>Share of each investment in each year of the last
+  /// simulation, by investment (by row) and year (by column).</summary>
+  std::vector< double > shares;
+  /// <summary>Annuity of each path of the last simulation, sorted.
+  /// </summary>
+  std::vector< double > annuities;
+  /// <summary>Annuity with every return equal to its mean, in the last
+  /// simulation.</summary>
+  double meanReturnAnnuity;
+public:
+  explicit PsaSimulation( const LawChangePSAACCT& newLawChangePSAACCT );
+  /// <summary>Returns the annuities of the last simulation.</summary>
+  ///
+  /// <returns>The annuities of the last simulation, in increasing order.
+  /// </returns>
+  const std::vector< double >& getAnnuities() const { return(annuities); }
+  double getMean() const;
+  /// <summary>Returns the annuity with every return equal to its mean.
+  /// </summary>
+  ///
+  /// <returns>The annuity with every return equal to its mean, in the last
+  /// simulation.</returns>
+  double getMeanReturnAnnuity() const { return(meanReturnAnnuity); }
+  /// <summary>Returns the number of paths.</summary>
+  ///
+  /// <returns>The number of paths.</returns>
+  unsigned getPaths() const { return(paths); }
+  double getPercentile( double percent ) const;
+  /// <summary>Returns the seed of the random returns.</summary>
+  ///
+  /// <returns>The seed of the random returns.</returns>
+  boost::uint64_t getSeed() const { return(seed); }
+  /// <summary>Returns the number of threads to use.</summary>
+  ///
+  /// <returns>The number of threads to use.</returns>
+  unsigned getThreadCount() const { return(threadCount); }
+  /// <summary>Sets the number of paths.</summary>
+  ///
+  /// <param name="newPaths">New number of paths.</param>
+  void setPaths( unsigned newPaths ) { paths = newPaths; }
+  /// <summary>Sets the seed of the random returns.</summary>
+  ///
+  /// <param name="newSeed">New seed.</param>
+  void setSeed( boost::uint64_t newSeed ) { seed = newSeed; }
+  void setThreadCount( unsigned newThreadCount );
+  void simulate( int newFirstYear, const std::vector< double >& newContribs,
+    const std::vector< double >& newShares, double annuityFactor,
+    boost::uint64_t workerKey );
+  void simulate( const Psa& psa, const DoubleAnnual& earnings,
+    int birthYear, int eligYear, int annuityYear, Sex::sex_type sex,
+    int spouseAge, boost::uint64_t workerKey );
+private:
+  double accumulateMean() const;
+  void runBlocks( unsigned first, unsigned step, boost::uint64_t workerKey );
+  PsaSimulation( const PsaSimulation& );
+  PsaSimulation& operator=( const PsaSimulation& );
+};
@@ -7,6 +7,7 @@
 
 #include <vector>
 #include "boost/serialization/access.hpp"
+#include "CalcArena.h"
 #include "qc.h"
 #include "QcPacked.h"
 #include "qtryear.h"
@@ -14,7 +15,9 @@
 /// <summary>Manages an array of annual quarters of coverage.</summary>
 ///
 /// <remarks>The quarters of coverage are stored in <see cref="QcPacked"/>
-/// structures to save space.</remarks>
+/// structures to save space. The vector takes its memory from the
+/// <see cref="CalcArena"/> current when the instance is created, if any.
+/// </remarks>
 ///
 /// <seealso cref="QcPacked"/>
 class QcArray
@@ -39,7 +42,7 @@ private:
   /// <summary>Last year of data.</summary>
   unsigned short lastYear;
   /// <summary>Quarters of coverage data.</summary>
-  std::vector< QcPacked > theData;
+  std::vector< QcPacked, ArenaAllocator< QcPacked > > theData;
 public:
   QcArray( int firstyr, int lastyr );
   QcArray( const QcArray& qcArray );
@@ -0,0 +1,65 @@
+// Declarations for the <see cref="QcBitset"/> class to count quarters of
+// coverage over any period of quarters without summing year by year.
+
+#pragma once
+
+#include <vector>
+#include "boost/cstdint.hpp"
+#include "qtryear.h"
+class QcArray;
+
+/// <summary>Holds annual quarters of coverage as one bit for each calendar
+/// quarter, with running totals, so the quarters of coverage in any period
+/// of quarters are found in constant time.</summary>
+///
+/// <remarks>The quarters of coverage of a year are not tied to particular
+/// quarters: in a period starting or ending within a year, the year counts
+/// as many of its quarters of coverage as it has quarters in the period (see
+/// <see cref="QcArray::accumulate"/>). A year with n quarters of coverage
+/// has the bits of its first n quarters set, so that count is the number of
+/// bits set in the first quarters of the year. The bits of 16 years are
+/// held in one 64-bit word, along with the total of all earlier words; the
+/// total through any quarter is then one of those totals plus the bits set
+/// in part of one word, and the total over a period is the difference of two
+/// such totals.
+///
+/// <see cref="PiaData"/> keeps one of these with the same quarters of
+/// coverage as <see cref="PiaData::qcov"/>, for the fully, currently,
+/// deemed, and disability insured status tests, which look at many periods
+/// for each worker. Since at most 4 quarters of coverage can be credited in
+/// a year, a larger annual amount is taken as 4.</remarks>
+///
+/// <seealso cref="QcArray"/>
+class QcBitset
+{
+public:
+  /// <summary>Number of years held in one word.</summary>
+  static const int YEARS_PER_WORD = 16;
+private:
+  /// <summary>First year of data.</summary>
+  int firstYear;
+  /// <summary>Last year of data.</summary>
+  int lastYear;
+  /// <summary>One bit for each quarter, 4 bits for each year.</summary>
+  std::vector< boost::uint64_t > bits;
+  /// <summary>Total quarters of coverage in the words before each word.
+  /// </summary>
+  std::vector< unsigned > totals;
+public:
+  QcBitset( int newFirstYear, int newLastYear );
+  ~QcBitset();
+  unsigned accumulate( int firstyr, int lastyr, unsigned startValue ) const;
+  unsigned accumulate( const QtrYear& qtrYear1, const QtrYear& qtrYear2,
+    unsigned startValue ) const;
+  void assign( const QcArray& qcArray );
+  void deleteContents();
+  unsigned get( int year ) const;
+  /// <summary>Returns the last year of data.</summary>
+  ///
+  /// <returns>The last year of data.</returns>
+  int getLastYear() const { return(lastYear); }
+private:
+  unsigned firstQuarters( int year, unsigned quarters ) const;
+  unsigned totalBefore( int year ) const;
+  static unsigned popcount( boost::uint64_t word );
+};
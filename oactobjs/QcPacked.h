@@ -5,7 +5,9 @@
 
 #pragma once
 
+#include "boost/mpl/bool.hpp"
 #include "boost/serialization/access.hpp"
+#include "boost/serialization/is_bitwise_serializable.hpp"
 
 /// <summary>Holds 8 annual quarters of coverage amounts in one word (4
 /// bytes). Each value is in 4 bits, and can take values from 0 to 4.</summary>
@@ -48,3 +50,6 @@ public:
   unsigned get( int index ) const;
   void set( int index, unsigned value );
 };
+
+// The data is 4 bytes, so arrays of it may be archived as bytes.
+BOOST_IS_BITWISE_SERIALIZABLE(QcPacked)
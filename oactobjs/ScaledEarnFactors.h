@@ -70,20 +70,24 @@ public:
   int getWidth() const { return(fieldWidth); }
   void read( std::istream& in, int ageStart, int ageEnd, bool desc );
   void setAverageEarnings( EarnProject& earnProject,
-    const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd );
+    const AverageWage& averageWage, int birthYear, int ageStart,
+    int ageEnd ) const;
   /// <summary>Sets number of decimals in output field.</summary>
   ///
   /// <param name="newDecimals">New number of decimals in output.</param>
   void setDecimals( int newDecimals ) { numDecimals = newDecimals; }
   void setHighEarnings( EarnProject& earnProject,
-    const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd );
+    const AverageWage& averageWage, int birthYear, int ageStart,
+    int ageEnd ) const;
   void setLowEarnings( EarnProject& earnProject,
-    const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd );
+    const AverageWage& averageWage, int birthYear, int ageStart,
+    int ageEnd ) const;
   void setVeryLowEarnings( EarnProject& earnProject,
-    const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd );
+    const AverageWage& averageWage, int birthYear, int ageStart,
+    int ageEnd ) const;
   void setScaledEarnings( EarnProject& earnProject,
     const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd, 
-    scaleType earnType);
+    scaleType earnType) const;
   /// <summary>Sets width of output field.</summary>
   ///
   /// <param name="newWidth">New width of output field.</param>
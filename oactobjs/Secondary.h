@@ -6,6 +6,7 @@
 #pragma once
 
 #include <vector>
+#include "boost/serialization/access.hpp"
 #include "bic.h"
 #include "datemoyr.h"
 #include "Pifc.h"
@@ -18,6 +19,20 @@
 /// <seealso cref="SecondaryArray"/>
 class Secondary
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data read from a pia file.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & bic & entDate; }
 public:
   /// <summary>Type of beneficiary code.</summary>
   Bic bic;
@@ -0,0 +1,152 @@
+// Declarations for the <see cref="StageTimes"/> class to accumulate the
+// time spent in each stage of a benefit calculation.
+
+#pragma once
+
+#include "PiaMethod.h"
+
+/// <summary>Accumulates the time spent, and the number of memory
+/// allocations made, in each stage of the calculation of one or more cases.
+/// </summary>
+///
+/// <remarks>The calculation classes do not time themselves unless they are
+/// given an instance of this class (see <see cref="PiaCal::setStageTimes"/>
+/// and <see cref="BatchCalculator::setStageTimes"/>), so the cost when
+/// timing is off is one test of a null pointer per stage.
+///
+/// Times are measured with the steady clock of boost::chrono (see
+/// <see cref="MethodCounters::now"/>).
+/// Allocations are counted only if a counting function has been supplied
+/// with <see cref="StageTimes::setAllocationCounter"/>; the library does not
+/// count allocations itself, since that requires replacing the global
+/// operator new in the executable.
+///
+/// The stages overlap: <see cref="StageTimes::EARN_PROJECTION"/> and the
+/// pia calculation methods are part of
+/// <see cref="StageTimes::CALCULATION"/>.</remarks>
+///
+/// <seealso cref="PiaCal"/>
+class StageTimes
+{
+public:
+  /// <summary>Stages of a calculation.</summary>
+  enum stage_type {
+    READ,  // Reading the case.
+    DATA_CHECK,  // Checking the worker and family data.
+    CALCULATION,  // Calculating the pias, benefits, and taxes.
+    EARN_PROJECTION,  // Projecting earnings (part of calculation).
+    OUTPUT,  // Preparing the output pages.
+    PRINT,  // Printing the output pages.
+    NUM_STAGES  // Number of stages.
+  };
+  /// <summary>Times one stage, or one pia calculation method, from its
+  /// construction to its destruction.</summary>
+  ///
+  /// <remarks>Nothing is timed if the <see cref="StageTimes"/> pointer is
+  /// null.</remarks>
+  class Timer
+  {
+  private:
+    /// <summary>Where to add the time (may be null).</summary>
+    StageTimes *stageTimes;
+    /// <summary>Stage being timed, if not a method.</summary>
+    stage_type stage;
+    /// <summary>Method being timed, or NO_PIA_TYPE if a stage.</summary>
+    PiaMethod::pia_type method;
+    /// <summary>Time at construction, in seconds.</summary>
+    double start;
+    /// <summary>Number of allocations at construction.</summary>
+    unsigned long allocations;
+  public:
+    Timer( StageTimes *newStageTimes, stage_type newStage );
+    Timer( StageTimes *newStageTimes, PiaMethod::pia_type newMethod );
+    ~Timer();
+  private:
+    Timer( const Timer& );
+    Timer& operator=( const Timer& );
+  };
+private:
+  /// <summary>Seconds spent in each stage.</summary>
+  double stageSeconds[NUM_STAGES];
+  /// <summary>Allocations made in each stage.</summary>
+  unsigned long stageAllocations[NUM_STAGES];
+  /// <summary>Number of times each stage was timed.</summary>
+  unsigned stageCalls[NUM_STAGES];
+  /// <summary>Seconds spent in each pia calculation method.</summary>
+  double methodSeconds[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Allocations made in each pia calculation method.</summary>
+  unsigned long methodAllocations[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Number of times each pia calculation method was timed.
+  /// </summary>
+  unsigned methodCalls[PiaMethod::NO_PIA_TYPE];
+  /// <summary>Function returning the number of allocations made so far, or
+  /// null if allocations are not counted.</summary>
+  static unsigned long (*allocationCounter)();
+  /// <summary>Names of the stages.</summary>
+  static const char *stageNames[NUM_STAGES];
+  /// <summary>Names of the pia calculation methods.</summary>
+  static const char *methodNames[PiaMethod::NO_PIA_TYPE];
+public:
+  StageTimes();
+  void add( stage_type stage, double seconds, unsigned long allocations );
+  void addMethod( PiaMethod::pia_type method, double seconds,
+    unsigned long allocations );
+  void clear();
+  /// <summary>Returns the allocations made in a pia calculation method.
+  /// </summary>
+  ///
+  /// <returns>The allocations made in a pia calculation method.</returns>
+  ///
+  /// <param name="method">The method.</param>
+  unsigned long getMethodAllocations( PiaMethod::pia_type method ) const
+  { return(methodAllocations[method]); }
+  /// <summary>Returns the number of times a pia calculation method was
+  /// timed.</summary>
+  ///
+  /// <returns>The number of times a pia calculation method was timed.
+  /// </returns>
+  ///
+  /// <param name="method">The method.</param>
+  unsigned getMethodCalls( PiaMethod::pia_type method ) const
+  { return(methodCalls[method]); }
+  /// <summary>Returns the seconds spent in a pia calculation method.
+  /// </summary>
+  ///
+  /// <returns>The seconds spent in a pia calculation method.</returns>
+  ///
+  /// <param name="method">The method.</param>
+  double getMethodSeconds( PiaMethod::pia_type method ) const
+  { return(methodSeconds[method]); }
+  /// <summary>Returns the allocations made in a stage.</summary>
+  ///
+  /// <returns>The allocations made in a stage.</returns>
+  ///
+  /// <param name="stage">The stage.</param>
+  unsigned long getStageAllocations( stage_type stage ) const
+  { return(stageAllocations[stage]); }
+  /// <summary>Returns the number of times a stage was timed.</summary>
+  ///
+  /// <returns>The number of times a stage was timed.</returns>
+  ///
+  /// <param name="stage">The stage.</param>
+  unsigned getStageCalls( stage_type stage ) const
+  { return(stageCalls[stage]); }
+  /// <summary>Returns the seconds spent in a stage.</summary>
+  ///
+  /// <returns>The seconds spent in a stage.</returns>
+  ///
+  /// <param name="stage">The stage.</param>
+  double getStageSeconds( stage_type stage ) const
+  { return(stageSeconds[stage]); }
+  static unsigned long getAllocations();
+  static const char *getMethodName( PiaMethod::pia_type method );
+  static const char *getStageName( stage_type stage );
+  static double now();
+  /// <summary>Sets the function that counts allocations.</summary>
+  ///
+  /// <param name="newAllocationCounter">Function returning the number of
+  /// allocations made so far, or null to stop counting.</param>
+  static void setAllocationCounter(
+    unsigned long (*newAllocationCounter)() )
+  { allocationCounter = newAllocationCounter; }
+};
@@ -0,0 +1,132 @@
+// Declarations for the <see cref="TaxBatch"/> class to calculate the
+// payroll taxes of a block of workers at once.
+
+#pragma once
+
+#include <vector>
+#include "TaxData.h"
+class BitAnnual;
+class DoubleAnnual;
+
+/// <summary>Calculates the OASI, DI, and HI taxes of a block of workers,
+/// in every year and for one set of tax rates.</summary>
+///
+/// <remarks>The earnings are stored by year, with the amounts for all of
+/// the workers in one year side by side, so each year is calculated by one
+/// loop over the workers using the same rates: the employee or
+/// self-employed rate of each trust fund is selected for each worker and
+/// multiplied by the earnings, and the taxes are added to the totals. The
+/// loop uses AVX or AVX-512 instructions when the compiler targets them,
+/// and scalar code otherwise. Each tax and total is calculated with the
+/// same operations, in the same order, as
+/// <see cref="TaxData::taxCal(const TaxRates&, const DoubleAnnual&,
+/// const DoubleAnnual&, const BitAnnual&)"/>, so the results are identical.
+///
+/// To use a batch, call <see cref="TaxBatch::clear"/> with the tax rates,
+/// <see cref="TaxBatch::add"/> for each worker, and
+/// <see cref="TaxBatch::calculate"/>; then
+/// <see cref="TaxData::taxCal(const TaxBatch&, unsigned)"/> copies the
+/// taxes of one worker.</remarks>
+///
+/// <seealso cref="TaxData"/>
+/// <seealso cref="TaxRates"/>
+class TaxBatch
+{
+public:
+  /// <summary>Number of rates stored for each year (the employee and
+  /// self-employed rates of OASI, DI, and HI).</summary>
+  static const unsigned NUM_RATES = 6u;
+private:
+  /// <summary>Last year stored (the first is 1937).</summary>
+  const int lastYear;
+  /// <summary>Maximum number of workers.</summary>
+  const unsigned capacity;
+  /// <summary>Number of amounts stored for each year (capacity rounded up
+  /// to a multiple of 8).</summary>
+  const unsigned stride;
+  /// <summary>Number of workers added.</summary>
+  unsigned workerCount;
+  /// <summary>Net tax rates in each year: employee OASI, DI, and HI, then
+  /// self-employed OASI, DI, and HI.</summary>
+  std::vector< double > rates;
+  /// <summary>OASDI earnings limited to the wage base, by year and worker.
+  /// </summary>
+  std::vector< double > earnOasdi;
+  /// <summary>HI earnings limited to the wage base, by year and worker.
+  /// </summary>
+  std::vector< double > earnHi;
+  /// <summary>1 if self-employed, 0 if employee, by year and worker.
+  /// </summary>
+  std::vector< double > selfEmployed;
+  /// <summary>Taxes by trust fund (see
+  /// <see cref="TaxRates::trustfundType"/>), year, and worker.</summary>
+  std::vector< double > taxes;
+  /// <summary>Total taxes by trust fund, group of years (see
+  /// <see cref="TaxData::YEAR_GROUP"/>), and worker.</summary>
+  std::vector< double > taxTotal;
+  /// <summary>True if the taxes of the workers added have been calculated.
+  /// </summary>
+  bool calculated;
+public:
+  TaxBatch( int newLastYear, unsigned newCapacity );
+  ~TaxBatch();
+  unsigned add( const DoubleAnnual& newEarnOasdi,
+    const DoubleAnnual& newEarnHi, const BitAnnual& taxType );
+  void calculate();
+  void clear( const TaxRates& taxRates );
+  /// <summary>Returns the maximum number of workers.</summary>
+  ///
+  /// <returns>The maximum number of workers.</returns>
+  unsigned getCapacity() const { return(capacity); }
+  /// <summary>Returns the last year stored.</summary>
+  ///
+  /// <returns>The last year stored.</returns>
+  int getLastYear() const { return(lastYear); }
+  /// <summary>Returns the taxes of one worker for one trust fund in one
+  /// year.</summary>
+  ///
+  /// <returns>The taxes of one worker.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="trustfund">Trust fund.</param>
+  /// <param name="year">Year of earnings.</param>
+  double getTaxes( unsigned worker, TaxRates::trustfundType trustfund,
+    int year ) const
+  { return(taxes[(static_cast<unsigned>(trustfund) * getYearCount() +
+    static_cast<unsigned>(year - YEAR37)) * stride + worker]); }
+  /// <summary>Returns the total taxes of one worker for one trust fund and
+  /// group of years.</summary>
+  ///
+  /// <returns>The total taxes of one worker.</returns>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="trustfund">Trust fund.</param>
+  /// <param name="yearGroup">Group of years.</param>
+  double getTaxesTotal( unsigned worker, TaxRates::trustfundType trustfund,
+    TaxData::YEAR_GROUP yearGroup ) const
+  { return(taxTotal[(static_cast<unsigned>(trustfund) *
+    TaxData::NUMYEARPERIODS + static_cast<unsigned>(yearGroup)) * stride +
+    worker]); }
+  /// <summary>Returns the number of workers added.</summary>
+  ///
+  /// <returns>The number of workers added.</returns>
+  unsigned getWorkerCount() const { return(workerCount); }
+  /// <summary>Returns the number of years stored.</summary>
+  ///
+  /// <returns>The number of years stored.</returns>
+  unsigned getYearCount() const
+  { return(static_cast<unsigned>(lastYear - YEAR37 + 1)); }
+  /// <summary>Returns true if the taxes of the workers added have been
+  /// calculated.</summary>
+  ///
+  /// <returns>True if the taxes have been calculated.</returns>
+  bool isCalculated() const { return(calculated); }
+  static void taxYear( const double *yearRates, const double *earnOasdi,
+    const double *earnHi, const double *selfEmployed, double *const *taxes,
+    double *const *totals, unsigned count );
+private:
+  TaxBatch( const TaxBatch& );
+  TaxBatch& operator=( const TaxBatch& );
+};
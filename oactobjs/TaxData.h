@@ -8,6 +8,7 @@
 #include <vector>
 #include "dbleann.h"
 #include "TaxRates.h"
+class TaxBatch;
 
 /// <summary>Manages the Social Security payroll and self-employed taxes paid
 /// by a worker.</summary>
@@ -57,5 +58,8 @@ public:
     YEAR_GROUP yearGroup ) const
   { return(taxTotal[trustfund][yearGroup]); }
   void oasdhiTaxCal();
+  void taxCal( const TaxRates& taxRates, const DoubleAnnual& earnOasdi,
+    const DoubleAnnual& earnHi, const BitAnnual& taxType );
+  void taxCal( const TaxBatch& batch, unsigned worker );
   void totalTaxCal();
 };
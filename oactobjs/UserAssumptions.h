@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "boost/serialization/access.hpp"
 #include "cachup.h"
 #include "biproj.h"
 #include "dbleann.h"
@@ -20,6 +21,22 @@
 /// </remarks>
 class UserAssumptions
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+  { ar & awincproj & baseOasdi & base77 & biproj & catchup & titleAw;
+    ar & titleBi & ialtbi & anscch & ialtaw & ibasch & jaltbi & jaltaw;
+    ar & jbasch & lastYear; }
 public:
   /// <summary>Projected increases in annual average earnings.</summary>
   DoubleAnnual awincproj;
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "WageIndGeneral.h"
+class WageIndBatch;
 
 /// <summary>Manages the functions required for calculation of a wage indexed
 /// Social Security benefit.</summary>
@@ -20,10 +21,14 @@ public:
   WageInd( const WorkerDataGeneral& newWorkerData, const PiaData& newPiaData,
     const PiaParams& newPiaParams, int newMaxyear );
   virtual ~WageInd();
+  unsigned addToBatch( WageIndBatch& batch ) const;
   void calculate();
+  void calculate( const WageIndBatch& batch, unsigned worker );
   bool isApplicable();
   static bool isApplicable( const WorkerDataGeneral& workerData,
     const PiaData& piaData );
 private:
+  void calculateIndexed( int year1, int year2 );
+  const AverageWage& getEarnings() const;
   WageInd operator=( WageInd newWageInd );
 };
@@ -0,0 +1,165 @@
+// Declarations for the <see cref="WageIndBatch"/> class to index the
+// earnings of a block of workers at once.
+
+#pragma once
+
+#include <vector>
+#include "PiaException.h"
+class DoubleAnnual;
+
+/// <summary>Indexes the earnings of a block of workers who have the same
+/// indexing year.</summary>
+///
+/// <remarks>The earnings are stored by year, with the amounts for all of
+/// the workers in one year side by side, so each year is indexed by one
+/// loop over the workers using the same average wages. The loop uses AVX or
+/// AVX-512 instructions when the compiler targets them, and scalar code
+/// otherwise. Each indexed amount is calculated with the same operations,
+/// in the same order, as <see cref="WageIndGeneral::indexEarnings"/>, so
+/// the results are identical to the penny.
+///
+/// To use a batch, call <see cref="WageIndBatch::clear"/> with the indexing
+/// year, <see cref="WageInd::addToBatch"/> for each worker with that
+/// indexing year, and <see cref="WageIndBatch::index"/>; then
+/// <see cref="WageInd::calculate(const WageIndBatch&, unsigned)"/> for
+/// each worker finishes the calculation of the pia from the indexed
+/// earnings.</remarks>
+///
+/// <seealso cref="WageInd"/>
+class WageIndBatch
+{
+private:
+  /// <summary>First year of earnings stored.</summary>
+  const int firstYear;
+  /// <summary>Last year of earnings stored.</summary>
+  const int lastYear;
+  /// <summary>Maximum number of workers.</summary>
+  const unsigned capacity;
+  /// <summary>Number of amounts stored for each year (capacity rounded up
+  /// to a multiple of 8).</summary>
+  const unsigned stride;
+  /// <summary>Number of workers added.</summary>
+  unsigned workerCount;
+  /// <summary>Indexing year (year of eligibility minus 2).</summary>
+  int baseYear;
+  /// <summary>Average wage in the indexing year.</summary>
+  double indexYearAvgWage;
+  /// <summary>Average wage in each year from the first year through the
+  /// indexing year.</summary>
+  std::vector< double > avgWage;
+  /// <summary>Unindexed earnings, by year and worker.</summary>
+  std::vector< double > earnings;
+  /// <summary>Earnings multiplied by the average wage in the indexing year,
+  /// by year and worker.</summary>
+  std::vector< double > earnMultiplied;
+  /// <summary>Indexed earnings, by year and worker.</summary>
+  std::vector< double > earnIndexed;
+  /// <summary>True if the earnings added have been indexed.</summary>
+  bool indexed;
+public:
+  WageIndBatch( int newFirstYear, int newLastYear, unsigned newCapacity );
+  ~WageIndBatch();
+  unsigned add( const DoubleAnnual& newEarnings );
+  void clear( int newBaseYear, const DoubleAnnual& newAvgWage );
+  /// <summary>Returns the indexing year.</summary>
+  ///
+  /// <returns>The indexing year.</returns>
+  int getBaseYear() const { return(baseYear); }
+  /// <summary>Returns the maximum number of workers.</summary>
+  ///
+  /// <returns>The maximum number of workers.</returns>
+  unsigned getCapacity() const { return(capacity); }
+  /// <summary>Returns unindexed earnings of one worker.</summary>
+  ///
+  /// <returns>Unindexed earnings of one worker.</returns>
+  ///
+  /// <exception cref="PiaException"><see cref="PiaException"/> if the
+  /// worker or year is out of range (only in debug mode).</exception>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="year">Year of earnings.</param>
+  double getEarnings( unsigned worker, int year ) const
+  {
+#if !defined(NDEBUG)
+    if (worker >= workerCount || year < firstYear || year > lastYear) {
+      throw PiaException(
+        "Worker or year out of range in WageIndBatch::getEarnings");
+    }
+#endif
+    return(earnings[(year - firstYear) * stride + worker]);
+  }
+  /// <summary>Returns indexed earnings of one worker.</summary>
+  ///
+  /// <returns>Indexed earnings of one worker.</returns>
+  ///
+  /// <exception cref="PiaException"><see cref="PiaException"/> if the
+  /// worker or year is out of range (only in debug mode).</exception>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="year">Year of earnings (no later than the indexing
+  /// year).</param>
+  double getEarnIndexed( unsigned worker, int year ) const
+  {
+#if !defined(NDEBUG)
+    if (worker >= workerCount || year < firstYear || year > baseYear) {
+      throw PiaException(
+        "Worker or year out of range in WageIndBatch::getEarnIndexed");
+    }
+#endif
+    return(earnIndexed[(year - firstYear) * stride + worker]);
+  }
+  /// <summary>Returns earnings of one worker multiplied by the average wage
+  /// in the indexing year.</summary>
+  ///
+  /// <returns>Earnings of one worker multiplied by the average wage in the
+  /// indexing year.</returns>
+  ///
+  /// <exception cref="PiaException"><see cref="PiaException"/> if the
+  /// worker or year is out of range (only in debug mode).</exception>
+  ///
+  /// <param name="worker">Number of worker, as returned by
+  /// <see cref="add"/>.</param>
+  /// <param name="year">Year of earnings (no later than the indexing
+  /// year).</param>
+  double getEarnMultiplied( unsigned worker, int year ) const
+  {
+#if !defined(NDEBUG)
+    if (worker >= workerCount || year < firstYear || year > baseYear) {
+      throw PiaException(
+        "Worker or year out of range in WageIndBatch::getEarnMultiplied");
+    }
+#endif
+    return(earnMultiplied[(year - firstYear) * stride + worker]);
+  }
+  /// <summary>Returns the first year of earnings stored.</summary>
+  ///
+  /// <returns>The first year of earnings stored.</returns>
+  int getFirstYear() const { return(firstYear); }
+  /// <summary>Returns average wage in the indexing year.</summary>
+  ///
+  /// <returns>Average wage in the indexing year.</returns>
+  double getIndexYearAvgWage() const { return(indexYearAvgWage); }
+  /// <summary>Returns the last year of earnings stored.</summary>
+  ///
+  /// <returns>The last year of earnings stored.</returns>
+  int getLastYear() const { return(lastYear); }
+  /// <summary>Returns the number of workers added.</summary>
+  ///
+  /// <returns>The number of workers added.</returns>
+  unsigned getWorkerCount() const { return(workerCount); }
+  void index();
+  bool isSameAvgWage( const DoubleAnnual& newAvgWage ) const;
+  /// <summary>Returns true if the earnings added have been indexed.
+  /// </summary>
+  ///
+  /// <returns>True if the earnings added have been indexed.</returns>
+  bool isIndexed() const { return(indexed); }
+  static void indexYear( const double *earnings, double *earnMultiplied,
+    double *earnIndexed, unsigned count, double indexYearAvgWage,
+    double yearAvgWage );
+private:
+  WageIndBatch( const WageIndBatch& );
+  WageIndBatch& operator=( const WageIndBatch& );
+};
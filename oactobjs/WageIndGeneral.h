@@ -6,6 +6,7 @@
 #pragma once
 
 #include "PiaMethod.h"
+class WageIndBatch;
 
 /// <summary>Parent of all classes that manage the functions required for
 /// calculation of a wage indexed Social Security benefit.</summary>
@@ -48,8 +49,8 @@ public:
     const PiaData& newPiaData, const PiaParams& newPiaParams,
     int newMaxyear, const std::string& newTitle, pia_type newMethod );
   virtual ~WageIndGeneral();
-  double aimepiaCal( const PortionAime& portionAime, const PercPia& percPiaTemp,
-    int year );
+  static double aimepiaCal( const PortionAime& portionAime,
+    const PercPia& percPiaTemp, int year );
   void bendPointCal( int eligYear, BendPia& bendPiaTemp ) const;
   double deconvertAme( const BendPia& bendPiaTemp,
     const PercPia& percPiaTemp ) const;
@@ -65,6 +66,9 @@ public:
   void indexEarnings( int year1, int year2, int year3,
     const DoubleAnnual& earnings, DoubleAnnual& earnMultiplied,
     DoubleAnnual& earnIndexed, const DoubleAnnual& avgWage );
+  void indexEarnings( int year1, int year3, const WageIndBatch& batch,
+    unsigned worker, DoubleAnnual& earnMultiplied,
+    DoubleAnnual& earnIndexed );
   void initialize();
   void realWageGainAdj( int eligYear );
   /// <summary>Sets windfall indicator in wage-indexed method.</summary>
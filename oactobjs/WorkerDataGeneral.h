@@ -71,6 +71,19 @@ public:
     QCSBYYEAR_BIT,  /// Indicator for QCs by single year prior to 1978.
     DEADOAB_BIT     /// Indicator for deceased OAB in survivor case.
   };
+  /// <summary>Kinds of changes to the data since the last calculation.
+  /// </summary>
+  ///
+  /// <remarks>These are bits that may be combined.</remarks>
+  enum ChangeType {
+    NO_CHANGE = 0,     // No change.
+    EARN_CHANGE = 1,   // Earnings, quarters of coverage, types of taxes,
+                       // or years of earnings.
+    DATE_CHANGE = 2,   // Dates of birth, entitlement, benefit, death, or
+                       // disability.
+    OTHER_CHANGE = 4,  // Any other data used in a calculation.
+    ALL_CHANGES = 7    // All of the above.
+  };
   /// <summary>Child care years, 1937 to 2100.</summary>
   BitAnnual childCareYears;
   /// <summary>Quarters of coverage, 1937 to
@@ -120,6 +133,17 @@ private:
   DateMoyr entDate;
   /// <summary>Month, day, and year of death.</summary>
   boost::gregorian::date deathDate;
+  /// <summary>Kinds of changes since the last calculation.</summary>
+  ///
+  /// <remarks>It is a combination of the values listed in
+  /// <see cref="ChangeType"/>. The setters record a change only if they
+  /// change a value; changes made directly to the public members are
+  /// recorded only with <see cref="addChanges"/>. The changes decide only
+  /// whether the pia methods are kept for the next calculation (see
+  /// <see cref="PiaCal::setIncremental"/>), not whether they are calculated
+  /// again, so a change that is not recorded cannot change the results.
+  /// </remarks>
+  unsigned changes;
 protected:
   /// <summary>Maximum year allowed.</summary>
   static int maxyear;
@@ -130,6 +154,12 @@ public:
   WorkerDataGeneral();
   WorkerDataGeneral( const WorkerDataGeneral& workerData );
   virtual ~WorkerDataGeneral();
+  /// <summary>Records changes made without a setter, such as to the
+  /// quarters of coverage or the periods of disability.</summary>
+  ///
+  /// <param name="newChanges">Kinds of changes (a combination of the values
+  /// listed in <see cref="ChangeType"/>).</param>
+  void addChanges( unsigned newChanges ) { changes |= newChanges; }
   /// <summary>Returns true if any self-employed taxes.</summary>
   ///
   /// <remarks>Needs to be implemented by a child class.</remarks>
@@ -175,6 +205,9 @@ public:
   /// <see cref="PIA_IDS_BIRTH5"/> if year of birth is after maximum allowed.
   /// </exception>
   void birth2Check() const { birth2Check(birthDate); }
+  /// <summary>Forgets the changes recorded since the last calculation.
+  /// </summary>
+  void clearChanges() { changes = NO_CHANGE; }
   /// <summary>Checks date of disability cessation, using stored values.
   /// </summary>
   ///
@@ -201,9 +234,10 @@ public:
   virtual void deleteContents();
   /// <summary>Deletes date of death.</summary>
   void deleteDeathDate()
-  { deathDate = boost::gregorian::date(boost::date_time::not_a_date_time); }
+  { deathDate = boost::gregorian::date(boost::date_time::not_a_date_time);
+    changes |= DATE_CHANGE; }
   /// <summary>Deletes date of entitlement.</summary>
-  void deleteEntDate() { entDate = DateMoyr(0,0); }
+  void deleteEntDate() { entDate = DateMoyr(0,0); changes |= DATE_CHANGE; }
   /// <summary>Checks date of disability onset, using stored values.</summary>
   ///
   /// <remarks>This version passes stored values to the static version with 7
@@ -270,6 +304,12 @@ public:
   ///
   /// <returns>True if blind, false otherwise.</returns>
   bool getBlindind() const { return(theBits[BLIND_BIT]); }
+  /// <summary>Returns the kinds of changes since the last calculation.
+  /// </summary>
+  ///
+  /// <returns>A combination of the values listed in
+  /// <see cref="ChangeType"/>.</returns>
+  unsigned getChanges() const { return(changes); }
   /// <summary>Returns date of death.</summary>
   ///
   /// <returns>The date of death.</returns>
@@ -677,7 +717,7 @@ public:
   /// <summary>Sets blind indicator.</summary>
   ///
   /// <param name="newBlindind">New blind indicator.</param>
-  void setBlindind( bool newBlindind ) { theBits[BLIND_BIT] = newBlindind; }
+  void setBlindind( bool newBlindind ) { setBit(BLIND_BIT, newBlindind); }
   void setCessationDate( unsigned index, const DateMoyr& dateMoyr );
   void setCessationMfb( unsigned index, float newMfb );
   void setCessationPia( unsigned index, float newPia );
@@ -686,12 +726,12 @@ public:
   ///
   /// <param name="newDeceasedOAB">New deceased OAB indicator.</param>
   void setDeceasedOAB( bool newDeceasedOAB )
-  { theBits[DEADOAB_BIT] = newDeceasedOAB; }
+  { setBit(DEADOAB_BIT, newDeceasedOAB); }
   /// <summary>Sets deemed insured indicator.</summary>
   ///
   /// <param name="newDeemedind">New deemed insured indicator.</param>
   void setDeemedind( bool newDeemedind )
-  { theBits[DEEMED_BIT] = newDeemedind; }
+  { setBit(DEEMED_BIT, newDeemedind); }
   /// <summary>Sets Medicare earnings for the specified year.</summary>
   ///
   /// <remarks>Needs to be implemented by a child class.</remarks>
@@ -707,12 +747,12 @@ public:
   /// <summary>Sets railroad indicator.</summary>
   ///
   /// <param name="newIndrr">New railroad indicator.</param>
-  void setIndrr( bool newIndrr ) { theBits[INDRR_BIT] = newIndrr; }
+  void setIndrr( bool newIndrr ) { setBit(INDRR_BIT, newIndrr); }
   void setJoasdi( int newJoasdi );
   /// <summary>Sets mqge indicator.</summary>
   ///
   /// <param name="newMqge">New mqge indicator.</param>
-  void setMqge( bool newMqge ) { theBits[MQGE_BIT] = newMqge; }
+  void setMqge( bool newMqge ) { setBit(MQGE_BIT, newMqge); }
   /// <summary>Sets one line of address.</summary>
   ///
   /// <remarks>Needs to be implemented by a child class.</remarks>
@@ -737,7 +777,8 @@ public:
   /// changes, or after a Statement calculation has been done.</summary>
   ///
   /// <param name="year">First year of projection period.</param>
-  void setPebsEarn( int year ) { iend = (unsigned short)(1 + year); }
+  void setPebsEarn( int year )
+  { iend = (unsigned short)(1 + year); changes |= EARN_CHANGE; }
   void setPriorentDate( unsigned index, const DateMoyr& dateMoyr );
   void setPriorentDateCheck( unsigned index, const DateMoyr& dateMoyr );
   /// <summary>Sets amount of monthly noncovered pension.</summary>
@@ -759,17 +800,17 @@ public:
   /// <param name="newQcsByYear">Indicator for QCs by year prior to 1978.
   /// </param>
   void setQcsByYear( bool newQcsByYear )
-  { theBits[QCSBYYEAR_BIT] = newQcsByYear; }
+  { setBit(QCSBYYEAR_BIT, newQcsByYear); }
   void setQctd( int qct );
   /// <summary>Sets recalculation indicator.</summary>
   ///
   /// <param name="newRecalc">New recalculation indicator.</param>
-  void setRecalc( bool newRecalc ) { theBits[RECALC_BIT] = newRecalc; }
+  void setRecalc( bool newRecalc ) { setBit(RECALC_BIT, newRecalc); }
   /// <summary>Sets reservist indicator.</summary>
   ///
   /// <param name="newReservist">New reservist indicator.</param>
   void setReservist( bool newReservist )
-  { theBits[RESERVIST_BIT] = newReservist; }
+  { setBit(RESERVIST_BIT, newReservist); }
   void setSex( Sex::sex_type newSex );
   /// <summary>Sets type of taxes for the specified year.</summary>
   ///
@@ -779,7 +820,7 @@ public:
   ///
   /// <param name="newTotalize">New totalization indicator.</param>
   void setTotalize( bool newTotalize )
-  { theBits[TOTALIZE_BIT] = newTotalize; }
+  { setBit(TOTALIZE_BIT, newTotalize); }
   void setValdi( int newValdi );
   void setWaitperDate( unsigned index );
   void setWaitperDate( unsigned index, const DateMoyr& dateMoyr );
@@ -832,7 +873,7 @@ public:
   ///  and after last year of specified earnings.</summary>
   virtual void zeroEarnOasdi( int, int ) { };
   /// <summary>Zeroes out the type of benefit.</summary>
-  void zeroOasdi() { joasdi = NO_BEN; }
+  void zeroOasdi() { joasdi = NO_BEN; changes |= OTHER_CHANGE; }
   static void benefitDate1Check( const DateMoyr& datetemp );
   /// <summary>Checks that date of benefit is at or after entitlement, using
   /// passed values.</summary>
@@ -1096,4 +1137,15 @@ public:
       throw PiaException(PIA_IDS_WAITPD4);
     if (cessation1Datet < waitper1Datet)
       throw PiaException(PIA_IDS_WAITPD6); }
+private:
+  /// <summary>Sets one member of the bitset, recording a change if it
+  /// changes.</summary>
+  ///
+  /// <param name="bit">The member to set.</param>
+  /// <param name="value">New value of the member.</param>
+  void setBit( BitsetMembers bit, bool value )
+  { if (theBits[bit] != value) {
+      theBits[bit] = value;
+      changes |= OTHER_CHANGE;
+    } }
 };
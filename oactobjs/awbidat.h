@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <iosfwd>
 #include "dbleann.h"
 
 /// <summary>Manages the historical Social Security parameters.</summary>
@@ -43,6 +44,7 @@ public:
   /// <returns>Last year of historical wage bases.</returns>
   int getLastYear() const { return(lastYear); }
   virtual void read();
+  unsigned readChanges( std::istream& in );
   /// <summary>Set data values.</summary>
   virtual void setData() = 0;
   /// <summary>Sets last year of historical wage bases.</summary>
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include "boost/serialization/access.hpp"
 
 /// <summary>Represents one 2-character bic (Beneficiary Identification code)
 /// code.</summary>
@@ -43,6 +44,20 @@
 /// An instance of this class is used in <see cref="Secondary"/>.</remarks>
 class Bic
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & majorBic & minorBic; }
 private:
   /// <summary>Major bic code.</summary>
   ///
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include "boost/serialization/access.hpp"
 
 /// <summary>Manages the catch-up benefit increases for one year of
 /// eligibility.</summary>
@@ -14,6 +15,20 @@
 /// any catch-up increases used would be projected ones.</remarks>
 class CatchupIncreases
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & theData; }
 public:
   /// <summary>The number of catch-up increases for one year of
   /// eligibility (8).</summary>
@@ -47,6 +62,20 @@ public:
 /// any catch-up increases used would be projected ones.</remarks>
 class Catchup
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & cstart & catchup; }
 public:
   /// <summary>The number of years of eligibility considered (10).</summary>
   static const int NUM_CATCHUP_ELIG_YEARS = 10;
@@ -8,13 +8,17 @@
 #include <numeric>
 #include <vector>
 #include "boost/serialization/access.hpp"
+#include "CalcArena.h"
 #include "Resource.h"
 #include "PiaException.h"
 
 /// <summary>Manages an array of annual doubles.</summary>
 ///
 /// <remarks>See <see cref="FloatAnnual"/> and <see cref="IntAnnual"/> for
-/// similar classes that manage arrays of annual floats and integers.</remarks>
+/// similar classes that manage arrays of annual floats and integers.
+///
+/// The vector takes its memory from the <see cref="CalcArena"/> current
+/// when the instance is created, if any.</remarks>
 class DoubleAnnual
 {
   /// <summary>Friend class to allow serialization.</summary>
@@ -33,7 +37,7 @@ class DoubleAnnual
     { ar & theData; }
 public:
   /// <summary>Vector of doubles.</summary>
-  std::vector< double > theData;
+  std::vector< double, ArenaAllocator< double > > theData;
   /// <summary>Base year of data.</summary>
   const int baseYear;
 private:
@@ -6,21 +6,40 @@
 #pragma once
 
 #include <vector>
+#include "boost/serialization/access.hpp"
+#include "CalcArena.h"
 #include "PiaException.h"
 #include "Resource.h"
 
 /// <summary>Manages an array of annual integers.</summary>
 ///
 /// <remarks>See <see cref="DoubleAnnual"/> and <see cref="FloatAnnual"/> for
-/// similar classes that manage arrays of annual doubles and floats.</remarks>
+/// similar classes that manage arrays of annual doubles and floats.
+///
+/// The vector takes its memory from the <see cref="CalcArena"/> current
+/// when the instance is created, if any.</remarks>
 ///
 /// <seealso cref="DoubleAnnual"/>
 /// <seealso cref="FloatAnnual"/>
 class IntAnnual
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & theData; }
 public:
   /// <summary>Integer array.</summary>
-  std::vector< int > theData;
+  std::vector< int, ArenaAllocator< int > > theData;
   /// <summary>Base year of data.</summary>
   const int baseYear;
 private:
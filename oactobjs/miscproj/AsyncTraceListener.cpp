@@ -0,0 +1,407 @@
+// Functions for the <see cref="AsyncTraceListener"/> class that listens for
+// <see cref="Trace"/> output and writes it to an ostream on a background
+// thread.
+
+#include <cstring>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include "boost/chrono/chrono.hpp"
+#include "AsyncTraceListener.h"
+#include "PiaException.h"
+
+using namespace std;
+
+const char AsyncTraceListener::magic[] = "PIATRACE";
+
+/// <summary>Creates an empty ring buffer.</summary>
+///
+/// <param name="size">Size of the ring buffer, in bytes.</param>
+/// <param name="newThread">Number of the thread.</param>
+AsyncTraceListener::Ring::Ring( unsigned size, unsigned newThread ) :
+queue(size), thread(newThread), dropped(0ul), reported(0ul), pending(),
+record()
+{ }
+
+/// <summary>Creates this instance and starts the drain thread.</summary>
+///
+/// <remarks>In binary format, the header is written to the stream here.
+/// </remarks>
+///
+/// <param name="newStream">The output stream to use as the logfile (opened
+/// in binary mode for binary format).</param>
+/// <param name="newBinary">True to write the binary format, false to
+/// write text.</param>
+/// <param name="newRingSize">Size of the ring buffer of each thread, in
+/// bytes.</param>
+AsyncTraceListener::AsyncTraceListener( std::ostream *newStream,
+bool newBinary, unsigned newRingSize ) :
+TraceListener(), strm(newStream), binary(newBinary),
+ringSize((newRingSize > RECORD_HEADER_SIZE) ? newRingSize :
+RECORD_HEADER_SIZE + 1u), startTime(now()), threadRing(noCleanup),
+rings(), mutex(), drained(), requested(0ul), finished(0ul),
+stopping(false), buffer(), drainThread()
+{
+  if (binary) {
+    char header[HEADER_SIZE];
+    memcpy(header, magic, 8);
+    const boost::uint32_t values[2] = { VERSION, ENDIAN_MARK };
+    memcpy(header + 8, values, sizeof(values));
+    strm->write(header, sizeof(header));
+  }
+  drainThread = boost::thread(&AsyncTraceListener::drainLoop, this);
+}
+
+/// <summary>Stops the drain thread and releases the ring buffers.
+/// </summary>
+AsyncTraceListener::~AsyncTraceListener()
+{
+  close();
+  for (size_t i = 0; i < rings.size(); i++) {
+    delete rings[i];
+  }
+}
+
+/// <summary>Writes all records traced so far, and stops the drain thread.
+/// </summary>
+///
+/// <remarks>Text of the current thread without a newline is written first.
+/// Records traced after this are not written.</remarks>
+void AsyncTraceListener::close()
+{
+  if (!drainThread.joinable())
+    return;
+  flush();
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    stopping = true;
+    drained.notify_all();
+  }
+  drainThread.join();
+}
+
+/// <summary>Writes all records traced so far by any thread, and flushes
+/// the stream.</summary>
+///
+/// <remarks>Text of the current thread without a newline is added as a
+/// record first. This waits for the drain thread.</remarks>
+void AsyncTraceListener::flush()
+{
+  Ring *ring = threadRing.get();
+  if (ring != 0 && !ring->pending.empty()) {
+    add(TEXT, ring->pending.data(), ring->pending.size());
+    ring->pending.clear();
+  }
+  boost::mutex::scoped_lock lock(mutex);
+  if (stopping)
+    return;
+  const unsigned long target = ++requested;
+  drained.notify_all();
+  while (finished < target) {
+    drained.wait(lock);
+  }
+}
+
+/// <summary>Returns the number of records dropped because a ring buffer
+/// was full.</summary>
+///
+/// <returns>The number of records dropped on all threads.</returns>
+unsigned long AsyncTraceListener::getDropped()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  unsigned long total = 0ul;
+  for (size_t i = 0; i < rings.size(); i++) {
+    total += rings[i]->dropped.load(boost::memory_order_relaxed);
+  }
+  return(total);
+}
+
+/// <summary>Write a string of output, without a newline.</summary>
+///
+/// <remarks>The string is kept until the next line is written.</remarks>
+///
+/// <param name="str">The string to output.</param>
+void AsyncTraceListener::write( const std::string& str )
+{
+  getRing()->pending += str;
+}
+
+/// <summary>Write the characters of output, without a newline.</summary>
+///
+/// <remarks>The characters are kept until the next line is written.
+/// </remarks>
+///
+/// <param name="str">The characters to output.</param>
+void AsyncTraceListener::write( const char *str )
+{
+  getRing()->pending += str;
+}
+
+/// <summary>Write a string of output, with a newline.</summary>
+///
+/// <param name="str">The string to output.</param>
+void AsyncTraceListener::writeLine( const std::string& str )
+{
+  Ring *ring = getRing();
+  if (ring->pending.empty()) {
+    add(LINE, str.data(), str.size());
+  }
+  else {
+    ring->pending += str;
+    add(LINE, ring->pending.data(), ring->pending.size());
+    ring->pending.clear();
+  }
+}
+
+/// <summary>Write the characters of output, with a newline.</summary>
+///
+/// <param name="str">The characters to output.</param>
+void AsyncTraceListener::writeLine( const char *str )
+{
+  Ring *ring = getRing();
+  if (ring->pending.empty()) {
+    add(LINE, str, strlen(str));
+  }
+  else {
+    ring->pending += str;
+    add(LINE, ring->pending.data(), ring->pending.size());
+    ring->pending.clear();
+  }
+}
+
+/// <summary>Adds a record to the ring buffer of the current thread.
+/// </summary>
+///
+/// <remarks>The record is dropped and counted if the ring is full. The
+/// record is added with one push, so the drain thread sees all of it or
+/// none of it.</remarks>
+///
+/// <param name="kind">Kind of record.</param>
+/// <param name="str">Text of the record.</param>
+/// <param name="length">Length of the text.</param>
+void AsyncTraceListener::add( record_kind kind, const char *str,
+size_t length )
+{
+  Ring *ring = getRing();
+  const size_t total = RECORD_HEADER_SIZE + length;
+  if (length > 0xffffffffu || total > ring->queue.write_available()) {
+    ring->dropped.fetch_add(1ul, boost::memory_order_relaxed);
+    return;
+  }
+  ring->record.resize(total);
+  char *record = &ring->record[0];
+  const boost::uint32_t size = static_cast<boost::uint32_t>(length);
+  const boost::uint16_t ids[2] = { static_cast<boost::uint16_t>(
+    ring->thread), static_cast<boost::uint16_t>(kind) };
+  const boost::uint64_t time = now() - startTime;
+  memcpy(record, &size, 4);
+  memcpy(record + 4, ids, 4);
+  memcpy(record + 8, &time, 8);
+  if (length > 0)
+    memcpy(record + RECORD_HEADER_SIZE, str, length);
+  ring->queue.push(record, total);
+}
+
+/// <summary>Moves the records in all ring buffers to the output buffer,
+/// with a report of any records dropped.</summary>
+///
+/// <returns>True if any records were moved.</returns>
+bool AsyncTraceListener::drain()
+{
+  vector< Ring* > current;
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    current = rings;
+  }
+  bool found = false;
+  char header[RECORD_HEADER_SIZE];
+  for (vector< Ring* >::iterator it = current.begin(); it != current.end();
+    ++it) {
+    Ring *ring = *it;
+    while (ring->queue.read_available() >= RECORD_HEADER_SIZE) {
+      ring->queue.pop(header, RECORD_HEADER_SIZE);
+      boost::uint32_t length;
+      boost::uint16_t ids[2];
+      memcpy(&length, header, 4);
+      memcpy(ids, header + 4, 4);
+      const size_t start = buffer.size();
+      if (binary) {
+        buffer.resize(start + RECORD_HEADER_SIZE + length);
+        memcpy(&buffer[start], header, RECORD_HEADER_SIZE);
+        if (length > 0)
+          ring->queue.pop(&buffer[start + RECORD_HEADER_SIZE], length);
+      }
+      else {
+        buffer.resize(start + length);
+        if (length > 0)
+          ring->queue.pop(&buffer[start], length);
+        if (ids[1] == LINE)
+          buffer.push_back('\n');
+      }
+      found = true;
+    }
+    const unsigned long dropped =
+      ring->dropped.load(boost::memory_order_relaxed);
+    if (dropped != ring->reported) {
+      const boost::uint64_t count = dropped - ring->reported;
+      ring->reported = dropped;
+      if (binary) {
+        const boost::uint32_t length = 8u;
+        const boost::uint16_t ids[2] = {
+          static_cast<boost::uint16_t>(ring->thread), DROPPED };
+        const boost::uint64_t time = now() - startTime;
+        const size_t start = buffer.size();
+        buffer.resize(start + RECORD_HEADER_SIZE + 8u);
+        memcpy(&buffer[start], &length, 4);
+        memcpy(&buffer[start + 4], ids, 4);
+        memcpy(&buffer[start + 8], &time, 8);
+        memcpy(&buffer[start + RECORD_HEADER_SIZE], &count, 8);
+      }
+      else {
+        ostringstream strm1;
+        strm1 << "*** " << count << " trace records dropped on thread "
+          << ring->thread << endl;
+        const string text = strm1.str();
+        buffer.insert(buffer.end(), text.begin(), text.end());
+      }
+      found = true;
+    }
+  }
+  return(found);
+}
+
+/// <summary>Drains the ring buffers until the listener is closed.
+/// </summary>
+///
+/// <remarks>This is the body of the drain thread. It drains every few
+/// milliseconds, or at once when a flush is requested, and flushes the
+/// stream after a requested pass.</remarks>
+void AsyncTraceListener::drainLoop()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  for (;;) {
+    const unsigned long target = requested;
+    const bool stop = stopping;
+    lock.unlock();
+    while (drain()) {
+      writeBuffer();
+    }
+    if (target != finished || stop)
+      strm->flush();
+    lock.lock();
+    finished = target;
+    drained.notify_all();
+    if (stop)
+      break;
+    if (requested == finished && !stopping)
+      drained.wait_for(lock, boost::chrono::milliseconds(2));
+  }
+}
+
+/// <summary>Returns the ring buffer of the current thread, creating it
+/// the first time the thread traces.</summary>
+///
+/// <returns>The ring buffer of the current thread.</returns>
+AsyncTraceListener::Ring *AsyncTraceListener::getRing()
+{
+  Ring *ring = threadRing.get();
+  if (ring == 0) {
+    boost::mutex::scoped_lock lock(mutex);
+    ring = new Ring(ringSize, static_cast<unsigned>(rings.size()));
+    rings.push_back(ring);
+    threadRing.reset(ring);
+  }
+  return(ring);
+}
+
+/// <summary>Writes the output buffer to the stream.</summary>
+void AsyncTraceListener::writeBuffer()
+{
+  if (!buffer.empty()) {
+    strm->write(&buffer[0], static_cast<streamsize>(buffer.size()));
+    buffer.clear();
+  }
+}
+
+/// <summary>Does nothing when a thread that traced exits.</summary>
+///
+/// <remarks>The rings are released by the destructor, since the drain
+/// thread may still be reading them.</remarks>
+void AsyncTraceListener::noCleanup( Ring * )
+{ }
+
+/// <summary>Returns the current time.</summary>
+///
+/// <returns>Nanoseconds since an arbitrary starting time.</returns>
+boost::uint64_t AsyncTraceListener::now()
+{
+  return(static_cast<boost::uint64_t>(
+    boost::chrono::duration_cast< boost::chrono::nanoseconds >(
+    boost::chrono::steady_clock::now().time_since_epoch()).count()));
+}
+
+/// <summary>Converts a stream in binary format to text.</summary>
+///
+/// <remarks>Each record is written on one line, with the seconds since the
+/// listener was created and the thread number before its text.</remarks>
+///
+/// <returns>The number of records converted.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the input
+/// is not in binary format, was written on a machine with a different byte
+/// order, or ends in the middle of a record.</exception>
+///
+/// <param name="in">Stream in binary format, opened in binary mode.</param>
+/// <param name="out">Stream to write the text to.</param>
+unsigned long AsyncTraceListener::decode( std::istream& in,
+std::ostream& out )
+{
+  char header[HEADER_SIZE];
+  in.read(header, HEADER_SIZE);
+  boost::uint32_t values[2];
+  memcpy(values, header + 8, sizeof(values));
+  if (in.gcount() != HEADER_SIZE || memcmp(header, magic, 8) != 0)
+    throw PiaException("Not a binary trace file");
+  if (values[1] != ENDIAN_MARK)
+    throw PiaException("Binary trace file has a different byte order");
+  if (values[0] != VERSION)
+    throw PiaException("Unsupported version of binary trace file");
+  const ios::fmtflags flags = out.flags();
+  out.setf(ios::fixed, ios::floatfield);
+  const streamsize precision = out.precision(9);
+  unsigned long records = 0ul;
+  string text;
+  for (;;) {
+    in.read(header, RECORD_HEADER_SIZE);
+    if (in.gcount() == 0)
+      break;
+    if (in.gcount() != RECORD_HEADER_SIZE)
+      throw PiaException("Incomplete record in binary trace file");
+    boost::uint32_t length;
+    boost::uint16_t ids[2];
+    boost::uint64_t time;
+    memcpy(&length, header, 4);
+    memcpy(ids, header + 4, 4);
+    memcpy(&time, header + 8, 8);
+    text.resize(length);
+    if (length > 0) {
+      in.read(&text[0], length);
+      if (static_cast<boost::uint32_t>(in.gcount()) != length)
+        throw PiaException("Incomplete record in binary trace file");
+    }
+    out << time / 1.0e9 << " " << ids[0] << " ";
+    if (ids[1] == DROPPED && length == 8u) {
+      boost::uint64_t count;
+      memcpy(&count, text.data(), 8);
+      out << "*** " << count << " trace records dropped" << endl;
+    }
+    else {
+      out << text << endl;
+    }
+    records++;
+  }
+  out.flags(flags);
+  out.precision(precision);
+  return(records);
+}
@@ -0,0 +1,222 @@
+// Functions for the <see cref="CalcArena"/> class to provide memory for the
+// objects of one calculation.
+
+#include "boost/thread/tss.hpp"
+#include "CalcArena.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>State of the arenas of one thread.</summary>
+struct ThreadState
+{
+  /// <summary>Current arena (may be null).</summary>
+  CalcArena *current;
+  /// <summary>Number of blocks of memory taken from the heap.</summary>
+  unsigned long allocations;
+  ThreadState() : current(0), allocations(0ul) { }
+};
+
+/// <summary>Returns the state of the arenas of the current thread.
+/// </summary>
+///
+/// <remarks>The state is created the first time a thread uses it, and
+/// deleted when the thread exits.</remarks>
+///
+/// <returns>The state of the arenas of the current thread.</returns>
+ThreadState& getThreadState()
+{
+  // a local static, so it can be used while other statics are constructed
+  static boost::thread_specific_ptr< ThreadState > threadState;
+  ThreadState *state = threadState.get();
+  if (state == 0) {
+    state = new ThreadState();
+    threadState.reset(state);
+  }
+  return(*state);
+}
+
+}  // namespace
+
+/// <summary>Makes an arena current for the thread.</summary>
+///
+/// <param name="arena">Arena to make current (may be null).</param>
+CalcArena::Scope::Scope( CalcArena *arena ) :
+previous(0), active(true)
+{
+  ThreadState& state = getThreadState();
+  previous = state.current;
+  state.current = arena;
+}
+
+/// <summary>Restores the arena that was current before this scope.
+/// </summary>
+CalcArena::Scope::~Scope()
+{
+  leave();
+}
+
+/// <summary>Restores the arena that was current before this scope, before
+/// the end of the scope.</summary>
+void CalcArena::Scope::leave()
+{
+  if (active) {
+    getThreadState().current = previous;
+    active = false;
+  }
+}
+
+/// <summary>Creates an arena with no memory.</summary>
+///
+/// <param name="newBlockSize">Size of a new block, in bytes.</param>
+CalcArena::CalcArena( size_t newBlockSize ) :
+blocks(), used(0u), usedBefore(0u), highWater(0u),
+blockSize((newBlockSize > ALIGNMENT) ? roundUp(newBlockSize) : ALIGNMENT)
+{ }
+
+/// <summary>Releases all memory.</summary>
+///
+/// <remarks>All objects in the arena must already be destroyed.</remarks>
+CalcArena::~CalcArena()
+{
+  releaseBlocks();
+}
+
+/// <summary>Allocates memory from the arena.</summary>
+///
+/// <returns>The memory allocated, aligned to
+/// <see cref="CalcArena::ALIGNMENT"/> bytes.</returns>
+///
+/// <param name="size">Number of bytes.</param>
+void *CalcArena::allocate( size_t size )
+{
+  size = roundUp((size > 0u) ? size : 1u);
+  if (blocks.empty() || size > blocks.back().size - used) {
+    usedBefore += used;
+    used = 0u;
+    addBlock((size > blockSize) ? size : blockSize);
+  }
+  void *p = blocks.back().data + used;
+  used += size;
+  if (usedBefore + used > highWater)
+    highWater = usedBefore + used;
+  return(p);
+}
+
+/// <summary>Returns the total size of the blocks.</summary>
+///
+/// <returns>The total size of the blocks, in bytes.</returns>
+size_t CalcArena::getCapacity() const
+{
+  size_t capacity = 0u;
+  for (vector< Block >::const_iterator it = blocks.begin();
+    it != blocks.end(); ++it) {
+    capacity += it->size;
+  }
+  return(capacity);
+}
+
+/// <summary>Makes all memory in the arena available again.</summary>
+///
+/// <remarks>All objects in the arena must already be destroyed. If more
+/// than one block was used, they are replaced by one block of the same
+/// total size.</remarks>
+void CalcArena::reset()
+{
+  if (blocks.size() > 1u) {
+    const size_t capacity = getCapacity();
+    releaseBlocks();
+    addBlock(capacity);
+  }
+  used = 0u;
+  usedBefore = 0u;
+}
+
+/// <summary>Allocates memory for an object from the current arena, or
+/// from the heap if there is none.</summary>
+///
+/// <remarks>This is used by the operator new of classes whose objects are
+/// created for one calculation. The memory starts with a header giving the
+/// arena, so <see cref="deallocateObject"/> knows whether to release it.
+/// </remarks>
+///
+/// <returns>The memory allocated.</returns>
+///
+/// <param name="size">Number of bytes.</param>
+void *CalcArena::allocateObject( size_t size )
+{
+  CalcArena *arena = getCurrent();
+  char *p;
+  if (arena != 0) {
+    p = static_cast<char *>(arena->allocate(size + ALIGNMENT));
+  }
+  else {
+    countAllocation();
+    p = static_cast<char *>(::operator new(size + ALIGNMENT));
+  }
+  *reinterpret_cast<CalcArena **>(p) = arena;
+  return(p + ALIGNMENT);
+}
+
+/// <summary>Releases memory allocated by <see cref="allocateObject"/>, if
+/// it is not from an arena.</summary>
+///
+/// <param name="p">Memory to release (may be null).</param>
+void CalcArena::deallocateObject( void *p )
+{
+  if (p == 0)
+    return;
+  char *start = static_cast<char *>(p) - ALIGNMENT;
+  if (*reinterpret_cast<CalcArena **>(start) == 0)
+    ::operator delete(start);
+}
+
+/// <summary>Counts one block of memory taken from the heap by the current
+/// thread.</summary>
+void CalcArena::countAllocation()
+{
+  getThreadState().allocations++;
+}
+
+/// <summary>Returns the arena current for the thread.</summary>
+///
+/// <returns>The arena current for the thread, or null if there is none.
+/// </returns>
+CalcArena *CalcArena::getCurrent()
+{
+  return(getThreadState().current);
+}
+
+/// <summary>Returns the number of blocks of memory taken from the heap by
+/// the current thread for arenas, and for arrays and objects with no
+/// arena.</summary>
+///
+/// <returns>The number of blocks taken from the heap by the current
+/// thread.</returns>
+unsigned long CalcArena::getThreadAllocations()
+{
+  return(getThreadState().allocations);
+}
+
+/// <summary>Adds a block and makes it current.</summary>
+///
+/// <param name="size">Size of the block, in bytes.</param>
+void CalcArena::addBlock( size_t size )
+{
+  Block block;
+  block.data = static_cast<char *>(::operator new(size));
+  block.size = size;
+  countAllocation();
+  blocks.push_back(block);
+}
+
+/// <summary>Releases all blocks.</summary>
+void CalcArena::releaseBlocks()
+{
+  for (vector< Block >::iterator it = blocks.begin(); it != blocks.end();
+    ++it) {
+    ::operator delete(it->data);
+  }
+  blocks.clear();
+}
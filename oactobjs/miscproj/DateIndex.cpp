@@ -0,0 +1,86 @@
+// Functions for the <see cref="DateIndex"/> class to manage a date as a
+// month index and day of month.
+
+#include "DateIndex.h"
+#include "age.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Initializes the date from a <c>boost::gregorian::date</c>.
+/// </summary>
+///
+/// <remarks>The year, month, and day are found with one conversion. A date
+/// that is not a date gives zeroes.</remarks>
+///
+/// <param name="date">The date to copy from.</param>
+DateIndex::DateIndex( const boost::gregorian::date& date ) :
+monthIndex(0), dayOfMonth(0)
+{
+  if (!date.is_special()) {
+    const boost::gregorian::date::ymd_type ymd = date.year_month_day();
+    monthIndex = 12 * static_cast<int>(ymd.year) +
+      static_cast<int>(ymd.month) - 1;
+    dayOfMonth = ymd.day;
+  }
+}
+
+/// <summary>Initializes the date from a <see cref="DateMoyr"/>.</summary>
+///
+/// <remarks>The day of the month is set to zero. A month and year that is not
+/// a date gives zeroes.</remarks>
+///
+/// <param name="dateMoyr">The month and year to copy from.</param>
+DateIndex::DateIndex( const DateMoyr& dateMoyr ) :
+monthIndex(dateMoyr.isNotADate() ? 0 :
+  12 * static_cast<int>(dateMoyr.getYear()) + dateMoyr.getMonth() - 1),
+dayOfMonth(0)
+{ }
+
+/// <summary>Compares this date to another one.</summary>
+///
+/// <returns>True if this date is before argument date.</returns>
+///
+/// <param name="dateIndex">The date to compare to.</param>
+bool DateIndex::operator<( const DateIndex& dateIndex ) const
+{
+  if (monthIndex != dateIndex.monthIndex)
+    return(monthIndex < dateIndex.monthIndex);
+  return(dayOfMonth < dateIndex.dayOfMonth);
+}
+
+/// <summary>Returns the date at which an age is attained.</summary>
+///
+/// <returns>The date this date plus the given age, with the same day of the
+/// month.</returns>
+///
+/// <param name="age">The age to add.</param>
+DateIndex DateIndex::operator+( const Age& age ) const
+{
+  DateIndex rv(*this);
+  rv.monthIndex += age.toMonths();
+  return(rv);
+}
+
+/// <summary>Returns the age at this date, of someone born at another date.
+/// </summary>
+///
+/// <remarks>As in <see cref="DateMoyr::operator-"/>, only the months are
+/// counted.</remarks>
+///
+/// <returns>The years and months from the other date to this date.
+/// </returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the other
+/// date is in a later month.</exception>
+///
+/// <param name="dateIndex">The earlier date.</param>
+Age DateIndex::operator-( const DateIndex& dateIndex ) const
+{
+  const int months = monthIndex - dateIndex.monthIndex;
+  if (months < 0) {
+    throw PiaException("Dates out of order in operator-");
+  }
+  return Age(static_cast<unsigned>(months / 12),
+    static_cast<unsigned>(months % 12));
+}
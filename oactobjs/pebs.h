@@ -6,6 +6,7 @@
 #pragma once
 
 #include <vector>
+#include "boost/serialization/access.hpp"
 #include "age.h"
 
 /// <summary>Manages most of the data required to prepare and print out the
@@ -15,6 +16,20 @@
 /// results of a Statement calculation.</remarks>
 class Pebs
 {
+  /// <summary>Friend class to allow serialization.</summary>
+  friend class boost::serialization::access;
+  /// <summary>Archives the data read from a pia file.</summary>
+  ///
+  /// <remarks>When the class Archive corresponds to an output archive, the
+  /// & operator is defined similar to <<. Likewise, when the class Archive is
+  /// a type of input archive, the & operator is defined similar to >>.
+  /// </remarks>
+  ///
+  /// <param name="ar">The archive to use.</param>
+  /// <param name="version">The version of the archive to use.</param>
+  template< class Archive >
+  void serialize( Archive& ar, const unsigned int version )
+    { ar & agePlan & monthnow; }
 public:
   /// <summary>Type of Statement calculation.</summary>
   enum pebes_type {
@@ -24,6 +24,10 @@ class ChildCareCalc;
 class TransGuar;
 class DibGuar;
 class WageIndNonFreeze;
+class StageTimes;
+class CalcArena;
+class MethodPool;
+class MethodCounters;
 
 /// <summary>Parent of all classes that manage the functions required for
 /// calculation of a Social Security benefit.</summary>
@@ -49,6 +53,9 @@ public:
   /// <summary>Pia calculation methods that apply only to widow(er)s.
   /// </summary>
   std::vector<ReindWid *> widowMethod;
+  /// <summary>Methods kept from the last calculation that have not yet
+  /// been used again (see <see cref="keepMethods"/>).</summary>
+  std::vector<PiaMethod *> keptMethods;
   /// <summary>Pointer to wage-indexed method.</summary>
   WageInd* wageInd;
   /// <summary>Pointer to old-start method.</summary>
@@ -69,6 +76,18 @@ public:
   WageIndNonFreeze* wageIndNonFreeze;
   /// <summary>Pointer to method with high pia.</summary>
   PiaMethod* highPiaMethod;
+  /// <summary>Where to add the time spent in each stage, or null if not
+  /// timing.</summary>
+  StageTimes* stageTimes;
+  /// <summary>Where to count the calls of each method, or null if not
+  /// counting.</summary>
+  MethodCounters* methodCounters;
+  /// <summary>Arena for the methods of a calculation, or null to use the
+  /// heap.</summary>
+  CalcArena* arena;
+  /// <summary>Threads to calculate the methods of a case at the same time,
+  /// or null to calculate them one at a time.</summary>
+  MethodPool* methodPool;
 private:
   /// <summary>Type of benefit, set even if Statement case.</summary>
   ///
@@ -82,6 +101,14 @@ private:
   /// <summary>True if old Pebs assumptions (with 1-percent real wage gain).
   /// </summary>
   bool pebsAssumptions;
+  /// <summary>True if the methods of a calculation are kept for the next
+  /// one (see <see cref="setIncremental"/>).</summary>
+  bool incremental;
+  /// <summary>True if the methods of the last calculation were kept.
+  /// </summary>
+  bool methodsKept;
+  /// <summary>Date of entitlement of the last calculation.</summary>
+  DateMoyr methodEntDate;
 public:
   PiaCal( WorkerDataGeneral& newWorkerData, PiaData& newPiaData,
     const PiaParams& newPiaParams );
@@ -118,15 +145,42 @@ public:
     Secondary *secondaryData, const DateMoyr& entDate ) const;
   void ardriCal() const;
   virtual void calculate2( const DateMoyr& entDate );
+  void calculateMethods( const std::vector< PiaMethod* >& methods );
+  void clearHighPia();
   virtual void dataCheck( const DateMoyr& entDate );
   void dataCheckAux( WorkerDataArray& widowDataArray,
     PiaDataArray& widowArray, SecondaryArray& secondaryArray );
   virtual void earnProjection() const;
+  void finishMethods();
   DateMoyr fullInsDateCal() const;
+  /// <summary>Returns the arena for the methods of a calculation.
+  /// </summary>
+  ///
+  /// <returns>The arena for the methods of a calculation, or null if they
+  /// are on the heap.</returns>
+  CalcArena* getArena() const { return(arena); }
   /// <summary>Returns type of benefit.</summary>
   ///
   /// <returns>Type of benefit.</returns>
   WorkerDataGeneral::ben_type getIoasdi() const { return(ioasdi); }
+  /// <summary>Returns where the calls of each method are counted.
+  /// </summary>
+  ///
+  /// <returns>Where the calls of each method are counted, or null if not
+  /// counting.</returns>
+  MethodCounters* getMethodCounters() const { return(methodCounters); }
+  /// <summary>Returns the threads used to calculate the methods of a case.
+  /// </summary>
+  ///
+  /// <returns>The threads used to calculate the methods of a case, or null
+  /// if they are calculated one at a time.</returns>
+  MethodPool* getMethodPool() const { return(methodPool); }
+  /// <summary>Returns where the time spent in each stage is added.
+  /// </summary>
+  ///
+  /// <returns>Where the time spent in each stage is added, or null if not
+  /// timing.</returns>
+  StageTimes* getStageTimes() const { return(stageTimes); }
   InsCode::InsCodeType insCal( const boost::gregorian::date& dateModyyr,
     int isWasPrimary );
   InsCode::InsCodeType insNonFreezeCal( const boost::gregorian::date& dateModyyr,
@@ -136,6 +190,13 @@ public:
   /// <returns>True if old Statement assumptions (with 1-percent real wage
   /// gain).</returns>
   bool isPebsAssumptions() const { return pebsAssumptions; }
+  /// <summary>Returns true if the methods of a calculation are kept for
+  /// the next one.</summary>
+  ///
+  /// <returns>True if the methods of a calculation are kept for the next
+  /// one.</returns>
+  bool isIncremental() const { return(incremental); }
+  bool keepMethods( const DateMoyr& entDate );
   void monthsArAgedSpouseCal( PiaData *widowData,
     Secondary *secondaryData ) const;
   void monthsArCal() const;
@@ -165,18 +226,50 @@ public:
   void qcCal();
   void reindWidCalAll( const WorkerDataArray& widowDataArray,
     PiaDataArray& widowArray, SecondaryArray& secondaryArray );
-  /// <summary>Calculates PIA for one re-indexed widow(er).</summary>
+  /// <summary>Creates the method for one re-indexed widow(er), if
+  /// applicable, to be calculated by <see cref="reindWidCalAll"/>.
+  /// </summary>
   virtual void reindWidCal( const WorkerDataGeneral&, const PiaData&,
     Secondary& ) = 0;
   double relEarnPositionCal();
   void releaseMemory();
+  PiaMethod* reuseMethod( PiaMethod::pia_type method );
+  void saveMethods( const DateMoyr& entDate );
   void resetAmend90();
   void setAmend90( const DateMoyr& entDate );
   void setArfApp();
+  /// <summary>Sets the arena for the methods of a calculation.</summary>
+  ///
+  /// <remarks>The arena is reset when the methods of the previous
+  /// calculation are released, so it must not be used by anything else,
+  /// and must not be changed while there are methods.</remarks>
+  ///
+  /// <param name="newArena">Arena for the methods, or null to use the
+  /// heap.</param>
+  void setArena( CalcArena* newArena ) { arena = newArena; }
   void setEligYearWidow( WorkerDataArray& widowDataArray,
     PiaDataArray& widowArray, SecondaryArray& secondaryArray ) const;
   void setHighMfb();
   void setHighPia();
+  /// <summary>Sets whether the methods of a calculation are kept for the
+  /// next one.</summary>
+  ///
+  /// <remarks>In incremental mode the methods are not created again if the
+  /// date of entitlement is the same and only earnings have changed since
+  /// the last calculation (see <see cref="WorkerDataGeneral::getChanges"/>),
+  /// so each method can reuse the ordering of its earnings from the last
+  /// calculation (see <see cref="PiaMethod::orderEarnings"/>). A kept
+  /// method holds nothing from the last calculation but its date of
+  /// entitlement and that ordering, which is checked against the earnings
+  /// before it is used, and it is always calculated again; so the results
+  /// are the same as those of a full calculation even if some change to the
+  /// worker's data, the parameters, or the law changes was not recorded.
+  /// The methods are not kept if there is an arena.</remarks>
+  ///
+  /// <param name="newIncremental">True to keep the methods of a calculation
+  /// for the next one.</param>
+  void setIncremental( bool newIncremental )
+  { incremental = newIncremental; }
   /// <summary>Sets the type of benefit.</summary>
   ///
   /// <param name="ioasdit">New type of benefit.</param>
@@ -187,7 +280,30 @@ public:
   /// (with 1-percent real wage gain).</param>
   void setPebsAssumptions( bool newPebsAssumptions )
   { pebsAssumptions = newPebsAssumptions; }
+  /// <summary>Sets where to count the calls of each method.</summary>
+  ///
+  /// <param name="newMethodCounters">Where to count the calls of each
+  /// method, or null to stop counting.</param>
+  void setMethodCounters( MethodCounters* newMethodCounters )
+  { methodCounters = newMethodCounters; }
+  /// <summary>Sets the threads used to calculate the methods of a case.
+  /// </summary>
+  ///
+  /// <remarks>The methods are calculated at the same time, and the highest
+  /// pia is then selected as usual, so the results are the same as when
+  /// they are calculated one at a time.</remarks>
+  ///
+  /// <param name="newMethodPool">Threads to use, or null to calculate the
+  /// methods one at a time.</param>
+  void setMethodPool( MethodPool* newMethodPool )
+  { methodPool = newMethodPool; }
   void setPifc();
+  /// <summary>Sets where to add the time spent in each stage.</summary>
+  ///
+  /// <param name="newStageTimes">Where to add the time spent in each
+  /// stage, or null to stop timing.</param>
+  void setStageTimes( StageTimes* newStageTimes )
+  { stageTimes = newStageTimes; }
   void setSupportPia();
   /// <summary>Applies maximum family benefit to family's benefits in a life
   /// case.</summary>
@@ -295,7 +411,10 @@ public:
   static void widowCheck( const boost::gregorian::date& jonsett,
     const boost::gregorian::date& jbirtht, const DateMoyr& ientt )
   { if (jonsett < jbirtht) throw PiaException(PIA_IDS_JONSET5);
-    if (ientt < jonsett) throw PiaException(PIA_IDS_JONSET6); }
+    if (ientt < DateIndex(jonsett).toDateMoyr())
+      throw PiaException(PIA_IDS_JONSET6); }
 private:
+  void clearMethodPointers();
+  void releaseWidowMethods();
   PiaCal& operator=( PiaCal& newPiaCal );
 };
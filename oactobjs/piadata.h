@@ -13,11 +13,13 @@
 #include "inscode.h"
 #include "frzyrs.h"
 #include "datemoyr.h"
+#include "DateIndex.h"
 #include "qcamt.h"
 #include "awinc.h"
 #include "avgwg.h"
 #include "BenefitAmount.h"
 #include "BitAnnual.h"
+#include "QcBitset.h"
 #include "boost/date_time/gregorian/greg_date.hpp"
 
 /// <summary>Manages all of the worker-specific amounts calculated in
@@ -119,6 +121,12 @@ public:
   /// <summary>Quarters of coverage, including railroad and military service.
   /// </summary>
   QcArray qcov;
+  /// <summary>The same quarters of coverage as <see cref="qcov"/>, one bit
+  /// for each quarter, for the insured status tests.</summary>
+  ///
+  /// <remarks>This is set from <see cref="qcov"/> whenever that changes.
+  /// </remarks>
+  QcBitset qcovBits;
   /// <summary>Military service quarters of coverage, 1937 to 1956.</summary>
   QcArray qcovMilServ;
   /// <summary>Annual relative earnings position, 1937 to maxyear.</summary>
@@ -212,6 +220,9 @@ private:
   int iendTotal;
   /// <summary>Day before birth of worker.</summary>
   boost::gregorian::date kbirth;
+  /// <summary>Day before birth of worker, as a month index and day, for
+  /// the age calculations.</summary>
+  DateIndex kbirthIndex;
   /// <summary>Mumber of months of early or delayed retirement.</summary>
   int monthsArdri;
   /// <summary>Indicator for earnings over maximum.</summary>
@@ -362,6 +373,11 @@ public:
   /// <returns>Day before worker's birth.</returns>
   const boost::gregorian::date& getBirthDateMinus1() const
   { return(kbirth); }
+  /// <summary>Returns day before worker's birth, as a month index and day.
+  /// </summary>
+  ///
+  /// <returns>Day before worker's birth, as a month index and day.</returns>
+  const DateIndex& getBirthIndexMinus1() const { return(kbirthIndex); }
   double getChildCareMaxCredit( int yearOfCredit ) const;
   /// <summary>Returns total number of child care years.</summary>
   ///
@@ -0,0 +1,113 @@
+// Functions for the <see cref="AmeIndex"/> class to find the AME giving
+// a pia in the old pia tables without searching every AME.
+
+#include <algorithm>
+#include "AmeIndex.h"
+
+using namespace std;
+
+/// <summary>Compares two keys, for sorting.</summary>
+///
+/// <returns>True if this key sorts before the other key.</returns>
+///
+/// <param name="key">Key to compare to.</param>
+bool AmeIndex::Key::operator<( const Key& key ) const
+{
+  if (table != key.table)
+    return(table < key.table);
+  if (lastYear != key.lastYear)
+    return(lastYear < key.lastYear);
+  if (eligYear != key.eligYear)
+    return(eligYear < key.eligYear);
+  return(dates < key.dates);
+}
+
+/// <summary>Creates an empty index.</summary>
+AmeIndex::AmeIndex() : mutex(), pias()
+{ }
+
+/// <summary>Destructor.</summary>
+AmeIndex::~AmeIndex()
+{ }
+
+/// <summary>Removes all the lists of pias.</summary>
+///
+/// <remarks>A list still held by a caller stays valid.</remarks>
+void AmeIndex::clear()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  pias.clear();
+}
+
+/// <summary>Returns the highest pia up to each AME in one table.</summary>
+///
+/// <returns>The highest pia up to each AME from <see cref="FIRST_AME"/> to
+/// <see cref="LAST_AME"/>, or an empty pointer if the table has not been
+/// added.</returns>
+///
+/// <param name="key">Table to find.</param>
+boost::shared_ptr< const std::vector< double > > AmeIndex::find(
+const Key& key )
+{
+  boost::mutex::scoped_lock lock(mutex);
+  const map< Key, boost::shared_ptr< const vector< double > > >::
+    const_iterator it = pias.find(key);
+  return((it != pias.end()) ? it->second :
+    boost::shared_ptr< const vector< double > >());
+}
+
+/// <summary>Returns the number of tables added.</summary>
+///
+/// <returns>The number of tables added.</returns>
+unsigned AmeIndex::getSize()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  return(static_cast<unsigned>(pias.size()));
+}
+
+/// <summary>Adds the pias of one table.</summary>
+///
+/// <remarks>If another thread has added the same table in the meantime,
+/// that one is kept; it has the same pias.</remarks>
+///
+/// <returns>The highest pia up to each AME in the table.</returns>
+///
+/// <param name="key">Table to add.</param>
+/// <param name="tablePias">Pia for each AME from <see cref="FIRST_AME"/> to
+/// <see cref="LAST_AME"/>.</param>
+boost::shared_ptr< const std::vector< double > > AmeIndex::insert(
+const Key& key, const std::vector< double >& tablePias )
+{
+  vector< double > *maxPias = new vector< double >(tablePias);
+  for (size_t i = 1; i < maxPias->size(); i++) {
+    (*maxPias)[i] = max((*maxPias)[i - 1], (*maxPias)[i]);
+  }
+  const boost::shared_ptr< const vector< double > > rv(maxPias);
+  boost::mutex::scoped_lock lock(mutex);
+  return(pias.insert(make_pair(key, rv)).first->second);
+}
+
+/// <summary>Finds the lowest AME whose pia is at least a given pia.
+/// </summary>
+///
+/// <returns>The lowest AME whose highest pia is not less than the given pia
+/// (<see cref="LAST_AME"/> if there is none).</returns>
+///
+/// <param name="maxPias">Highest pia up to each AME (see
+/// <see cref="find"/>).</param>
+/// <param name="pia">Pia to find.</param>
+int AmeIndex::search( const std::vector< double >& maxPias, double pia )
+{
+  // the same test as the search over every AME, so a pia that is not a
+  // number gives the lowest AME
+  size_t low = 0;
+  size_t high = maxPias.size();
+  while (low < high) {
+    const size_t mid = low + (high - low) / 2;
+    if (pia > maxPias[mid])
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return(min(FIRST_AME + static_cast<int>(low), LAST_AME));
+}
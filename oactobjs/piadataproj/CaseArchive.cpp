@@ -0,0 +1,93 @@
+// Functions for the <see cref="CaseOArchive"/> and
+// <see cref="CaseIArchive"/> classes to save and restore the data of a case
+// with the serialize functions of its classes.
+
+#include "CaseArchive.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Saves a string, with its length.</summary>
+///
+/// <param name="t">String to save.</param>
+void CaseOArchive::save( const std::string& t )
+{
+  saveCount(t.size());
+  buffer.append(t);
+}
+
+/// <summary>Saves a date, as its day number.</summary>
+///
+/// <remarks>The day number also represents the special values, such as a
+/// date that has not been set.</remarks>
+///
+/// <param name="t">Date to save.</param>
+void CaseOArchive::save( const boost::gregorian::date& t )
+{
+  save(static_cast<boost::uint32_t>(t.day_number()));
+}
+
+/// <summary>Saves a count, in as few bytes as it needs.</summary>
+///
+/// <remarks>Each byte holds 7 bits of the count, starting with the lowest
+/// bits; the high bit is set in every byte but the last.</remarks>
+///
+/// <param name="count">Count to save.</param>
+void CaseOArchive::saveCount( std::size_t count )
+{
+  while (count >= 0x80u) {
+    buffer.push_back(static_cast<char>((count & 0x7fu) | 0x80u));
+    count >>= 7;
+  }
+  buffer.push_back(static_cast<char>(count));
+}
+
+/// <summary>Reports an archive that does not hold what is being restored.
+/// </summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> always.
+/// </exception>
+void CaseIArchive::fail()
+{
+  throw PiaException("Incomplete case archive in CaseIArchive");
+}
+
+/// <summary>Restores a string, with its length.</summary>
+///
+/// <param name="t">String to restore.</param>
+void CaseIArchive::load( std::string& t )
+{
+  const size_t size = loadCount();
+  t.assign(take(size), size);
+}
+
+/// <summary>Restores a date saved as its day number.</summary>
+///
+/// <param name="t">Date to restore.</param>
+void CaseIArchive::load( boost::gregorian::date& t )
+{
+  boost::uint32_t dayNumber = 0u;
+  load(dayNumber);
+  t = boost::gregorian::date(
+    static_cast<boost::gregorian::date::date_int_type>(dayNumber));
+}
+
+/// <summary>Restores a count saved by <see cref="CaseOArchive::saveCount"/>
+/// in more than one byte.</summary>
+///
+/// <returns>The count.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// archive ends before the count does.</exception>
+size_t CaseIArchive::loadLongCount()
+{
+  size_t count = 0u;
+  for (unsigned shift = 0u; ; shift += 7u) {
+    if (next == end || shift >= 8u * sizeof(size_t))
+      fail();
+    const unsigned char byte = static_cast<unsigned char>(*next++);
+    count |= static_cast<size_t>(byte & 0x7fu) << shift;
+    if ((byte & 0x80u) == 0u)
+      return(count);
+  }
+}
@@ -0,0 +1,266 @@
+// Functions for the <see cref="CaseCache"/> class to keep the cases of a
+// batch run in binary form from one run to the next.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include "CaseCache.h"
+#include "WorkerDataGeneral.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>First bytes of a case cache file.</summary>
+const char MAGIC[8] = { 'P', 'I', 'A', 'C', 'A', 'S', 'E', 'S' };
+
+/// <summary>Returns the number of bytes to add to an offset to make it a
+/// multiple of 8.</summary>
+///
+/// <returns>The number of bytes to add.</returns>
+///
+/// <param name="offset">Offset in the file.</param>
+size_t padding( boost::uint64_t offset )
+{
+  return(static_cast<size_t>((8u - offset % 8u) % 8u));
+}
+
+}  // namespace
+
+const boost::uint32_t CaseCache::ENGINE_VERSION;
+
+/// <summary>Opens the file, if it exists and has the same stamp as this
+/// run.</summary>
+///
+/// <param name="newFileName">Name of the file.</param>
+/// <param name="baseYear">First year of projections.</param>
+CaseCache::CaseCache( const std::string& newFileName, int baseYear ) :
+fileName(newFileName), file(), stamp(), index(0), indexCount(0u), used(),
+added(), hits(0ul), mutex()
+{
+  // the archives are in the byte order and type sizes of this machine
+  stamp.push_back(0x01020304u);
+  stamp.push_back(ENGINE_VERSION);
+  stamp.push_back(static_cast<boost::uint32_t>(sizeof(int)));
+  stamp.push_back(static_cast<boost::uint32_t>(sizeof(long)));
+  stamp.push_back(static_cast<boost::uint32_t>(sizeof(size_t)));
+  stamp.push_back(static_cast<boost::uint32_t>(baseYear));
+  stamp.push_back(static_cast<boost::uint32_t>(
+    WorkerDataGeneral::getMaxyear()));
+  stamp.push_back(static_cast<boost::uint32_t>(
+    WorkerDataGeneral::getQcLumpYear()));
+  open();
+}
+
+/// <summary>Unmaps the file.</summary>
+CaseCache::~CaseCache()
+{ }
+
+/// <summary>Computes the checksum of an archive.</summary>
+///
+/// <returns>The checksum.</returns>
+///
+/// <param name="begin">First byte of the archive.</param>
+/// <param name="end">One past the last byte of the archive.</param>
+boost::uint64_t CaseCache::checksum( const char *begin, const char *end )
+{
+  const boost::uint64_t multiplier = 0xff51afd7ed558ccdULL;
+  boost::uint64_t hash = static_cast<boost::uint64_t>(end - begin);
+  for (; end - begin >= 8; begin += 8) {
+    boost::uint64_t word;
+    memcpy(&word, begin, 8);
+    hash = (hash ^ word) * multiplier;
+    hash ^= hash >> 33;
+  }
+  boost::uint64_t word = 0u;
+  memcpy(&word, begin, static_cast<size_t>(end - begin));
+  hash = (hash ^ word) * multiplier;
+  return(hash ^ (hash >> 33));
+}
+
+/// <summary>Finds the archive of a case.</summary>
+///
+/// <returns>True if the case was found and its archive is intact, false
+/// otherwise.</returns>
+///
+/// <param name="key">Key of the case.</param>
+/// <param name="begin">First byte of the archive (returned).</param>
+/// <param name="end">One past the last byte of the archive (returned).
+/// </param>
+bool CaseCache::find( boost::uint64_t key, const char *& begin,
+const char *& end )
+{
+  size_t low = 0u;
+  size_t high = indexCount;
+  while (low < high) {
+    const size_t middle = low + (high - low) / 2u;
+    if (index[middle].key < key)
+      low = middle + 1u;
+    else
+      high = middle;
+  }
+  if (low == indexCount || index[low].key != key)
+    return(false);
+  begin = file.data() + index[low].offset;
+  end = begin + index[low].size;
+  if (checksum(begin, end) != index[low].check)
+    return(false);
+  boost::mutex::scoped_lock lock(mutex);
+  used[low] = 1;
+  hits++;
+  return(true);
+}
+
+/// <summary>Returns the number of cases added in this run.</summary>
+///
+/// <returns>The number of cases added in this run.</returns>
+unsigned long CaseCache::getAddedCount()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  return(static_cast<unsigned long>(added.size()));
+}
+
+/// <summary>Returns the number of cases found in this run.</summary>
+///
+/// <returns>The number of cases found in this run.</returns>
+unsigned long CaseCache::getHitCount()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  return(hits);
+}
+
+/// <summary>Adds the archive of a case.</summary>
+///
+/// <remarks>The case is written to the file by <see cref="save"/>. If a
+/// case with the same key has already been added, it is kept.</remarks>
+///
+/// <param name="key">Key of the case.</param>
+/// <param name="archive">Archive of the case.</param>
+void CaseCache::insert( boost::uint64_t key, const std::string& archive )
+{
+  boost::mutex::scoped_lock lock(mutex);
+  added.insert(make_pair(key, archive));
+}
+
+/// <summary>Maps the file and checks its stamp and index.</summary>
+///
+/// <remarks>If the file does not exist, or cannot be used, the cache starts
+/// empty.</remarks>
+void CaseCache::open()
+{
+  ifstream in(fileName.c_str(), ios::in | ios::binary | ios::ate);
+  if (!in)
+    return;
+  const boost::uint64_t size = static_cast<boost::uint64_t>(in.tellg());
+  in.close();
+  const size_t stampSize = stamp.size() * sizeof(boost::uint32_t);
+  const size_t headerSize = sizeof(MAGIC) + stampSize;
+  if (size < headerSize + 2u * sizeof(boost::uint64_t))
+    return;
+  try {
+    file.open(fileName);
+  } catch (ios_base::failure&) {
+    return;
+  }
+  const char *data = file.data();
+  boost::uint64_t trailer[2];
+  memcpy(trailer, data + size - sizeof(trailer), sizeof(trailer));
+  const boost::uint64_t indexOffset = trailer[0];
+  const boost::uint64_t count = trailer[1];
+  if (memcmp(data, MAGIC, sizeof(MAGIC)) != 0 ||
+    memcmp(data + sizeof(MAGIC), &stamp[0], stampSize) != 0 ||
+    indexOffset % 8u != 0u || indexOffset < headerSize ||
+    indexOffset > size - sizeof(trailer) ||
+    count != (size - sizeof(trailer) - indexOffset) / sizeof(IndexEntry) ||
+    (size - sizeof(trailer) - indexOffset) % sizeof(IndexEntry) != 0u) {
+    file.close();
+    return;
+  }
+  const IndexEntry *entries =
+    reinterpret_cast<const IndexEntry *>(data + indexOffset);
+  for (boost::uint64_t i = 0u; i < count; i++) {
+    if (entries[i].offset < headerSize || entries[i].offset > indexOffset ||
+      entries[i].size > indexOffset - entries[i].offset ||
+      (i > 0u && entries[i].key <= entries[i - 1u].key)) {
+      file.close();
+      return;
+    }
+  }
+  index = entries;
+  indexCount = static_cast<size_t>(count);
+  used.assign(indexCount, 0);
+}
+
+/// <summary>Replaces the file with the cases found or added in this run.
+/// </summary>
+///
+/// <remarks>The new file is written under another name and then renamed,
+/// so an interrupted run leaves the old file. Nothing is written if every
+/// case in the file was found and none was added. This must not be called
+/// while other threads use the instance, and no cases can be found after
+/// it.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the file
+/// cannot be written.</exception>
+void CaseCache::save()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  if (added.empty() && std::find(used.begin(), used.end(), 0) == used.end())
+    return;
+  const string newFileName = fileName + ".new";
+  ofstream out(newFileName.c_str(), ios::out | ios::binary | ios::trunc);
+  if (!out)
+    throw PiaException("Cannot open " + newFileName + " for output");
+  out.write(MAGIC, sizeof(MAGIC));
+  out.write(reinterpret_cast<const char *>(&stamp[0]),
+    static_cast<streamsize>(stamp.size() * sizeof(boost::uint32_t)));
+  boost::uint64_t offset =
+    sizeof(MAGIC) + stamp.size() * sizeof(boost::uint32_t);
+  vector< IndexEntry > newIndex;
+  newIndex.reserve(indexCount + added.size());
+  for (size_t i = 0u; i < indexCount; i++) {
+    if (used[i] == 0)
+      continue;
+    const IndexEntry entry =
+      { index[i].key, offset, index[i].size, index[i].check };
+    out.write(file.data() + index[i].offset,
+      static_cast<streamsize>(index[i].size));
+    newIndex.push_back(entry);
+    offset += index[i].size;
+  }
+  for (map< boost::uint64_t, string >::const_iterator it = added.begin();
+    it != added.end(); ++it) {
+    const IndexEntry entry = { it->first, offset, it->second.size(),
+      checksum(it->second.data(), it->second.data() + it->second.size()) };
+    out.write(it->second.data(), static_cast<streamsize>(it->second.size()));
+    newIndex.push_back(entry);
+    offset += it->second.size();
+  }
+  const char zeros[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+  out.write(zeros, static_cast<streamsize>(padding(offset)));
+  offset += padding(offset);
+  // the cases found are in key order, and so are those added, but a key
+  // added may fall between two found
+  sort(newIndex.begin(), newIndex.end());
+  if (!newIndex.empty()) {
+    out.write(reinterpret_cast<const char *>(&newIndex[0]),
+      static_cast<streamsize>(newIndex.size() * sizeof(IndexEntry)));
+  }
+  const boost::uint64_t trailer[2] = { offset, newIndex.size() };
+  out.write(reinterpret_cast<const char *>(trailer), sizeof(trailer));
+  out.close();
+  if (!out)
+    throw PiaException("Cannot write " + newFileName);
+  // the old file must be unmapped before it is replaced
+  index = 0;
+  indexCount = 0u;
+  used.clear();
+  added.clear();
+  file.close();
+  remove(fileName.c_str());
+  if (rename(newFileName.c_str(), fileName.c_str()) != 0)
+    throw PiaException("Cannot rename " + newFileName + " to " + fileName);
+}
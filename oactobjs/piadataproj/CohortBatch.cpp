@@ -0,0 +1,341 @@
+// Functions for the <see cref="CohortBatch"/> class to calculate the
+// old-age pias of a cohort of workers at once.
+
+#include <cmath>  // for floor
+#include <algorithm>
+#include <utility>
+#include "CohortBatch.h"
+#include "WageIndBatch.h"
+#include "WageIndGeneral.h"
+#include "piaparms.h"
+#include "qc.h"
+#include "qtryear.h"
+#include "bendpia.h"
+#include "percpia.h"
+#include "PortionAime.h"
+#include "dbleann.h"
+#include "oactcnst.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Allocates the arrays for a block of workers.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the last
+/// year is before 1978.</exception>
+///
+/// <param name="newPiaParams">Benefit calculation parameters.</param>
+/// <param name="newLastYear">Last year of earnings stored.</param>
+/// <param name="newCapacity">Maximum number of workers.</param>
+CohortBatch::CohortBatch( const PiaParams& newPiaParams, int newLastYear,
+unsigned newCapacity ) :
+piaParams(newPiaParams), lastYear(newLastYear), capacity(newCapacity),
+stride((newCapacity + 7u) & ~7u), workerCount(0u), birthDate(),
+entDate(), benefitDate(), eligYear(0), qcReq(0), compYears(0),
+earnings(), earnIndexed(), qcs(), qcTotal50(newCapacity, 0),
+qcTotal5177(newCapacity, 0), qcTotal(newCapacity, 0),
+aime(newCapacity, 0.0), piaElig(newCapacity, 0.0),
+piaBen(newCapacity, 0.0), specMinYears(newCapacity, 0),
+fallback(newCapacity, 0u), calculated(false)
+{
+  if (lastYear < FIRST_QC_YEAR)
+    throw PiaException("Last year out of range in CohortBatch::CohortBatch");
+  const size_t size =
+    static_cast<size_t>(lastYear - FIRST_YEAR + 1) * stride;
+  earnings.resize(size, 0.0);
+  earnIndexed.resize(size, 0.0);
+  qcs.resize(static_cast<size_t>(lastYear - FIRST_QC_YEAR + 1) * stride,
+    0u);
+}
+
+/// <summary>Destructor.</summary>
+CohortBatch::~CohortBatch()
+{ }
+
+/// <summary>Removes all workers, and sets the dates of the next cohort.
+/// </summary>
+///
+/// <remarks>The year of eligibility, required quarters of coverage, and
+/// number of computation years are found here, as in
+/// <see cref="PiaCal::qcReqCal"/>, <see cref="PiaCal::nelapsedCal"/>, and
+/// <see cref="PiaCal::nCal"/> for an old-age worker without a period of
+/// disability.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the date of
+/// entitlement is before the year of eligibility, or the benefit date is
+/// before the date of entitlement.</exception>
+///
+/// <param name="newBirthDate">Date of birth.</param>
+/// <param name="newEntDate">Date of entitlement.</param>
+/// <param name="newBenefitDate">Benefit date.</param>
+void CohortBatch::clear( const boost::gregorian::date& newBirthDate,
+const DateMoyr& newEntDate, const DateMoyr& newBenefitDate )
+{
+  const int birthYear = static_cast<int>(
+    (newBirthDate - boost::gregorian::days(1)).year());
+  if (static_cast<int>(newEntDate.getYear()) < birthYear + 62 ||
+    newBenefitDate < newEntDate)
+    throw PiaException("Dates out of range in CohortBatch::clear");
+  birthDate = newBirthDate;
+  entDate = newEntDate;
+  benefitDate = newBenefitDate;
+  eligYear = birthYear + 62;
+  const int elapsed1 = max(birthYear + 21, YEAR50);
+  qcReq = min(40, max(6, eligYear - 1 - elapsed1));
+  const int nElapsed = max(eligYear - 1 - elapsed1, 2);
+  compYears = max(nElapsed - 5, 2);
+  workerCount = 0u;
+  calculated = false;
+}
+
+/// <summary>Adds the earnings and quarters of coverage of one worker.
+/// </summary>
+///
+/// <remarks>Earnings in years not covered by the argument are set to
+/// zero.</remarks>
+///
+/// <returns>The number of the worker in this batch.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the batch
+/// is full.</exception>
+///
+/// <param name="newEarnings">OASDI earnings of the worker.</param>
+/// <param name="newQcTotal50">Quarters of coverage before 1951.</param>
+/// <param name="newQcTotal5177">Quarters of coverage from 1951 through
+/// 1977.</param>
+unsigned CohortBatch::add( const DoubleAnnual& newEarnings,
+int newQcTotal50, int newQcTotal5177 )
+{
+  if (workerCount >= capacity)
+    throw PiaException("Too many workers in CohortBatch::add");
+  const unsigned worker = workerCount++;
+  const int year1 = max(static_cast<int>(FIRST_YEAR),
+    newEarnings.getBaseYear());
+  const int year2 = min(lastYear, newEarnings.getLastYear());
+  for (int year = FIRST_YEAR; year <= lastYear; year++) {
+    earnings[(year - FIRST_YEAR) * stride + worker] =
+      (year >= year1 && year <= year2) ? newEarnings[year] : 0.0;
+  }
+  qcTotal50[worker] = newQcTotal50;
+  qcTotal5177[worker] = newQcTotal5177;
+  calculated = false;
+  return(worker);
+}
+
+/// <summary>Adds the earnings and quarters of coverage of a block of
+/// workers.</summary>
+///
+/// <remarks>The earnings are in the same order as they are stored, by year
+/// from 1951 through the last year stored, with the amounts of all of the
+/// workers in the block side by side in each year.</remarks>
+///
+/// <returns>The number of the first worker of the block in this batch.
+/// </returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the block
+/// does not fit in the batch.</exception>
+///
+/// <param name="count">Number of workers in the block.</param>
+/// <param name="newEarnings">OASDI earnings of the workers, by year and
+/// worker.</param>
+/// <param name="newQcTotal50">Quarters of coverage before 1951, by worker.
+/// </param>
+/// <param name="newQcTotal5177">Quarters of coverage from 1951 through
+/// 1977, by worker.</param>
+unsigned CohortBatch::add( unsigned count, const double newEarnings[],
+const int newQcTotal50[], const int newQcTotal5177[] )
+{
+  if (count > capacity - workerCount)
+    throw PiaException("Too many workers in CohortBatch::add");
+  const unsigned first = workerCount;
+  for (int year = FIRST_YEAR; year <= lastYear; year++) {
+    const size_t row = static_cast<size_t>(year - FIRST_YEAR);
+    copy(newEarnings + row * count, newEarnings + (row + 1) * count,
+      earnings.begin() + (row * stride + first));
+  }
+  copy(newQcTotal50, newQcTotal50 + count, qcTotal50.begin() + first);
+  copy(newQcTotal5177, newQcTotal5177 + count,
+    qcTotal5177.begin() + first);
+  workerCount += count;
+  calculated = false;
+  return(first);
+}
+
+/// <summary>Calculates the quarters of coverage, insured status, and pias
+/// of all workers added.</summary>
+///
+/// <remarks>If the year of eligibility is before 1984, only the quarters
+/// of coverage and insured status are calculated, and every worker needs
+/// the per-worker calculation.</remarks>
+void CohortBatch::calculate()
+{
+  fill(fallback.begin(), fallback.begin() + workerCount, 0u);
+  qcCal();
+  if (eligYear < YEAR79 + 5) {
+    fill(aime.begin(), aime.begin() + workerCount, 0.0);
+    fill(piaElig.begin(), piaElig.begin() + workerCount, 0.0);
+    fill(piaBen.begin(), piaBen.begin() + workerCount, 0.0);
+    fill(specMinYears.begin(), specMinYears.begin() + workerCount, 0);
+    fill(fallback.begin(), fallback.begin() + workerCount, 1u);
+  }
+  else {
+    piaCal();
+    specMinCal();
+  }
+  calculated = true;
+}
+
+/// <summary>Calculates the quarters of coverage in each year from 1978,
+/// and the total through the quarter of entitlement.</summary>
+///
+/// <remarks>As in <see cref="PiaData::qcCal"/> and
+/// <see cref="PiaData::qcTotalCal"/>. A worker with quarters of coverage
+/// before 1951 may need the old-start method.</remarks>
+void CohortBatch::qcCal()
+{
+  const int entYear = entDate.getYear();
+  const unsigned entQuarter = QtrYear(entDate).getQuarter();
+  for (unsigned i = 0u; i < workerCount; i++) {
+    qcTotal[i] = qcTotal50[i] + qcTotal5177[i];
+    if (qcTotal50[i] > 0)
+      fallback[i] = 1u;
+  }
+  const int year2 = min(entYear, lastYear);
+  for (int year = FIRST_QC_YEAR; year <= year2; year++) {
+    unsigned char *yearQcs =
+      &qcs[static_cast<size_t>(year - FIRST_QC_YEAR) * stride];
+    const double *yearEarnings =
+      &earnings[static_cast<size_t>(year - FIRST_YEAR) * stride];
+    const double qcAmount = piaParams.qcamt[year];
+    for (unsigned i = 0u; i < workerCount; i++) {
+      yearQcs[i] =
+        static_cast<unsigned char>(Qc::qcCal(yearEarnings[i], qcAmount));
+    }
+    if (year < entYear) {
+      for (unsigned i = 0u; i < workerCount; i++)
+        qcTotal[i] += yearQcs[i];
+    }
+    else {
+      for (unsigned i = 0u; i < workerCount; i++) {
+        qcTotal[i] += static_cast<int>(min(static_cast<unsigned>(yearQcs[i]),
+          entQuarter + 1u));
+      }
+    }
+  }
+}
+
+/// <summary>Calculates the AIME and wage-indexed pia of each worker.
+/// </summary>
+///
+/// <remarks>As in <see cref="WageInd::calculate"/>: the earnings limited
+/// to the wage base are indexed through the year before the indexing year
+/// by <see cref="WageIndBatch::indexYear"/>, the highest years are selected
+/// for each worker (ranked by amount and year, as in
+/// <see cref="PiaMethod::orderEarnings"/>) and added in order of year, and
+/// the AIME, pia at eligibility, and pia at the benefit date follow.
+/// </remarks>
+void CohortBatch::piaCal()
+{
+  const int baseYear = eligYear - 2;
+  const int year2 = min(static_cast<int>(benefitDate.getYear()) - 1,
+    lastYear);
+  const AverageWage& avgWage = piaParams.getFqIndex();
+  const double indexYearAvgWage = avgWage[baseYear];
+  vector< double > limited(stride);
+  vector< double > earnMultiplied(stride);
+  for (int year = FIRST_YEAR; year <= year2; year++) {
+    const size_t row = static_cast<size_t>(year - FIRST_YEAR) * stride;
+    const double base = piaParams.getBaseOasdi(year);
+    for (unsigned i = 0u; i < workerCount; i++)
+      limited[i] = min(earnings[row + i], base);
+    if (year < baseYear) {
+      WageIndBatch::indexYear(&limited[0], &earnMultiplied[0],
+        &earnIndexed[row], workerCount, indexYearAvgWage, avgWage[year]);
+    }
+    else {
+      copy(limited.begin(), limited.begin() + workerCount,
+        earnIndexed.begin() + row);
+    }
+  }
+  // total of the highest years
+  const int numYears = max(year2 - FIRST_YEAR + 1, 0);
+  const int count = min(compYears, numYears);
+  vector< pair< double, int > > order(static_cast<size_t>(numYears));
+  for (unsigned i = 0u; i < workerCount; i++) {
+    for (int year = FIRST_YEAR; year <= year2; year++) {
+      order[year - FIRST_YEAR] =
+        make_pair(earnIndexed[(year - FIRST_YEAR) * stride + i], year);
+    }
+    // the lowest of the years selected, if not all of them
+    const bool all = (count >= numYears);
+    pair< double, int > lowest(0.0, 0);
+    if (!all) {
+      nth_element(order.begin(), order.end() - count, order.end());
+      lowest = *(order.end() - count);
+    }
+    double tearn = 0.0;
+    for (int year = FIRST_YEAR; year <= year2; year++) {
+      const double earn = earnIndexed[(year - FIRST_YEAR) * stride + i];
+      if (all || !(make_pair(earn, year) < lowest))
+        tearn += earn;
+    }
+    aime[i] = floor(tearn / (static_cast<double>(compYears) * 12.0));
+  }
+  // pia at eligibility, from the bend points and percentages of the year
+  // of eligibility
+  BendPia bendPia(3);
+  const int numBp = piaParams.bpPiaOut.getNumBend(eligYear);
+  bendPia.setNumBend(numBp);
+  for (int j = 1; j <= numBp; j++)
+    bendPia[j] = piaParams.bpPiaOut.getBppia(eligYear, j);
+  PercPia percPia;
+  piaParams.percPiaCal(eligYear, percPia);
+  PortionAime portionAime(3);
+  for (unsigned i = 0u; i < workerCount; i++) {
+    WageIndGeneral::setPortionAime(aime[i], portionAime, bendPia);
+    piaElig[i] =
+      WageIndGeneral::aimepiaCal(portionAime, percPia, eligYear - 1);
+  }
+  // pia at the benefit date
+  const int benYear = benefitDate.getYear();
+  const int year3 = (static_cast<int>(benefitDate.getMonth()) <
+    piaParams.getMonthBeninc(benYear)) ? benYear - 1 : benYear;
+  DoubleAnnual pia(YEAR37, piaParams.getMaxyear());
+  for (unsigned i = 0u; i < workerCount; i++) {
+    pia[eligYear - 1] = piaElig[i];
+    piaBen[i] = piaParams.applyColas(pia, eligYear, year3, eligYear,
+      benefitDate);
+  }
+}
+
+/// <summary>Counts the years of coverage for the special minimum, and marks
+/// each worker whose special minimum pia is at least the wage-indexed pia.
+/// </summary>
+///
+/// <remarks>As in <see cref="PiaMethod::specMinYearsCal"/> and
+/// <see cref="SpecMin::calculate"/>, with no earnings before 1951.
+/// </remarks>
+void CohortBatch::specMinCal()
+{
+  const int year2 = min(static_cast<int>(benefitDate.getYear()) - 1,
+    lastYear);
+  fill(specMinYears.begin(), specMinYears.begin() + workerCount, 0);
+  for (int year = FIRST_YEAR; year <= year2; year++) {
+    const double *yearEarnings =
+      &earnings[static_cast<size_t>(year - FIRST_YEAR) * stride];
+    const double yocAmount = piaParams.getYocAmountSpecMin(year) - 0.009;
+    for (unsigned i = 0u; i < workerCount; i++) {
+      if (yearEarnings[i] > yocAmount)
+        specMinYears[i]++;
+    }
+  }
+  const int maxYears = PiaParams::specMinMaxYearsPL();
+  vector< double > specMinPia(static_cast<size_t>(maxYears + 1), 0.0);
+  for (int j = 1; j <= maxYears; j++)
+    specMinPia[j] = piaParams.getSpecMinPia(benefitDate, j);
+  for (unsigned i = 0u; i < workerCount; i++) {
+    const int excessYears = min(max(specMinYears[i] - 10, 0), maxYears);
+    if (excessYears > 0 && specMinPia[excessYears] >= piaBen[i])
+      fallback[i] = 1u;
+  }
+}
@@ -0,0 +1,149 @@
+// Functions for the <see cref="ColaTable"/> class to apply a range of
+// benefit increases from precomputed factors.
+
+#include <algorithm>
+#include "ColaTable.h"
+#include "dbleann.h"
+#include "BenefitAmount.h"
+#include "oactcnst.h"
+#include "piaparms.h"
+#include "PiaException.h"
+#include "Resource.h"
+
+using namespace std;
+
+/// <summary>Creates an empty table.</summary>
+ColaTable::ColaTable() :
+firstYear(0), lastYear(-1), catchupStart(0), factors(), unFactors(),
+catchupFactors(), factor99(1.0), unFactor99(1.0)
+{ }
+
+/// <summary>Applies the benefit increases for a range of years, saving the
+/// amount after each one.</summary>
+///
+/// <remarks>The amount before the first increase is taken from amounts at
+/// index (year1 - 1). This gives the same amounts as
+/// <see cref="PiaParams::applyCola"/> (or
+/// <see cref="PiaParams::applyCola99"/>) applied for each year.</remarks>
+///
+/// <returns>The amount after the last increase.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_APPCOLA2"/> if a year is out of the range of the
+/// table (debug mode only).</exception>
+///
+/// <param name="amounts">PIA or MFB to be increased.</param>
+/// <param name="year1">First year of benefit increases.</param>
+/// <param name="year3">Last year of benefit increases.</param>
+/// <param name="eligYear">Year of eligibility for catch-up benefit
+/// increases.</param>
+/// <param name="cola99">True if the special 1999 increase applies.</param>
+double ColaTable::apply( DoubleAnnual& amounts, int year1, int year3,
+int eligYear, bool cola99 ) const
+{
+#ifndef NDEBUG
+  if (year1 <= year3 && (year1 < firstYear || year3 > lastYear)) {
+    throw PiaException(PIA_IDS_APPCOLA2);
+  }
+#endif
+  double amount = (year1 <= year3) ? amounts[year1 - 1] : 0.0;
+  for (int year = year1; year <= year3; year++) {
+    if (cola99 && year == PiaParams::YEAR1999) {
+      amount = BenefitAmount::round(amount * factor99, year);
+    }
+    else {
+      amount = BenefitAmount::round(amount * factors[year - firstYear],
+        year);
+      const double catchupFactor = getCatchupFactor(eligYear, year);
+      if (catchupFactor > 0.0)
+        amount = BenefitAmount::round(amount * catchupFactor, year);
+    }
+    amounts[year] = amount;
+  }
+  return(amounts[year3]);
+}
+
+/// <summary>Computes the factors from the benefit increases.</summary>
+///
+/// <param name="cpiinc">Benefit increases.</param>
+/// <param name="catchup">Catch-up benefit increases.</param>
+void ColaTable::build( const DoubleAnnual& cpiinc, const Catchup& catchup )
+{
+  firstYear = cpiinc.getBaseYear();
+  lastYear = cpiinc.getLastYear();
+  catchupStart = catchup.getCstart();
+  const int count = lastYear - firstYear + 1;
+  factors.resize(count);
+  unFactors.resize(count);
+  for (int year = firstYear; year <= lastYear; year++) {
+    const double percent = cpiinc[year];
+    factors[year - firstYear] = 1. + percent / 100.;
+    unFactors[year - firstYear] = 100. / (100. + percent);
+  }
+  catchupFactors.assign(Catchup::NUM_CATCHUP_ELIG_YEARS * count, 0.0);
+  for (int row = 0; row < Catchup::NUM_CATCHUP_ELIG_YEARS; row++) {
+    for (int year = max(firstYear, YEAR37); year <= lastYear; year++) {
+      if (catchup.exist(catchupStart + row, year)) {
+        catchupFactors[row * count + year - firstYear] =
+          catchup.get(catchupStart + row, year) / 100.0 + 1.0;
+      }
+    }
+  }
+  const double percent99 = (firstYear <= PiaParams::YEAR1999 &&
+    lastYear >= PiaParams::YEAR1999) ? cpiinc[PiaParams::YEAR1999] : 0.0;
+  factor99 = 1. + (percent99 + 0.1) / 100.;
+  unFactor99 = 100. / (100. + (percent99 + 0.1));
+}
+
+/// <summary>Empties the table.</summary>
+void ColaTable::clear()
+{
+  firstYear = 0;
+  lastYear = -1;
+  factors.clear();
+  unFactors.clear();
+  catchupFactors.clear();
+}
+
+/// <summary>Removes the benefit increases for a range of years, starting
+/// with the last one.</summary>
+///
+/// <remarks>This gives the same amount as
+/// <see cref="PiaParams::unApplyCola"/> (or
+/// <see cref="PiaParams::unApplyCola99"/>) applied for each year.
+/// </remarks>
+///
+/// <returns>The amount before the first increase.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_UNBICCHP"/> if a year is out of the range of the
+/// table (debug mode only).</exception>
+///
+/// <param name="amount">PIA or MFB after the last increase.</param>
+/// <param name="year1">First year of benefit increases.</param>
+/// <param name="year3">Last year of benefit increases.</param>
+/// <param name="eligYear">Year of eligibility for catch-up benefit
+/// increases.</param>
+/// <param name="cola99">True if the special 1999 increase applies.</param>
+double ColaTable::unApply( double amount, int year1, int year3,
+int eligYear, bool cola99 ) const
+{
+#ifndef NDEBUG
+  if (year1 <= year3 && (year1 < firstYear || year3 > lastYear)) {
+    throw PiaException(PIA_IDS_UNBICCHP);
+  }
+#endif
+  for (int year = year3; year >= year1; year--) {
+    if (cola99 && year == PiaParams::YEAR1999) {
+      amount = BenefitAmount::unround(amount * unFactor99, year);
+    }
+    else {
+      amount = BenefitAmount::unround(amount * unFactors[year - firstYear],
+        year);
+      const double catchupFactor = getCatchupFactor(eligYear, year);
+      if (catchupFactor > 0.0)
+        amount = BenefitAmount::unround(amount / catchupFactor, year);
+    }
+  }
+  return(amount);
+}
@@ -99,7 +99,7 @@ void FrozMin::setFrozMin()
   const int year = (getIoasdi() == WorkerDataGeneral::SURVIVOR) ?
     (int)workerData.getDeathDate().year() :
     (int)workerData.getEntDate().getYear();
-  int yearCpiTemp = min(year, piaData.getBirthDateMinus1().year() + 65);
+  int yearCpiTemp = min(year, piaData.getBirthIndexMinus1().getYear() + 65);
   yearCpi[YEAR_ELIG] = yearCpiTemp;
   yearCpiTemp--;
   yearCpi[FIRST_YEAR] = yearCpiTemp;
@@ -0,0 +1,174 @@
+// Functions for the <see cref="MethodCounters"/> class to count the calls
+// of each pia calculation method and the time spent in them.
+
+#include <iomanip>
+#include <ostream>
+#include "boost/chrono/chrono.hpp"
+#include "MethodCounters.h"
+#include "StageTimes.h"
+
+using namespace std;
+
+/// <summary>Starts timing a call of a pia calculation method.</summary>
+///
+/// <param name="newMethodCounters">Where to add the call (may be null).
+/// </param>
+/// <param name="newMethod">Method being timed.</param>
+MethodCounters::Timer::Timer( MethodCounters *newMethodCounters,
+PiaMethod::pia_type newMethod ) :
+methodCounters(newMethodCounters), method(newMethod), start(0u)
+{
+  if (methodCounters != 0)
+    start = now();
+}
+
+/// <summary>Adds the call, and the time since construction, to the
+/// method.</summary>
+MethodCounters::Timer::~Timer()
+{
+  if (methodCounters != 0)
+    methodCounters->add(method, now() - start);
+}
+
+/// <summary>Initializes all counts to zero.</summary>
+MethodCounters::MethodCounters()
+{
+  clear();
+}
+
+/// <summary>Adds the counts of another instance to this one.</summary>
+///
+/// <returns>This instance.</returns>
+///
+/// <param name="methodCounters">Counts to add.</param>
+MethodCounters& MethodCounters::operator+=(
+const MethodCounters& methodCounters )
+{
+  calculations += methodCounters.calculations;
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    calls[i] += methodCounters.calls[i];
+    highPia[i] += methodCounters.highPia[i];
+    nanoseconds[i] += methodCounters.nanoseconds[i];
+    for (int j = 0; j < NUM_BUCKETS; j++) {
+      histogram[i][j] += methodCounters.histogram[i][j];
+    }
+  }
+  return(*this);
+}
+
+/// <summary>Adds one call of a method.</summary>
+///
+/// <param name="method">The method.</param>
+/// <param name="time">Nanoseconds spent in the call.</param>
+void MethodCounters::add( PiaMethod::pia_type method, boost::uint64_t time )
+{
+  calls[method]++;
+  nanoseconds[method] += time;
+  histogram[method][bucketCal(time)]++;
+}
+
+/// <summary>Adds one pia calculation.</summary>
+///
+/// <param name="highPiaMethod">Method with the highest pia (may be null).
+/// </param>
+void MethodCounters::addCalculation( const PiaMethod *highPiaMethod )
+{
+  calculations++;
+  if (highPiaMethod != 0 &&
+    highPiaMethod->getMethod() < PiaMethod::NO_PIA_TYPE)
+    highPia[highPiaMethod->getMethod()]++;
+}
+
+/// <summary>Sets all counts to zero.</summary>
+void MethodCounters::clear()
+{
+  calculations = 0ul;
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    calls[i] = 0ul;
+    highPia[i] = 0ul;
+    nanoseconds[i] = 0u;
+    for (int j = 0; j < NUM_BUCKETS; j++) {
+      histogram[i][j] = 0ul;
+    }
+  }
+}
+
+/// <summary>Writes the counts as a table, with the nonzero buckets of the
+/// histogram of each method on the following line.</summary>
+///
+/// <param name="out">Stream to write to.</param>
+void MethodCounters::write( std::ostream& out ) const
+{
+  out << "pia calculations: " << calculations << endl;
+  out << left << setw(17) << "method" << right << setw(10) << "calls"
+    << setw(9) << "applic" << setw(9) << "high" << setw(12) << "total ms"
+    << setw(10) << "mean us" << endl;
+  const ios::fmtflags flags = out.flags();
+  const streamsize precision = out.precision();
+  out.setf(ios::fixed, ios::floatfield);
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    if (calls[i] == 0ul)
+      continue;
+    const PiaMethod::pia_type method = static_cast<PiaMethod::pia_type>(i);
+    out.precision(3);
+    out << left << setw(17) << StageTimes::getMethodName(method) << right
+      << setw(10) << calls[i] << setw(9)
+      << ((calculations > 0ul) ?
+      static_cast<double>(calls[i]) / calculations : 0.0)
+      << setw(9) << ((calculations > 0ul) ?
+      static_cast<double>(highPia[i]) / calculations : 0.0);
+    out.precision(1);
+    out << setw(12) << nanoseconds[i] / 1.0e6 << setw(10)
+      << nanoseconds[i] / 1.0e3 / calls[i] << endl;
+    out << "  ";
+    for (int j = 0; j < NUM_BUCKETS; j++) {
+      if (histogram[i][j] == 0ul)
+        continue;
+      if (j < NUM_BUCKETS - 1)
+        out << " <" << getBucketLimit(j) << "ns:" << histogram[i][j];
+      else
+        out << " >=" << getBucketLimit(j - 1) << "ns:" << histogram[i][j];
+    }
+    out << endl;
+  }
+  out.flags(flags);
+  out.precision(precision);
+}
+
+/// <summary>Returns the bucket of the histogram for a time.</summary>
+///
+/// <returns>The bucket of the histogram for a time.</returns>
+///
+/// <param name="time">Time in nanoseconds.</param>
+int MethodCounters::bucketCal( boost::uint64_t time )
+{
+  int bucket = 0;
+  for (time >>= 8; time > 0u && bucket < NUM_BUCKETS - 1; time >>= 1) {
+    bucket++;
+  }
+  return(bucket);
+}
+
+/// <summary>Returns the upper limit of a bucket of the histogram.</summary>
+///
+/// <returns>The upper limit (exclusive) of a bucket, in nanoseconds. The
+/// last bucket has no upper limit; the largest integer is returned for it.
+/// </returns>
+///
+/// <param name="bucket">Number of bucket.</param>
+boost::uint64_t MethodCounters::getBucketLimit( int bucket )
+{
+  return((bucket < NUM_BUCKETS - 1) ?
+    static_cast<boost::uint64_t>(256u) << bucket :
+    ~static_cast<boost::uint64_t>(0u));
+}
+
+/// <summary>Returns the current time.</summary>
+///
+/// <returns>Nanoseconds since an arbitrary starting time.</returns>
+boost::uint64_t MethodCounters::now()
+{
+  return(static_cast<boost::uint64_t>(
+    boost::chrono::duration_cast< boost::chrono::nanoseconds >(
+    boost::chrono::steady_clock::now().time_since_epoch()).count()));
+}
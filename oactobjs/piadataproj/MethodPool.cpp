@@ -0,0 +1,120 @@
+// Functions for the <see cref="MethodPool"/> class to calculate the pia
+// calculation methods of one case on several threads.
+
+#include "boost/bind.hpp"
+#include "MethodPool.h"
+#include "MethodCounters.h"
+#include "PiaMethod.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Starts the threads.</summary>
+///
+/// <param name="newThreadCount">Number of threads to start, not counting
+/// the thread that calls <see cref="calculate"/>.</param>
+MethodPool::MethodPool( unsigned newThreadCount ) :
+threads(), mutex(), work(), done(), methods(0), times(0), piaErrors(),
+otherErrors(), next(0u), remaining(0u), threadCount(newThreadCount),
+stopping(false)
+{
+  for (unsigned i = 0; i < threadCount; i++) {
+    threads.create_thread(boost::bind(&MethodPool::workLoop, this));
+  }
+}
+
+/// <summary>Stops the threads.</summary>
+MethodPool::~MethodPool()
+{
+  {
+    boost::mutex::scoped_lock lock(mutex);
+    stopping = true;
+    work.notify_all();
+  }
+  threads.join_all();
+}
+
+/// <summary>Calculates methods, on the threads of this instance and the
+/// calling thread.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// first method in error threw one.</exception>
+/// <exception cref="std::runtime_error">Exception with the message of the
+/// exception thrown by the first method in error, if it was not a
+/// <see cref="PiaException"/>.</exception>
+///
+/// <param name="newMethods">Methods to calculate.</param>
+/// <param name="newTimes">Nanoseconds spent in each method (returned).
+/// </param>
+void MethodPool::calculate( const std::vector< PiaMethod* >& newMethods,
+std::vector< boost::uint64_t >& newTimes )
+{
+  const size_t count = newMethods.size();
+  newTimes.assign(count, 0u);
+  boost::mutex::scoped_lock lock(mutex);
+  methods = &newMethods;
+  times = &newTimes;
+  piaErrors.assign(count, boost::shared_ptr< PiaException >());
+  otherErrors.assign(count, boost::shared_ptr< runtime_error >());
+  next = 0u;
+  remaining = count;
+  if (count > 1u)
+    work.notify_all();
+  while (next < count) {
+    const size_t index = next++;
+    lock.unlock();
+    calculateOne(index);
+    lock.lock();
+    remaining--;
+  }
+  while (remaining > 0u) {
+    done.wait(lock);
+  }
+  methods = 0;
+  times = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (piaErrors[i])
+      throw PiaException(*piaErrors[i]);
+    if (otherErrors[i])
+      throw runtime_error(otherErrors[i]->what());
+  }
+}
+
+/// <summary>Calculates one method of the current request, saving its time
+/// and any exception it throws.</summary>
+///
+/// <param name="index">Index of the method.</param>
+void MethodPool::calculateOne( size_t index )
+{
+  const boost::uint64_t start = MethodCounters::now();
+  try {
+    (*methods)[index]->calculate();
+  } catch (PiaException& e) {
+    piaErrors[index].reset(new PiaException(e));
+  } catch (exception& e) {
+    otherErrors[index].reset(new runtime_error(e.what()));
+  }
+  (*times)[index] = MethodCounters::now() - start;
+}
+
+/// <summary>Calculates methods of each request until the instance is
+/// destroyed.</summary>
+///
+/// <remarks>This is the body of each thread.</remarks>
+void MethodPool::workLoop()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  for (;;) {
+    while (!stopping && (methods == 0 || next >= methods->size())) {
+      work.wait(lock);
+    }
+    if (stopping)
+      break;
+    const size_t index = next++;
+    lock.unlock();
+    calculateOne(index);
+    lock.lock();
+    if (--remaining == 0u)
+      done.notify_all();
+  }
+}
@@ -18,6 +18,7 @@
 #include "PiaException.h"
 #include "UserAssumptions.h"
 #include "SecondaryArray.h"
+#include "MethodCounters.h"
 #include "piaparms.h"
 #include "DebugCase.h"
 #if defined(DEBUGCASE)
@@ -64,7 +65,8 @@ void PiaCalPL::piaCal( const DateMoyr& entDate )
   setAmend90(entDate);
   // release any memory from a prior case
   releaseMemory();
-  // get new memory
+  // get new memory, from the arena if there is one
+  CalcArena::Scope arenaScope(arena);
   int maxYear = piaParams.getMaxyear();
   if (OldStart::isApplicable(piaData)) {
     PiaMethod* method = new OldStart(workerData, piaData, piaParams, maxYear,
@@ -118,16 +120,19 @@ void PiaCalPL::piaCal( const DateMoyr& entDate )
     piaMethod.push_back(method);
     wageIndNonFreeze = dynamic_cast<WageIndNonFreeze *>(method);
   }
+  arenaScope.leave();
   for (vector< PiaMethod * >::iterator iter = piaMethod.begin();
     iter != piaMethod.end(); iter++) {
     (*iter)->setApplicable(PiaMethod::APPLICABLE);
     (*iter)->setIoasdi(getIoasdi());
     (*iter)->setPebsAssumptions(isPebsAssumptions());
-    (*iter)->calculate();
   }
+  calculateMethods(piaMethod);
   resetAmend90();
   piaCal1();
   piaCal2();
+  if (methodCounters != 0)
+    methodCounters->addCalculation(highPiaMethod);
 #if defined(DEBUGCASE)
   if (isDebugPid(workerData.getIdNumber())) {
     Trace::writeLine(workerData.getIdString() +
@@ -158,7 +163,8 @@ void PiaCalPL::calculate2( const DateMoyr& entDate )
 #endif
 }
 
-/// <summary>Calculates PIA for one re-indexed widow(er).</summary>
+/// <summary>Creates the method for one re-indexed widow(er), if
+/// applicable.</summary>
 ///
 /// <param name="widowData">Widow basic data.</param>
 /// <param name="widowPiaData">Computed information for widow.</param>
@@ -168,12 +174,13 @@ const PiaData& widowPiaData, Secondary& secondary )
 {
   if (ReindWid::isApplicable(workerData, piaData, widowPiaData.getEligYear(),
     secondary)) {
+    CalcArena::Scope arenaScope(arena);
     ReindWid *reindWid = new ReindWid(workerData, piaData, piaParams,
       piaParams.getMaxyear(), widowPiaData, widowData, secondary);
+    arenaScope.leave();
     widowMethod.push_back(reindWid);
     reindWid->setApplicable(PiaMethod::APPLICABLE);
     reindWid->setIoasdi(getIoasdi());
     reindWid->setPebsAssumptions(isPebsAssumptions());
-    reindWid->calculate();
   }
 }
@@ -0,0 +1,421 @@
+// Functions for the <see cref="PiaColumnConvert"/> class to convert
+// between multi-record pia files and columnar population files.
+
+#include <iomanip>
+#include <ostream>
+#include "PiaColumnConvert.h"
+#include "PiaMappedFile.h"
+#include "PiaColumnFile.h"
+#include "PiaColumnWrite.h"
+#include "piawrite.h"
+#include "DateFormatter.h"
+#include "PiaException.h"
+#include "Resource.h"
+
+using namespace std;
+
+/// <summary>Initializes the data used to read each case.</summary>
+///
+/// <param name="baseYear">First year of projections.</param>
+PiaColumnConvert::PiaColumnConvert( int baseYear ) :
+workerData(), widowDataArray(), widowArray(), secondaryArray(),
+userAssumptions(WorkerData::getMaxyear()),
+piaRead(workerData, widowDataArray, widowArray, userAssumptions,
+secondaryArray), ssn(), text(), earnOasdi(), earnHi(), taxType(), qc(),
+childCare(), famBic(), famBirthDate(), famEntDate(), famOnsetDate()
+{
+  userAssumptions.setIstart(baseYear);
+  deleteContents();
+}
+
+/// <summary>Destructor.</summary>
+PiaColumnConvert::~PiaColumnConvert()
+{ }
+
+/// <summary>Clears the data from the previous case.</summary>
+void PiaColumnConvert::deleteContents()
+{
+  workerData.deleteContents();
+  widowArray.deleteContents();
+  widowDataArray.deleteContents();
+  secondaryArray.deleteContents();
+  userAssumptions.setIaltaw(AssumptionType::FLAT);
+  userAssumptions.setIaltbi(AssumptionType::FLAT);
+  userAssumptions.setIbasch(1);
+}
+
+/// <summary>Returns the flag of a line stored in columns.</summary>
+///
+/// <returns>The flag of the line in <see cref="PiaColumnRecord::flags"/>,
+/// 0 if the line is kept as text with the case, or
+/// <see cref="PiaColumnRecord::TEXT_ONLY"/> if the whole case must be kept
+/// as text.</returns>
+///
+/// <param name="lineType">Type of line (other than the first line and the
+/// family member lines).</param>
+unsigned PiaColumnConvert::lineFlag( int lineType )
+{
+  switch (lineType)
+  {
+  case 2:
+    return(PiaColumnRecord::DEATH);
+  case 3:
+    return(PiaColumnRecord::TOB);
+  case 4:
+    return(PiaColumnRecord::BENDATE);
+  case 6:
+    return(PiaColumnRecord::YEARS);
+  case 9:
+    return(PiaColumnRecord::DISAB1);
+  case 10:
+    return(PiaColumnRecord::DISAB2);
+  case 12:
+    return(PiaColumnRecord::PUBPEN);
+  case 13:
+    return(PiaColumnRecord::TOTALIZE);
+  case 14:
+    return(PiaColumnRecord::BLIND);
+  case 15:
+    return(PiaColumnRecord::DEEMED);
+  case 21:
+    return(PiaColumnRecord::TAXTYPE);
+  case 38:
+    return(PiaColumnRecord::RESERVIST);
+  case 39:
+    return(PiaColumnRecord::OABENT);
+  case 95:
+    return(PiaColumnRecord::QC1);
+  case 96:
+    return(PiaColumnRecord::QC2);
+  case 97:
+    return(PiaColumnRecord::CHILDCARE);
+  default:
+    if (lineType >= 22 && lineType <= 29)
+      return(PiaColumnRecord::EARN_OASDI);
+    if (lineType >= 30 && lineType <= 37)
+      return(PiaColumnRecord::EARN_HI);
+    if (lineType == 11 || (lineType >= 16 && lineType <= 19) ||
+      (lineType >= 40 && lineType <= 68) ||
+      (lineType >= 84 && lineType <= 94))
+      return(0u);
+    return(PiaColumnRecord::TEXT_ONLY);
+  }
+}
+
+/// <summary>Sets the values of one case of a pia file.</summary>
+///
+/// <remarks>The pointers in the record refer to memory in this instance
+/// and in the case, and are valid until the next call.</remarks>
+///
+/// <param name="begin">First character of the case (its line of type 1).
+/// </param>
+/// <param name="end">One past the last character of the case.</param>
+/// <param name="record">Values of the case (returned).</param>
+void PiaColumnConvert::makeRecord( const char *begin, const char *end,
+PiaColumnRecord& record )
+{
+  record.deleteContents();
+  text.clear();
+  famBic.clear();
+  unsigned flags = 0u;
+  unsigned famSize = 0u;
+  int lastLineType = 0;
+  // a case is stored in columns only if every line is complete
+  bool columns = (begin < end && end[-1] == '\n');
+  for (const char *next = begin; columns; ) {
+    const char *lineEnd = PiaRead::findLineEnd(next, end);
+    if (lineEnd == 0)
+      break;
+    const int lineType = PiaRead::lineTypeCal(next, lineEnd);
+    const char *line = next + piaRead.getWidth();
+    if (lineType <= lastLineType || (lastLineType == 0 && lineType != 1) ||
+      line > lineEnd) {
+      columns = false;
+    }
+    else if (lineType == 1) {
+      if (lineEnd - line < 9)
+        columns = false;
+      else
+        ssn.assign(line, 9);
+    }
+    else if (lineType >= 69 && lineType <= 83) {
+      if (lineType != 69 + static_cast<int>(famSize) || lineEnd - line < 2)
+        columns = false;
+      else {
+        famBic.append(line, 2);
+        famSize++;
+      }
+    }
+    else {
+      const unsigned flag = lineFlag(lineType);
+      if (flag == PiaColumnRecord::TEXT_ONLY)
+        columns = false;
+      else if (flag == 0u)
+        text.append(next, lineEnd + 1);
+      else
+        flags |= flag;
+    }
+    lastLineType = lineType;
+    next = lineEnd + 1;
+  }
+  // values by year are stored from the years of earnings
+  if ((flags & (PiaColumnRecord::TAXTYPE | PiaColumnRecord::EARN_OASDI |
+    PiaColumnRecord::EARN_HI | PiaColumnRecord::QC2 |
+    PiaColumnRecord::CHILDCARE)) && !(flags & PiaColumnRecord::YEARS))
+    columns = false;
+  if (columns) {
+    deleteContents();
+    try {
+      if (piaRead.read(begin, end) != PIA_IDS_READEOF ||
+        workerData.getJoasdi() == WorkerData::PEBS_CALC)
+        columns = false;
+    } catch (exception&) {
+      columns = false;
+    }
+  }
+  if (!columns) {
+    record.flags = PiaColumnRecord::TEXT_ONLY;
+    record.text = begin;
+    record.textLength = static_cast<unsigned>(end - begin);
+    return;
+  }
+  // quarters of coverage by year replace the summary quarters
+  if (flags & PiaColumnRecord::QC2)
+    flags &= ~PiaColumnRecord::QC1;
+  record.flags = flags;
+  record.ssn = ssn.data();
+  record.sex = static_cast<int>(workerData.getSex());
+  record.birthDate = PiaColumnRecord::fromDate(workerData.getBirthDate());
+  record.deathDate = PiaColumnRecord::fromDate(workerData.getDeathDate());
+  record.joasdi = static_cast<int>(workerData.getJoasdi());
+  record.entDate = PiaColumnRecord::fromDateMoyr(workerData.getEntDate());
+  record.benefitDate =
+    PiaColumnRecord::fromDateMoyr(workerData.getBenefitDate());
+  const int ibegin = workerData.getIbegin();
+  const int iend = workerData.getIend();
+  record.ibegin = ibegin;
+  record.iend = iend;
+  for (int i = 0; i < 2; i++) {
+    const DisabPeriod& disabPeriod = workerData.disabPeriod[i];
+    record.onsetDate[i] =
+      PiaColumnRecord::fromDate(disabPeriod.getOnsetDate());
+    record.priorentDate[i] =
+      PiaColumnRecord::fromDateMoyr(disabPeriod.getEntDate());
+    record.waitperDate[i] =
+      PiaColumnRecord::fromDateMoyr(disabPeriod.getWaitperDate());
+    record.cessationDate[i] =
+      PiaColumnRecord::fromDateMoyr(disabPeriod.getCessationDate());
+    record.cessationPia[i] = disabPeriod.getCessationPia();
+    record.cessationMfb[i] = disabPeriod.getCessationMfb();
+  }
+  record.pubpen = workerData.getPubpen();
+  record.pubpenDate = PiaColumnRecord::fromDateMoyr(workerData.getPubpenDate());
+  record.pubpenReservist = workerData.getPubpenReservist();
+  record.totalize = workerData.getTotalize();
+  record.blind = workerData.getBlindind();
+  record.deemed = workerData.getDeemedind();
+  record.oabEntDate = PiaColumnRecord::fromDateMoyr(workerData.getOabEntDate());
+  record.oabCessDate =
+    PiaColumnRecord::fromDateMoyr(workerData.getOabCessDate());
+  record.qctd = workerData.getQctottd();
+  record.qc51td = workerData.getQctot51td();
+  earnOasdi.clear();
+  if (flags & PiaColumnRecord::EARN_OASDI) {
+    for (int yr = ibegin; yr <= iend; yr++)
+      earnOasdi.push_back(workerData.getEarnOasdi(yr));
+  }
+  earnHi.clear();
+  if (flags & PiaColumnRecord::EARN_HI) {
+    for (int yr = workerData.firstEarnHiYear(); yr <= iend; yr++)
+      earnHi.push_back(workerData.getEarnHi(yr));
+  }
+  taxType.clear();
+  if (flags & PiaColumnRecord::TAXTYPE) {
+    for (int yr = ibegin; yr <= iend; yr++)
+      taxType.push_back(workerData.getTaxType(yr) ? 1u : 0u);
+  }
+  qc.clear();
+  if (flags & PiaColumnRecord::QC2) {
+    for (int yr = ibegin; yr <= workerData.lastQcyr(); yr++)
+      qc.push_back(static_cast<unsigned char>(workerData.qc.get(yr)));
+  }
+  childCare.clear();
+  if (flags & PiaColumnRecord::CHILDCARE) {
+    for (int yr = ibegin; yr <= iend; yr++)
+      childCare.push_back(workerData.childCareYears.getBit(yr) ? 1u : 0u);
+  }
+  famBirthDate.clear();
+  famEntDate.clear();
+  famOnsetDate.clear();
+  for (unsigned i = 0; i < famSize; i++) {
+    const WorkerData& widowData = *widowDataArray.workerData[i];
+    famBirthDate.push_back(
+      PiaColumnRecord::fromDate(widowData.getBirthDate()));
+    famEntDate.push_back(
+      PiaColumnRecord::fromDateMoyr(secondaryArray.secondary[i]->entDate));
+    famOnsetDate.push_back(
+      PiaColumnRecord::fromDate(widowData.disabPeriod[0].getOnsetDate()));
+  }
+  record.earnOasdi = earnOasdi.empty() ? 0 : &earnOasdi[0];
+  record.earnOasdiCount = static_cast<unsigned>(earnOasdi.size());
+  record.earnHi = earnHi.empty() ? 0 : &earnHi[0];
+  record.earnHiCount = static_cast<unsigned>(earnHi.size());
+  record.taxType = taxType.empty() ? 0 : &taxType[0];
+  record.taxTypeCount = static_cast<unsigned>(taxType.size());
+  record.qc = qc.empty() ? 0 : &qc[0];
+  record.qcCount = static_cast<unsigned>(qc.size());
+  record.childCare = childCare.empty() ? 0 : &childCare[0];
+  record.childCareCount = static_cast<unsigned>(childCare.size());
+  record.famSize = famSize;
+  record.famBic = famBic.data();
+  record.famBirthDate = famBirthDate.empty() ? 0 : &famBirthDate[0];
+  record.famEntDate = famEntDate.empty() ? 0 : &famEntDate[0];
+  record.famOnsetDate = famOnsetDate.empty() ? 0 : &famOnsetDate[0];
+  record.text = text.data();
+  record.textLength = static_cast<unsigned>(text.size());
+}
+
+/// <summary>Converts every case of a pia file to a columnar file.
+/// </summary>
+///
+/// <remarks>The directory of the columnar file is written after the last
+/// case.</remarks>
+///
+/// <returns>The number of cases converted.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// columnar file cannot be written.</exception>
+///
+/// <param name="in">The pia file.</param>
+/// <param name="out">The columnar file.</param>
+unsigned long PiaColumnConvert::toColumns( const PiaMappedFile& in,
+PiaColumnWrite& out )
+{
+  PiaColumnRecord record;
+  const unsigned count = in.getRecordCount();
+  for (unsigned i = 0; i < count; i++) {
+    makeRecord(in.getRecordBegin(i), in.getRecordEnd(i), record);
+    out.write(record);
+  }
+  out.finish();
+  return(count);
+}
+
+/// <summary>Converts every case of a columnar file to a pia file.
+/// </summary>
+///
+/// <returns>The number of cases converted.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if a case
+/// cannot be read.</exception>
+///
+/// <param name="in">The columnar file.</param>
+/// <param name="out">The pia file.</param>
+unsigned long PiaColumnConvert::toText( const PiaColumnFile& in,
+std::ostream& out )
+{
+  out.setf(ios::fixed, ios::floatfield);
+  PiaColumnRecord record;
+  const unsigned count = in.getRecordCount();
+  for (unsigned i = 0; i < count; i++) {
+    in.getRecord(i, record);
+    writeRecord(record, out);
+  }
+  return(count);
+}
+
+/// <summary>Writes the lines kept as text up to a type of line.</summary>
+///
+/// <returns>The first line not written.</returns>
+///
+/// <param name="next">First line not yet written.</param>
+/// <param name="end">End of the lines kept as text.</param>
+/// <param name="lastLineType">Last type of line to write.</param>
+/// <param name="out">The pia file.</param>
+const char *PiaColumnConvert::writeText( const char *next, const char *end,
+int lastLineType, std::ostream& out )
+{
+  for (const char *lineEnd = PiaRead::findLineEnd(next, end);
+    lineEnd != 0 && PiaRead::lineTypeCal(next, lineEnd) <= lastLineType;
+    lineEnd = PiaRead::findLineEnd(next, end)) {
+    out.write(next, lineEnd + 1 - next);
+    next = lineEnd + 1;
+  }
+  return(next);
+}
+
+/// <summary>Writes one case of a columnar file as lines of a pia file.
+/// </summary>
+///
+/// <remarks>The lines stored in columns are written as
+/// <see cref="PiaWrite"/> writes them, in order with the lines kept as
+/// text. The stream should use fixed-point notation.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// cannot be read.</exception>
+///
+/// <param name="record">Values of the case.</param>
+/// <param name="out">The pia file.</param>
+void PiaColumnConvert::writeRecord( const PiaColumnRecord& record,
+std::ostream& out )
+{
+  if (record.flags & PiaColumnRecord::TEXT_ONLY) {
+    out.write(record.text, record.textLength);
+    return;
+  }
+  deleteContents();
+  const unsigned int ret = piaRead.read(record);
+  if (ret != PIA_IDS_READEOF)
+    throw PiaException(static_cast<int>(ret));
+  const unsigned flags = record.flags;
+  const char *next = record.text;
+  const char *end = record.text + record.textLength;
+  PiaWrite piaWrite(workerData, widowDataArray, widowArray, userAssumptions,
+    secondaryArray);
+  const int width = piaWrite.getWidth();
+  piaWrite.writeSsn(out);
+  if (flags & PiaColumnRecord::DEATH)
+    piaWrite.writeDeath(out);
+  // written even without a benefit, to keep the date of entitlement
+  if (flags & PiaColumnRecord::TOB) {
+    out << setfill('0') << setw(width) << 3 << setfill(' ') << record.joasdi
+      << DateFormatter::toString(workerData.getEntDate(), "n") << endl;
+  }
+  if (flags & PiaColumnRecord::BENDATE)
+    piaWrite.writeBenDate(out);
+  if (flags & PiaColumnRecord::YEARS)
+    piaWrite.writeYears(out);
+  if (flags & PiaColumnRecord::DISAB1)
+    piaWrite.writeDisab1(out);
+  if (flags & PiaColumnRecord::DISAB2)
+    piaWrite.writeDisab2(out);
+  next = writeText(next, end, 11, out);
+  if (flags & PiaColumnRecord::PUBPEN)
+    piaWrite.writePubpen(out);
+  if (flags & PiaColumnRecord::TOTALIZE)
+    piaWrite.writeTotalize(out);
+  if (flags & PiaColumnRecord::BLIND)
+    piaWrite.writeBlind(out);
+  if (flags & PiaColumnRecord::DEEMED)
+    piaWrite.writeDeemed(out);
+  next = writeText(next, end, 19, out);
+  if (flags & PiaColumnRecord::TAXTYPE)
+    piaWrite.writeTaxType(out);
+  if (flags & PiaColumnRecord::EARN_OASDI)
+    piaWrite.writeEarnOasdi(out);
+  if (flags & PiaColumnRecord::EARN_HI)
+    piaWrite.writeEarnHi(out);
+  if (flags & PiaColumnRecord::RESERVIST)
+    piaWrite.writePubpenReservist(out);
+  if (flags & PiaColumnRecord::OABENT)
+    piaWrite.writeOabEnt(out);
+  next = writeText(next, end, 68, out);
+  piaWrite.writeFamilyMembers(out);
+  next = writeText(next, end, 94, out);
+  if (flags & PiaColumnRecord::QC1)
+    piaWrite.writeQc1(out);
+  if (flags & PiaColumnRecord::QC2)
+    piaWrite.writeQc2(out);
+  if (flags & PiaColumnRecord::CHILDCARE)
+    piaWrite.writeChildCareYears(out);
+}
@@ -0,0 +1,325 @@
+// Functions for the <see cref="PiaColumnFile"/> class to read the cases
+// of a columnar population file mapped into memory.
+
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include "PiaColumnFile.h"
+#include "PiaColumnRecord.h"
+#include "piaread.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Returns a column as an array of values.</summary>
+///
+/// <returns>The column as an array of values.</returns>
+///
+/// <param name="column">Start of the column.</param>
+template< class T >
+inline const T *columnArray( const char *column )
+{
+  return reinterpret_cast< const T * >(column);
+}
+
+/// <summary>Returns a value stored in the file.</summary>
+///
+/// <returns>The value.</returns>
+///
+/// <param name="data">Location of the value.</param>
+inline boost::uint64_t getUint64( const char *data )
+{
+  boost::uint64_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+/// <summary>Returns a value stored in the file.</summary>
+///
+/// <returns>The value.</returns>
+///
+/// <param name="data">Location of the value.</param>
+inline boost::uint32_t getUint32( const char *data )
+{
+  boost::uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+/// <summary>Throws the exception for a file that is not a valid columnar
+/// file.</summary>
+void badFile()
+{
+  throw PiaException("Invalid columnar population file");
+}
+
+}  // namespace
+
+const PiaColumnFile::ColumnInfo
+PiaColumnFile::columnInfo[PiaColumnFile::NUM_COLUMNS] = {
+  { PER_CASE, 4u, 1u, FLAGS },  // FLAGS
+  { PER_CASE, 1u, 9u, SSN },  // SSN
+  { PER_CASE, 1u, 1u, SEX },  // SEX
+  { PER_CASE, 4u, 1u, BIRTH_DATE },  // BIRTH_DATE
+  { PER_CASE, 4u, 1u, DEATH_DATE },  // DEATH_DATE
+  { PER_CASE, 1u, 1u, JOASDI },  // JOASDI
+  { PER_CASE, 4u, 1u, ENT_DATE },  // ENT_DATE
+  { PER_CASE, 4u, 1u, BENEFIT_DATE },  // BENEFIT_DATE
+  { PER_CASE, 2u, 1u, IBEGIN },  // IBEGIN
+  { PER_CASE, 2u, 1u, IEND },  // IEND
+  { PER_CASE, 4u, 2u, ONSET_DATE },  // ONSET_DATE
+  { PER_CASE, 4u, 2u, PRIORENT_DATE },  // PRIORENT_DATE
+  { PER_CASE, 4u, 2u, WAITPER_DATE },  // WAITPER_DATE
+  { PER_CASE, 4u, 2u, CESSATION_DATE },  // CESSATION_DATE
+  { PER_CASE, 4u, 2u, CESSATION_PIA },  // CESSATION_PIA
+  { PER_CASE, 4u, 2u, CESSATION_MFB },  // CESSATION_MFB
+  { PER_CASE, 4u, 1u, PUBPEN },  // PUBPEN
+  { PER_CASE, 4u, 1u, PUBPEN_DATE },  // PUBPEN_DATE
+  { PER_CASE, 4u, 1u, PUBPEN_RESERVIST },  // PUBPEN_RESERVIST
+  { PER_CASE, 1u, 1u, INDICATORS },  // INDICATORS
+  { PER_CASE, 4u, 1u, OABENT_DATE },  // OABENT_DATE
+  { PER_CASE, 4u, 1u, OABCESS_DATE },  // OABCESS_DATE
+  { PER_CASE, 2u, 1u, QCTD },  // QCTD
+  { PER_CASE, 2u, 1u, QC51TD },  // QC51TD
+  { INDEX, 4u, 1u, EARN_OASDI_INDEX },  // EARN_OASDI_INDEX
+  { VALUES, 8u, 1u, EARN_OASDI_INDEX },  // EARN_OASDI
+  { INDEX, 4u, 1u, EARN_HI_INDEX },  // EARN_HI_INDEX
+  { VALUES, 8u, 1u, EARN_HI_INDEX },  // EARN_HI
+  { INDEX, 4u, 1u, TAX_TYPE_INDEX },  // TAX_TYPE_INDEX
+  { VALUES, 1u, 1u, TAX_TYPE_INDEX },  // TAX_TYPE
+  { INDEX, 4u, 1u, QC_INDEX },  // QC_INDEX
+  { VALUES, 1u, 1u, QC_INDEX },  // QC
+  { INDEX, 4u, 1u, CHILD_CARE_INDEX },  // CHILD_CARE_INDEX
+  { VALUES, 1u, 1u, CHILD_CARE_INDEX },  // CHILD_CARE
+  { INDEX, 4u, 1u, FAMILY_INDEX },  // FAMILY_INDEX
+  { VALUES, 1u, 2u, FAMILY_INDEX },  // FAMILY_BIC
+  { VALUES, 4u, 1u, FAMILY_INDEX },  // FAMILY_BIRTH_DATE
+  { VALUES, 4u, 1u, FAMILY_INDEX },  // FAMILY_ENT_DATE
+  { VALUES, 4u, 1u, FAMILY_INDEX },  // FAMILY_ONSET_DATE
+  { INDEX, 4u, 1u, TEXT_INDEX },  // TEXT_INDEX
+  { VALUES, 1u, 1u, TEXT_INDEX }  // TEXT
+};
+
+const char PiaColumnFile::magic[] = "PIACOLS1";
+
+/// <summary>Maps the file into memory and reads its directory.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the file
+/// cannot be opened, or is not a valid columnar file written on a machine
+/// with the same byte order.</exception>
+///
+/// <param name="fileName">Name of columnar file.</param>
+PiaColumnFile::PiaColumnFile( const std::string& fileName ) :
+file(), groupSize(0u), recordCount(0u), groups()
+{
+  try {
+    file.open(fileName);
+  } catch (ios_base::failure&) {
+    throw PiaException("Cannot open " + fileName + " for input");
+  }
+  readDirectory();
+}
+
+/// <summary>Unmaps the file.</summary>
+PiaColumnFile::~PiaColumnFile()
+{ }
+
+/// <summary>Checks the header and finds the columns of each group.
+/// </summary>
+///
+/// <remarks>Every column is checked to lie within the file and to have the
+/// size required by the number of cases, and every index column is checked
+/// to be in order, so that the cases can be read later without checking.
+/// </remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the file
+/// is not valid.</exception>
+void PiaColumnFile::readDirectory()
+{
+  const char *data = file.data();
+  const boost::uint64_t size = file.size();
+  if (size < HEADER_SIZE + TRAILER_SIZE || memcmp(data, magic, 8) != 0 ||
+    memcmp(data + size - 8, magic, 8) != 0)
+    badFile();
+  if (getUint32(data + 8) != VERSION || getUint32(data + 12) != ENDIAN_MARK)
+    throw PiaException("Unsupported columnar population file");
+  if (getUint32(data + 16) != NUM_COLUMNS)
+    badFile();
+  groupSize = getUint32(data + 20);
+  const boost::uint64_t directory = getUint64(data + size - TRAILER_SIZE);
+  const boost::uint64_t groupCount =
+    getUint64(data + size - TRAILER_SIZE + 8);
+  const boost::uint64_t entrySize = 8u * (1u + 2u * NUM_COLUMNS);
+  if (groupSize == 0u || directory < HEADER_SIZE ||
+    groupCount > (size - directory) / entrySize ||
+    directory + groupCount * entrySize + TRAILER_SIZE != size)
+    badFile();
+  groups.resize(static_cast<size_t>(groupCount));
+  boost::uint64_t total = 0u;
+  for (size_t i = 0; i < groups.size(); i++) {
+    const char *entry = data + directory + i * entrySize;
+    Group& group = groups[i];
+    const boost::uint64_t count = getUint64(entry);
+    if (count > groupSize || (count < groupSize && i + 1 < groups.size()))
+      badFile();
+    group.recordCount = static_cast<unsigned>(count);
+    total += count;
+    for (int j = 0; j < NUM_COLUMNS; j++) {
+      const boost::uint64_t offset = getUint64(entry + 8u + 16u * j);
+      const boost::uint64_t length = getUint64(entry + 16u + 16u * j);
+      if (offset % 8u != 0u || offset < HEADER_SIZE || offset > directory ||
+        length > directory - offset)
+        badFile();
+      group.column[j] = data + offset;
+      const ColumnInfo& info = columnInfo[j];
+      boost::uint64_t elements = 0u;
+      if (info.kind == PER_CASE) {
+        elements = count * info.count;
+      }
+      else if (info.kind == INDEX) {
+        elements = count + 1u;
+        if (length != elements * info.elementSize)
+          badFile();
+        const boost::uint32_t *index =
+          columnArray< boost::uint32_t >(group.column[j]);
+        if (index[0] != 0u)
+          badFile();
+        for (boost::uint64_t k = 0u; k < count; k++) {
+          if (index[k + 1] < index[k])
+            badFile();
+        }
+      }
+      else {
+        elements = static_cast<boost::uint64_t>(columnArray< boost::uint32_t >(
+          group.column[info.index])[count]) * info.count;
+      }
+      if (length != elements * info.elementSize)
+        badFile();
+    }
+  }
+  if (total > 0xffffffffu)
+    badFile();
+  recordCount = static_cast<unsigned>(total);
+}
+
+/// <summary>Returns the values of one case.</summary>
+///
+/// <remarks>The arrays in the case point into the mapped file, so they are
+/// valid for the life of this instance.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// number is out of range.</exception>
+///
+/// <param name="index">Number of case (starting at 0).</param>
+/// <param name="record">Values of the case (returned).</param>
+void PiaColumnFile::getRecord( unsigned index,
+PiaColumnRecord& record ) const
+{
+  if (index >= recordCount)
+    throw PiaException("Case number out of range in PiaColumnFile::getRecord");
+  const Group& group = groups[index / groupSize];
+  const unsigned i = index % groupSize;
+  const char * const *column = group.column;
+  record.flags = columnArray< boost::uint32_t >(column[FLAGS])[i];
+  record.ssn = column[SSN] + 9u * i;
+  record.sex = columnArray< boost::uint8_t >(column[SEX])[i];
+  record.birthDate = columnArray< boost::int32_t >(column[BIRTH_DATE])[i];
+  record.deathDate = columnArray< boost::int32_t >(column[DEATH_DATE])[i];
+  record.joasdi = columnArray< boost::uint8_t >(column[JOASDI])[i];
+  record.entDate = columnArray< boost::int32_t >(column[ENT_DATE])[i];
+  record.benefitDate =
+    columnArray< boost::int32_t >(column[BENEFIT_DATE])[i];
+  record.ibegin = columnArray< boost::int16_t >(column[IBEGIN])[i];
+  record.iend = columnArray< boost::int16_t >(column[IEND])[i];
+  for (unsigned j = 0; j < 2u; j++) {
+    record.onsetDate[j] =
+      columnArray< boost::int32_t >(column[ONSET_DATE])[2u * i + j];
+    record.priorentDate[j] =
+      columnArray< boost::int32_t >(column[PRIORENT_DATE])[2u * i + j];
+    record.waitperDate[j] =
+      columnArray< boost::int32_t >(column[WAITPER_DATE])[2u * i + j];
+    record.cessationDate[j] =
+      columnArray< boost::int32_t >(column[CESSATION_DATE])[2u * i + j];
+    record.cessationPia[j] =
+      columnArray< float >(column[CESSATION_PIA])[2u * i + j];
+    record.cessationMfb[j] =
+      columnArray< float >(column[CESSATION_MFB])[2u * i + j];
+  }
+  record.pubpen = columnArray< float >(column[PUBPEN])[i];
+  record.pubpenDate = columnArray< boost::int32_t >(column[PUBPEN_DATE])[i];
+  record.pubpenReservist = columnArray< float >(column[PUBPEN_RESERVIST])[i];
+  const unsigned indicators =
+    columnArray< boost::uint8_t >(column[INDICATORS])[i];
+  record.totalize = (indicators & 1u) != 0u;
+  record.blind = (indicators & 2u) != 0u;
+  record.deemed = (indicators & 4u) != 0u;
+  record.oabEntDate = columnArray< boost::int32_t >(column[OABENT_DATE])[i];
+  record.oabCessDate =
+    columnArray< boost::int32_t >(column[OABCESS_DATE])[i];
+  record.qctd = columnArray< boost::int16_t >(column[QCTD])[i];
+  record.qc51td = columnArray< boost::int16_t >(column[QC51TD])[i];
+  const boost::uint32_t *index1 =
+    columnArray< boost::uint32_t >(column[EARN_OASDI_INDEX]);
+  record.earnOasdi = columnArray< double >(column[EARN_OASDI]) + index1[i];
+  record.earnOasdiCount = index1[i + 1] - index1[i];
+  index1 = columnArray< boost::uint32_t >(column[EARN_HI_INDEX]);
+  record.earnHi = columnArray< double >(column[EARN_HI]) + index1[i];
+  record.earnHiCount = index1[i + 1] - index1[i];
+  index1 = columnArray< boost::uint32_t >(column[TAX_TYPE_INDEX]);
+  record.taxType =
+    columnArray< unsigned char >(column[TAX_TYPE]) + index1[i];
+  record.taxTypeCount = index1[i + 1] - index1[i];
+  index1 = columnArray< boost::uint32_t >(column[QC_INDEX]);
+  record.qc = columnArray< unsigned char >(column[QC]) + index1[i];
+  record.qcCount = index1[i + 1] - index1[i];
+  index1 = columnArray< boost::uint32_t >(column[CHILD_CARE_INDEX]);
+  record.childCare =
+    columnArray< unsigned char >(column[CHILD_CARE]) + index1[i];
+  record.childCareCount = index1[i + 1] - index1[i];
+  index1 = columnArray< boost::uint32_t >(column[FAMILY_INDEX]);
+  record.famSize = index1[i + 1] - index1[i];
+  record.famBic = column[FAMILY_BIC] + 2u * index1[i];
+  record.famBirthDate =
+    columnArray< boost::int32_t >(column[FAMILY_BIRTH_DATE]) + index1[i];
+  record.famEntDate =
+    columnArray< boost::int32_t >(column[FAMILY_ENT_DATE]) + index1[i];
+  record.famOnsetDate =
+    columnArray< boost::int32_t >(column[FAMILY_ONSET_DATE]) + index1[i];
+  index1 = columnArray< boost::uint32_t >(column[TEXT_INDEX]);
+  record.text = column[TEXT] + index1[i];
+  record.textLength = index1[i + 1] - index1[i];
+}
+
+/// <summary>Reads one case.</summary>
+///
+/// <remarks>Call <see cref="WorkerDataGeneral::deleteContents"/> for the
+/// worker and each family member before this function.</remarks>
+///
+/// <returns>The value returned by <see cref="PiaRead::read(const
+/// PiaColumnRecord&)"/>.</returns>
+///
+/// <param name="piaRead">Reader to use.</param>
+/// <param name="index">Number of case (starting at 0).</param>
+unsigned int PiaColumnFile::read( PiaRead& piaRead, unsigned index ) const
+{
+  PiaColumnRecord record;
+  getRecord(index, record);
+  return(piaRead.read(record));
+}
+
+/// <summary>Checks whether a file is a columnar population file.</summary>
+///
+/// <returns>True if the file starts with the columnar file identifier.
+/// </returns>
+///
+/// <param name="fileName">Name of file.</param>
+bool PiaColumnFile::isColumnFile( const std::string& fileName )
+{
+  ifstream in(fileName.c_str(), ios::in | ios::binary);
+  char header[8];
+  if (!in.read(header, sizeof(header)))
+    return false;
+  return memcmp(header, magic, sizeof(header)) == 0;
+}
@@ -0,0 +1,94 @@
+// Functions for the <see cref="PiaColumnRecord"/> class to hold the
+// values of one case in a columnar population file.
+
+#include "PiaColumnRecord.h"
+
+using namespace std;
+
+/// <summary>Initializes an empty case.</summary>
+PiaColumnRecord::PiaColumnRecord()
+{
+  deleteContents();
+}
+
+/// <summary>Clears all values.</summary>
+void PiaColumnRecord::deleteContents()
+{
+  flags = 0u;
+  ssn = 0;
+  sex = 0;
+  birthDate = deathDate = 0;
+  joasdi = 0;
+  entDate = benefitDate = 0;
+  ibegin = iend = 0;
+  for (int i = 0; i < 2; i++) {
+    onsetDate[i] = priorentDate[i] = waitperDate[i] = cessationDate[i] = 0;
+    cessationPia[i] = cessationMfb[i] = 0.0f;
+  }
+  pubpen = pubpenReservist = 0.0f;
+  pubpenDate = 0;
+  totalize = blind = deemed = false;
+  oabEntDate = oabCessDate = 0;
+  qctd = qc51td = 0;
+  earnOasdi = earnHi = 0;
+  earnOasdiCount = earnHiCount = 0u;
+  taxType = qc = childCare = 0;
+  taxTypeCount = qcCount = childCareCount = 0u;
+  famSize = 0u;
+  famBic = 0;
+  famBirthDate = famEntDate = famOnsetDate = 0;
+  text = 0;
+  textLength = 0u;
+}
+
+/// <summary>Returns a full date as stored in a columnar file.</summary>
+///
+/// <returns>The date as yyyymmdd, or 0 if it has not been set.</returns>
+///
+/// <param name="dateModyyr">The date to convert.</param>
+int PiaColumnRecord::fromDate( const boost::gregorian::date& dateModyyr )
+{
+  if (dateModyyr.is_special())
+    return 0;
+  const boost::gregorian::date::ymd_type ymd = dateModyyr.year_month_day();
+  return (static_cast<int>(ymd.year) * 100 + static_cast<int>(ymd.month)) *
+    100 + static_cast<int>(ymd.day);
+}
+
+/// <summary>Returns a month and year as stored in a columnar file.
+/// </summary>
+///
+/// <returns>The date as yyyymm (0 if it has not been set).</returns>
+///
+/// <param name="dateMoyr">The date to convert.</param>
+int PiaColumnRecord::fromDateMoyr( const DateMoyr& dateMoyr )
+{
+  return static_cast<int>(dateMoyr.getYear()) * 100 +
+    static_cast<int>(dateMoyr.getMonth());
+}
+
+/// <summary>Returns a full date stored in a columnar file.</summary>
+///
+/// <returns>The date, or not-a-date if the value is 0.</returns>
+///
+/// <param name="value">The date as yyyymmdd.</param>
+boost::gregorian::date PiaColumnRecord::toDate( int value )
+{
+  if (value == 0)
+    return boost::gregorian::date(boost::date_time::not_a_date_time);
+  return boost::gregorian::date(
+    static_cast<unsigned short>(value / 10000),
+    static_cast<unsigned short>((value / 100) % 100),
+    static_cast<unsigned short>(value % 100));
+}
+
+/// <summary>Returns a month and year stored in a columnar file.</summary>
+///
+/// <returns>The month and year.</returns>
+///
+/// <param name="value">The date as yyyymm.</param>
+DateMoyr PiaColumnRecord::toDateMoyr( int value )
+{
+  return DateMoyr(static_cast<unsigned>(value % 100),
+    static_cast<unsigned>(value / 100));
+}
@@ -0,0 +1,249 @@
+// Functions for the <see cref="PiaColumnWrite"/> class to write a
+// columnar population file.
+
+#include <cstring>
+#include <ostream>
+#include "PiaColumnWrite.h"
+#include "PiaColumnRecord.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Zero bytes used to align the columns.</summary>
+const char padding[8] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+}  // namespace
+
+/// <summary>Writes the header of the file.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// header cannot be written.</exception>
+///
+/// <param name="newOut">Output stream, opened in binary mode.</param>
+/// <param name="newGroupSize">Number of cases in each group.</param>
+PiaColumnWrite::PiaColumnWrite( std::ostream& newOut,
+unsigned newGroupSize ) :
+out(newOut), groupSize((newGroupSize > 0u) ? newGroupSize : 1u),
+groupRecords(0u), groups(), position(0u), recordCount(0ul),
+finished(false)
+{
+  char header[PiaColumnFile::HEADER_SIZE];
+  memset(header, 0, sizeof(header));
+  memcpy(header, PiaColumnFile::magic, 8);
+  const boost::uint32_t values[4] = { PiaColumnFile::VERSION,
+    PiaColumnFile::ENDIAN_MARK, PiaColumnFile::NUM_COLUMNS, groupSize };
+  memcpy(header + 8, values, sizeof(values));
+  writeBytes(header, sizeof(header));
+  startGroup();
+}
+
+/// <summary>Destructor.</summary>
+///
+/// <remarks>This does not write the directory; call
+/// <see cref="finish"/> first.</remarks>
+PiaColumnWrite::~PiaColumnWrite()
+{ }
+
+/// <summary>Adds one case.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the group
+/// cannot be written, or the file has been finished.</exception>
+///
+/// <param name="record">Values of the case.</param>
+void PiaColumnWrite::write( const PiaColumnRecord& record )
+{
+  if (finished)
+    throw PiaException("Columnar population file already finished");
+  const boost::uint32_t flags = record.flags;
+  append(PiaColumnFile::FLAGS, &flags, sizeof(flags));
+  append(PiaColumnFile::SSN, (record.ssn != 0) ? record.ssn : "000000000",
+    9u);
+  const boost::uint8_t sex = static_cast<boost::uint8_t>(record.sex);
+  append(PiaColumnFile::SEX, &sex, sizeof(sex));
+  boost::int32_t date = record.birthDate;
+  append(PiaColumnFile::BIRTH_DATE, &date, sizeof(date));
+  date = record.deathDate;
+  append(PiaColumnFile::DEATH_DATE, &date, sizeof(date));
+  const boost::uint8_t joasdi = static_cast<boost::uint8_t>(record.joasdi);
+  append(PiaColumnFile::JOASDI, &joasdi, sizeof(joasdi));
+  date = record.entDate;
+  append(PiaColumnFile::ENT_DATE, &date, sizeof(date));
+  date = record.benefitDate;
+  append(PiaColumnFile::BENEFIT_DATE, &date, sizeof(date));
+  boost::int16_t year = static_cast<boost::int16_t>(record.ibegin);
+  append(PiaColumnFile::IBEGIN, &year, sizeof(year));
+  year = static_cast<boost::int16_t>(record.iend);
+  append(PiaColumnFile::IEND, &year, sizeof(year));
+  for (int i = 0; i < 2; i++) {
+    date = record.onsetDate[i];
+    append(PiaColumnFile::ONSET_DATE, &date, sizeof(date));
+    date = record.priorentDate[i];
+    append(PiaColumnFile::PRIORENT_DATE, &date, sizeof(date));
+    date = record.waitperDate[i];
+    append(PiaColumnFile::WAITPER_DATE, &date, sizeof(date));
+    date = record.cessationDate[i];
+    append(PiaColumnFile::CESSATION_DATE, &date, sizeof(date));
+    append(PiaColumnFile::CESSATION_PIA, &record.cessationPia[i],
+      sizeof(float));
+    append(PiaColumnFile::CESSATION_MFB, &record.cessationMfb[i],
+      sizeof(float));
+  }
+  append(PiaColumnFile::PUBPEN, &record.pubpen, sizeof(float));
+  date = record.pubpenDate;
+  append(PiaColumnFile::PUBPEN_DATE, &date, sizeof(date));
+  append(PiaColumnFile::PUBPEN_RESERVIST, &record.pubpenReservist,
+    sizeof(float));
+  const boost::uint8_t indicators = static_cast<boost::uint8_t>(
+    (record.totalize ? 1u : 0u) | (record.blind ? 2u : 0u) |
+    (record.deemed ? 4u : 0u));
+  append(PiaColumnFile::INDICATORS, &indicators, sizeof(indicators));
+  date = record.oabEntDate;
+  append(PiaColumnFile::OABENT_DATE, &date, sizeof(date));
+  date = record.oabCessDate;
+  append(PiaColumnFile::OABCESS_DATE, &date, sizeof(date));
+  boost::int16_t qcs = static_cast<boost::int16_t>(record.qctd);
+  append(PiaColumnFile::QCTD, &qcs, sizeof(qcs));
+  qcs = static_cast<boost::int16_t>(record.qc51td);
+  append(PiaColumnFile::QC51TD, &qcs, sizeof(qcs));
+  append(PiaColumnFile::EARN_OASDI, record.earnOasdi,
+    record.earnOasdiCount * sizeof(double));
+  appendIndex(PiaColumnFile::EARN_OASDI_INDEX, record.earnOasdiCount);
+  append(PiaColumnFile::EARN_HI, record.earnHi,
+    record.earnHiCount * sizeof(double));
+  appendIndex(PiaColumnFile::EARN_HI_INDEX, record.earnHiCount);
+  append(PiaColumnFile::TAX_TYPE, record.taxType, record.taxTypeCount);
+  appendIndex(PiaColumnFile::TAX_TYPE_INDEX, record.taxTypeCount);
+  append(PiaColumnFile::QC, record.qc, record.qcCount);
+  appendIndex(PiaColumnFile::QC_INDEX, record.qcCount);
+  append(PiaColumnFile::CHILD_CARE, record.childCare,
+    record.childCareCount);
+  appendIndex(PiaColumnFile::CHILD_CARE_INDEX, record.childCareCount);
+  append(PiaColumnFile::FAMILY_BIC, record.famBic, 2u * record.famSize);
+  append(PiaColumnFile::FAMILY_BIRTH_DATE, record.famBirthDate,
+    record.famSize * sizeof(boost::int32_t));
+  append(PiaColumnFile::FAMILY_ENT_DATE, record.famEntDate,
+    record.famSize * sizeof(boost::int32_t));
+  append(PiaColumnFile::FAMILY_ONSET_DATE, record.famOnsetDate,
+    record.famSize * sizeof(boost::int32_t));
+  appendIndex(PiaColumnFile::FAMILY_INDEX, record.famSize);
+  append(PiaColumnFile::TEXT, record.text, record.textLength);
+  appendIndex(PiaColumnFile::TEXT_INDEX, record.textLength);
+  groupRecords++;
+  recordCount++;
+  if (groupRecords == groupSize) {
+    writeGroup();
+    startGroup();
+  }
+}
+
+/// <summary>Writes the last group and the directory.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the file
+/// cannot be written.</exception>
+void PiaColumnWrite::finish()
+{
+  if (finished)
+    return;
+  if (groupRecords > 0u)
+    writeGroup();
+  const boost::uint64_t directory = position;
+  for (vector< GroupEntry >::const_iterator it = groups.begin();
+    it != groups.end(); ++it) {
+    writeBytes(&it->recordCount, sizeof(it->recordCount));
+    for (int j = 0; j < PiaColumnFile::NUM_COLUMNS; j++) {
+      writeBytes(&it->offset[j], sizeof(it->offset[j]));
+      writeBytes(&it->length[j], sizeof(it->length[j]));
+    }
+  }
+  const boost::uint64_t trailer[2] = { directory, groups.size() };
+  writeBytes(trailer, sizeof(trailer));
+  writeBytes(PiaColumnFile::magic, 8u);
+  out.flush();
+  if (!out)
+    throw PiaException("Error writing columnar population file");
+  finished = true;
+}
+
+/// <summary>Appends values to a column of the current group.</summary>
+///
+/// <param name="column">Column to append to.</param>
+/// <param name="data">Values to append.</param>
+/// <param name="length">Number of bytes to append.</param>
+void PiaColumnWrite::append( PiaColumnFile::column_id column,
+const void *data, std::size_t length )
+{
+  if (length > 0u) {
+    const char *bytes = static_cast<const char *>(data);
+    buffer[column].insert(buffer[column].end(), bytes, bytes + length);
+  }
+}
+
+/// <summary>Appends the end of the values of the current case to an index
+/// column.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the group
+/// has too many values for the index.</exception>
+///
+/// <param name="column">Index column to append to.</param>
+/// <param name="count">Number of values of the current case.</param>
+void PiaColumnWrite::appendIndex( PiaColumnFile::column_id column,
+unsigned count )
+{
+  vector< char >& index = buffer[column];
+  boost::uint32_t last;
+  memcpy(&last, &index[index.size() - sizeof(last)], sizeof(last));
+  if (count > 0xffffffffu - last)
+    throw PiaException("Too many values in columnar population group");
+  last += count;
+  append(column, &last, sizeof(last));
+}
+
+/// <summary>Starts a new group.</summary>
+void PiaColumnWrite::startGroup()
+{
+  for (int j = 0; j < PiaColumnFile::NUM_COLUMNS; j++) {
+    buffer[j].clear();
+    if (PiaColumnFile::columnInfo[j].kind == PiaColumnFile::INDEX) {
+      const boost::uint32_t zero = 0u;
+      append(static_cast<PiaColumnFile::column_id>(j), &zero, sizeof(zero));
+    }
+  }
+  groupRecords = 0u;
+}
+
+/// <summary>Writes bytes to the file.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the bytes
+/// cannot be written.</exception>
+///
+/// <param name="data">Bytes to write.</param>
+/// <param name="length">Number of bytes to write.</param>
+void PiaColumnWrite::writeBytes( const void *data, std::size_t length )
+{
+  out.write(static_cast<const char *>(data),
+    static_cast<streamsize>(length));
+  if (!out)
+    throw PiaException("Error writing columnar population file");
+  position += length;
+}
+
+/// <summary>Writes the columns of the current group, each aligned on an
+/// 8-byte boundary.</summary>
+void PiaColumnWrite::writeGroup()
+{
+  GroupEntry entry;
+  entry.recordCount = groupRecords;
+  for (int j = 0; j < PiaColumnFile::NUM_COLUMNS; j++) {
+    if (position % 8u != 0u)
+      writeBytes(padding, static_cast<size_t>(8u - position % 8u));
+    entry.offset[j] = position;
+    entry.length[j] = buffer[j].size();
+    if (!buffer[j].empty())
+      writeBytes(&buffer[j][0], buffer[j].size());
+  }
+  if (position % 8u != 0u)
+    writeBytes(padding, static_cast<size_t>(8u - position % 8u));
+  groups.push_back(entry);
+}
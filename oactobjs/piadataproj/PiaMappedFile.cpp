@@ -0,0 +1,154 @@
+// Functions for the <see cref="PiaMappedFile"/> class to read the cases
+// of a pia file mapped into memory.
+
+#include <cstring>
+#include <fstream>
+#include <ios>
+#include "PiaMappedFile.h"
+#include "piaread.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Maps the file into memory and finds the start of each case.
+/// </summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the file
+/// cannot be opened.</exception>
+///
+/// <param name="fileName">Name of pia file.</param>
+PiaMappedFile::PiaMappedFile( const std::string& fileName ) :
+file(), recordStart()
+{
+  ifstream in(fileName.c_str(), ios::in | ios::binary | ios::ate);
+  if (!in)
+    throw PiaException("Cannot open " + fileName + " for input");
+  // an empty file cannot be mapped, and has no cases
+  if (in.tellg() > 0) {
+    in.close();
+    try {
+      file.open(fileName);
+    } catch (ios_base::failure&) {
+      throw PiaException("Cannot open " + fileName + " for input");
+    }
+  }
+  indexRecords();
+}
+
+/// <summary>Unmaps the file.</summary>
+PiaMappedFile::~PiaMappedFile()
+{ }
+
+/// <summary>Finds the start of each case.</summary>
+///
+/// <remarks>The first case starts at the start of the file, whatever its
+/// line type, as in <see cref="PiaRead::read(std::istream&)"/>. Each later
+/// case starts at a line of type 1.</remarks>
+void PiaMappedFile::indexRecords()
+{
+  recordStart.clear();
+  if (!file.is_open() || file.size() == 0) {
+    recordStart.push_back(0);
+    return;
+  }
+  const char *begin = file.data();
+  const char *end = begin + file.size();
+  recordStart.push_back(0);
+  const char *lineEnd = PiaRead::findLineEnd(begin, end);
+  if (lineEnd != 0) {
+    for (const char *next = lineEnd + 1; ; next = lineEnd + 1) {
+      lineEnd = PiaRead::findLineEnd(next, end);
+      if (lineEnd == 0 || lineEnd == next) {
+        recordStart.push_back(static_cast<size_t>(next - begin));
+        return;
+      }
+      if (PiaRead::lineTypeCal(next, lineEnd) == 1)
+        recordStart.push_back(static_cast<size_t>(next - begin));
+    }
+  }
+  recordStart.push_back(file.size());
+}
+
+/// <summary>Returns the first character of a case.</summary>
+///
+/// <returns>The first character of a case.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// number is out of range.</exception>
+///
+/// <param name="index">Number of case (starting at 0).</param>
+const char *PiaMappedFile::getRecordBegin( unsigned index ) const
+{
+  if (index >= getRecordCount())
+    throw PiaException("Case number out of range in PiaMappedFile::getRecordBegin");
+  return(file.data() + recordStart[index]);
+}
+
+/// <summary>Returns one past the last character of a case.</summary>
+///
+/// <returns>One past the last character of a case.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// number is out of range.</exception>
+///
+/// <param name="index">Number of case (starting at 0).</param>
+const char *PiaMappedFile::getRecordEnd( unsigned index ) const
+{
+  if (index >= getRecordCount())
+    throw PiaException("Case number out of range in PiaMappedFile::getRecordEnd");
+  return(file.data() + recordStart[index + 1]);
+}
+
+/// <summary>Returns a key that identifies the text of a case.</summary>
+///
+/// <remarks>The key is a 64-bit hash of the text of the case and its
+/// length, taken 8 bytes at a time, so cases with the same text have the
+/// same key, in this file or any other.</remarks>
+///
+/// <returns>True (every case has a key).</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// number is out of range.</exception>
+///
+/// <param name="index">Number of case (starting at 0).</param>
+/// <param name="key">Key of the case (returned).</param>
+bool PiaMappedFile::getRecordKey( unsigned index, boost::uint64_t& key ) const
+{
+  const char *next = getRecordBegin(index);
+  const char *end = getRecordEnd(index);
+  const boost::uint64_t multiplier = 0x9e3779b97f4a7c15ULL;
+  boost::uint64_t hash = static_cast<boost::uint64_t>(end - next) *
+    multiplier;
+  for (; end - next >= 8; next += 8) {
+    boost::uint64_t word;
+    memcpy(&word, next, 8);
+    hash = (hash ^ word) * multiplier;
+    hash ^= hash >> 29;
+  }
+  boost::uint64_t word = 0u;
+  memcpy(&word, next, static_cast<size_t>(end - next));
+  hash = (hash ^ word) * multiplier;
+  key = hash ^ (hash >> 32);
+  return(true);
+}
+
+/// <summary>Reads one case.</summary>
+///
+/// <remarks>The case is read up to the end of the file, so that it stops
+/// at the first line of the next case, if any, and only the last case is
+/// finished as the end of the file, as when the cases are read in order
+/// from a stream.
+///
+/// Call <see cref="WorkerDataGeneral::deleteContents"/> for the worker and
+/// each family member before this function.</remarks>
+///
+/// <returns>The value returned by <see cref="PiaRead::read(const char*,
+/// const char*)"/>: 0 if another case follows, or
+/// <see cref="PIA_IDS_READEOF"/> for the last case.</returns>
+///
+/// <param name="piaRead">Reader to use.</param>
+/// <param name="index">Number of case (starting at 0).</param>
+unsigned int PiaMappedFile::read( PiaRead& piaRead, unsigned index ) const
+{
+  return(piaRead.read(getRecordBegin(index), file.data() + file.size()));
+}
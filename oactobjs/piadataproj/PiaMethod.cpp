@@ -37,11 +37,13 @@ indCap(NO_CAP), ioasdi(WorkerDataGeneral::NO_BEN), tableNum(NO_TABLE),
 piasub(0.0), methodType(newMethod), mfbsub(0.0), pebsAssumptions(false),
 piaEligTotal(), piaTotal(), piaWindfall(), methodTitle(newTitle),
 workerData(newWorkerData), piaData(newPiaData), piaParams(newPiaParams),
-dirty(false), iorder(YEAR37, newMaxyear), mfbElig(YEAR37, newMaxyear),
-mfbEnt(), piaElig(YEAR37, newMaxyear), piaEnt(), earnMultiplied(YEAR37,
-newMaxyear), earnIndexed(YEAR37, newMaxyear)
+dirty(false), orderBuffer(), orderFirst(0), orderLast(-1), orderSorted(0),
+iorder(YEAR37, newMaxyear), mfbElig(YEAR37, newMaxyear), mfbEnt(),
+piaElig(YEAR37, newMaxyear), piaEnt(), earnMultiplied(YEAR37, newMaxyear),
+earnIndexed(YEAR37, newMaxyear)
 {
   fill_n(yearCpi, (int)MAXIYCPI, 0);
+  orderBuffer.reserve(static_cast<size_t>(newMaxyear - YEAR37 + 1));
 }
 
 /// <summary>Destructor.</summary>
@@ -262,66 +264,102 @@ double PiaMethod::applyColasElig( DoubleAnnual& pia77, int year1,
   // prior to benefit increase month, there are no CPI increases applied
   const int year3 = (static_cast< int >(dateMoyr2.getMonth()) <
     piaParams.getMonthBeninc(year2)) ? year2 - 1 : year2;
-  for (int year = year1; year <= year3; year++) {
-    // check for special 1999 increase (with extra 0.1 percent)
-    if (piaParams.isApplicableCola99(year, dateMoyr2)) {
-      // apply 1999 special increase
+  const double rv =
+    piaParams.applyColas(pia77, year1, year3, catchupYear, dateMoyr2);
 #if defined(DEBUGCASE)
-      if (isDebugPid(workerData.getIdNumber())) {
-        Trace::writeLine(workerData.getIdString() +
-          ": Calling piaParams.applyCola99");
-      }
-#endif
-      pia77[year] = piaParams.applyCola99(pia77[year-1]);
-    }
-    else {
-#if defined(DEBUGCASE)
-      if (isDebugPid(workerData.getIdNumber())) {
-        ostringstream strm;
-        strm << workerData.getIdString() << ", cola for year " << year
-          << ": Calling piaParams.applyCola";
-        Trace::writeLine(strm.str());
-      }
-#endif
-      pia77[year] = piaParams.applyCola(pia77[year-1], year, catchupYear);
-    }
-#if defined(DEBUGCASE)
-    if (isDebugPid(workerData.getIdNumber())) {
-      ostringstream strm;
-      strm.setf(ios::fixed, ios::floatfield);
-      strm.precision(2);
-      strm << workerData.getIdString() << ", amount with cola "
-        << pia77[year]
-        << ": After calling piaParams.applyCola or applyCola99";
-      Trace::writeLine(strm.str());
+  if (isDebugPid(workerData.getIdNumber())) {
+    ostringstream strm;
+    strm.setf(ios::fixed, ios::floatfield);
+    strm.precision(2);
+    for (int year = year1; year <= year3; year++) {
+      strm << workerData.getIdString() << ", amount with cola for year "
+        << year << " " << pia77[year]
+        << ": After calling piaParams.applyColas" << endl;
     }
-#endif
+    Trace::write(strm.str());
   }
-  return(pia77[year3]);
+#endif
+  return(rv);
 }
 
 /// <summary>Orders earnings and sets indicator for the highest years.
 /// </summary>
 ///
 /// <remarks>The number of years selected could be less than the desired
-/// number, if there are not that many years of earnings.</remarks>
+/// number, if there are not that many years of earnings.
+///
+/// Years are ranked by (earnings, year), so of two years with equal
+/// earnings the later one is selected first. Only the highest years are
+/// separated from the rest and put in order. If the earnings in the range
+/// are unchanged since the last call, the previous ordering is reused, so
+/// trying different numbers of computation years does not sort the
+/// earnings again. The ordering is also reused if the only years that
+/// changed were below the highest years already in order, and still are,
+/// since the same years are then selected; this happens when a method is
+/// kept from one calculation to the next (see
+/// <see cref="PiaCal::setIncremental"/>).</remarks>
 ///
 /// <param name="first">First year of earnings.</param>
 /// <param name="last">Last year of earnings.</param>
 /// <param name="number">Number of years to be selected.</param>
 void PiaMethod::orderEarnings( int first, int last, int number )
 {
-  vector< pair< double, int > > wearn;  // earnings array
   const int numtosort = last - first + 1;
-  if (numtosort > 0) {
-    for (int i1 = 0; i1 < numtosort; i1++) {  // initialize array
-      wearn.push_back(make_pair(earnIndexed[first + i1], first + i1));
+  if (numtosort <= 0)
+    return;
+  bool unchanged = (first == orderFirst && last == orderLast);
+  // years before this index are not in order, and are below those after it
+  const int lowest = static_cast<int>(orderBuffer.size()) - orderSorted;
+  for (int i1 = 0; unchanged && i1 < static_cast<int>(orderBuffer.size());
+    i1++) {
+    pair< double, int >& entry = orderBuffer[i1];
+    const double earn = earnIndexed[entry.second];
+    if (entry.first != earn) {
+      unchanged = (i1 < lowest && (orderSorted == 0 ||
+        make_pair(earn, entry.second) < orderBuffer[lowest]));
+      if (unchanged)
+        entry.first = earn;
     }
-    sort(wearn.begin(),wearn.end());
-    const int i2 = max(numtosort - number, 0);
-    for (int i1 = i2; i1 < numtosort; i1++) {
-      iorder[wearn[i1].second] = 1;
+  }
+  if (!unchanged) {
+    orderBuffer.clear();
+    for (int i1 = first; i1 <= last; i1++) {  // initialize array
+      orderBuffer.push_back(make_pair(earnIndexed[i1], i1));
     }
+    orderFirst = first;
+    orderLast = last;
+    orderSorted = 0;
+  }
+  orderEarnings(number);
+}
+
+/// <summary>Sets indicator for the highest years, using the earnings
+/// ordered by the last call to
+/// <see cref="orderEarnings(int, int, int)"/>.</summary>
+///
+/// <remarks>The highest years not already in order are separated from the
+/// rest with a partial selection and sorted, so repeated calls with an
+/// increasing number of years do only the additional work. The earnings
+/// must not have changed since the last ordering.</remarks>
+///
+/// <param name="number">Number of years to be selected.</param>
+void PiaMethod::orderEarnings( int number )
+{
+  const int numtosort = static_cast<int>(orderBuffer.size());
+  const int count = min(max(number, 0), numtosort);
+  if (count > orderSorted) {
+    const vector< pair< double, int >,
+      ArenaAllocator< pair< double, int > > >::iterator end =
+      orderBuffer.end() - orderSorted;
+    const vector< pair< double, int >,
+      ArenaAllocator< pair< double, int > > >::iterator nth =
+      orderBuffer.end() - count;
+    nth_element(orderBuffer.begin(), nth, end);
+    sort(nth, end);
+    orderSorted = count;
+  }
+  for (int i1 = numtosort - count; i1 < numtosort; i1++) {
+    iorder[orderBuffer[i1].second] = 1;
   }
 }
 
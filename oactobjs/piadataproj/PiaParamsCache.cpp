@@ -0,0 +1,238 @@
+// Functions for the <see cref="PiaParamsCache"/> class to manage shared,
+// read-only Social Security parameters projected for one set of assumptions.
+
+#include <algorithm>
+#include <sstream>
+#include "boost/functional/hash.hpp"
+#include "PiaParamsCache.h"
+#include "piaparmsAny.h"
+#include "UserAssumptions.h"
+#include "Assumptions.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Appends the values of an annual array to a string stream.
+/// </summary>
+///
+/// <param name="strm">Stream to append to.</param>
+/// <param name="data">Array of values.</param>
+/// <param name="firstYear">First year to append.</param>
+void appendAnnual( ostringstream& strm, const DoubleAnnual& data,
+int firstYear )
+{
+  for (int yr = max(firstYear, data.getBaseYear()); yr <= data.getLastYear();
+    yr++) {
+    strm << data[yr] << ' ';
+  }
+  strm << '\n';
+}
+
+}  // namespace
+
+/// <summary>Orders keys by hash first, so that most comparisons do not
+/// look at the user-specified values.</summary>
+///
+/// <returns>True if this key is ordered before the other key.</returns>
+///
+/// <param name="key">Key to compare to.</param>
+bool PiaParamsCache::Key::operator<( const Key& key ) const
+{
+  if (userHash != key.userHash)
+    return userHash < key.userHash;
+  if (altbi != key.altbi)
+    return altbi < key.altbi;
+  if (altaw != key.altaw)
+    return altaw < key.altaw;
+  if (ibasch != key.ibasch)
+    return ibasch < key.ibasch;
+  return userData < key.userData;
+}
+
+/// <summary>Checks two keys for equality.</summary>
+///
+/// <returns>True if the keys identify the same assumptions.</returns>
+///
+/// <param name="key">Key to compare to.</param>
+bool PiaParamsCache::Key::operator==( const Key& key ) const
+{
+  return userHash == key.userHash && altbi == key.altbi &&
+    altaw == key.altaw && ibasch == key.ibasch && userData == key.userData;
+}
+
+/// <summary>Initializes the cache, with no snapshots.</summary>
+///
+/// <remarks>The arguments must remain valid for the life of the cache and
+/// of every snapshot it returns.</remarks>
+///
+/// <param name="newIstart">Year after last known benefit increase.</param>
+/// <param name="newMaxyear">Maximum projected year.</param>
+/// <param name="newAwbiData">Historical average wages and benefit
+/// increases.</param>
+/// <param name="newLawChange">Law change parameters.</param>
+/// <param name="newAssumptions">Stored benefit increase and average wage
+/// assumptions.</param>
+PiaParamsCache::PiaParamsCache( int newIstart, int newMaxyear,
+AwbiData& newAwbiData, const LawChangeArray& newLawChange,
+Assumptions& newAssumptions ) :
+istart(newIstart), maxyear(newMaxyear), awbiData(newAwbiData),
+lawChange(newLawChange), assumptions(newAssumptions), mutex(), snapshots()
+{ }
+
+/// <summary>Destructor.</summary>
+PiaParamsCache::~PiaParamsCache()
+{ }
+
+/// <summary>Releases all snapshots held by the cache.</summary>
+///
+/// <remarks>Snapshots still held by a calculation are destroyed when the
+/// calculation releases them.</remarks>
+void PiaParamsCache::clear()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  snapshots.clear();
+}
+
+/// <summary>Returns the number of snapshots held by the cache.</summary>
+///
+/// <returns>The number of snapshots held by the cache.</returns>
+unsigned PiaParamsCache::getSize()
+{
+  boost::mutex::scoped_lock lock(mutex);
+  return static_cast<unsigned>(snapshots.size());
+}
+
+/// <summary>Returns the snapshot for a set of user assumptions, building it
+/// if necessary.</summary>
+///
+/// <returns>The snapshot for the assumptions.</returns>
+///
+/// <param name="userAssumptions">User-specified assumptions.</param>
+boost::shared_ptr< const PiaParamsAny > PiaParamsCache::get(
+const UserAssumptions& userAssumptions )
+{
+  return get(makeKey(userAssumptions), userAssumptions);
+}
+
+/// <summary>Returns the snapshot for a set of user assumptions, building it
+/// if necessary.</summary>
+///
+/// <remarks>If another thread is building a snapshot, this waits for it to
+/// finish, so each snapshot is projected only once.</remarks>
+///
+/// <returns>The snapshot for the assumptions.</returns>
+///
+/// <param name="key">Key of the assumptions, from
+/// <see cref="makeKey"/>.</param>
+/// <param name="userAssumptions">User-specified assumptions.</param>
+boost::shared_ptr< const PiaParamsAny > PiaParamsCache::get(
+const Key& key, const UserAssumptions& userAssumptions )
+{
+  boost::mutex::scoped_lock lock(mutex);
+  map< Key, boost::shared_ptr< const PiaParamsAny > >::const_iterator it =
+    snapshots.find(key);
+  if (it != snapshots.end())
+    return it->second;
+  boost::shared_ptr< const PiaParamsAny > snapshot(build(userAssumptions));
+  snapshots[key] = snapshot;
+  return snapshot;
+}
+
+/// <summary>Returns the key identifying a set of user assumptions.</summary>
+///
+/// <remarks>The user-specified values are included only if they are used,
+/// so all cases using the stored alternatives share one snapshot.</remarks>
+///
+/// <returns>The key identifying the assumptions.</returns>
+///
+/// <param name="userAssumptions">User-specified assumptions.</param>
+PiaParamsCache::Key PiaParamsCache::makeKey(
+const UserAssumptions& userAssumptions )
+{
+  Key key;
+  key.altbi = userAssumptions.getIaltbi();
+  key.altaw = userAssumptions.getIaltaw();
+  key.ibasch = userAssumptions.getIbasch();
+  ostringstream strm;
+  strm.precision(17);
+  if (key.altbi == AssumptionType::OTHER_ASSUM) {
+    strm << userAssumptions.titleBi << '\n';
+    appendAnnual(strm, userAssumptions.biproj, UserAssumptions::getIstart());
+    const Catchup& catchup = userAssumptions.catchup;
+    strm << catchup.getCstart();
+    for (int i = 0; i < Catchup::NUM_CATCHUP_ELIG_YEARS; i++) {
+      for (int j = 0; j < CatchupIncreases::NUM_CATCHUP_INCREASES; j++) {
+        strm << ' ' << catchup.getCatchupIncreases(i).get(j);
+      }
+    }
+    strm << '\n';
+  }
+  if (key.altaw == AssumptionType::OTHER_ASSUM) {
+    strm << userAssumptions.titleAw << '\n';
+    appendAnnual(strm, userAssumptions.awincproj,
+      UserAssumptions::getIstart() - 1);
+  }
+  if (key.ibasch == 2) {
+    appendAnnual(strm, userAssumptions.baseOasdi,
+      UserAssumptions::getIstart() + 1);
+    appendAnnual(strm, userAssumptions.base77,
+      UserAssumptions::getIstart() + 1);
+  }
+  key.userData = strm.str();
+  key.userHash = boost::hash_value(key.userData);
+  return key;
+}
+
+/// <summary>Builds a new snapshot.</summary>
+///
+/// <remarks>This does the same projections as
+/// <see cref="PiaCalAny::calculate1"/> does when all of the assumptions
+/// have changed. It is called with the mutex locked, since it changes the
+/// stored assumptions.</remarks>
+///
+/// <returns>The new snapshot.</returns>
+///
+/// <param name="userAssumptions">User-specified assumptions.</param>
+PiaParamsAny *PiaParamsCache::build( const UserAssumptions& userAssumptions )
+{
+  PiaParamsAny *piaParams =
+    new PiaParamsAny(istart, maxyear, awbiData, lawChange);
+  try {
+    piaParams->setHistFqinc();
+    const AssumptionType::assum_type altbi = userAssumptions.getIaltbi();
+    if (altbi == AssumptionType::OTHER_ASSUM) {
+      piaParams->updateCpiinc(userAssumptions.biproj,
+        userAssumptions.catchup, userAssumptions.titleBi,
+        UserAssumptions::getIstart(), userAssumptions.biproj.getLastYear());
+    }
+    else {
+      assumptions.benefitIncMenu(altbi);
+      piaParams->updateCpiinc(assumptions.getBiProj().theData,
+        assumptions.getCatchupDoc().catchup,
+        assumptions.getBenefitInc(altbi), assumptions.getIstart(),
+        assumptions.getBiProj().theData.getLastYear());
+    }
+    const AssumptionType::assum_type altaw = userAssumptions.getIaltaw();
+    if (altaw == AssumptionType::OTHER_ASSUM) {
+      piaParams->updateFqinc(userAssumptions.awincproj,
+        userAssumptions.titleAw, UserAssumptions::getIstart() - 1,
+        userAssumptions.awincproj.getLastYear());
+    }
+    else {
+      assumptions.averageWageMenu(altaw);
+      piaParams->updateFqinc(assumptions.getAwincProj().awinc,
+        assumptions.getAverageWage(altaw), assumptions.getIstart() - 1,
+        assumptions.getAwincProj().awinc.getLastYear());
+    }
+    piaParams->updateBases(userAssumptions.baseOasdi,
+      userAssumptions.base77, userAssumptions.getIbasch(),
+      UserAssumptions::getIstart() + 1,
+      userAssumptions.baseOasdi.getLastYear());
+    piaParams->updateYocAmountSpecMin();
+  } catch (...) {
+    delete piaParams;
+    throw;
+  }
+  return piaParams;
+}
@@ -0,0 +1,37 @@
+// Functions for the <see cref="PibTableSearch"/> class to search the
+// pib-pia conversion tables.
+
+#include "pibtable.h"
+
+/// <summary>Finds the lowest entry of a table that an amount does not
+/// exceed.</summary>
+///
+/// <remarks>The entries from first to last must be in increasing order.
+/// The result is the same as starting at the first entry and moving up
+/// while the amount is greater than the entry plus the margin, stopping at
+/// the last entry.</remarks>
+///
+/// <returns>Index of the lowest entry from first to last, such that the
+/// amount is not greater than the entry plus the margin (last if there is
+/// none).</returns>
+///
+/// <param name="table">Entries of the table.</param>
+/// <param name="first">Index of the first entry to consider.</param>
+/// <param name="last">Index of the last entry to consider.</param>
+/// <param name="amount">Amount to find.</param>
+/// <param name="margin">Amount added to each entry before comparing.
+/// </param>
+int PibTableSearch::bracket( const double table[], int first, int last,
+double amount, double margin )
+{
+  int low = first;
+  int high = last;
+  while (low < high) {
+    const int mid = low + (high - low) / 2;
+    if (amount > table[mid] + margin)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return(low);
+}
@@ -285,18 +285,33 @@ double Psa::contribCal( int eligYear, int benYear, double earnings ) const
 /// (0 if not married).</param>
 double Psa::annuityCal( double amount, int year, Sex::sex_type sex,
  int workerAge, int spouseAge ) const
+{
+  // Return the amount that person will get each month.
+  return amount / getAnnuityFactor(year, sex, workerAge, spouseAge);
+}
+
+/// <summary>Returns the annuity factor: the amount in a psa account that
+/// buys an annuity of one dollar a month.</summary>
+///
+/// <returns>The annuity factor.</returns>
+///
+/// <param name="year">Year for which annuity is being calculated.</param>
+/// <param name="sex">The sex of the person.</param>
+/// <param name="workerAge">The age in years of the person getting the annuity.
+/// </param>
+/// <param name="spouseAge">The age in years of the person's spouse
+/// (0 if not married).</param>
+double Psa::getAnnuityFactor( int year, Sex::sex_type sex, int workerAge,
+int spouseAge ) const
 {
   const int yearInd = getLimitedYear(year);
   const int workerAgeInd = getAgeIndex(workerAge);
   const int spouseAgeInd = getAgeIndex(spouseAge);
   const bool isSLorUnmarried = (annuityType == ANNUITY_SL || spouseAge == 0);
   const PsaSexType sexInd = getSexType(sex, isSLorUnmarried);
-  // Find the correct annuity factor
-  const double annFac = (isSLorUnmarried) ?
+  return (isSLorUnmarried) ?
     (*annFacSL[sexInd][workerAgeInd])[yearInd] :
     (*annFacJS[sexInd][workerAgeInd][spouseAgeInd])[yearInd];
-  // Return the amount that person will get each month.
-  return amount / annFac;
 }
 
 /// <summary>Calculate the ammount that a person would get if he sold back
@@ -0,0 +1,393 @@
+// Functions for the <see cref="PsaSimulation"/> class to simulate the
+// distribution of psa annuities over random investment returns.
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include "boost/bind.hpp"
+#include "boost/thread/thread.hpp"
+#include "PsaSimulation.h"
+#include "LawChangePSAACCT.h"
+#include "dbleann.h"
+#include "PiaException.h"
+
+using namespace std;
+
+namespace {
+
+/// <summary>Multiplier of the first word of the Philox4x32 counter.
+/// </summary>
+const boost::uint32_t PHILOX_M0 = 0xD2511F53u;
+/// <summary>Multiplier of the third word of the Philox4x32 counter.
+/// </summary>
+const boost::uint32_t PHILOX_M1 = 0xCD9E8D57u;
+/// <summary>Increment of the first word of the Philox4x32 key.</summary>
+const boost::uint32_t PHILOX_W0 = 0x9E3779B9u;
+/// <summary>Increment of the second word of the Philox4x32 key.</summary>
+const boost::uint32_t PHILOX_W1 = 0xBB67AE85u;
+
+/// <summary>Returns four random words for a counter and key, using the
+/// Philox4x32-10 generator of Salmon et al. (2011).</summary>
+///
+/// <param name="ctr">Counter (replaced by the random words).</param>
+/// <param name="key0">First word of the key.</param>
+/// <param name="key1">Second word of the key.</param>
+void philox( boost::uint32_t ctr[4], boost::uint32_t key0,
+boost::uint32_t key1 )
+{
+  for (int round = 0; round < 10; round++) {
+    const boost::uint64_t product0 =
+      static_cast<boost::uint64_t>(PHILOX_M0) * ctr[0];
+    const boost::uint64_t product1 =
+      static_cast<boost::uint64_t>(PHILOX_M1) * ctr[2];
+    const boost::uint32_t word0 =
+      static_cast<boost::uint32_t>(product1 >> 32) ^ ctr[1] ^ key0;
+    const boost::uint32_t word2 =
+      static_cast<boost::uint32_t>(product0 >> 32) ^ ctr[3] ^ key1;
+    ctr[1] = static_cast<boost::uint32_t>(product1);
+    ctr[3] = static_cast<boost::uint32_t>(product0);
+    ctr[0] = word0;
+    ctr[2] = word2;
+    key0 += PHILOX_W0;
+    key1 += PHILOX_W1;
+  }
+}
+
+/// <summary>Returns a uniform random number in (0, 1) from two random
+/// words.</summary>
+///
+/// <returns>A uniform random number in (0, 1).</returns>
+///
+/// <param name="high">Word giving the high bits.</param>
+/// <param name="low">Word giving the low bits.</param>
+double toUniform( boost::uint32_t high, boost::uint32_t low )
+{
+  const boost::uint64_t bits =
+    ((static_cast<boost::uint64_t>(high) << 32) | low) >> 11;
+  return((static_cast<double>(bits) + 0.5) / 9007199254740992.0);
+}
+
+/// <summary>Sets standard normal random numbers, one for each investment,
+/// for one path and year.</summary>
+///
+/// <remarks>The pairs of numbers are made from the Philox words by the
+/// Box-Muller transform.</remarks>
+///
+/// <param name="normals">Normal random numbers (returned).</param>
+/// <param name="seed">Seed of the simulation.</param>
+/// <param name="workerKey">Key of the worker.</param>
+/// <param name="path">Number of the path.</param>
+/// <param name="year">Year.</param>
+void setNormals( double normals[], boost::uint64_t seed,
+boost::uint64_t workerKey, unsigned path, int year )
+{
+  static const double TWO_PI = 6.283185307179586;
+  for (int pair = 0; 2 * pair < Psa::NUM_INVESTMENTS; pair++) {
+    boost::uint32_t ctr[4];
+    ctr[0] = path;
+    ctr[1] = (static_cast<boost::uint32_t>(year) << 8) |
+      static_cast<boost::uint32_t>(pair);
+    ctr[2] = static_cast<boost::uint32_t>(workerKey);
+    ctr[3] = static_cast<boost::uint32_t>(workerKey >> 32);
+    philox(ctr, static_cast<boost::uint32_t>(seed),
+      static_cast<boost::uint32_t>(seed >> 32));
+    const double radius = sqrt(-2.0 * log(toUniform(ctr[0], ctr[1])));
+    const double angle = TWO_PI * toUniform(ctr[2], ctr[3]);
+    normals[2 * pair] = radius * cos(angle);
+    if (2 * pair + 1 < Psa::NUM_INVESTMENTS)
+      normals[2 * pair + 1] = radius * sin(angle);
+  }
+}
+
+/// <summary>Returns true if the contributions of a year are split among
+/// the investments.</summary>
+///
+/// <returns>True if the shares of the investments in the year are not all
+/// zero.</returns>
+///
+/// <param name="shares">Share of each investment in each year, by
+/// investment (by row) and year (by column).</param>
+/// <param name="years">Number of years.</param>
+/// <param name="i">Index of the year.</param>
+bool hasShares( const vector< double >& shares, int years, int i )
+{
+  for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+    if (shares[type * years + i] > 0.0)
+      return(true);
+  }
+  return(false);
+}
+
+}  // namespace
+
+/// <summary>Creates a simulation with 10,000 paths on one thread per
+/// processor.</summary>
+///
+/// <param name="newLawChangePSAACCT">Psa law change parameters.</param>
+PsaSimulation::PsaSimulation(
+const LawChangePSAACCT& newLawChangePSAACCT ) :
+lawChangePSAACCT(newLawChangePSAACCT), paths(10000u), seed(0u),
+threadCount(1u), firstYear(0), years(0), contribs(), shares(),
+annuities(), meanReturnAnnuity(0.0)
+{
+  fill_n(mean, static_cast<int>(Psa::NUM_INVESTMENTS), 0.0);
+  fill_n(stdDev, static_cast<int>(Psa::NUM_INVESTMENTS), 0.0);
+  fill_n(keep, static_cast<int>(Psa::NUM_INVESTMENTS), 1.0);
+  fill_n(adminFee, static_cast<int>(Psa::NUM_INVESTMENTS), 0.0);
+  setThreadCount(0u);
+}
+
+/// <summary>Returns the mean annuity of the last simulation.</summary>
+///
+/// <returns>The mean annuity of the last simulation (0 if none).</returns>
+double PsaSimulation::getMean() const
+{
+  if (annuities.empty())
+    return(0.0);
+  return(accumulate(annuities.begin(), annuities.end(), 0.0) /
+    static_cast<double>(annuities.size()));
+}
+
+/// <summary>Returns one percentile of the annuities of the last
+/// simulation.</summary>
+///
+/// <remarks>The percentile is the smallest annuity such that at least the
+/// given percent of the paths have an annuity no larger.</remarks>
+///
+/// <returns>The percentile of the annuities.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if there has
+/// been no simulation, or the percent is not from 0 to 100.</exception>
+///
+/// <param name="percent">Percent of paths (0 to 100).</param>
+double PsaSimulation::getPercentile( double percent ) const
+{
+  if (annuities.empty())
+    throw PiaException("PsaSimulation::getPercentile: No simulation");
+  if (percent < 0.0 || percent > 100.0)
+    throw PiaException("PsaSimulation::getPercentile: Invalid percent");
+  const double rank =
+    ceil(percent / 100.0 * static_cast<double>(annuities.size()));
+  const size_t index = (rank < 1.0) ? 0u : static_cast<size_t>(rank) - 1u;
+  return(annuities[min(index, annuities.size() - 1u)]);
+}
+
+/// <summary>Sets the number of threads to use.</summary>
+///
+/// <param name="newThreadCount">New number of threads, or 0 for one per
+/// processor.</param>
+void PsaSimulation::setThreadCount( unsigned newThreadCount )
+{
+  if (newThreadCount == 0u)
+    newThreadCount = boost::thread::hardware_concurrency();
+  threadCount = max(newThreadCount, 1u);
+}
+
+/// <summary>Simulates a psa account with given contributions.</summary>
+///
+/// <remarks>The returns and fees are taken from the law change as the
+/// simulation starts. The annuities of the paths are then available from
+/// <see cref="getAnnuities"/> and <see cref="getPercentile"/>.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// contributions and shares do not have one value for each investment in
+/// each year, or the annuity factor is not positive.</exception>
+///
+/// <param name="newFirstYear">First year of contributions.</param>
+/// <param name="newContribs">Contribution to each investment in each year,
+/// by investment (by row) and year (by column).</param>
+/// <param name="newShares">Share of each investment in each year, by
+/// investment (by row) and year (by column), used to rebalance the
+/// investments (all zero in a year with no contribution split).</param>
+/// <param name="annuityFactor">Amount in the account that buys an annuity
+/// of one dollar.</param>
+/// <param name="workerKey">Key for the worker's random returns, such as
+/// the Social Security number; workers with different keys get
+/// independent returns.</param>
+void PsaSimulation::simulate( int newFirstYear,
+const std::vector< double >& newContribs,
+const std::vector< double >& newShares, double annuityFactor,
+boost::uint64_t workerKey )
+{
+  if (newContribs.size() % Psa::NUM_INVESTMENTS != 0u ||
+    newShares.size() != newContribs.size())
+    throw PiaException("PsaSimulation::simulate: Invalid contributions");
+  if (!(annuityFactor > 0.0))
+    throw PiaException("PsaSimulation::simulate: Invalid annuity factor");
+  firstYear = newFirstYear;
+  years = static_cast<int>(newContribs.size() / Psa::NUM_INVESTMENTS);
+  contribs = newContribs;
+  shares = newShares;
+  for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+    const Psa::InvestmentType investment =
+      static_cast<Psa::InvestmentType>(type);
+    // as in Psa::setParameters
+    mean[type] = lawChangePSAACCT.getInvestMean(investment) / 100.0;
+    stdDev[type] = lawChangePSAACCT.getInvestStdDev(investment) / 100.0;
+    keep[type] = 1.0 - lawChangePSAACCT.getMngmtFee(investment);
+    adminFee[type] = lawChangePSAACCT.getAdminFee(investment);
+  }
+  meanReturnAnnuity = accumulateMean() / annuityFactor;
+  annuities.assign(paths, 0.0);
+  const unsigned blocks = (paths + BLOCK_SIZE - 1u) / BLOCK_SIZE;
+  const unsigned threads = min(threadCount, blocks);
+  if (threads > 1u) {
+    boost::thread_group group;
+    for (unsigned i = 0; i < threads; i++) {
+      group.create_thread(boost::bind(&PsaSimulation::runBlocks, this, i,
+        threads, workerKey));
+    }
+    group.join_all();
+  }
+  else {
+    runBlocks(0u, 1u, workerKey);
+  }
+  for (vector< double >::iterator it = annuities.begin();
+    it != annuities.end(); ++it) {
+    *it /= annuityFactor;
+  }
+  sort(annuities.begin(), annuities.end());
+}
+
+/// <summary>Simulates the psa account of one worker.</summary>
+///
+/// <remarks>Contributions are made from the year the worker reaches the
+/// starting age for contributions through the year before the annuity
+/// year, and the annuity factor is that of the annuity year.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the annuity
+/// factor is not positive.</exception>
+///
+/// <param name="psa">Psa parameters and annuity factors.</param>
+/// <param name="earnings">Annual earnings of the worker.</param>
+/// <param name="birthYear">Year of birth of the worker.</param>
+/// <param name="eligYear">Year of eligibility of the worker.</param>
+/// <param name="annuityYear">Year in which the annuity is bought.</param>
+/// <param name="sex">Sex of the worker.</param>
+/// <param name="spouseAge">Age of the worker's spouse in the annuity year
+/// (0 if not married).</param>
+/// <param name="workerKey">Key for the worker's random returns.</param>
+void PsaSimulation::simulate( const Psa& psa, const DoubleAnnual& earnings,
+int birthYear, int eligYear, int annuityYear, Sex::sex_type sex,
+int spouseAge, boost::uint64_t workerKey )
+{
+  const int first = max(earnings.getBaseYear(),
+    birthYear + lawChangePSAACCT.getContribStartAge());
+  const int lastYear = min(annuityYear - 1, earnings.getLastYear());
+  const int count = max(lastYear - first + 1, 0);
+  vector< double > newContribs(Psa::NUM_INVESTMENTS * count, 0.0);
+  vector< double > newShares(Psa::NUM_INVESTMENTS * count, 0.0);
+  for (int i = 0; i < count; i++) {
+    const int year = first + i;
+    const double contrib = psa.contribCal(eligYear, year, earnings[year]);
+    double perc[Psa::NUM_INVESTMENTS];
+    double sum = 0.0;
+    for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+      perc[type] = psa.getInvestPerc(static_cast<Psa::InvestmentType>(type),
+        year - birthYear, eligYear, year);
+      sum += perc[type];
+    }
+    if (sum > 0.0) {
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+        newShares[type * count + i] = perc[type] / sum;
+        newContribs[type * count + i] = contrib * perc[type] / sum;
+      }
+    }
+  }
+  simulate(first, newContribs, newShares, psa.getAnnuityFactor(annuityYear,
+    sex, annuityYear - birthYear, spouseAge), workerKey);
+}
+
+/// <summary>Returns the account at the annuity year with every return
+/// equal to its mean.</summary>
+///
+/// <remarks>The account is accumulated with the same operations as each
+/// path in <see cref="runBlocks"/>, so with no standard deviation every
+/// path has exactly this account.</remarks>
+///
+/// <returns>The account at the annuity year.</returns>
+double PsaSimulation::accumulateMean() const
+{
+  double balance[Psa::NUM_INVESTMENTS];
+  fill_n(balance, static_cast<int>(Psa::NUM_INVESTMENTS), 0.0);
+  const bool rebalance = lawChangePSAACCT.getRebalanceAccounts();
+  for (int i = 0; i < years; i++) {
+    for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+      const double growth = (1.0 + mean[type]) * keep[type];
+      const double amount =
+        (balance[type] + contribs[type * years + i]) * growth -
+        adminFee[type];
+      balance[type] = (amount > 0.0) ? amount : 0.0;
+    }
+    if (rebalance && hasShares(shares, years, i)) {
+      double total = 0.0;
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+        total += balance[type];
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+        balance[type] = total * shares[type * years + i];
+    }
+  }
+  double total = 0.0;
+  for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+    total += balance[type];
+  return(total);
+}
+
+/// <summary>Simulates the accounts of some blocks of paths, saving the
+/// account of each path at the annuity year.</summary>
+///
+/// <remarks>This is the body of each thread. The blocks run are first,
+/// first + step, first + 2 * step, and so on.</remarks>
+///
+/// <param name="first">First block to run.</param>
+/// <param name="step">Difference between the blocks run.</param>
+/// <param name="workerKey">Key of the worker.</param>
+void PsaSimulation::runBlocks( unsigned first, unsigned step,
+boost::uint64_t workerKey )
+{
+  double balance[Psa::NUM_INVESTMENTS][BLOCK_SIZE];
+  double growth[Psa::NUM_INVESTMENTS][BLOCK_SIZE];
+  const bool rebalance = lawChangePSAACCT.getRebalanceAccounts();
+  for (unsigned block = first; block * BLOCK_SIZE < paths; block += step) {
+    const unsigned start = block * BLOCK_SIZE;
+    const unsigned count = min(BLOCK_SIZE, paths - start);
+    for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+      fill_n(balance[type], count, 0.0);
+    for (int i = 0; i < years; i++) {
+      const int year = firstYear + i;
+      for (unsigned path = 0; path < count; path++) {
+        double normals[Psa::NUM_INVESTMENTS];
+        setNormals(normals, seed, workerKey, start + path, year);
+        for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+          growth[type][path] =
+            (1.0 + mean[type] + stdDev[type] * normals[type]) * keep[type];
+        }
+      }
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++) {
+        const double contrib = contribs[type * years + i];
+        double *account = balance[type];
+        const double *factor = growth[type];
+        for (unsigned path = 0; path < count; path++) {
+          const double amount =
+            (account[path] + contrib) * factor[path] - adminFee[type];
+          account[path] = (amount > 0.0) ? amount : 0.0;
+        }
+      }
+      if (rebalance && hasShares(shares, years, i)) {
+        for (unsigned path = 0; path < count; path++) {
+          double total = 0.0;
+          for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+            total += balance[type][path];
+          for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+            balance[type][path] = total * shares[type * years + i];
+        }
+      }
+    }
+    for (unsigned path = 0; path < count; path++) {
+      double total = 0.0;
+      for (int type = 0; type < Psa::NUM_INVESTMENTS; type++)
+        total += balance[type][path];
+      annuities[start + path] = total;
+    }
+  }
+}
@@ -0,0 +1,191 @@
+// Functions for the <see cref="QcBitset"/> class to count quarters of
+// coverage over any period of quarters without summing year by year.
+
+#include <algorithm>
+#include "QcBitset.h"
+#include "QcArray.h"
+#include "PiaException.h"
+#include "Resource.h"
+
+using namespace std;
+
+/// <summary>Constructor.</summary>
+///
+/// <remarks>Sets all quarters of coverage to zero. There is one more word
+/// than needed for the years, so the total through the last year can be
+/// found as the total before the year after it.</remarks>
+///
+/// <param name="newFirstYear">First year of data.</param>
+/// <param name="newLastYear">Last year of data.</param>
+QcBitset::QcBitset( int newFirstYear, int newLastYear ) :
+firstYear(newFirstYear), lastYear(newLastYear),
+bits((newLastYear - newFirstYear + 1) / YEARS_PER_WORD + 1, 0u),
+totals((newLastYear - newFirstYear + 1) / YEARS_PER_WORD + 1, 0u)
+{ }
+
+/// <summary>Destructor.</summary>
+QcBitset::~QcBitset()
+{ }
+
+/// <summary>Sets the quarters of coverage from a <see cref="QcArray"/>.
+/// </summary>
+///
+/// <remarks>This goes through the years once, setting the bits of each year
+/// and then the running totals of the words.</remarks>
+///
+/// <param name="qcArray">Annual quarters of coverage, for at least the
+/// years of this instance.</param>
+void QcBitset::assign( const QcArray& qcArray )
+{
+  fill(bits.begin(), bits.end(), 0u);
+  for (int year = firstYear; year <= lastYear; year++) {
+    const unsigned qcs = min(qcArray.get(year), 4u);
+    const int offset = year - firstYear;
+    bits[offset / YEARS_PER_WORD] |= static_cast<boost::uint64_t>(
+      (1u << qcs) - 1u) << (4 * (offset % YEARS_PER_WORD));
+  }
+  unsigned total = 0u;
+  for (size_t i = 0; i < bits.size(); i++) {
+    totals[i] = total;
+    total += popcount(bits[i]);
+  }
+}
+
+/// <summary>Sets all quarters of coverage to zero.</summary>
+void QcBitset::deleteContents()
+{
+  fill(bits.begin(), bits.end(), 0u);
+  fill(totals.begin(), totals.end(), 0u);
+}
+
+/// <summary>Sums quarters of coverage over a period of years.</summary>
+///
+/// <returns>Sum of quarters of coverage.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_QCARRAY3"/> if years are out of range (only in debug
+/// mode).</exception>
+///
+/// <param name="firstyr">First year to sum.</param>
+/// <param name="lastyr">Last year to sum.</param>
+/// <param name="startValue">Starting value.</param>
+unsigned QcBitset::accumulate( int firstyr, int lastyr,
+unsigned startValue ) const
+{
+#ifndef NDEBUG
+  if (firstyr < firstYear || lastyr < firstYear || firstyr > lastYear ||
+    lastyr > lastYear)
+    throw PiaException(PIA_IDS_QCARRAY3);
+#endif
+  if (firstyr > lastyr)
+    return(startValue);
+  return(startValue + totalBefore(lastyr + 1) - totalBefore(firstyr));
+}
+
+/// <summary>Sums quarters of coverage over a period of quarters.</summary>
+///
+/// <returns>Sum of quarters of coverage, the same as that of
+/// <see cref="QcArray::accumulate"/>.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_QCARRAY4"/> if quarters are out of range (only in
+/// debug mode).</exception>
+///
+/// <param name="qtrYear1">First quarter and year to sum.</param>
+/// <param name="qtrYear2">Last quarter and year to sum.</param>
+/// <param name="startValue">Starting value.</param>
+unsigned QcBitset::accumulate( const QtrYear& qtrYear1,
+const QtrYear& qtrYear2, unsigned startValue ) const
+{
+  const int year1 = static_cast<int>(qtrYear1.getYear());
+  const int year2 = static_cast<int>(qtrYear2.getYear());
+#ifndef NDEBUG
+  qtrYear1.check();
+  qtrYear2.check();
+  if (year1 < firstYear || year2 < firstYear ||
+    year1 > lastYear || year2 > lastYear)
+    throw PiaException(PIA_IDS_QCARRAY4);
+#endif
+  if (qtrYear2 < qtrYear1)
+    return(startValue);
+  if (year1 < year2) {
+    // last quarters of the first year, full years in between, and first
+    // quarters of the last year
+    return(startValue + firstQuarters(year1, 4u - qtrYear1.getQuarter()) +
+      totalBefore(year2) - totalBefore(year1 + 1) +
+      firstQuarters(year2, qtrYear2.getQuarter() + 1u));
+  }
+  return(startValue + firstQuarters(year1,
+    qtrYear2.getQuarter() - qtrYear1.getQuarter() + 1u));
+}
+
+/// <summary>Returns the number of quarters of coverage for one year.
+/// </summary>
+///
+/// <returns>The number of quarters of coverage for one year.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_QCARRAY1"/> if year is out of range
+/// (only in debug mode).</exception>
+///
+/// <param name="year">Year for which number of quarters of coverage is
+/// desired.</param>
+unsigned QcBitset::get( int year ) const
+{
+#if !defined(NDEBUG)
+  if (year < firstYear || year > lastYear)
+    throw PiaException(PIA_IDS_QCARRAY1);
+#endif
+  return(firstQuarters(year, 4u));
+}
+
+/// <summary>Returns the quarters of coverage of one year that fit in a
+/// number of its quarters.</summary>
+///
+/// <returns>The lesser of the quarters of coverage of the year and the
+/// number of quarters.</returns>
+///
+/// <param name="year">Year of quarters of coverage.</param>
+/// <param name="quarters">Number of quarters (1 to 4).</param>
+unsigned QcBitset::firstQuarters( int year, unsigned quarters ) const
+{
+  const int offset = year - firstYear;
+  const boost::uint64_t yearBits = bits[offset / YEARS_PER_WORD] >>
+    (4 * (offset % YEARS_PER_WORD));
+  return(popcount(yearBits & ((1u << quarters) - 1u)));
+}
+
+/// <summary>Returns the total quarters of coverage before one year.
+/// </summary>
+///
+/// <returns>The total quarters of coverage from the first year through the
+/// year before the given year.</returns>
+///
+/// <param name="year">Year after the last year summed (from the first year
+/// to the year after the last year).</param>
+unsigned QcBitset::totalBefore( int year ) const
+{
+  const int offset = year - firstYear;
+  const int word = offset / YEARS_PER_WORD;
+  const boost::uint64_t mask =
+    (static_cast<boost::uint64_t>(1u) << (4 * (offset % YEARS_PER_WORD))) -
+    1u;
+  return(totals[word] + popcount(bits[word] & mask));
+}
+
+/// <summary>Returns the number of bits set in a word.</summary>
+///
+/// <returns>The number of bits set in a word.</returns>
+///
+/// <param name="word">The word to count.</param>
+unsigned QcBitset::popcount( boost::uint64_t word )
+{
+  // count the bits in each 2 bits, then each 4, then each byte, and add up
+  // the bytes
+  word -= (word >> 1) & UINT64_C(0x5555555555555555);
+  word = (word & UINT64_C(0x3333333333333333)) +
+    ((word >> 2) & UINT64_C(0x3333333333333333));
+  word = (word + (word >> 4)) & UINT64_C(0x0f0f0f0f0f0f0f0f);
+  return(static_cast<unsigned>(
+    (word * UINT64_C(0x0101010101010101)) >> 56));
+}
@@ -206,5 +206,5 @@ void ReindWid::setEligYear()
 {
   eligYear = min(max(static_cast<int>(piaData.getEligDate().getYear()),
     widowPiaData.getEligYear()),
-    static_cast<int>(piaData.getBirthDateMinus1().year()) + 62);
+    piaData.getBirthIndexMinus1().getYear() + 62);
 }
@@ -123,7 +123,8 @@ double ScaledEarnFactors::getScaledEarnFactor( int theAge, scaleType earnType )
 /// <param name="ageStart">First year of high earnings.</param>
 /// <param name="ageEnd">Last year of high earnings.</param>
 void ScaledEarnFactors::setHighEarnings( EarnProject& earnProject,
-const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
+const AverageWage& averageWage, int birthYear, int ageStart,
+int ageEnd ) const
 {
   const int startYear =
     max(earnProject.getFirstYear(), birthYear + ageStart);
@@ -146,7 +147,8 @@ const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
 /// <param name="ageStart">First year of average earnings.</param>
 /// <param name="ageEnd">Last year of average earnings.</param>
 void ScaledEarnFactors::setAverageEarnings( EarnProject& earnProject,
-const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
+const AverageWage& averageWage, int birthYear, int ageStart,
+int ageEnd ) const
 {
   const int startYear =
     max(earnProject.getFirstYear(), birthYear + ageStart);
@@ -169,7 +171,8 @@ const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
 /// <param name="ageStart">First year of low earnings.</param>
 /// <param name="ageEnd">Last year of low earnings.</param>
 void ScaledEarnFactors::setLowEarnings( EarnProject& earnProject,
-const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
+const AverageWage& averageWage, int birthYear, int ageStart,
+int ageEnd ) const
 {
   const int startYear =
     max(earnProject.getFirstYear(), birthYear + ageStart);
@@ -192,7 +195,8 @@ const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
 /// <param name="ageStart">First year of low earnings.</param>
 /// <param name="ageEnd">Last year of low earnings.</param>
 void ScaledEarnFactors::setVeryLowEarnings( EarnProject& earnProject,
-const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
+const AverageWage& averageWage, int birthYear, int ageStart,
+int ageEnd ) const
 {
   const int startYear =
     max(earnProject.getFirstYear(), birthYear + ageStart);
@@ -216,7 +220,7 @@ const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd )
 /// <param name="ageEnd">Last year of low earnings.</param>
 /// <param name="earnType">Type of scaled earnings.</param>
 void ScaledEarnFactors::setScaledEarnings( EarnProject& earnProject,
-const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd, scaleType earnType )
+const AverageWage& averageWage, int birthYear, int ageStart, int ageEnd, scaleType earnType ) const
 {
   const int startYear =
     max(earnProject.getFirstYear(), birthYear + ageStart);
@@ -0,0 +1,146 @@
+// Functions for the <see cref="StageTimes"/> class to accumulate the time
+// spent in each stage of a benefit calculation.
+
+#include "StageTimes.h"
+#include "MethodCounters.h"
+
+using namespace std;
+
+unsigned long (*StageTimes::allocationCounter)() = 0;
+
+const char *StageTimes::stageNames[NUM_STAGES] = {
+  "read", "dataCheck", "calculation", "earnProjection", "output", "print"
+};
+
+const char *StageTimes::methodNames[PiaMethod::NO_PIA_TYPE] = {
+  "OldStart", "PiaTable", "WageInd", "TransGuar", "SpecMin", "ReindWid",
+  "FrozMin", "ChildCare", "DibGuar", "WageIndNonFreeze"
+};
+
+/// <summary>Starts timing a stage.</summary>
+///
+/// <param name="newStageTimes">Where to add the time (may be null).</param>
+/// <param name="newStage">Stage being timed.</param>
+StageTimes::Timer::Timer( StageTimes *newStageTimes, stage_type newStage ) :
+stageTimes(newStageTimes), stage(newStage),
+method(PiaMethod::NO_PIA_TYPE), start(0.0), allocations(0ul)
+{
+  if (stageTimes != 0) {
+    allocations = getAllocations();
+    start = now();
+  }
+}
+
+/// <summary>Starts timing a pia calculation method.</summary>
+///
+/// <param name="newStageTimes">Where to add the time (may be null).</param>
+/// <param name="newMethod">Method being timed.</param>
+StageTimes::Timer::Timer( StageTimes *newStageTimes,
+PiaMethod::pia_type newMethod ) :
+stageTimes(newStageTimes), stage(READ), method(newMethod), start(0.0),
+allocations(0ul)
+{
+  if (stageTimes != 0) {
+    allocations = getAllocations();
+    start = now();
+  }
+}
+
+/// <summary>Adds the time since construction to the stage or method.
+/// </summary>
+StageTimes::Timer::~Timer()
+{
+  if (stageTimes != 0) {
+    const double seconds = now() - start;
+    const unsigned long count = getAllocations() - allocations;
+    if (method == PiaMethod::NO_PIA_TYPE)
+      stageTimes->add(stage, seconds, count);
+    else
+      stageTimes->addMethod(method, seconds, count);
+  }
+}
+
+/// <summary>Initializes all times to zero.</summary>
+StageTimes::StageTimes()
+{
+  clear();
+}
+
+/// <summary>Adds time to a stage.</summary>
+///
+/// <param name="stage">The stage.</param>
+/// <param name="seconds">Seconds to add.</param>
+/// <param name="allocations">Allocations to add.</param>
+void StageTimes::add( stage_type stage, double seconds,
+unsigned long allocations )
+{
+  stageSeconds[stage] += seconds;
+  stageAllocations[stage] += allocations;
+  stageCalls[stage]++;
+}
+
+/// <summary>Adds time to a pia calculation method.</summary>
+///
+/// <param name="method">The method.</param>
+/// <param name="seconds">Seconds to add.</param>
+/// <param name="allocations">Allocations to add.</param>
+void StageTimes::addMethod( PiaMethod::pia_type method, double seconds,
+unsigned long allocations )
+{
+  methodSeconds[method] += seconds;
+  methodAllocations[method] += allocations;
+  methodCalls[method]++;
+}
+
+/// <summary>Sets all times to zero.</summary>
+void StageTimes::clear()
+{
+  for (int i = 0; i < NUM_STAGES; i++) {
+    stageSeconds[i] = 0.0;
+    stageAllocations[i] = 0ul;
+    stageCalls[i] = 0u;
+  }
+  for (int i = 0; i < PiaMethod::NO_PIA_TYPE; i++) {
+    methodSeconds[i] = 0.0;
+    methodAllocations[i] = 0ul;
+    methodCalls[i] = 0u;
+  }
+}
+
+/// <summary>Returns the number of allocations made so far.</summary>
+///
+/// <returns>The number of allocations made so far, or zero if allocations
+/// are not counted.</returns>
+unsigned long StageTimes::getAllocations()
+{
+  return((allocationCounter != 0) ? (*allocationCounter)() : 0ul);
+}
+
+/// <summary>Returns the name of a pia calculation method, for reports.
+/// </summary>
+///
+/// <returns>The name of a pia calculation method.</returns>
+///
+/// <param name="method">The method.</param>
+const char *StageTimes::getMethodName( PiaMethod::pia_type method )
+{
+  return(methodNames[method]);
+}
+
+/// <summary>Returns the name of a stage, for reports.</summary>
+///
+/// <returns>The name of a stage.</returns>
+///
+/// <param name="stage">The stage.</param>
+const char *StageTimes::getStageName( stage_type stage )
+{
+  return(stageNames[stage]);
+}
+
+/// <summary>Returns the current time.</summary>
+///
+/// <returns>Seconds since an arbitrary starting time.</returns>
+double StageTimes::now()
+{
+  return(MethodCounters::now() / 1.0e9);
+}
@@ -0,0 +1,237 @@
+// Functions for the <see cref="TaxBatch"/> class to calculate the payroll
+// taxes of a block of workers at once.
+
+#include <algorithm>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+#include "TaxBatch.h"
+#include "BitAnnual.h"
+#include "dbleann.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Allocates the arrays for a block of workers.</summary>
+///
+/// <param name="newLastYear">Last year stored.</param>
+/// <param name="newCapacity">Maximum number of workers.</param>
+TaxBatch::TaxBatch( int newLastYear, unsigned newCapacity ) :
+lastYear(newLastYear), capacity(newCapacity),
+stride((newCapacity + 7u) & ~7u), workerCount(0u), rates(), earnOasdi(),
+earnHi(), selfEmployed(), taxes(), taxTotal(), calculated(false)
+{
+  const size_t size = static_cast<size_t>(getYearCount()) * stride;
+  rates.resize(static_cast<size_t>(getYearCount()) * NUM_RATES, 0.0);
+  earnOasdi.resize(size, 0.0);
+  earnHi.resize(size, 0.0);
+  selfEmployed.resize(size, 0.0);
+  taxes.resize(size * TaxRates::NUMTRUSTFUNDTYPES, 0.0);
+  taxTotal.resize(static_cast<size_t>(TaxRates::NUMTRUSTFUNDTYPES) *
+    TaxData::NUMYEARPERIODS * stride, 0.0);
+}
+
+/// <summary>Destructor.</summary>
+TaxBatch::~TaxBatch()
+{ }
+
+/// <summary>Adds the earnings of one worker.</summary>
+///
+/// <remarks>Earnings in years not covered by the arguments are set to
+/// zero.</remarks>
+///
+/// <returns>The number of the worker in this batch.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the batch
+/// is full.</exception>
+///
+/// <param name="newEarnOasdi">OASDI earnings limited to the wage base.
+/// </param>
+/// <param name="newEarnHi">HI earnings limited to the wage base.</param>
+/// <param name="taxType">Tax type in each year (true for self-employed).
+/// </param>
+unsigned TaxBatch::add( const DoubleAnnual& newEarnOasdi,
+const DoubleAnnual& newEarnHi, const BitAnnual& taxType )
+{
+  if (workerCount >= capacity)
+    throw PiaException("Too many workers in TaxBatch::add");
+  const unsigned worker = workerCount++;
+  for (int year = YEAR37; year <= lastYear; year++) {
+    const size_t i = static_cast<size_t>(year - YEAR37) * stride + worker;
+    earnOasdi[i] = (year >= newEarnOasdi.getBaseYear() &&
+      year <= newEarnOasdi.getLastYear()) ? newEarnOasdi[year] : 0.0;
+    earnHi[i] = (year >= newEarnHi.getBaseYear() &&
+      year <= newEarnHi.getLastYear()) ? newEarnHi[year] : 0.0;
+    selfEmployed[i] = (year >= taxType.getBaseYear() &&
+      year <= taxType.getLastYear() && taxType.getBit(year)) ? 1.0 : 0.0;
+  }
+  calculated = false;
+  return(worker);
+}
+
+/// <summary>Calculates the taxes of all workers added, in every year
+/// stored.</summary>
+void TaxBatch::calculate()
+{
+  const size_t fundSize = static_cast<size_t>(getYearCount()) * stride;
+  double *yearTaxes[TaxRates::NUMTRUSTFUNDTYPES];
+  double *totals[TaxRates::NUMTRUSTFUNDTYPES];
+  for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++) {
+    // the totals of all years are kept as they are added up, and the
+    // totals through 1950 are copied from them
+    totals[fund] = &taxTotal[(static_cast<size_t>(fund) *
+      TaxData::NUMYEARPERIODS + TaxData::YEARS1937PLUS) * stride];
+    fill_n(totals[fund], stride, 0.0);
+  }
+  const int yearGroupEnd = min(YEAR50, lastYear);
+  for (int year = YEAR37; year <= lastYear; year++) {
+    const size_t row = static_cast<size_t>(year - YEAR37) * stride;
+    for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++)
+      yearTaxes[fund] = &taxes[fund * fundSize + row];
+    taxYear(&rates[static_cast<size_t>(year - YEAR37) * NUM_RATES],
+      &earnOasdi[row], &earnHi[row], &selfEmployed[row], yearTaxes, totals,
+      workerCount);
+    if (year == yearGroupEnd) {
+      for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++) {
+        copy(totals[fund], totals[fund] + stride,
+          &taxTotal[(static_cast<size_t>(fund) * TaxData::NUMYEARPERIODS +
+          TaxData::YEARS1937_50) * stride]);
+      }
+    }
+  }
+  calculated = true;
+}
+
+/// <summary>Removes all workers, and sets the tax rates for the next block
+/// of workers.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the tax
+/// rates do not cover the years stored.</exception>
+///
+/// <param name="taxRates">Tax rates.</param>
+void TaxBatch::clear( const TaxRates& taxRates )
+{
+  if (taxRates.getTaxRatesNet(TaxRates::EMPLOYEERATE,
+    TaxRates::OASITF).getLastYear() < lastYear)
+    throw PiaException("Tax rates out of range in TaxBatch::clear");
+  const TaxRates::trustfundType funds[3] =
+    { TaxRates::OASITF, TaxRates::DITF, TaxRates::HITF };
+  for (int year = YEAR37; year <= lastYear; year++) {
+    double *yearRates = &rates[static_cast<size_t>(year - YEAR37) * NUM_RATES];
+    for (int fund = 0; fund < 3; fund++) {
+      yearRates[fund] = taxRates.getTaxRatesNet(TaxRates::EMPLOYEERATE,
+        funds[fund])[year];
+      yearRates[fund + 3] = taxRates.getTaxRatesNet(TaxRates::SELFEMPRATE,
+        funds[fund])[year];
+    }
+  }
+  workerCount = 0u;
+  calculated = false;
+}
+
+/// <summary>Calculates the taxes of several workers in one year, and adds
+/// them to their totals.</summary>
+///
+/// <remarks>The OASI, DI, and HI taxes are the employee or self-employed
+/// net rate times the earnings limited to the wage base, the OASDI taxes
+/// are the OASI plus DI taxes, and the OASDHI taxes are the OASDI plus HI
+/// taxes, exactly as in <see cref="TaxRates::taxCalOneYearNet"/> and
+/// <see cref="TaxData::oasdhiTaxCal"/>, so the vector and scalar loops
+/// give the same results.</remarks>
+///
+/// <param name="yearRates">Net tax rates in the year: employee OASI, DI,
+/// and HI, then self-employed OASI, DI, and HI.</param>
+/// <param name="earnOasdi">OASDI earnings limited to the wage base.</param>
+/// <param name="earnHi">HI earnings limited to the wage base.</param>
+/// <param name="selfEmployed">1 if self-employed, 0 if employee.</param>
+/// <param name="taxes">Taxes for each trust fund (output).</param>
+/// <param name="totals">Total taxes for each trust fund, to add to.</param>
+/// <param name="count">Number of workers.</param>
+void TaxBatch::taxYear( const double *yearRates, const double *earnOasdi,
+const double *earnHi, const double *selfEmployed, double *const *taxes,
+double *const *totals, unsigned count )
+{
+  double *const taxesOasi = taxes[TaxRates::OASITF];
+  double *const taxesDi = taxes[TaxRates::DITF];
+  double *const taxesOasdi = taxes[TaxRates::OASDITF];
+  double *const taxesHi = taxes[TaxRates::HITF];
+  double *const taxesOasdhi = taxes[TaxRates::OASDHITF];
+  unsigned i = 0u;
+#if defined(__AVX512F__)
+  {
+    const __m512d zero = _mm512_setzero_pd();
+    const __m512d oasiEe = _mm512_set1_pd(yearRates[0]);
+    const __m512d diEe = _mm512_set1_pd(yearRates[1]);
+    const __m512d hiEe = _mm512_set1_pd(yearRates[2]);
+    const __m512d oasiSe = _mm512_set1_pd(yearRates[3]);
+    const __m512d diSe = _mm512_set1_pd(yearRates[4]);
+    const __m512d hiSe = _mm512_set1_pd(yearRates[5]);
+    for (; i + 8u <= count; i += 8u) {
+      const __mmask8 self = _mm512_cmp_pd_mask(
+        _mm512_loadu_pd(selfEmployed + i), zero, _CMP_NEQ_OQ);
+      const __m512d oasdiEarn = _mm512_loadu_pd(earnOasdi + i);
+      const __m512d oasi = _mm512_mul_pd(
+        _mm512_mask_blend_pd(self, oasiEe, oasiSe), oasdiEarn);
+      const __m512d di = _mm512_mul_pd(
+        _mm512_mask_blend_pd(self, diEe, diSe), oasdiEarn);
+      const __m512d hi = _mm512_mul_pd(
+        _mm512_mask_blend_pd(self, hiEe, hiSe),
+        _mm512_loadu_pd(earnHi + i));
+      const __m512d oasdi = _mm512_add_pd(oasi, di);
+      const __m512d oasdhi = _mm512_add_pd(oasdi, hi);
+      _mm512_storeu_pd(taxesOasi + i, oasi);
+      _mm512_storeu_pd(taxesDi + i, di);
+      _mm512_storeu_pd(taxesOasdi + i, oasdi);
+      _mm512_storeu_pd(taxesHi + i, hi);
+      _mm512_storeu_pd(taxesOasdhi + i, oasdhi);
+      for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++) {
+        _mm512_storeu_pd(totals[fund] + i, _mm512_add_pd(
+          _mm512_loadu_pd(totals[fund] + i), _mm512_loadu_pd(taxes[fund] + i)));
+      }
+    }
+  }
+#endif
+#if defined(__AVX__)
+  {
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d oasiEe = _mm256_set1_pd(yearRates[0]);
+    const __m256d diEe = _mm256_set1_pd(yearRates[1]);
+    const __m256d hiEe = _mm256_set1_pd(yearRates[2]);
+    const __m256d oasiSe = _mm256_set1_pd(yearRates[3]);
+    const __m256d diSe = _mm256_set1_pd(yearRates[4]);
+    const __m256d hiSe = _mm256_set1_pd(yearRates[5]);
+    for (; i + 4u <= count; i += 4u) {
+      const __m256d self = _mm256_cmp_pd(
+        _mm256_loadu_pd(selfEmployed + i), zero, _CMP_NEQ_OQ);
+      const __m256d oasdiEarn = _mm256_loadu_pd(earnOasdi + i);
+      const __m256d oasi =
+        _mm256_mul_pd(_mm256_blendv_pd(oasiEe, oasiSe, self), oasdiEarn);
+      const __m256d di =
+        _mm256_mul_pd(_mm256_blendv_pd(diEe, diSe, self), oasdiEarn);
+      const __m256d hi = _mm256_mul_pd(_mm256_blendv_pd(hiEe, hiSe, self),
+        _mm256_loadu_pd(earnHi + i));
+      const __m256d oasdi = _mm256_add_pd(oasi, di);
+      const __m256d oasdhi = _mm256_add_pd(oasdi, hi);
+      _mm256_storeu_pd(taxesOasi + i, oasi);
+      _mm256_storeu_pd(taxesDi + i, di);
+      _mm256_storeu_pd(taxesOasdi + i, oasdi);
+      _mm256_storeu_pd(taxesHi + i, hi);
+      _mm256_storeu_pd(taxesOasdhi + i, oasdhi);
+      for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++) {
+        _mm256_storeu_pd(totals[fund] + i, _mm256_add_pd(
+          _mm256_loadu_pd(totals[fund] + i), _mm256_loadu_pd(taxes[fund] + i)));
+      }
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    const bool self = (selfEmployed[i] != 0.0);
+    taxesOasi[i] = (self ? yearRates[3] : yearRates[0]) * earnOasdi[i];
+    taxesDi[i] = (self ? yearRates[4] : yearRates[1]) * earnOasdi[i];
+    taxesHi[i] = (self ? yearRates[5] : yearRates[2]) * earnHi[i];
+    taxesOasdi[i] = taxesOasi[i] + taxesDi[i];
+    taxesOasdhi[i] = taxesOasdi[i] + taxesHi[i];
+    for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++)
+      totals[fund][i] += taxes[fund][i];
+  }
+}
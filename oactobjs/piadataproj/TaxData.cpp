@@ -3,7 +3,11 @@
 //
 // $Id: TaxData.cpp 1.9 2011/08/09 16:51:48EDT 044579 Development  $
 
+#include <algorithm>
 #include "TaxData.h"
+#include "TaxBatch.h"
+#include "BitAnnual.h"
+#include "PiaException.h"
 #include "wrkrdata.h"
 #include "oactcnst.h"
 
@@ -56,6 +60,112 @@ void TaxData::totalTaxCal()
     YEAR51, maxyear, taxTotal[TaxRates::OASDHITF][YEARS1937_50]);
 }
 
+/// <summary>Calculates the taxes paid over a lifetime for all trust funds,
+/// and their totals.</summary>
+///
+/// <remarks>This gives the same results as calling
+/// <see cref="TaxRates::taxCalAllYears"/> for the OASI, DI, and HI trust
+/// funds, then <see cref="oasdhiTaxCal"/> and <see cref="totalTaxCal"/>,
+/// with the same operations in the same order, but in one pass over the
+/// years.</remarks>
+///
+/// <param name="taxRates">Tax rates.</param>
+/// <param name="earnOasdi">OASDI earnings limited to the wage base.</param>
+/// <param name="earnHi">HI earnings limited to the wage base.</param>
+/// <param name="taxType">Tax type in each year (true for self-employed).
+/// </param>
+void TaxData::taxCal( const TaxRates& taxRates, const DoubleAnnual& earnOasdi,
+const DoubleAnnual& earnHi, const BitAnnual& taxType )
+{
+  const DoubleAnnual *rates[TaxRates::NUMTAXRATETYPES][3];
+  for (int i = 0; i < TaxRates::NUMTAXRATETYPES; i++) {
+    const TaxRates::taxrateType rateType =
+      static_cast<TaxRates::taxrateType>(i);
+    rates[i][0] = &taxRates.getTaxRatesNet(rateType, TaxRates::OASITF);
+    rates[i][1] = &taxRates.getTaxRatesNet(rateType, TaxRates::DITF);
+    rates[i][2] = &taxRates.getTaxRatesNet(rateType, TaxRates::HITF);
+  }
+  const int lastOasdi = min(maxyear, earnOasdi.getLastYear());
+  const int lastHi = min(maxyear, earnHi.getLastYear());
+  // the taxes are kept in locals, so they are not read back from the arrays
+  double *const oasi = &taxesOasi[YEAR37];
+  double *const di = &taxesDi[YEAR37];
+  double *const oasdi = &taxesOasdi[YEAR37];
+  double *const hi = &taxesHi[YEAR37];
+  double *const oasdhi = &taxesOasdhi[YEAR37];
+  double total[TaxRates::NUMTRUSTFUNDTYPES] = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+  for (int yr = YEAR37; yr <= maxyear; yr++) {
+    const int i = yr - YEAR37;
+    double yearOasi = oasi[i];
+    double yearDi = di[i];
+    double yearHi = hi[i];
+    if (yr <= lastOasdi || yr <= lastHi) {
+      const DoubleAnnual *const *yearRates = rates[taxType.getBit(yr) ?
+        TaxRates::SELFEMPRATE : TaxRates::EMPLOYEERATE];
+      if (yr <= lastOasdi) {
+        yearOasi = (*yearRates[0])[yr] * earnOasdi[yr];
+        yearDi = (*yearRates[1])[yr] * earnOasdi[yr];
+        oasi[i] = yearOasi;
+        di[i] = yearDi;
+      }
+      if (yr <= lastHi) {
+        yearHi = (*yearRates[2])[yr] * earnHi[yr];
+        hi[i] = yearHi;
+      }
+    }
+    const double yearOasdi = yearOasi + yearDi;
+    const double yearOasdhi = yearOasdi + yearHi;
+    oasdi[i] = yearOasdi;
+    oasdhi[i] = yearOasdhi;
+    total[TaxRates::OASITF] += yearOasi;
+    total[TaxRates::DITF] += yearDi;
+    total[TaxRates::OASDITF] += yearOasdi;
+    total[TaxRates::HITF] += yearHi;
+    total[TaxRates::OASDHITF] += yearOasdhi;
+    if (yr == YEAR50) {
+      for (int fund = 0; fund < TaxRates::NUMTRUSTFUNDTYPES; fund++)
+        taxTotal[fund][YEARS1937_50] = total[fund];
+    }
+  }
+  for (int i = 0; i < TaxRates::NUMTRUSTFUNDTYPES; i++)
+    taxTotal[i][YEARS1937PLUS] = total[i];
+}
+
+/// <summary>Copies the taxes of one worker calculated in a batch.</summary>
+///
+/// <remarks>The results are the same as those of <see cref="taxCal(const
+/// TaxRates&, const DoubleAnnual&, const DoubleAnnual&, const BitAnnual&)"/>
+/// with the same earnings and rates.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the taxes
+/// of the batch have not been calculated, or it does not cover the years
+/// of this instance.</exception>
+///
+/// <param name="batch">Batch of workers, with the taxes calculated.</param>
+/// <param name="worker">Number of worker, as returned by
+/// <see cref="TaxBatch::add"/>.</param>
+void TaxData::taxCal( const TaxBatch& batch, unsigned worker )
+{
+  if (!batch.isCalculated() || batch.getLastYear() != maxyear ||
+    worker >= batch.getWorkerCount())
+    throw PiaException("Batch does not match in TaxData::taxCal");
+  for (int yr = YEAR37; yr <= maxyear; yr++) {
+    taxesOasi[yr] = batch.getTaxes(worker, TaxRates::OASITF, yr);
+    taxesDi[yr] = batch.getTaxes(worker, TaxRates::DITF, yr);
+    taxesOasdi[yr] = batch.getTaxes(worker, TaxRates::OASDITF, yr);
+    taxesHi[yr] = batch.getTaxes(worker, TaxRates::HITF, yr);
+    taxesOasdhi[yr] = batch.getTaxes(worker, TaxRates::OASDHITF, yr);
+  }
+  for (int i = 0; i < TaxRates::NUMTRUSTFUNDTYPES; i++) {
+    const TaxRates::trustfundType fund =
+      static_cast<TaxRates::trustfundType>(i);
+    taxTotal[i][YEARS1937_50] =
+      batch.getTaxesTotal(worker, fund, YEARS1937_50);
+    taxTotal[i][YEARS1937PLUS] =
+      batch.getTaxesTotal(worker, fund, YEARS1937PLUS);
+  }
+}
+
 /// <summary>Calculates OASDI and OASDHI taxes paid over a lifetime.</summary>
 ///
 /// <remarks>Calculates OASDI and OASDHI taxes paid over a lifetime. Assumes
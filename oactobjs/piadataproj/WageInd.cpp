@@ -4,6 +4,7 @@
 // $Id: WageInd.cpp 1.40 2017/09/18 10:37:22EDT 277133 Development  $
 
 #include "WageInd.h"
+#include "WageIndBatch.h"
 #include "UserAssumptions.h"
 #include "piaparms.h"
 #include "DebugCase.h"
@@ -74,8 +75,7 @@ void WageInd::calculate()
   }
 #endif
   setTableNum(PL_1977);
-  const AverageWage& earnings = workerData.getTotalize() ?
-    piaData.earnTotalizedLimited : piaData.earnOasdiLimited;
+  const AverageWage& earnings = getEarnings();
   const int year1 = piaData.getEarn50(PiaData::EARN_WITH_TOTALIZATION);
   const int year2 = piaData.getEarnYear();
 #if defined(DEBUGCASE)
@@ -97,6 +97,70 @@ void WageInd::calculate()
 #endif
   indexEarnings(year1, piaData.getEligYear() - 2, year2, earnings,
     earnMultiplied, earnIndexed, piaParams.getFqIndex());
+  calculateIndexed(year1, year2);
+}
+
+/// <summary>Computes wage indexed PIA, using earnings indexed in a batch of
+/// workers.</summary>
+///
+/// <remarks>If the batch has not been indexed, or has a different indexing
+/// year or average wages from the parameters of this calculation, the
+/// earnings are indexed as in <see cref="calculate()"/>.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the years
+/// of earnings are not all stored in the batch.</exception>
+///
+/// <param name="batch">Batch with the earnings of this worker, from
+/// <see cref="addToBatch"/>.</param>
+/// <param name="worker">Number of this worker in the batch.</param>
+void WageInd::calculate( const WageIndBatch& batch, unsigned worker )
+{
+  if (!batch.isIndexed() || worker >= batch.getWorkerCount() ||
+    batch.getBaseYear() != piaData.getEligYear() - 2 ||
+    !batch.isSameAvgWage(piaParams.getFqIndex())) {
+    calculate();
+    return;
+  }
+  setTableNum(PL_1977);
+  const int year1 = piaData.getEarn50(PiaData::EARN_WITH_TOTALIZATION);
+  const int year2 = piaData.getEarnYear();
+  indexEarnings(year1, year2, batch, worker, earnMultiplied, earnIndexed);
+  calculateIndexed(year1, year2);
+}
+
+/// <summary>Adds the earnings of this worker to a batch to be indexed.
+/// </summary>
+///
+/// <remarks>The batch should have been cleared with an indexing year of
+/// the year of eligibility minus 2.</remarks>
+///
+/// <returns>The number of this worker in the batch.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the batch
+/// is full.</exception>
+///
+/// <param name="batch">Batch of workers to add to.</param>
+unsigned WageInd::addToBatch( WageIndBatch& batch ) const
+{
+  return(batch.add(getEarnings()));
+}
+
+/// <summary>Returns the earnings to index.</summary>
+///
+/// <returns>The limited earnings, or the totalized earnings in a
+/// totalization case.</returns>
+const AverageWage& WageInd::getEarnings() const
+{
+  return(workerData.getTotalize() ?
+    piaData.earnTotalizedLimited : piaData.earnOasdiLimited);
+}
+
+/// <summary>Computes wage indexed PIA from indexed earnings.</summary>
+///
+/// <param name="year1">First year of earnings.</param>
+/// <param name="year2">Last year of earnings.</param>
+void WageInd::calculateIndexed( int year1, int year2 )
+{
   const int N = piaData.compPeriodNew.getN();
   orderEarnings(year1, year2, N);
   totalEarnCal(year1, year2, N);
@@ -0,0 +1,183 @@
+// Functions for the <see cref="WageIndBatch"/> class to index the
+// earnings of a block of workers at once.
+
+#include <cmath>  // for floor
+#include <algorithm>
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+#include "WageIndBatch.h"
+#include "dbleann.h"
+#include "PiaException.h"
+
+using namespace std;
+
+/// <summary>Allocates the arrays for a block of workers.</summary>
+///
+/// <param name="newFirstYear">First year of earnings stored.</param>
+/// <param name="newLastYear">Last year of earnings stored.</param>
+/// <param name="newCapacity">Maximum number of workers.</param>
+WageIndBatch::WageIndBatch( int newFirstYear, int newLastYear,
+unsigned newCapacity ) :
+firstYear(newFirstYear), lastYear(newLastYear), capacity(newCapacity),
+stride((newCapacity + 7u) & ~7u), workerCount(0u), baseYear(newFirstYear),
+indexYearAvgWage(0.0), avgWage(), earnings(), earnMultiplied(),
+earnIndexed(), indexed(false)
+{
+  const size_t size =
+    static_cast<size_t>(lastYear - firstYear + 1) * stride;
+  earnings.resize(size, 0.0);
+  earnMultiplied.resize(size, 0.0);
+  earnIndexed.resize(size, 0.0);
+}
+
+/// <summary>Destructor.</summary>
+WageIndBatch::~WageIndBatch()
+{ }
+
+/// <summary>Removes all workers, and sets the indexing year and average
+/// wages for the next block of workers.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// indexing year is not one of the years stored, or the average wages do
+/// not cover the years stored through the indexing year.</exception>
+///
+/// <param name="newBaseYear">Indexing year (year of eligibility minus 2).
+/// </param>
+/// <param name="newAvgWage">Average wage indexing series.</param>
+void WageIndBatch::clear( int newBaseYear, const DoubleAnnual& newAvgWage )
+{
+  if (newBaseYear < firstYear || newBaseYear > lastYear ||
+    newAvgWage.getBaseYear() > firstYear ||
+    newAvgWage.getLastYear() < newBaseYear)
+    throw PiaException("Indexing year out of range in WageIndBatch::clear");
+  baseYear = newBaseYear;
+  indexYearAvgWage = newAvgWage[baseYear];
+  avgWage.resize(static_cast<size_t>(baseYear - firstYear + 1));
+  for (int year = firstYear; year <= baseYear; year++)
+    avgWage[year - firstYear] = newAvgWage[year];
+  workerCount = 0u;
+  indexed = false;
+}
+
+/// <summary>Adds the earnings of one worker.</summary>
+///
+/// <remarks>Earnings in years not covered by the argument are set to
+/// zero.</remarks>
+///
+/// <returns>The number of the worker in this batch.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the batch
+/// is full.</exception>
+///
+/// <param name="newEarnings">Unindexed earnings of the worker.</param>
+unsigned WageIndBatch::add( const DoubleAnnual& newEarnings )
+{
+  if (workerCount >= capacity)
+    throw PiaException("Too many workers in WageIndBatch::add");
+  const unsigned worker = workerCount++;
+  const int year1 = max(firstYear, newEarnings.getBaseYear());
+  const int year2 = min(lastYear, newEarnings.getLastYear());
+  for (int year = firstYear; year <= lastYear; year++) {
+    earnings[(year - firstYear) * stride + worker] =
+      (year >= year1 && year <= year2) ? newEarnings[year] : 0.0;
+  }
+  indexed = false;
+  return(worker);
+}
+
+/// <summary>Returns true if an average wage indexing series has the
+/// average wages of this batch.</summary>
+///
+/// <returns>True if the series has the same average wage as this batch in
+/// each year from the first year stored through the indexing year.
+/// </returns>
+///
+/// <param name="newAvgWage">Average wage indexing series.</param>
+bool WageIndBatch::isSameAvgWage( const DoubleAnnual& newAvgWage ) const
+{
+  if (newAvgWage.getBaseYear() > firstYear ||
+    newAvgWage.getLastYear() < baseYear ||
+    avgWage.size() != static_cast<size_t>(baseYear - firstYear + 1))
+    return(false);
+  for (int year = firstYear; year <= baseYear; year++) {
+    if (avgWage[year - firstYear] != newAvgWage[year])
+      return(false);
+  }
+  return(true);
+}
+
+/// <summary>Indexes the earnings of all workers added, from the first year
+/// stored through the indexing year.</summary>
+void WageIndBatch::index()
+{
+  for (int year = firstYear; year <= baseYear; year++) {
+    const size_t row = static_cast<size_t>(year - firstYear) * stride;
+    indexYear(&earnings[row], &earnMultiplied[row], &earnIndexed[row],
+      workerCount, indexYearAvgWage, avgWage[year - firstYear]);
+  }
+  indexed = true;
+}
+
+/// <summary>Indexes the earnings of several workers in one year.</summary>
+///
+/// <remarks>Each amount is multiplied by the average wage in the indexing
+/// year, divided by the average wage in the year of earnings, and rounded
+/// to the nearest penny, exactly as in
+/// <see cref="WageIndGeneral::indexEarnings"/>, so the vector and scalar
+/// loops give the same results.</remarks>
+///
+/// <param name="earnings">Unindexed earnings.</param>
+/// <param name="earnMultiplied">The earnings multiplied by the average wage
+/// in the indexing year (output).</param>
+/// <param name="earnIndexed">Indexed earnings (output).</param>
+/// <param name="count">Number of workers.</param>
+/// <param name="indexYearAvgWage">Average wage in the indexing year.</param>
+/// <param name="yearAvgWage">Average wage in the year of earnings.</param>
+void WageIndBatch::indexYear( const double *earnings,
+double *earnMultiplied, double *earnIndexed, unsigned count,
+double indexYearAvgWage, double yearAvgWage )
+{
+  unsigned i = 0u;
+#if defined(__AVX512F__)
+  {
+    const __m512d factor = _mm512_set1_pd(indexYearAvgWage);
+    const __m512d divisor = _mm512_set1_pd(yearAvgWage);
+    const __m512d hundred = _mm512_set1_pd(100.0);
+    const __m512d half = _mm512_set1_pd(0.5);
+    for (; i + 8u <= count; i += 8u) {
+      const __m512d multiplied =
+        _mm512_mul_pd(factor, _mm512_loadu_pd(earnings + i));
+      _mm512_storeu_pd(earnMultiplied + i, multiplied);
+      const __m512d temp = _mm512_div_pd(multiplied, divisor);
+      const __m512d rounded = _mm512_roundscale_pd(
+        _mm512_add_pd(_mm512_mul_pd(temp, hundred), half),
+        _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+      _mm512_storeu_pd(earnIndexed + i, _mm512_div_pd(rounded, hundred));
+    }
+  }
+#endif
+#if defined(__AVX__)
+  {
+    const __m256d factor = _mm256_set1_pd(indexYearAvgWage);
+    const __m256d divisor = _mm256_set1_pd(yearAvgWage);
+    const __m256d hundred = _mm256_set1_pd(100.0);
+    const __m256d half = _mm256_set1_pd(0.5);
+    for (; i + 4u <= count; i += 4u) {
+      const __m256d multiplied =
+        _mm256_mul_pd(factor, _mm256_loadu_pd(earnings + i));
+      _mm256_storeu_pd(earnMultiplied + i, multiplied);
+      const __m256d temp = _mm256_div_pd(multiplied, divisor);
+      const __m256d rounded = _mm256_floor_pd(
+        _mm256_add_pd(_mm256_mul_pd(temp, hundred), half));
+      _mm256_storeu_pd(earnIndexed + i, _mm256_div_pd(rounded, hundred));
+    }
+  }
+#endif
+  for (; i < count; i++) {
+    earnMultiplied[i] = indexYearAvgWage * earnings[i];
+    const double temp = earnMultiplied[i] / yearAvgWage;
+    // round to nearest penny
+    earnIndexed[i] = floor(temp * 100.0 + 0.5) / 100.0;
+  }
+}
@@ -6,6 +6,7 @@
 #include <cmath>  // for floor
 #include <algorithm>
 #include "WageIndGeneral.h"
+#include "WageIndBatch.h"
 #include "piaparms.h"
 #include "UserAssumptions.h"
 #include "DebugCase.h"
@@ -185,6 +186,53 @@ DoubleAnnual& earnIndexed, const DoubleAnnual& avgWage )
   }
 }
 
+/// <summary>Sets indexed earnings from a batch of workers indexed
+/// together.</summary>
+///
+/// <remarks>This gives the same results as the version that indexes the
+/// earnings itself, with the indexing year of the batch as the base year.
+/// Years of disability freeze are not used, as in that version.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the years
+/// of earnings are not all stored in the batch.</exception>
+///
+/// <param name="year1">First year of earnings.</param>
+/// <param name="year3">Last year of earnings.</param>
+/// <param name="batch">Batch with the earnings of this worker, already
+/// indexed.</param>
+/// <param name="worker">Number of this worker in the batch.</param>
+/// <param name="earnMultiplied">The earnings multiplied by average earnings
+/// (output).</param>
+/// <param name="earnIndexed">Indexed earnings (output).</param>
+void WageIndGeneral::indexEarnings( int year1, int year3,
+const WageIndBatch& batch, unsigned worker, DoubleAnnual& earnMultiplied,
+DoubleAnnual& earnIndexed )
+{
+  const int year2 = batch.getBaseYear();
+  if (year1 < batch.getFirstYear() || year3 > batch.getLastYear())
+    throw PiaException(
+      "Years of earnings out of range in WageIndGeneral::indexEarnings");
+  indexYearAvgWage = batch.getIndexYearAvgWage();
+  for (int year = year1; year <= year2; year++) {
+    if (!piaData.freezeYears.isFreezeYear(year)) {
+      earnMultiplied[year] = batch.getEarnMultiplied(worker, year);
+      earnIndexed[year] = batch.getEarnIndexed(worker, year);
+    }
+    else {
+      earnMultiplied[year] = earnIndexed[year] = 0.0;
+    }
+  }
+  for (int year = year2; year <= year3; year++) {
+    if (!piaData.freezeYears.isFreezeYear(year)) {
+      earnMultiplied[year] = 0.0;
+      earnIndexed[year] = batch.getEarnings(worker, year);
+    }
+    else {
+      earnMultiplied[year] = earnIndexed[year] = 0.0;
+    }
+  }
+}
+
 /// <summary>Calculates an AIME PIA under the 1977 law.</summary>
 ///
 /// <returns>The PIA.</returns>
@@ -78,7 +78,7 @@ const PiaData& piaData )
     }
   }
   int elyTemp = min((int)workerData.disabPeriod[0].getWaitperDate().getYear(),
-     (int)piaData.getBirthDateMinus1().year()+62);
+     piaData.getBirthIndexMinus1().getYear()+62);
   return (elyTemp > 1978 && (workerData.getIend() > 1950 ||
     workerData.getTotalize()));
 }
@@ -35,7 +35,7 @@ WorkerDataGeneral::WorkerDataGeneral() :
 childCareYears(YEAR37, maxyear), qc(YEAR37, maxyear), qctot51td(0),
 qctottd(0), joasdi(NO_BEN), valdi(0), ibegin(0), iend(0),
 theBits(string("00010000001")), birthDate(), benefitDate(), entDate(),
-deathDate()
+deathDate(), changes(ALL_CHANGES)
 { }
 
 /// <summary>Initializes a WorkerDataGeneral structure by copying all the data
@@ -51,7 +51,8 @@ qctot51td(workerData.qctot51td), qctottd(workerData.qctottd),
 joasdi(workerData.joasdi), valdi(workerData.valdi), ibegin(workerData.ibegin),
 iend(workerData.iend), theBits(workerData.theBits),
 birthDate(workerData.birthDate), benefitDate(workerData.benefitDate),
-entDate(workerData.entDate), deathDate(workerData.deathDate)
+entDate(workerData.entDate), deathDate(workerData.deathDate),
+changes(ALL_CHANGES)
 {
   for (int i = 0; i < NUM_DISAB_PERIODS; i++) {
     disabPeriod[i] = workerData.disabPeriod[i];
@@ -81,6 +82,7 @@ void WorkerDataGeneral::deleteContents()
   }
   qc.deleteContents();
   childCareYears.deleteContents();
+  changes = ALL_CHANGES;
 }
 
 /// <summary>Checks for first year of earnings within bounds, using passed
@@ -148,7 +150,10 @@ void WorkerDataGeneral::setWaitperDate( unsigned index,
       Trace::writeLine(strm.str());
     }
 #endif
-    disabPeriod[index].setWaitperDate(dateMoyr);
+    if (!(disabPeriod[index].getWaitperDate() == dateMoyr)) {
+      disabPeriod[index].setWaitperDate(dateMoyr);
+      changes |= DATE_CHANGE;
+    }
   }
 }
 
@@ -171,7 +176,10 @@ void WorkerDataGeneral::setOnsetDate( unsigned index,
     Trace::writeLine(strm.str());
   }
 #endif
-  disabPeriod[index].setOnsetDate(dateModyyr);
+  if (disabPeriod[index].getOnsetDate() != dateModyyr) {
+    disabPeriod[index].setOnsetDate(dateModyyr);
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Sets date of disability cessation.</summary>
@@ -182,6 +190,7 @@ void WorkerDataGeneral::setOnsetDate( unsigned index,
 void WorkerDataGeneral::setCessationDate( unsigned index,
  const DateMoyr& dateMoyr )
 {
+  const DateMoyr oldDate(disabPeriod[index].getCessationDate());
   if ((index == 1 && valdi > 1) || (index == 0 && needDiCess())) {
 #ifndef NDEBUG
     DisabPeriod::cessationDateCheck(dateMoyr);
@@ -207,6 +216,8 @@ void WorkerDataGeneral::setCessationDate( unsigned index,
 #endif
     disabPeriod[index].deleteCessationDate();
   }
+  if (!(disabPeriod[index].getCessationDate() == oldDate))
+    changes |= DATE_CHANGE;
 }
 
 /// <summary>Sets pia at disability cessation.</summary>
@@ -227,7 +238,10 @@ void WorkerDataGeneral::setCessationPia( unsigned index, float newPia )
       Trace::writeLine(strm.str());
     }
 #endif
-    disabPeriod[index].setCessationPia(newPia);
+    if (disabPeriod[index].getCessationPia() != newPia) {
+      disabPeriod[index].setCessationPia(newPia);
+      changes |= OTHER_CHANGE;
+    }
   }
 }
 
@@ -249,7 +263,10 @@ void WorkerDataGeneral::setCessationMfb( unsigned index, float newMfb )
       Trace::writeLine(strm.str());
     }
 #endif
-    disabPeriod[index].setCessationMfb(newMfb);
+    if (disabPeriod[index].getCessationMfb() != newMfb) {
+      disabPeriod[index].setCessationMfb(newMfb);
+      changes |= OTHER_CHANGE;
+    }
   }
 }
 
@@ -452,7 +469,10 @@ void WorkerDataGeneral::setPriorentDate( unsigned index,
     Trace::writeLine(strm.str());
   }
 #endif
-  disabPeriod[index].setEntDate(dateMoyr);
+  if (!(disabPeriod[index].getEntDate() == dateMoyr)) {
+    disabPeriod[index].setEntDate(dateMoyr);
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Sets date of prior entitlement to disability.</summary>
@@ -474,7 +494,10 @@ void WorkerDataGeneral::setPriorentDateCheck( unsigned index,
     Trace::writeLine(strm.str());
   }
 #endif
-  disabPeriod[index].setEntDate(dateMoyr);
+  if (!(disabPeriod[index].getEntDate() == dateMoyr)) {
+    disabPeriod[index].setEntDate(dateMoyr);
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Checks date of prior entitlement to disability, using passed
@@ -564,7 +587,10 @@ void WorkerDataGeneral::setBenefitDate( const DateMoyr& newBenefitDate )
       Trace::writeLine(strm.str());
     }
 #endif
-    benefitDate = newBenefitDate;
+    if (!(benefitDate == newBenefitDate)) {
+      benefitDate = newBenefitDate;
+      changes |= DATE_CHANGE;
+    }
   }
   else {
     setBenefitDate();
@@ -586,7 +612,10 @@ void WorkerDataGeneral::setBenefitDate()
     Trace::writeLine(strm.str());
   }
 #endif
-  benefitDate = entDate;
+  if (!(benefitDate == entDate)) {
+    benefitDate = entDate;
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Zeroes out earnings and quarters of coverage before first year
@@ -602,6 +631,7 @@ void WorkerDataGeneral::zeroEarn( int ibegint, int iendt )
 {
   qc.deleteContents(YEAR37, ibegint - 1);
   qc.deleteContents(iendt + 1, maxyear);
+  changes |= EARN_CHANGE;
 }
 
 /// <summary>Sets date of entitlement.</summary>
@@ -620,7 +650,10 @@ void WorkerDataGeneral::setEntDate( const DateMoyr& newEntDate )
     Trace::writeLine(strm.str());
   }
 #endif
-  entDate = newEntDate;
+  if (!(entDate == newEntDate)) {
+    entDate = newEntDate;
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Initializes some Statement data (no disability and no date of
@@ -630,6 +663,7 @@ void WorkerDataGeneral::setPebsData()
   valdi = 0;
   deathDate = boost::gregorian::date(boost::date_time::not_a_date_time);
   disabPeriod[0].deleteContents();
+  changes |= DATE_CHANGE;
 }
 
 /// <summary>Checks quarters of coverage to 1977 for consistency, assuming
@@ -641,6 +675,8 @@ void WorkerDataGeneral::setPebsData()
 /// coverage, 1951-77, is out of range.</exception>
 void WorkerDataGeneral::qctdCheck2()
 {
+  const unsigned char oldQctottd = qctottd;
+  const unsigned char oldQctot51td = qctot51td;
   // limit number of qcs 1937-1977 if first year of earnings is after 1950
   if (ibegin > 1950) {
     qc51tdCheck(qctottd);
@@ -652,6 +688,8 @@ void WorkerDataGeneral::qctdCheck2()
   if (ibegin > 1977) {
     qctottd = qctot51td = 0;
   }
+  if (qctottd != oldQctottd || qctot51td != oldQctot51td)
+    changes |= EARN_CHANGE;
 }
 
 /// <summary>Sets summary quarters of coverage, 1937 to 1977.</summary>
@@ -662,7 +700,10 @@ void WorkerDataGeneral::setQctd( int qct )
 #ifndef NDEBUG
   qctdCheck(qct);
 #endif
-  qctottd = (unsigned char)qct;
+  if (qctottd != qct) {
+    qctottd = (unsigned char)qct;
+    changes |= EARN_CHANGE;
+  }
 }
 
 /// <summary>Sets summary quarters of coverage, 1951 to 1977.</summary>
@@ -677,7 +718,10 @@ void WorkerDataGeneral::setQc51td( int qct )
 #ifndef NDEBUG
   qc51tdCheck(qct);
 #endif
-  qctot51td = (unsigned char)qct;
+  if (qctot51td != qct) {
+    qctot51td = (unsigned char)qct;
+    changes |= EARN_CHANGE;
+  }
 }
 
 /// <summary>Sets type of benefit.</summary>
@@ -692,7 +736,10 @@ void WorkerDataGeneral::setJoasdi( int newJoasdi )
 #ifndef NDEBUG
   joasdiCheck(newJoasdi);
 #endif
-  joasdi = static_cast< unsigned char >(newJoasdi);
+  if (joasdi != newJoasdi) {
+    joasdi = static_cast< unsigned char >(newJoasdi);
+    changes |= OTHER_CHANGE;
+  }
 }
 
 /// <summary>Sets the sex of the worker.</summary>
@@ -715,7 +762,7 @@ void WorkerDataGeneral::setSex( Sex::sex_type newSex )
     Trace::writeLine(strm.str());
   }
 #endif
-  theBits[SEX_BIT] = (newSex > 0);
+  setBit(SEX_BIT, newSex > 0);
 }
 
 /// <summary>Sets date of birth.</summary>
@@ -735,7 +782,10 @@ const boost::gregorian::date& newBirthDate )
     Trace::writeLine(strm.str());
   }
 #endif
-  birthDate = newBirthDate;
+  if (birthDate != newBirthDate) {
+    birthDate = newBirthDate;
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Sets first year of earnings, including any projected earnings.
@@ -748,7 +798,10 @@ void WorkerDataGeneral::setIbegin( int newIbegin )
 #ifndef NDEBUG
   ibegin2Check(newIbegin);
 #endif
-  ibegin = (unsigned short)newIbegin;
+  if (ibegin != newIbegin) {
+    ibegin = (unsigned short)newIbegin;
+    changes |= EARN_CHANGE;
+  }
   //if (projback == 0)
   //   earnpebs.setFirstYear(newIbegin);
   // HI earnings start in same year, but at least 1983
@@ -816,7 +869,10 @@ void WorkerDataGeneral::setIend( int newIend )
 #ifndef NDEBUG
   iendCheck(newIend);
 #endif
-  iend = (unsigned short)newIend;
+  if (iend != newIend) {
+    iend = (unsigned short)newIend;
+    changes |= EARN_CHANGE;
+  }
 }
 
 /// <summary>Sets number of periods of disability.</summary>
@@ -839,7 +895,10 @@ void WorkerDataGeneral::setValdi( int newValdi )
     Trace::writeLine(strm.str());
   }
 #endif
-  valdi = static_cast< unsigned char >(newValdi);
+  if (valdi != newValdi) {
+    valdi = static_cast< unsigned char >(newValdi);
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Sets date of death.</summary>
@@ -859,7 +918,10 @@ const boost::gregorian::date& newDeathDate )
     Trace::writeLine(strm.str());
   }
 #endif
-  deathDate = newDeathDate;
+  if (deathDate != newDeathDate) {
+    deathDate = newDeathDate;
+    changes |= DATE_CHANGE;
+  }
 }
 
 /// <summary>Returns true if benefit increase assumptions are needed.
@@ -1220,7 +1282,7 @@ void WorkerDataGeneral::setIndearn( bool newIndearn )
     Trace::writeLine(strm.str());
   }
 #endif
-  theBits[INDEARN_BIT] = newIndearn;
+  setBit(INDEARN_BIT, newIndearn);
 }
 
 /// <summary>Returns earliest entitlement date on this record.</summary>
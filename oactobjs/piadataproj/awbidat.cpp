@@ -3,9 +3,12 @@
 //
 // $Id: awbidat.cpp 1.20 2011/07/28 10:16:26EDT 044579 Development  $
 
+#include <istream>
+#include <sstream>
 #include "awbidat.h"
 #include "oactcnst.h"
 #include "BaseYearNonFile.h"
+#include "PiaException.h"
 
 using namespace std;
 
@@ -40,6 +43,83 @@ AwbiData::~AwbiData()
 void AwbiData::read()
 { }
 
+/// <summary>Changes some of the historical parameters.</summary>
+///
+/// <remarks>Each line of the input has the name of a parameter (cpiinc, fq,
+/// baseOasdi, baseHi, or base77), a year, and the new value for that year,
+/// separated by blanks. Blank lines, and lines starting with #, are
+/// skipped. A change to the OASDI wage base before
+/// <see cref="HI_BASE_YEAR"/> also changes the HI wage base. The years must
+/// be historical: through the last year of wage bases, the year before for
+/// benefit increases, and two years before for average wages.
+///
+/// This is meant to be used after <see cref="AwbiDataNonFile::setData"/>
+/// has set the parameters stored in the code, so only the values that
+/// differ from them need to be given.</remarks>
+///
+/// <returns>The number of values changed.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if a line
+/// cannot be read, or has an unknown parameter or a year out of range.
+/// </exception>
+///
+/// <param name="in">An open input stream to read from.</param>
+unsigned AwbiData::readChanges( std::istream& in )
+{
+  unsigned count = 0u;
+  int lineNumber = 0;
+  string line;
+  while (getline(in, line)) {
+    lineNumber++;
+    istringstream fields(line);
+    string name;
+    if (!(fields >> name) || name[0] == '#')
+      continue;
+    int year;
+    double value;
+    string extra;
+    DoubleAnnual *values = 0;
+    int lastHistYear = lastYear;
+    if (name == "cpiinc") {
+      values = &cpiinc;
+      lastHistYear = lastYear - 1;
+    }
+    else if (name == "fq") {
+      values = &fq;
+      lastHistYear = lastYear - 2;
+    }
+    else if (name == "baseOasdi") {
+      values = &baseOasdi;
+    }
+    else if (name == "baseHi") {
+      values = &baseHi;
+    }
+    else if (name == "base77") {
+      values = &base77;
+    }
+    ostringstream error;
+    error << "Line " << lineNumber << " of historical parameter changes: ";
+    if (values == 0) {
+      error << "unknown parameter " << name;
+      throw PiaException(error.str());
+    }
+    if (!(fields >> year >> value) || (fields >> extra)) {
+      error << "expected parameter, year, and value";
+      throw PiaException(error.str());
+    }
+    if (year < values->getBaseYear() || year > lastHistYear ||
+      (values == &baseHi && year < HI_BASE_YEAR)) {
+      error << "year " << year << " out of range for " << name;
+      throw PiaException(error.str());
+    }
+    (*values)[year] = value;
+    if (values == &baseOasdi && year < HI_BASE_YEAR)
+      baseHi[year] = value;
+    count++;
+  }
+  return(count);
+}
+
 /// <summary>Dummy function (descendant class may use it).</summary>
 void AwbiData::write()
 { }
@@ -5,6 +5,7 @@
 
 #include <cmath>  // for floor
 #include <utility>  // for rel_ops
+#include <vector>
 #include "OldPia.h"
 #include "date.h"
 #include "piaparms.h"
@@ -191,25 +192,46 @@ PiaMethod::table_type OldPia::cpiBase( const DateMoyr& benefitDate,
 
 /// <summary>Finds AME from PIA in PIA table.</summary>
 ///
+/// <remarks>The lowest AME from $76 to $1000 whose PIA in the table is at
+/// least the PIA is found by a binary search in the
+/// <see cref="AmeIndex"/> of the parameters, adding the PIAs of the table
+/// to it the first time the table is used. With a cap on benefit increases,
+/// which can change from one calculation to the next, every AME is tried
+/// in turn instead. Either way, the PIA and MFB are then calculated for the
+/// AME found, so the results are the same.</remarks>
+///
 /// <returns>AME corresponding to the PIA.</returns>
 ///
 /// <param name="belowMin">False to not adjust for PIA below minimum,
 /// true to adjust.</param>
 double OldPia::mfbOldCal( bool belowMin )
 {
-  // start with lowest applicable AME
-  int rv = 75;
-  do {
-    rv++;
-    // test to see which PIA table to use
-    if (workerData.getBenefitDate() < PiaParams::amend742)
-      static_cast<void>(pl1972(rv));
-    else {
-      // apply benefit increases if June 1975 or later
-      setTableNum(cpiBase(workerData.getBenefitDate(), false,
-        static_cast<double>(rv), false));
+  int rv;
+  if (piaParams.needColaCap()) {
+    // start with lowest applicable AME
+    rv = AmeIndex::FIRST_AME - 1;
+    do {
+      rv++;
+      oldTablePia(rv);
+    } while (piaEnt.get() > piasub && rv < AmeIndex::LAST_AME);
+  }
+  else {
+    AmeIndex& ameIndex = piaParams.getAmeIndex();
+    const AmeIndex::Key key = ameIndexKey();
+    boost::shared_ptr< const vector< double > > maxPias =
+      ameIndex.find(key);
+    if (!maxPias) {
+      vector< double > tablePias;
+      tablePias.reserve(AmeIndex::LAST_AME - AmeIndex::FIRST_AME + 1);
+      for (int ame = AmeIndex::FIRST_AME; ame <= AmeIndex::LAST_AME; ame++) {
+        oldTablePia(ame);
+        tablePias.push_back(piasub);
+      }
+      maxPias = ameIndex.insert(key, tablePias);
     }
-  } while (piaEnt.get() > piasub && rv < 1000);
+    rv = AmeIndex::search(*maxPias, piaEnt.get());
+    oldTablePia(rv);
+  }
   if (belowMin && rv == 76) {
     mfbEnt.set(BenefitAmount::round(PiaParams::factor150 * piaEnt.get(),
       yearCpi[YEAR_BEN]));
@@ -220,6 +242,62 @@ double OldPia::mfbOldCal( bool belowMin )
   return static_cast<double>(rv);
 }
 
+/// <summary>Calculates the PIA and MFB for one AME in the PIA table in
+/// effect at the benefit date.</summary>
+///
+/// <remarks>This is the 1972 Act table before June 1974, and the 1973 Act
+/// table with later benefit increases applied otherwise (see
+/// <see cref="cpiBase"/>).</remarks>
+///
+/// <param name="amesub">AME in this function.</param>
+void OldPia::oldTablePia( int amesub )
+{
+  // test to see which PIA table to use
+  if (workerData.getBenefitDate() < PiaParams::amend742)
+    static_cast<void>(pl1972(amesub));
+  else {
+    // apply benefit increases if June 1975 or later
+    setTableNum(cpiBase(workerData.getBenefitDate(), false,
+      static_cast<double>(amesub), false));
+  }
+}
+
+/// <summary>Returns the key of the PIA table in effect at the benefit date
+/// in the <see cref="AmeIndex"/>.</summary>
+///
+/// <remarks>The key has everything about the worker that the PIAs of the
+/// table depend on (see <see cref="oldTablePia"/>): the dates of the
+/// amendments that change the 1972 Act table, or the last benefit increase,
+/// the year of eligibility if it has catch-up increases, and whether the
+/// special 1999 increase applies.</remarks>
+///
+/// <returns>The key of the PIA table.</returns>
+AmeIndex::Key OldPia::ameIndexKey() const
+{
+  const DateMoyr& benefitDate = workerData.getBenefitDate();
+  AmeIndex::Key key;
+  if (benefitDate < PiaParams::amend742) {
+    key.table = PL_1972;
+    key.lastYear = 0;
+    key.eligYear = 0;
+    key.dates = ((benefitDate >= PiaParams::amend61) ? 1 : 0) +
+      ((benefitDate >= PiaParams::amend741) ? 2 : 0);
+  }
+  else {
+    const int year = benefitDate.getYear();
+    key.table = PL_1973;
+    key.lastYear = (static_cast<int>(benefitDate.getMonth()) <
+      piaParams.getMonthBeninc(year)) ? year - 1 : year;
+    const int eligYear = piaData.getEligYear();
+    const int cstart = piaParams.getCatchup().getCstart();
+    key.eligYear = (eligYear >= cstart &&
+      eligYear < cstart + Catchup::NUM_CATCHUP_ELIG_YEARS) ? eligYear : 0;
+    key.dates =
+      piaParams.isApplicableCola99(PiaParams::YEAR1999, benefitDate) ? 1 : 0;
+  }
+  return(key);
+}
+
 /// <summary>Calculates PIAs under 1973 Act.</summary>
 ///
 /// <param name="amesub">AME in this function.</param>
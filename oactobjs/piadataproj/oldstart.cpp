@@ -68,8 +68,8 @@ bool OldStart::isApplicable()
     ostringstream strm;
     strm << workerData.getIdString() << ", piaData.getQcTotal50() = "
       << piaData.getQcTotal50()
-      << ", piaData.getBirthDateMinus1().getYear() = "
-      << piaData.getBirthDateMinus1().year()
+      << ", piaData.getBirthIndexMinus1().getYear() = "
+      << piaData.getBirthIndexMinus1().getYear()
       << ": At top of OldStart::isApplicable";
     Trace::writeLine(strm.str());
   }
@@ -108,7 +108,7 @@ bool OldStart::isApplicable( const PiaData& piaData )
 {
   if (piaData.getQcTotal50() < 1)
     return(false);
-  const int year = piaData.getBirthDateMinus1().year();
+  const int year = piaData.getBirthIndexMinus1().getYear();
   return (year < 1929 || (year < 1951 && piaData.getQcTotal51() < 6));
 }
 
@@ -206,8 +206,7 @@ void OldStart::calculate()
       i3 = (workerData.getBenefitDate() < PiaParams::amend69) ? 11 : 12;
     }
   }
-  while (getPibInc() > Pib58Pib::getAt(i3) && i3 < 62)
-    i3++;
+  i3 = Pib58Pib::find(getPibInc(), i3);
   setAme(static_cast<double>(Pib58Ame::getAt(i3)));
   if (getMethodOs() == OS1977_79) {
     // if eligible in 1982 or later, extend down below minimum
@@ -306,9 +305,7 @@ void OldStart::oldStart39Cal()
 /// <summary>Calculates 1950 old-start PIA and MFB.</summary>
 void OldStart::oldStart50Cal()
 {
-  int i1 = 0;
-  while (getPibInc() > Pib50Pib::getAt(i1)+.005 && i1 < 485)
-    i1++;
+  const int i1 = Pib50Pib::find(getPibInc());
   // PIAs in conversion table start at $20 and increase at $.10 per interval
   piaEnt.set(20.00 + static_cast<double>(i1) / 10.0);
   piaElig[yearCpi[FIRST_YEAR]] = piaEnt.get();
@@ -323,11 +320,7 @@ void OldStart::oldStart50Cal()
     piaEnt.set(piasub);
     if (workerData.getBenefitDate() < PiaParams::amend54) {
       mfbEnt.set(Pib52Mfb::getAt(i1));
-      int i2 = 0;
-      while (piaEnt.get()-0.005 > Pib52Ame::getAt(i2)) {
-        i2++;
-      }
-      setAme(static_cast<double>(45 + i2));
+      setAme(static_cast<double>(45 + Pib52Ame::find(piaEnt.get())));
     }
     else {
       if (i1 < 329) {
@@ -338,11 +331,7 @@ void OldStart::oldStart50Cal()
         piaEnt.set(Pib54Pia::getAt(i1 - 329));
       }
       mfbEnt.set(Pib54Mfb::getAt(i1));
-      int i2 = 0;
-      while (piaEnt.get()-0.005 > Pib54Ame::getAt(i2)) {
-        i2++;
-      }
-      setAme(static_cast<double>(55 + i2));
+      setAme(static_cast<double>(55 + Pib54Ame::find(piaEnt.get())));
     }
   }
 }
@@ -376,10 +365,10 @@ OldStart::OldStartType OldStart::methodOsCal()
     getIoasdi() == WorkerDataGeneral::SURVIVOR)
     return(piaData.getAmend90() ? OS1990 : OS1965);
   // separate into old-law and new-law
-  if (piaData.getBirthDateMinus1().year() < 1916 ||
+  if (piaData.getBirthIndexMinus1().getYear() < 1916 ||
     piaData.getEligYear() < 1978) {
     // if born before 1916, use 1967 old-start or 1990 amendments
-    if (piaData.getBirthDateMinus1().year() < 1916)
+    if (piaData.getBirthIndexMinus1().getYear() < 1916)
       return(piaData.getAmend90() ? OS1990 : OS1967);
     // if born in 1916 or later, use 1965 old-start or 1990 amendments
     else
@@ -423,7 +412,7 @@ void OldStart::imputeEarnings()
         i3 = min(i3, piaData.freezeYears.getYear3() - 1);
       i3 = max(i3, YEAR37);
       const int year21 = static_cast<int>(
-        piaData.getBirthDateMinus1().year()) + 21;
+        piaData.getBirthIndexMinus1().getYear()) + 21;
       i2 = min(i3, max(YEAR37, min(year21, 1950)));
       setDivisorOs(i3 - i2 + 1);
     }
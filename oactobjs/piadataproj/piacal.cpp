@@ -22,6 +22,9 @@
 #include "WageIndNonFreeze.h"
 #include "Pifc.h"
 #include "DebugCase.h"
+#include "MethodCounters.h"
+#include "MethodPool.h"
+#include "StageTimes.h"
 #if defined(DEBUGCASE)
 #include <sstream>
 #include "Trace.h"
@@ -41,9 +44,11 @@ using namespace std::rel_ops;
 PiaCal::PiaCal( WorkerDataGeneral& newWorkerData, PiaData& newPiaData,
 const PiaParams& newPiaParams ) :
 workerData(newWorkerData), piaData(newPiaData), piaParams(newPiaParams),
-piaMethod(), widowMethod(), wageInd(0), oldStart(0), specMin(0), piaTable(0),
-frozMin(0), childCareCalc(0), transGuar(0), highPiaMethod(0),
-ioasdi(WorkerData::NO_BEN), pebsAssumptions(false)
+piaMethod(), widowMethod(), keptMethods(), wageInd(0), oldStart(0), specMin(0),
+piaTable(0), frozMin(0), childCareCalc(0), transGuar(0), highPiaMethod(0),
+stageTimes(0), methodCounters(0), arena(0), methodPool(0),
+ioasdi(WorkerData::NO_BEN), pebsAssumptions(false), incremental(false),
+methodsKept(false), methodEntDate()
 { }
 
 /// <summary>Destructor.</summary>
@@ -313,6 +318,30 @@ void PiaCal::setHighPia()
   setPifc();
 }
 
+/// <summary>Clears the high pia and support pia, so that they can be set
+/// again from the pias of the methods.</summary>
+///
+/// <remarks>This clears only what <see cref="piaCal1"/> and
+/// <see cref="piaCal2"/> set from the pias of the methods already
+/// calculated, so that they can be called again after the pias of the
+/// methods are changed.</remarks>
+void PiaCal::clearHighPia()
+{
+  piaData.highPia.set(0.0);
+  piaData.supportPia.set(0.0);
+  piaData.highMfb.set(0.0);
+  piaData.setIappn(-1);
+  piaData.setIapps(-1);
+  piaData.setArfApp(PiaData::NO_SPEC_MIN_DRC);
+  highPiaMethod = static_cast<PiaMethod *>(0);
+  for (vector< PiaMethod * >::iterator iter = piaMethod.begin();
+    iter != piaMethod.end(); iter++) {
+    if ((*iter)->getApplicable() == PiaMethod::HIGH_PIA ||
+      (*iter)->getApplicable() == PiaMethod::SUPPORT_PIA)
+      (*iter)->setApplicable(PiaMethod::APPLICABLE);
+  }
+}
+
 /// <summary>Sets applicable mfb.</summary>
 ///
 /// <remarks>This should be called after the high pia is set. The mfb is based
@@ -488,12 +517,12 @@ Secondary *secondaryData, const DateMoyr& entDate ) const
         // handle aged wife (assumes earliest possible retirement age is
         // same as for old-age benie; true so far)
         widowPiaData->earlyRetAge = piaParams.earlyAgeOabCal(
-          widowData->getSex(), widowPiaData->getBirthDateMinus1());
+          widowData->getSex(), widowPiaData->getBirthIndexMinus1());
         if (widowPiaData->ageEnt < widowPiaData->earlyRetAge)
           throw PiaException(PIA_IDS_ARDRI10);
         // widow(er)'s full retirement age
         widowPiaData->fullRetAge = piaParams.fullRetAgeCal(
-          widowPiaData->getBirthDateMinus1().year() + 62);
+          widowPiaData->getBirthIndexMinus1().getYear() + 62);
         monthsArAgedSpouseCal(widowPiaData, secondaryData);
 #if defined(DEBUGCASE)
         if (isDebugPid(workerData.getIdNumber())) {
@@ -542,7 +571,7 @@ Secondary *secondaryData, const DateMoyr& entDate ) const
       }
       // disabled widow's full retirement age
       widowPiaData->fullRetAge = piaParams.fullRetAgeCal(
-        widowPiaData->getBirthDateMinus1().year() + 60);
+        widowPiaData->getBirthIndexMinus1().getYear() + 60);
       monthsArDisWidCal(widowPiaData, secondaryData, entDate);
 #if defined(DEBUGCASE)
       if (isDebugPid(workerData.getIdNumber())) {
@@ -558,7 +587,7 @@ Secondary *secondaryData, const DateMoyr& entDate ) const
         throw PiaException(PIA_IDS_ARDRI6);
       // widow's full retirement age
       widowPiaData->fullRetAge = piaParams.fullRetAgeCal(
-        widowPiaData->getBirthDateMinus1().year() + 60);
+        widowPiaData->getBirthIndexMinus1().getYear() + 60);
       monthsArWidCal(widowPiaData, secondaryData);
 #if defined(DEBUGCASE)
       if (isDebugPid(workerData.getIdNumber())) {
@@ -589,7 +618,7 @@ void PiaCal::monthsDriCal() const
   const int eligYear = piaData.getEligDate().getYear();
   piaData.setFullInsDate(fullInsDateCal());
   piaData.setMonthsArdri(PiaParams::monthsDriCal(piaData.getFullRetDate(),
-    eligYear, piaData.getBirthDateMinus1(), workerData.getEntDate(),
+    eligYear, piaData.getBirthIndexMinus1(), workerData.getEntDate(),
     workerData.getBenefitDate(), piaData.getFullInsDate()));
   piaData.setArf(PiaParams::factorDriCal(piaData.getMonthsArdri(),
     eligYear));
@@ -701,7 +730,7 @@ void PiaCal::calculate2( const DateMoyr& entDate )
 #endif
     piaData.earnTotal50Cal0();
     piaData.freezeYearsCal(workerData, ioasdi, piaParams.fullRetAgeCalDI(
-      piaData.getBirthDateMinus1().year() + 62, entDate.getYear()));
+      piaData.getBirthIndexMinus1().getYear() + 62, entDate.getYear()));
     piaData.earnYearCal(workerData, ioasdi);
     if (workerData.getTotalize()) {
       if (piaData.getQcTotal() == 0)
@@ -728,6 +757,35 @@ void PiaCal::calculate2( const DateMoyr& entDate )
   }
 }
 
+/// <summary>Calculates methods, adding the time spent in each.</summary>
+///
+/// <remarks>If there are threads to calculate the methods (see
+/// <see cref="setMethodPool"/>), the methods are calculated at the same
+/// time; otherwise they are calculated one at a time, in order.</remarks>
+///
+/// <param name="methods">Methods to calculate.</param>
+void PiaCal::calculateMethods( const std::vector< PiaMethod* >& methods )
+{
+  if (methodPool != 0 && methods.size() > 1u) {
+    vector< boost::uint64_t > times;
+    methodPool->calculate(methods, times);
+    for (size_t i = 0; i < methods.size(); i++) {
+      const PiaMethod::pia_type method = methods[i]->getMethod();
+      if (stageTimes != 0)
+        stageTimes->addMethod(method, times[i] / 1.0e9, 0ul);
+      if (methodCounters != 0)
+        methodCounters->add(method, times[i]);
+    }
+    return;
+  }
+  for (vector< PiaMethod* >::const_iterator iter = methods.begin();
+    iter != methods.end(); iter++) {
+    StageTimes::Timer timer(stageTimes, (*iter)->getMethod());
+    MethodCounters::Timer counter(methodCounters, (*iter)->getMethod());
+    (*iter)->calculate();
+  }
+}
+
 /// <summary>Calculates annual quarters of coverage and insured status.
 /// </summary>
 void PiaCal::qcCal()
@@ -841,7 +899,7 @@ double PiaCal::relEarnPositionCal()
     // fill in earnings from 22 to eligibility, plus other years with
     // at least 1 qc
     double earnstt = 0.0;
-    const int birthYear = piaData.getBirthDateMinus1().year();
+    const int birthYear = piaData.getBirthIndexMinus1().getYear();
     if (((yr < birthYear + 22 || yr >= temp) && piaData.qcov.get(yr) > 0) ||
       (yr > birthYear + 21 && yr < temp)) {
       earnstt = rv * piaParams.getFq(min(yr,awiYear));
@@ -906,7 +964,7 @@ void PiaCal::nelapsedCal( CompPeriod& compPeriod, int elapsed2 )
 {
   // calculate first elapsed year
   const int elapsed1 =
-    max(static_cast<int>(piaData.getBirthDateMinus1().year()) + 21,
+    max(piaData.getBirthIndexMinus1().getYear() + 21,
     compPeriod.getBaseYear());
   compPeriod.setNElapsed(elapsed2 - elapsed1);
 #if defined(DEBUGCASE)
@@ -982,7 +1040,7 @@ void PiaCal::nelapsedNonFreezeCal( CompPeriod& compPeriod, int elapsed2 )
 {
   // calculate first elapsed year
   const int elapsed1 =
-    max(static_cast<int>(piaData.getBirthDateMinus1().year()) + 21,
+    max(piaData.getBirthIndexMinus1().getYear() + 21,
     compPeriod.getBaseYear());
   compPeriod.setNElapsed(elapsed2 - elapsed1);
 #if defined(DEBUGCASE)
@@ -1227,19 +1285,19 @@ void PiaCal::dataCheck( const DateMoyr& entDate )
   //}
   piaData.setBirthDateMinus1(workerData.getBirthDate());
   piaData.fullRetAge =
-    piaParams.fullRetAgeCal(piaData.getBirthDateMinus1().year() + 62);
+    piaParams.fullRetAgeCal(piaData.getBirthIndexMinus1().getYear() + 62);
   piaData.setFullRetDate();
   // calculate early retirement age
   if (ioasdi == WorkerData::OLD_AGE)  // only for old-age
     piaData.earlyRetAge = piaParams.earlyAgeOabCal(workerData.getSex(),
-      piaData.getBirthDateMinus1());
+      piaData.getBirthIndexMinus1());
   if (ioasdi != WorkerData::SURVIVOR) {
     // calculate age at entitlement
     piaData.ageEnt = workerData.getEntDate() -
-      DateMoyr(piaData.getBirthDateMinus1());
+      piaData.getBirthIndexMinus1().toDateMoyr();
     // calculate age at benefit date
     piaData.ageBen = workerData.getBenefitDate() -
-      DateMoyr(piaData.getBirthDateMinus1());
+      piaData.getBirthIndexMinus1().toDateMoyr();
   }
   workerData.qctdCheck2();
   workerData.qcCheck();
@@ -1408,7 +1466,7 @@ PiaDataArray& widowArray, SecondaryArray& secondaryArray )
       widowPiaDataptr->setBirthDateMinus1(widowDataptr->getBirthDate());
       // calculate spouse's or widow(er)'s age at entitlement
       widowPiaDataptr->ageEnt = secondaryptr->entDate -
-        DateMoyr(widowPiaDataptr->getBirthDateMinus1());
+        widowPiaDataptr->getBirthIndexMinus1().toDateMoyr();
       if (secondaryptr->bic.getMajorBic() == 'W') {
         widowCheck(*widowDataptr, *secondaryptr);
       }
@@ -1724,7 +1782,7 @@ PiaDataArray& widowArray, SecondaryArray& secondaryArray ) const
       PiaData * widowPiaDataptr = widowArray.piaData[i];
       widowPiaDataptr->setEligYear(eligYearWidowCal(
         secondaryptr->bic.getMajorBic(),
-        widowPiaDataptr->getBirthDateMinus1().year(),
+        widowPiaDataptr->getBirthIndexMinus1().getYear(),
         widowDataptr->disabPeriod[0].getOnsetDate()));
     }
   }
@@ -1795,7 +1853,8 @@ double ratio, int year )
 ///
 /// <remarks> This should be called immediately after <see cref="piaCal"/> in
 /// survivor cases. (It doesn't hurt to call it in other than survivor cases,
-/// but it will simply return without doing anything.)</remarks>
+/// but it will simply return without doing anything.) The methods for all
+/// widow(er)s are created first, then calculated together.</remarks>
 ///
 /// <param name="widowDataArray">Basic information for all family members.
 /// </param>
@@ -1805,12 +1864,18 @@ double ratio, int year )
 void PiaCal::reindWidCalAll( const WorkerDataArray& widowDataArray,
 PiaDataArray& widowArray, SecondaryArray& secondaryArray )
 {
+  const size_t first = widowMethod.size();
   for (int i = 0; i < PiaDataArray::MAXFAMSIZE; i++) {
     if (secondaryArray.secondary[i]->isWidow()) {
       reindWidCal(*widowDataArray.workerData[i], *widowArray.piaData[i],
         *secondaryArray.secondary[i]);
     }
   }
+  if (widowMethod.size() > first) {
+    const vector< PiaMethod* > methods(widowMethod.begin() + first,
+      widowMethod.end());
+    calculateMethods(methods);
+  }
 }
 
 /// <summary>Sets indicator for entitlement after 1990 amendments.</summary>
@@ -1927,7 +1992,7 @@ WorkerDataGeneral::ben_type ioasdi, int year )
     min(year, static_cast<int>(piaData.getEligDate().getYear()) - 1);
   // set first elapsed year
   const int elapsed1 = max(
-    static_cast<int>(piaData.getBirthDateMinus1().year() + 21), 1950);
+    piaData.getBirthIndexMinus1().getYear() + 21, 1950);
   // check for years wholly or partially within period of disability
 #if defined(DEBUGCASE)
   if (isDebugPid(workerData.getIdNumber())) {
@@ -1975,7 +2040,7 @@ WorkerDataGeneral::ben_type ioasdi, int year )
     min(year, static_cast<int>(piaData.getEligDate().getYear()) - 1);
   // set first elapsed year
   const int elapsed1 = max(
-    static_cast<int>(piaData.getBirthDateMinus1().year() + 21), 1950);
+    piaData.getBirthIndexMinus1().getYear() + 21, 1950);
   if (ioasdi == WorkerDataGeneral::DISABILITY) {
     diYears = didropNonFreezeCal(workerData, elapsed1, elapsed2);
   }
@@ -1998,7 +2063,7 @@ PiaData& piaData, WorkerDataGeneral::ben_type ioasdi )
 {
   int didropout = 0;
   const int elap1 = max(
-    static_cast<int>(piaData.getBirthDateMinus1().year() + 21), 1950);
+    piaData.getBirthIndexMinus1().getYear() + 21, 1950);
   piaData.setEligDate(eligYearCal1(workerData, piaData, ioasdi, 0));
   const int elap2 = piaData.getEligDate().getYear() - 1;
   if (workerData.getValdi()) {
@@ -2030,7 +2095,7 @@ PiaData& piaData, WorkerDataGeneral::ben_type ioasdi )
 {
   int diYears = 0;
   const int elap1 = max(
-    static_cast<int>(piaData.getBirthDateMinus1().year() + 21), 1950);
+    piaData.getBirthIndexMinus1().getYear() + 21, 1950);
   piaData.setEligDate(eligYearCal1(workerData, piaData, ioasdi, 0));
   const int elap2 = piaData.getEligDate().getYear() - 1;
   if (ioasdi == WorkerDataGeneral::DISABILITY) {
@@ -2061,7 +2126,8 @@ int PiaCal::qcCurrentCal( const PiaData& piaData, const QtrYear& qtrYear )
   startQtrYear.subtract(12);
   if (startQtrYear < PiaParams::year37qtr1)
     startQtrYear = PiaParams::year37qtr1;
-  const int tempqccur = piaData.qcov.accumulate(startQtrYear, qtrYear, 0u);
+  const int tempqccur =
+    piaData.qcovBits.accumulate(startQtrYear, qtrYear, 0u);
   return tempqccur;
 }
 
@@ -2087,7 +2153,8 @@ int PiaCal::qcCurrentNonFreezeCal( const PiaData& piaData, const QtrYear& qtrYea
   startQtrYear.subtract(12);
   if (startQtrYear < PiaParams::year37qtr1)
     startQtrYear = PiaParams::year37qtr1;
-  const int tempqccur = piaData.qcov.accumulate(startQtrYear, qtrYear, 0u);
+  const int tempqccur =
+    piaData.qcovBits.accumulate(startQtrYear, qtrYear, 0u);
   return tempqccur;
 }
 
@@ -2151,13 +2218,13 @@ PiaData& piaData, WorkerDataGeneral::ben_type ioasdi, int jind7 )
   }
 #endif
 #if !defined(NDEBUG)
-  if (piaData.getBirthDateMinus1().is_not_a_date()) {
+  if (piaData.getBirthIndexMinus1().isNotADate()) {
     throw PiaException("birthDateMinus1 is not a date");
   }
 #endif
-  const int birthYear = piaData.getBirthDateMinus1().year();
+  const int birthYear = piaData.getBirthIndexMinus1().getYear();
   // start with month and year of age 62, plus any additional amount
-  DateMoyr eligDateTemp(piaData.getBirthDateMinus1().month(),
+  DateMoyr eligDateTemp(piaData.getBirthIndexMinus1().getMonth(),
     birthYear + 62 + jind7);
   // account for age-65 computation point for older male workers
   if (workerData.isMale()) {
@@ -2303,7 +2370,7 @@ PiaData& piaData, const QtrYear& qtrYear, int iswasPrimary )
     } else {
       if (piaData.getQcTotal() > 2 && piaData.getQcTotal() +
         (workerData.isMale() ? 1887 : 1890) >
-        static_cast<int>(piaData.getBirthDateMinus1().year())) {
+        piaData.getBirthIndexMinus1().getYear()) {
         // transitionally insured
         return(InsCode::TRANSITIONAL);
       } else {
@@ -2384,7 +2451,7 @@ PiaData& piaData, const QtrYear& qtrYear, int iswasPrimary )
     } else {
       if (piaData.getQcTotalNonFreeze() > 2 && piaData.getQcTotalNonFreeze() +
         (workerData.isMale() ? 1887 : 1890) >
-        static_cast<int>(piaData.getBirthDateMinus1().year())) {
+        piaData.getBirthIndexMinus1().getYear()) {
         // transitionally insured
         return(InsCode::TRANSITIONAL);
       } else {
@@ -2507,7 +2574,7 @@ bool PiaCal::deemedInsCal( PiaData& piaData, const QtrYear& qtrYear )
 {
   // determine number of QC's required
   piaData.setDeemedQcReq(PiaParams::deemedQcReqCal(
-    piaData.getBirthDateMinus1().year()));
+    piaData.getBirthIndexMinus1().getYear()));
   if (piaData.getDeemedQcReq() < 0) {
     return(false);
   }
@@ -2515,7 +2582,7 @@ bool PiaCal::deemedInsCal( PiaData& piaData, const QtrYear& qtrYear )
   qtrYear.check();
 #endif
   const int tempQctot =
-    piaData.qcov.accumulate(PiaParams::qtr184, qtrYear, 0u);
+    piaData.qcovBits.accumulate(PiaParams::qtr184, qtrYear, 0u);
   return (tempQctot >= piaData.getDeemedQcReq());
 }
 
@@ -2553,7 +2620,7 @@ const DateMoyr& dateMoyr, int iswasPrimary )
     return DisInsCode::NOQCS;
   }
   // set quarter and year after attainment of age 21
-  QtrYear tempQtrYear(piaData.getBirthDateMinus1());
+  QtrYear tempQtrYear(piaData.getBirthIndexMinus1().toDateMoyr());
   tempQtrYear.add(QtrYear(1,21));
   // look at period after cessation
   int trial = 0;
@@ -2687,7 +2754,7 @@ const DateMoyr& dateMoyr, int iswasPrimary )
     return DisInsCode::NOQCS;
   }
   // set quarter and year after attainment of age 21
-  QtrYear tempQtrYear(piaData.getBirthDateMinus1());
+  QtrYear tempQtrYear(piaData.getBirthIndexMinus1().toDateMoyr());
   tempQtrYear.add(QtrYear(1,21));
   // try 20/40 beginning with waiting period, before checking
   // special test.
@@ -2900,6 +2967,9 @@ int PiaCal::didropNonFreezeCal( const WorkerDataGeneral& workerData,
 }
 
 /// <summary>Releases memory.</summary>
+///
+/// <remarks>The arena, if any, is reset once the methods are deleted.
+/// </remarks>
 void PiaCal::releaseMemory()
 {
   // clear general methods
@@ -2908,6 +2978,23 @@ void PiaCal::releaseMemory()
     delete *iter1;
   }
   piaMethod.clear();
+  clearMethodPointers();
+  // clear methods kept from a prior calculation
+  for (vector< PiaMethod * >::iterator iter2 = keptMethods.begin();
+    iter2 != keptMethods.end(); iter2++) {
+    delete *iter2;
+  }
+  keptMethods.clear();
+  // clear widow methods
+  releaseWidowMethods();
+  // all methods in the arena are gone
+  if (arena != 0)
+    arena->reset();
+}
+
+/// <summary>Clears the pointers to particular methods.</summary>
+void PiaCal::clearMethodPointers()
+{
   wageInd = static_cast<WageInd *>(0);
   oldStart = static_cast<OldStart *>(0);
   specMin = static_cast<SpecMin *>(0);
@@ -2918,14 +3005,93 @@ void PiaCal::releaseMemory()
   transGuar = static_cast<TransGuar *>(0);
   dibGuar = static_cast<DibGuar *>(0);
   wageIndNonFreeze = static_cast<WageIndNonFreeze *>(0);
-  // clear widow methods
-  for (vector< ReindWid * >::iterator iter2 = widowMethod.begin();
-    iter2 != widowMethod.end(); iter2++) {
-    delete *iter2;
+}
+
+/// <summary>Releases the methods for re-indexed widow(er)s.</summary>
+void PiaCal::releaseWidowMethods()
+{
+  for (vector< ReindWid * >::iterator iter = widowMethod.begin();
+    iter != widowMethod.end(); iter++) {
+    delete *iter;
   }
   widowMethod.clear();
 }
 
+/// <summary>Starts the methods of a calculation, keeping those of the last
+/// calculation if they can be used again.</summary>
+///
+/// <remarks>In incremental mode (see <see cref="setIncremental"/>), the
+/// methods of the last calculation are kept if there is no arena, the date
+/// of entitlement is the same, and only earnings have changed since; they
+/// are moved to <see cref="keptMethods"/>, to be taken back one at a time
+/// with <see cref="reuseMethod"/>. Otherwise all memory from a prior case
+/// is released.</remarks>
+///
+/// <returns>True if the methods were kept.</returns>
+///
+/// <param name="entDate">The date of entitlement.</param>
+bool PiaCal::keepMethods( const DateMoyr& entDate )
+{
+  const bool kept = (incremental && methodsKept && arena == 0 &&
+    entDate == methodEntDate &&
+    (workerData.getChanges() & ~WorkerDataGeneral::EARN_CHANGE) == 0);
+  methodsKept = false;
+  if (kept) {
+    keptMethods.swap(piaMethod);
+    piaMethod.clear();
+    clearMethodPointers();
+    releaseWidowMethods();
+  }
+  else {
+    releaseMemory();
+  }
+  return(kept);
+}
+
+/// <summary>Takes back a method that was kept from the last calculation.
+/// </summary>
+///
+/// <returns>The method, or null if none of that type was kept.</returns>
+///
+/// <param name="method">Type of method.</param>
+PiaMethod* PiaCal::reuseMethod( PiaMethod::pia_type method )
+{
+  for (vector< PiaMethod * >::iterator iter = keptMethods.begin();
+    iter != keptMethods.end(); iter++) {
+    if (*iter != 0 && (*iter)->getMethod() == method) {
+      PiaMethod* rv = *iter;
+      *iter = 0;
+      return(rv);
+    }
+  }
+  return(0);
+}
+
+/// <summary>Finishes the methods of a calculation, deleting any method
+/// that was kept from the last calculation but not used again.</summary>
+void PiaCal::finishMethods()
+{
+  for (vector< PiaMethod * >::iterator iter = keptMethods.begin();
+    iter != keptMethods.end(); iter++) {
+    delete *iter;
+  }
+  keptMethods.clear();
+}
+
+/// <summary>Saves what the methods of a successful calculation used, so
+/// they can be kept for the next one.</summary>
+///
+/// <remarks>The changes recorded in the worker's data are cleared.
+/// </remarks>
+///
+/// <param name="entDate">The date of entitlement.</param>
+void PiaCal::saveMethods( const DateMoyr& entDate )
+{
+  methodsKept = (incremental && arena == 0);
+  methodEntDate = entDate;
+  workerData.clearChanges();
+}
+
 /// <summary>Calculates simplified quarters of coverage, 1937-50.</summary>
 ///
 /// <returns>Simplified quarters of coverage, 1937-50.</returns>
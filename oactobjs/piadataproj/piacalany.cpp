@@ -4,7 +4,11 @@
 // $Id: piacalany.cpp 1.91 2011/08/09 15:55:03EDT 044579 Development  $
 
 #include <cmath>  // definition of floor
+#include <algorithm>
 #include "PiaCalAny.h"
+#include "ClaimAgeBenefit.h"
+#include "PiaMethod.h"
+#include "StageTimes.h"
 #include "oactcnst.h"
 #include "PiaException.h"
 #include "UserAssumptions.h"
@@ -46,20 +50,58 @@ Pebs& newPebs, EarnProject& newEarnProject ) :
 PiaCalLC(newWorkerData, newPiaData, newPiaParamsAny, newLawChange),
 widowDataArray(newWidowDataArray), widowArray(newWidowArray),
 secondaryArray(newSecondary), earnProject(newEarnProject),
-userAssumptions(newUserAssumptions), piaParamsAny(newPiaParamsAny),
+userAssumptions(newUserAssumptions), snapshot(),
+piaParamsAny(newPiaParamsAny), piaParamsUpdate(&newPiaParamsAny),
 pebs(newPebs)
 { }
 
+/// <summary>Initializes a PiaCalAny instance that uses a shared, read-only
+/// snapshot of the parameters.</summary>
+///
+/// <param name="newWorkerData">Worker's basic data.</param>
+/// <param name="newPiaData">Worker's calculation data.</param>
+/// <param name="newWidowDataArray">Widow and other family members' basic
+/// data.</param>
+/// <param name="newWidowArray">Widow and other family members' calculation
+///  data.</param>
+/// <param name="newSnapshot">Pia calculation parameters, already projected
+/// for the assumptions of every case to be calculated.</param>
+/// <param name="newUserAssumptions">User-specified assumptions.</param>
+/// <param name="newSecondary">Array of <see cref="Secondary"/> benefits.
+/// </param>
+/// <param name="newLawChange">Law change parameters.</param>
+/// <param name="newPebs">Statement information.</param>
+/// <param name="newEarnProject">Projected earnings information.</param>
+PiaCalAny::PiaCalAny( WorkerDataGeneral& newWorkerData, PiaData& newPiaData,
+WorkerDataArray& newWidowDataArray, PiaDataArray& newWidowArray,
+const boost::shared_ptr< const PiaParamsAny >& newSnapshot,
+UserAssumptions& newUserAssumptions, SecondaryArray& newSecondary,
+const LawChangeArray& newLawChange, Pebs& newPebs,
+EarnProject& newEarnProject ) :
+PiaCalLC(newWorkerData, newPiaData, *newSnapshot, newLawChange),
+widowDataArray(newWidowDataArray), widowArray(newWidowArray),
+secondaryArray(newSecondary), earnProject(newEarnProject),
+userAssumptions(newUserAssumptions), snapshot(newSnapshot),
+piaParamsAny(*newSnapshot), piaParamsUpdate(0), pebs(newPebs)
+{ }
+
 /// <summary>Destructor.</summary>
 PiaCalAny::~PiaCalAny()
 { }
 
 /// <summary>Calculates preparatory variables.</summary>
 ///
+/// <remarks>If the parameters are a shared snapshot, they are not changed;
+/// only the assumption triggers are reset.</remarks>
+///
 /// <param name="assumptions">Stored benefit increase and average wage
 ///  assumptions.</param>
 void PiaCalAny::calculate1( Assumptions& assumptions )
 {
+  if (piaParamsUpdate == 0) {
+    userAssumptions.resetTriggers();
+    return;
+  }
 #if defined(DEBUGCASE)
   if (isDebugPid(workerData.getIdNumber())) {
     ostringstream strm;
@@ -81,13 +123,13 @@ void PiaCalAny::calculate1( Assumptions& assumptions )
 #endif
     const AssumptionType::assum_type alt = userAssumptions.getIaltbi();
     if (alt == AssumptionType::OTHER_ASSUM) {
-      piaParamsAny.updateCpiinc(userAssumptions.biproj,
+      piaParamsUpdate->updateCpiinc(userAssumptions.biproj,
         userAssumptions.catchup, userAssumptions.titleBi,
         UserAssumptions::getIstart(), userAssumptions.biproj.getLastYear());
     }
     else {
       assumptions.benefitIncMenu(alt);
-      piaParamsAny.updateCpiinc(assumptions.getBiProj().theData,
+      piaParamsUpdate->updateCpiinc(assumptions.getBiProj().theData,
         assumptions.getCatchupDoc().catchup,
         assumptions.getBenefitInc(alt), assumptions.getIstart(),
         assumptions.getBiProj().theData.getLastYear());
@@ -114,7 +156,7 @@ void PiaCalAny::calculate1( Assumptions& assumptions )
 #endif
     const AssumptionType::assum_type alt = userAssumptions.getIaltaw();
     if (alt == AssumptionType::OTHER_ASSUM) {
-      piaParamsAny.updateFqinc(userAssumptions.awincproj,
+      piaParamsUpdate->updateFqinc(userAssumptions.awincproj,
         userAssumptions.titleAw, UserAssumptions::getIstart() - 1,
         userAssumptions.awincproj.getLastYear());
     }
@@ -130,7 +172,7 @@ void PiaCalAny::calculate1( Assumptions& assumptions )
         Trace::writeLine(strm.str());
       }
 #endif
-      piaParamsAny.updateFqinc(assumptions.getAwincProj().awinc,
+      piaParamsUpdate->updateFqinc(assumptions.getAwincProj().awinc,
         assumptions.getAverageWage(alt), assumptions.getIstart() - 1,
         assumptions.getAwincProj().awinc.getLastYear());
     }
@@ -149,11 +191,11 @@ void PiaCalAny::calculate1( Assumptions& assumptions )
     userAssumptions.getJaltaw() != userAssumptions.getIaltaw() ||
     userAssumptions.getIaltaw() == AssumptionType::OTHER_ASSUM ||
     userAssumptions.getIbasch() == 2) {
-    piaParamsAny.updateBases(userAssumptions.baseOasdi,
+    piaParamsUpdate->updateBases(userAssumptions.baseOasdi,
       userAssumptions.base77, userAssumptions.getIbasch(),
       UserAssumptions::getIstart() + 1,
       userAssumptions.baseOasdi.getLastYear());
-    piaParamsAny.updateYocAmountSpecMin();
+    piaParamsUpdate->updateYocAmountSpecMin();
   }
   // This line must come after above conditionals
   userAssumptions.resetTriggers();
@@ -174,6 +216,7 @@ void PiaCalAny::calculate2( const DateMoyr& entDate )
   }
   else {
     i2 = 1;
+    StageTimes::Timer timer(stageTimes, StageTimes::EARN_PROJECTION);
     if (workerData.getIndearn()) {
       workerData.ibeginCheck();
       earnProSteady();
@@ -181,7 +224,7 @@ void PiaCalAny::calculate2( const DateMoyr& entDate )
     earnProjection();
   }
   piaData.earlyRetAge = piaParams.earlyAgeOabCal(workerData.getSex(),
-    piaData.getBirthDateMinus1());
+    piaData.getBirthIndexMinus1());
   for (int i1 = 0; i1 < i2; i1++) {
     const Pebs::pebes_type pebsType = (Pebs::pebes_type)i1;
     if (workerData.getJoasdi() == WorkerData::PEBS_CALC)
@@ -224,12 +267,268 @@ void PiaCalAny::calculate2( const DateMoyr& entDate )
   }
 }
 
+/// <summary>Calculates PIA and benefit for a case whose earnings have
+/// already been projected.</summary>
+///
+/// <remarks>This does the part of <see cref="calculate2"/> that depends on
+/// the law changes: the projected earnings do not, so they are taken from
+/// the case data, where <see cref="calculate2"/> of another instance bound
+/// to the same data left them. The child care credits and the limits to the
+/// wage bases do depend on the law changes, so the earnings used in the
+/// calculation are filled in again from the projected earnings (see
+/// <see cref="PiaCalLC::earnProjection"/>), and the quarters of coverage
+/// and insured status are calculated again from them.
+/// <see cref="dataCheck"/> must still be called first, with this instance.
+/// A Statement case is projected differently for each of its calculations,
+/// so it cannot be calculated this way.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the case
+/// is a Statement case, or if the calculation fails.</exception>
+///
+/// <param name="entDate">The date of entitlement.</param>
+void PiaCalAny::calculate2Projected( const DateMoyr& entDate )
+{
+  if (workerData.getJoasdi() == WorkerData::PEBS_CALC)
+    throw PiaException("A Statement case cannot reuse its projection");
+  setPebsAssumptions(userAssumptions.getIaltaw() ==
+    AssumptionType::PEBS_ASSUM);
+  {
+    StageTimes::Timer timer(stageTimes, StageTimes::EARN_PROJECTION);
+    PiaCalLC::earnProjection();
+  }
+  piaData.earlyRetAge = piaParams.earlyAgeOabCal(workerData.getSex(),
+    piaData.getBirthIndexMinus1());
+  qcCal();
+  PiaCalLC::calculate2(entDate);
+}
+
+/// <summary>Calculates the old-age benefit for every month of entitlement
+/// from age 62 (or the earliest retirement age, if later) through age 70.
+/// </summary>
+///
+/// <remarks>The worker's data must have been read, but not checked. The
+/// months are grouped by the earnings that a calculation would use, which
+/// end with the year before entitlement or the last year of earnings,
+/// whichever is earlier. The full pia calculation is done once for each
+/// group, with entitlement in its last month; the pia for each earlier
+/// month of the group is then taken from the pia at eligibility with the
+/// benefit increases through that month, and only the selection of the high
+/// pia and the benefit are done again for each month (see
+/// <see cref="claimAgeBenefitCal"/>). For a worker with no earnings after
+/// age 61 there is a single pia calculation for all 97 months.
+///
+/// In a totalization case, with the old Statement assumptions, or if any
+/// applicable method does not apply benefit increases year by year from
+/// eligibility (such as the pia table method), the pia at entitlement is
+/// not derived from the pia at eligibility, so there is one calculation for
+/// each year of benefit increases instead.
+///
+/// Benefits of family members are not calculated. The worker's date of
+/// entitlement and benefit date are changed for each calculation and
+/// restored on return, but the calculation data are those of entitlement
+/// at age 70, so the case must be calculated again before its own benefit
+/// is used.</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the worker
+/// is not an old-age case, or if any calculation fails.</exception>
+///
+/// <param name="results">The benefit for each month of entitlement, in
+/// order (output).</param>
+void PiaCalAny::claimAgeSweep( std::vector< ClaimAgeBenefit >& results )
+{
+  if (workerData.getJoasdi() != WorkerData::OLD_AGE)
+    throw PiaException("Claim-age sweep requires an old-age case");
+  results.clear();
+  piaData.setBirthDateMinus1(workerData.getBirthDate());
+  const DateMoyr birthDate(piaData.getBirthIndexMinus1().toDateMoyr());
+  const Age earlyAge = piaParams.earlyAgeOabCal(workerData.getSex(),
+    piaData.getBirthIndexMinus1());
+  const int firstMonth = max(earlyAge.toMonths(), Age(62, 0).toMonths());
+  const int lastMonth = Age(70, 0).toMonths();
+  if (firstMonth > lastMonth)
+    return;
+  results.resize(static_cast<size_t>(lastMonth - firstMonth + 1));
+  for (int month = firstMonth; month <= lastMonth; month++) {
+    ClaimAgeBenefit& result = results[month - firstMonth];
+    result.ageEnt = Age(month / 12, month % 12);
+    result.entDate = birthDate + result.ageEnt;
+  }
+  int lastEarnYear = YEAR37 - 1;
+  if (workerData.getIndearn())
+    lastEarnYear = workerData.getIend();
+  if (workerData.getIndrr())
+    lastEarnYear = max(lastEarnYear, workerData.getLastYearRR());
+  bool reuseColas = !workerData.getTotalize() &&
+    userAssumptions.getIaltaw() != AssumptionType::PEBS_ASSUM;
+  // the dates of each calculation are set in the worker's data
+  const DateMoyr entDateSave = workerData.getEntDate();
+  const DateMoyr benefitDateSave = workerData.getBenefitDate();
+  vector< double > piaEnt(piaMethod.size());
+  try {
+    claimAgeGroupsCal(results, lastEarnYear, reuseColas, piaEnt);
+  } catch (...) {
+    claimAgeDatesRestore(entDateSave, benefitDateSave);
+    throw;
+  }
+  claimAgeDatesRestore(entDateSave, benefitDateSave);
+}
+
+/// <summary>Restores the worker's date of entitlement and benefit date
+/// after a claim-age sweep.</summary>
+///
+/// <remarks>A date that was never set is left as the last one used.
+/// </remarks>
+///
+/// <param name="entDate">Date of entitlement before the sweep.</param>
+/// <param name="benefitDate">Benefit date before the sweep.</param>
+void PiaCalAny::claimAgeDatesRestore( const DateMoyr& entDate,
+const DateMoyr& benefitDate )
+{
+  if (!entDate.isNotADate())
+    workerData.setEntDate(entDate);
+  if (!benefitDate.isNotADate())
+    workerData.setBenefitDate(benefitDate);
+}
+
+/// <summary>Calculates the old-age benefits of a claim-age sweep, one group
+/// of months at a time.</summary>
+///
+/// <param name="results">The months of entitlement, and the benefit for
+/// each (output).</param>
+/// <param name="lastEarnYear">Last year of earnings.</param>
+/// <param name="reuseColas">True if the pia at entitlement may be derived
+/// from the pia at eligibility.</param>
+/// <param name="piaEnt">Space for the pia at entitlement of each method.
+/// </param>
+void PiaCalAny::claimAgeGroupsCal( std::vector< ClaimAgeBenefit >& results,
+int lastEarnYear, bool reuseColas, std::vector< double >& piaEnt )
+{
+  size_t first = 0;
+  while (first < results.size()) {
+    const int group =
+      claimAgeGroup(results[first].entDate, lastEarnYear, reuseColas);
+    size_t last = first;
+    while (last + 1 < results.size() && claimAgeGroup(
+      results[last + 1].entDate, lastEarnYear, reuseColas) == group)
+      last++;
+    // full calculation for the last month of the group
+    const DateMoyr entDate = results[last].entDate;
+    workerData.setEntDate(entDate);
+    workerData.setBenefitDate(entDate);
+    dataCheck(entDate);
+    calculate2(entDate);
+    if (reuseColas) {
+      for (vector< PiaMethod * >::const_iterator iter = piaMethod.begin();
+        iter != piaMethod.end(); iter++) {
+        if ((*iter)->getCpiYear(PiaMethod::YEAR_ELIG) < YEAR79 ||
+          (*iter)->getCpiYear(PiaMethod::FIRST_YEAR) <= 0)
+          reuseColas = false;
+      }
+      // regroup the remaining months by year of benefit increases
+      if (!reuseColas)
+        continue;
+    }
+    for (size_t i = first; i <= last; i++) {
+      workerData.setEntDate(results[i].entDate);
+      workerData.setBenefitDate(results[i].entDate);
+      piaData.ageEnt = results[i].ageEnt;
+      claimAgeBenefitCal(results[i], piaEnt);
+    }
+    first = last + 1;
+  }
+}
+
+/// <summary>Calculates the benefit for one month of entitlement, from the
+/// pias of the last full calculation.</summary>
+///
+/// <remarks>The worker's date of entitlement, benefit date, and age at
+/// entitlement must be set to the month. The pia of each method is set to
+/// its pia with the benefit increases through the month, and the high pia
+/// and the benefit are then found by <see cref="PiaCal::piaCal1"/> and
+/// <see cref="PiaCal::piaCal2"/>, as in a full calculation. The pias of
+/// the methods are put back afterwards, for the next month.</remarks>
+///
+/// <param name="result">The month of entitlement, and the calculated
+/// benefit (output).</param>
+/// <param name="piaEnt">Space for the pia at entitlement of each method.
+/// </param>
+void PiaCalAny::claimAgeBenefitCal( ClaimAgeBenefit& result,
+std::vector< double >& piaEnt )
+{
+  const DateMoyr& benefitDate = workerData.getBenefitDate();
+  int year = benefitDate.getYear();
+  if (static_cast<int>(benefitDate.getMonth()) <
+    piaParams.getMonthBeninc(year)) {
+    year--;
+  }
+  piaEnt.resize(piaMethod.size());
+  for (size_t i = 0; i < piaMethod.size(); i++) {
+    piaEnt[i] = piaMethod[i]->piaEnt.get();
+    piaMethod[i]->piaEnt.set(piaInYear(*piaMethod[i], year));
+  }
+  clearHighPia();
+  piaCal1();
+  piaCal2();
+  for (size_t i = 0; i < piaMethod.size(); i++) {
+    piaMethod[i]->piaEnt.set(piaEnt[i]);
+  }
+  result.monthsArdri = piaData.getMonthsArdri();
+  result.arf = piaData.getArf();
+  result.pia = piaData.highPia;
+  result.unroundedBenefit = piaData.unroundedBenefit;
+  result.roundedBenefit = piaData.roundedBenefit;
+}
+
+/// <summary>Returns the group of a month of entitlement in a claim-age
+/// sweep.</summary>
+///
+/// <remarks>Consecutive months with the same group use the same earnings,
+/// so they can share one pia calculation. Months before and after the 2001
+/// correction of the 1999 benefit increase are in different groups, since
+/// the increase applied depends on the benefit date.</remarks>
+///
+/// <returns>The group of a month of entitlement.</returns>
+///
+/// <param name="entDate">Month of entitlement.</param>
+/// <param name="lastEarnYear">Last year of earnings.</param>
+/// <param name="reuseColas">True if the pia at entitlement can be derived
+/// from the pia at eligibility; false to make one group for each year of
+/// benefit increases.</param>
+int PiaCalAny::claimAgeGroup( const DateMoyr& entDate, int lastEarnYear,
+bool reuseColas ) const
+{
+  const int year = entDate.getYear();
+  const int group = reuseColas ? min(year - 1, lastEarnYear) :
+    2 * year + ((static_cast<int>(entDate.getMonth()) <
+    piaParams.getMonthBeninc(year)) ? 0 : 1);
+  return(2 * group + ((entDate < PiaParams::amend01) ? 0 : 1));
+}
+
+/// <summary>Returns the pia of one method, with benefit increases through
+/// a specified year.</summary>
+///
+/// <remarks>The year must be no earlier than the year before eligibility.
+/// If the year is not before the last year of benefit increases applied,
+/// the pia at entitlement is returned.</remarks>
+///
+/// <returns>The pia with benefit increases through the year.</returns>
+///
+/// <param name="method">The pia calculation method.</param>
+/// <param name="year">Last year of benefit increases.</param>
+double PiaCalAny::piaInYear( const PiaMethod& method, int year )
+{
+  if (year >= method.getCpiYear(PiaMethod::YEAR_BEN))
+    return(method.piaEnt.get());
+  return(method.piaElig[max(year,
+    method.getCpiYear(PiaMethod::FIRST_YEAR))]);
+}
+
 /// <summary>Calculates number of old-age calculations to do.</summary>
 void PiaCalAny::pebsOabCal()
 {
   DateMoyr datetemp(pebs.getMonthnow(), UserAssumptions::getIstart());
   // calculate age now
-  pebs.ageNow = datetemp - DateMoyr(piaData.getBirthDateMinus1());
+  pebs.ageNow = datetemp - piaData.getBirthIndexMinus1().toDateMoyr();
   // check for worker already at least full retirement age
   if (!(pebs.ageNow < piaData.fullRetAge)) {
     // do not do a disability benefit
@@ -267,7 +566,7 @@ void PiaCalAny::pebsSetup( Pebs::pebes_type type, const DateMoyr& entDate )
       // check against current age
       if (pebs.oab2 < pebs.ageNow)
         pebs.oab2 = pebs.ageNow;
-      date2 = DateMoyr(piaData.getBirthDateMinus1()) + pebs.oab2;
+      date2 = piaData.getBirthIndexMinus1().toDateMoyr() + pebs.oab2;
       workerData.setEntDate(date2);
       workerData.setBenefitDate();
       // set age at entitlement
@@ -283,7 +582,7 @@ void PiaCalAny::pebsSetup( Pebs::pebes_type type, const DateMoyr& entDate )
       // check against current age
       if (pebs.oab1 < pebs.ageNow)
         pebs.oab1 = pebs.ageNow;
-      date2 = DateMoyr(piaData.getBirthDateMinus1()) + pebs.oab1;
+      date2 = piaData.getBirthIndexMinus1().toDateMoyr() + pebs.oab1;
       workerData.setEntDate(date2);
       workerData.setBenefitDate();
       // set age at entitlement
@@ -302,14 +601,14 @@ void PiaCalAny::pebsSetup( Pebs::pebes_type type, const DateMoyr& entDate )
       // check against current age
       if (pebs.agePlan1 < pebs.ageNow)
         pebs.agePlan1 = pebs.ageNow;
-      date2 = DateMoyr(piaData.getBirthDateMinus1()) + pebs.agePlan1;
+      date2 = piaData.getBirthIndexMinus1().toDateMoyr() + pebs.agePlan1;
       workerData.setEntDate(date2);
       workerData.setBenefitDate();
       // set age at entitlement
       piaData.ageEnt = pebs.agePlan1;
       // stop earnings in early retirement year
       if ((int)pebs.agePlan1.getYears() > pebs.getAgePlan2()) {
-        workerData.setIend(piaData.getBirthDateMinus1().year() +
+        workerData.setIend(piaData.getBirthIndexMinus1().getYear() +
           pebs.getAgePlan2() - 1);
       }
       // continue earnings to year before current year
@@ -325,10 +624,10 @@ void PiaCalAny::pebsSetup( Pebs::pebes_type type, const DateMoyr& entDate )
       workerData.setBenefitDate();
       // set age at entitlement
       piaData.ageEnt = workerData.getEntDate() -
-        DateMoyr(piaData.getBirthDateMinus1());
+        piaData.getBirthIndexMinus1().toDateMoyr();
       // set age at benefit date
       piaData.ageBen = workerData.getBenefitDate() -
-        DateMoyr(piaData.getBirthDateMinus1());
+        piaData.getBirthIndexMinus1().toDateMoyr();
       // stop earnings in year of death
       workerData.setIend(UserAssumptions::getIstart());
       break;
@@ -488,10 +787,10 @@ void PiaCalAny::dataCheck( const DateMoyr& entDate )
     workerData.setPebsData();
     piaData.setBirthDateMinus1(workerData.getBirthDate());
     // eligibility year is not yet calculated for PEBES case; use
-    // piadata.getBirthDateMinus1().year()+62 since there is no prior
+    // piadata.getBirthIndexMinus1().getYear()+62 since there is no prior
     // disability in PEBES case
     piaData.fullRetAge =
-      piaParams.fullRetAgeCal(piaData.getBirthDateMinus1().year() + 62);
+      piaParams.fullRetAgeCal(piaData.getBirthIndexMinus1().getYear() + 62);
     piaData.setFullRetDate();
     workerData.qctdCheck2();
     workerData.qcCheck();
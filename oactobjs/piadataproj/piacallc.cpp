@@ -24,6 +24,7 @@
 #include "LawChangeArray.h"
 #include "oactcnst.h"
 #include "DebugCase.h"
+#include "MethodCounters.h"
 #if defined(DEBUGCASE) || !defined(NDEBUG)
 #include <sstream>
 #include "Trace.h"
@@ -243,6 +244,7 @@ const LawChangeArray& lawChange )
           piaData.getChildCareMaxCredit(yr), piaParams.qcamt[yr]));
       }
     }
+    piaData.qcovBits.assign(piaData.qcov);
   }
 }
 
@@ -425,25 +427,30 @@ void PiaCalLC::piaCal( const DateMoyr& entDate )
     piaData.initialize();
     piaData.earn50Cal(workerData);
     setAmend90(entDate);
-    // release any memory from a prior case
-    releaseMemory();
-    // get new memory
+    // keep the methods of the last calculation if they can be used again,
+    // or release any memory from a prior case
+    const bool kept = keepMethods(entDate);
+    // get new memory, from the arena if there is one
+    CalcArena::Scope arenaScope(arena);
     const int maxYear = piaParams.getMaxyear();
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
       ostringstream strm;
       strm << workerData.getIdString() << ", piaData.getQcTotal50() = "
         << piaData.getQcTotal50()
-        << ", piaData.getBirthDateMinus1().getYear() = "
-        << piaData.getBirthDateMinus1().year()
+        << ", piaData.getBirthIndexMinus1().getYear() = "
+        << piaData.getBirthIndexMinus1().getYear()
         << ": Calling OldStartLC::isApplicable";
       Trace::writeLine(strm.str());
     }
 #endif
     if (OldStartLC::isApplicable(entDate, workerData.getBenefitDate(),
       piaData, lawChange)) {
-      PiaMethod* method = new OldStartLC(workerData, piaData, piaParams,
-        maxYear, entDate, lawChange);
+      PiaMethod* method = reuseMethod(PiaMethod::OLD_START);
+      if (method == 0) {
+        method = new OldStartLC(workerData, piaData, piaParams, maxYear,
+          entDate, lawChange);
+      }
       // find old-start n
       nelapsedCal(piaData.compPeriodOld, entDate);
       nCal(piaData.compPeriodOld, entDate);
@@ -452,64 +459,94 @@ void PiaCalLC::piaCal( const DateMoyr& entDate )
     }
     if (PiaTableLC::isApplicable(workerData, piaData, getIoasdi(), lawChange,
       entDate)) {
-      PiaMethod* method = new PiaTableLC(workerData, piaData, piaParams,
-        maxYear, lawChange, entDate);
+      PiaMethod* method = reuseMethod(PiaMethod::PIA_TABLE);
+      if (method == 0) {
+        method = new PiaTableLC(workerData, piaData, piaParams, maxYear,
+          lawChange, entDate);
+      }
       piaMethod.push_back(method);
       piaTable = dynamic_cast<PiaTable *>(method);
     }
     if (WageIndLC::isApplicable(workerData, piaData, lawChange, entDate)) {
-      PiaMethod* method = new WageIndLC(workerData, piaData, piaParams,
-        maxYear, lawChange, entDate);
+      PiaMethod* method = reuseMethod(PiaMethod::WAGE_IND);
+      if (method == 0) {
+        method = new WageIndLC(workerData, piaData, piaParams, maxYear,
+          lawChange, entDate);
+      }
       piaMethod.push_back(method);
       wageInd = dynamic_cast<WageInd *>(method);
     }
     if (TransGuarLC::isApplicable(workerData, piaData, getIoasdi(),
       lawChange)) {
-      PiaMethod* method = new TransGuarLC(workerData, piaData, piaParams,
-        maxYear, lawChange);
+      PiaMethod* method = reuseMethod(PiaMethod::TRANS_GUAR);
+      if (method == 0) {
+        method = new TransGuarLC(workerData, piaData, piaParams, maxYear,
+          lawChange);
+      }
       piaMethod.push_back(method);
       transGuar = dynamic_cast<TransGuar *>(method);
     }
     if (SpecMinLC::isApplicable(workerData, lawChange)) {
-      PiaMethod* method = new SpecMinLC(workerData, piaData, piaParams,
-        maxYear, lawChange);
+      PiaMethod* method = reuseMethod(PiaMethod::SPEC_MIN);
+      if (method == 0) {
+        method = new SpecMinLC(workerData, piaData, piaParams, maxYear,
+          lawChange);
+      }
       piaMethod.push_back(method);
       specMin = dynamic_cast<SpecMin *>(method);
     }
     if (FrozMin::isApplicable(workerData, piaData)) {
-      PiaMethod* method = new FrozMin(workerData, piaData, piaParams,
-        maxYear);
+      PiaMethod* method = reuseMethod(PiaMethod::FROZ_MIN);
+      if (method == 0)
+        method = new FrozMin(workerData, piaData, piaParams, maxYear);
       piaMethod.push_back(method);
       frozMin = dynamic_cast<FrozMin *>(method);
     }
     if (ChildCareCalcLC::isApplicable(workerData, piaData, getIoasdi(),
       lawChange)) {
-      PiaMethod* method = new ChildCareCalcLC(workerData, piaData,
-        piaParams, maxYear, lawChange);
+      PiaMethod* method = reuseMethod(PiaMethod::CHILD_CARE);
+      if (method == 0) {
+        method = new ChildCareCalcLC(workerData, piaData, piaParams, maxYear,
+          lawChange);
+      }
       piaMethod.push_back(method);
       childCareCalc = dynamic_cast<ChildCareCalc *>(method);
     }
     if (DibGuarLC::isApplicable(entDate, workerData, piaData, getIoasdi(),
       lawChange)) {
-      PiaMethod* method = new DibGuar(workerData, piaData, piaParams, maxYear);
+      PiaMethod* method = reuseMethod(PiaMethod::DIB_GUAR);
+      if (method == 0)
+        method = new DibGuar(workerData, piaData, piaParams, maxYear);
       piaMethod.push_back(method);
       dibGuar = dynamic_cast<DibGuar *>(method);
     }
     if (WageIndNonFreeze::isApplicable( workerData, piaData)) {
-      PiaMethod* method = new WageIndNonFreeze(workerData, piaData, piaParams, maxYear);
+      PiaMethod* method = reuseMethod(PiaMethod::WAGE_IND_NON_FREEZE);
+      if (method == 0) {
+        method = new WageIndNonFreeze(workerData, piaData, piaParams,
+          maxYear);
+      }
       piaMethod.push_back(method);
       wageIndNonFreeze = dynamic_cast<WageIndNonFreeze *>(method);
     }
+    arenaScope.leave();
+    finishMethods();
     for (vector< PiaMethod * >::iterator iter = piaMethod.begin();
       iter != piaMethod.end(); iter++) {
+      // clear the results of a method kept from the last calculation
+      if (kept)
+        (*iter)->initialize();
       (*iter)->setApplicable(PiaMethod::APPLICABLE);
       (*iter)->setIoasdi(getIoasdi());
       (*iter)->setPebsAssumptions(isPebsAssumptions());
-      (*iter)->calculate();
     }
+    calculateMethods(piaMethod);
     resetAmend90();
     piaCal1();
     piaCal2();
+    saveMethods(entDate);
+    if (methodCounters != 0)
+      methodCounters->addCalculation(highPiaMethod);
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
       Trace::writeLine(workerData.getIdString() +
@@ -547,7 +584,8 @@ void PiaCalLC::calculate2( const DateMoyr& entDate )
   }
 }
 
-/// <summary>Calculates PIA for one re-indexed widow(er).</summary>
+/// <summary>Creates the method for one re-indexed widow(er), if
+/// applicable.</summary>
 ///
 /// <param name="widowData">Widow(er) basic data.</param>
 /// <param name="widowPiaData">Calculation information for widow(er).</param>
@@ -557,12 +595,13 @@ const PiaData& widowPiaData, Secondary& secondary )
 {
   if (ReindWidLC::isApplicable(workerData, piaData,
     widowPiaData.getEligYear(), secondary, lawChange)) {
+    CalcArena::Scope arenaScope(arena);
     ReindWid *reindWid = new ReindWidLC(workerData, piaData, piaParams,
       piaParams.getMaxyear(), widowPiaData, widowData, secondary, lawChange);
+    arenaScope.leave();
     widowMethod.push_back(reindWid);
     reindWid->setApplicable(PiaMethod::APPLICABLE);
     reindWid->setIoasdi(getIoasdi());
     reindWid->setPebsAssumptions(isPebsAssumptions());
-    reindWid->calculate();
   }
 }
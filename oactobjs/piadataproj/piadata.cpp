@@ -46,13 +46,14 @@ earnTotalized(YEAR37, WorkerDataGeneral::getMaxyear()),
 earnTotalizedLimited(YEAR37, WorkerDataGeneral::getMaxyear()),
 finsCode(), fullRetAge(),
 freezeYears(), highMfb(), highPia(), partialFreezeYears(),
-qcov(YEAR37, WorkerDataGeneral::getMaxyear()), qcovMilServ(YEAR37, 1956),
+qcov(YEAR37, WorkerDataGeneral::getMaxyear()),
+qcovBits(YEAR37, WorkerDataGeneral::getMaxyear()), qcovMilServ(YEAR37, 1956),
 relEarnPosition(YEAR37, WorkerDataGeneral::getMaxyear()), roundedBenefit(),
 supportPia(), amend90(false), arf(0.0), arfApp(NO_SPEC_MIN_DRC),
 childCareYearsTotal(0), deemedQcReq(0), deemedQctot(0), doEarlyQcs(true),
 earn3750ms(0.0), earnYear(0), eligDate(), finsCode2(' '), fullInsDate(),
 fullRetDate(), iappn(0), iapps(0), ibeginAll(0), ibeginTotal(0), ielgyr(0),
-ielgyrnf(0), iendAll(0), iendTotal(0), kbirth(), monthsArdri(0), 
+ielgyrnf(0), iendAll(0), iendTotal(0), kbirth(), kbirthIndex(), monthsArdri(0), 
 overMax(false), pifc(' '), qc3750ms(0), qc3750simp(0), qcCurrent(0), 
 qcDisDate1(), qcDisDate2(), qcDisDate3(), qcDisDate4(), qcDisDate5(), 
 qcDisDate6(), qcDisQtr(0), qcDisQtr2(0),qcDisReq(0), qcDisYears(0), 
@@ -96,6 +97,7 @@ PiaData& PiaData::operator=( const PiaData& newData )
   highPia = newData.highPia;
   partialFreezeYears = newData.partialFreezeYears;
   qcov = newData.qcov;
+  qcovBits = newData.qcovBits;
   qcovMilServ = newData.qcovMilServ;
   const DoubleAnnual& da2 = newData.relEarnPosition;
   relEarnPosition.assign(da2, da2.getBaseYear(), da2.getLastYear());
@@ -127,6 +129,7 @@ PiaData& PiaData::operator=( const PiaData& newData )
   iendAll = newData.iendAll;
   iendTotal = newData.iendTotal;
   kbirth = newData.kbirth;
+  kbirthIndex = newData.kbirthIndex;
   monthsArdri = newData.monthsArdri;
   overMax = newData.overMax;
   pifc = newData.pifc;
@@ -169,12 +172,15 @@ void PiaData::deleteContents()
   compPeriodNew.deleteContents();
   compPeriodNewNonFreeze.deleteContents();
   qcov.deleteContents();
+  qcovBits.deleteContents();
   qcovMilServ.deleteContents();
   childCareOrder.deleteContents();
   childCareMaxCredit.clear();
   childCareYearsTotal = 0;
   qc3750simp = qc3750ms = qcTotal = qcTotal50 = 0;
   earn3750ms = earnTotal50[0] = earnTotal50[1] = 0.;
+  arf = 0.0;
+  arfApp = NO_SPEC_MIN_DRC;
 }
 
 /// <summary>Calculates sum of regular pre-1951 earnings.</summary>
@@ -261,7 +267,7 @@ const DateMoyr& date, int trial, bool dospecial, bool dofreeze )
     qcDisDate2 = date;
   }
   // set quarter and year after attainment of age 21
-  tempQtrYear = getBirthDateMinus1();
+  tempQtrYear = getBirthIndexMinus1().toDateMoyr();
   tempQtrYear.add(QtrYear(1,21));
   // calculate number of elapsed quarters
   if (qcDisQtr2 == 40) {
@@ -417,7 +423,7 @@ const DateMoyr& date, int trial, bool dospecial, bool dofreeze )
     qcDisDateNonFreeze2 = date;
   }
   // set quarter and year after attainment of age 21
-  tempQtrYear = getBirthDateMinus1();
+  tempQtrYear = getBirthIndexMinus1().toDateMoyr();
   tempQtrYear.add(QtrYear(1,21));
   // set beginning quarter and year, based on 40 quarters
   qcDisDateNonFreeze1 = qcDisDateNonFreeze2;
@@ -537,7 +543,7 @@ void PiaData::qcDiSpec( int qcdiqtrt, int period )
     tempQcDisDate2 = &qcDisDate6;
   }
   // start with quarter after attainment of age 21
-  *tempQcDisDate1 = getBirthDateMinus1();
+  *tempQcDisDate1 = getBirthIndexMinus1().toDateMoyr();
   tempQcDisDate1->add(QtrYear(1,21));
   // set minimum number of qcs that must be in special period
   const int tempqcs = 12 - qcdiqtrt;
@@ -569,7 +575,7 @@ void PiaData::qcDiSpecNonFreeze( int qcdiqtrt, int period )
   tempQcDisDate1 = &qcDisDateNonFreeze1;
   tempQcDisDate2 = &qcDisDateNonFreeze2;
   // start with quarter after attainment of age 21
-  *tempQcDisDate1 = getBirthDateMinus1();
+  *tempQcDisDate1 = getBirthIndexMinus1().toDateMoyr();
   tempQcDisDate1->add(QtrYear(1,21));
   // set minimum number of qcs that must be in special period
   const int tempqcs = 12 - qcdiqtrt;
@@ -609,7 +615,7 @@ void PiaData::qcDisCal( const WorkerDataGeneral& workerData )
     if (qcDisDate2.getYear() <= 0)
       throw PiaException(PIA_IDS_QCDISCAL);
 #endif
-    qcTotalDis = qcov.accumulate(qcDisDate1, qcDisDate2, qcTotalDis);
+    qcTotalDis = qcovBits.accumulate(qcDisDate1, qcDisDate2, qcTotalDis);
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
       ostringstream strm;
@@ -637,7 +643,7 @@ void PiaData::qcDisCal( const WorkerDataGeneral& workerData )
     if (qcDisDate4.getYear() <= 0)
       throw PiaException(PIA_IDS_QCDISCAL);
 #endif
-    qcTotalDis = qcov.accumulate(qcDisDate3, qcDisDate4, qcTotalDis);
+    qcTotalDis = qcovBits.accumulate(qcDisDate3, qcDisDate4, qcTotalDis);
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
       ostringstream strm;
@@ -665,7 +671,7 @@ void PiaData::qcDisCal( const WorkerDataGeneral& workerData )
     if (qcDisDate6.getYear() <= 0)
       throw PiaException(PIA_IDS_QCDISCAL);
 #endif
-    qcTotalDis = qcov.accumulate(qcDisDate5, qcDisDate6, qcTotalDis);
+    qcTotalDis = qcovBits.accumulate(qcDisDate5, qcDisDate6, qcTotalDis);
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
       ostringstream strm;
@@ -709,7 +715,7 @@ void PiaData::qcDisNonFreezeCal( const WorkerDataGeneral& workerData )
     if (qcDisDateNonFreeze2.getYear() <= 0)
       throw PiaException(PIA_IDS_QCDISCAL);
 #endif
-    qcTotalDisNonFreeze = qcov.accumulate(qcDisDateNonFreeze1, 
+    qcTotalDisNonFreeze = qcovBits.accumulate(qcDisDateNonFreeze1, 
       qcDisDateNonFreeze2, qcTotalDisNonFreeze);
 #if defined(DEBUGCASE)
     if (isDebugPid(workerData.getIdNumber())) {
@@ -797,7 +803,7 @@ const QtrYear& qtrYear )
         ": Calling qcov.accumulate");
     }
 #endif
-    qcTotal51 = qcov.accumulate(qtr151, qtrYear, 0u);
+    qcTotal51 = qcovBits.accumulate(qtr151, qtrYear, 0u);
   } else {
   // use lump sum to 1977, annual quarters thereafter
 #if defined(DEBUGCASE)
@@ -816,7 +822,7 @@ const QtrYear& qtrYear )
         ": Calling qcov.accumulate");
     }
 #endif
-    qcTotal51 = qcov.accumulate(qtr178, qtrYear, qcTotal51);
+    qcTotal51 = qcovBits.accumulate(qtr178, qtrYear, qcTotal51);
   }
   setQcTotal(i1 + qcTotal51);
 #if defined(DEBUGCASE)
@@ -857,7 +863,7 @@ const QtrYear& qtrYear )
         ": Calling qcov.accumulate");
     }
 #endif
-    qcTotal51NonFreeze = qcov.accumulate(qtr151, qtrYear, 0u);
+    qcTotal51NonFreeze = qcovBits.accumulate(qtr151, qtrYear, 0u);
   } else {
   // use lump sum to 1977, annual quarters thereafter
 #if defined(DEBUGCASE)
@@ -876,7 +882,8 @@ const QtrYear& qtrYear )
         ": Calling qcov.accumulate");
     }
 #endif
-    qcTotal51NonFreeze = qcov.accumulate(qtr178, qtrYear, qcTotal51NonFreeze);
+    qcTotal51NonFreeze = qcovBits.accumulate(qtr178, qtrYear,
+      qcTotal51NonFreeze);
   }
   setQcTotalNonFreeze(i1 + qcTotal51NonFreeze);
 #if defined(DEBUGCASE)
@@ -953,8 +960,8 @@ WorkerDataGeneral::ben_type ioasdi, const Age& fullRetAgeDI )
       (int)disabPeriod.getOnsetDate().year() :
       (int)disabPeriod.getOnsetDate().year() + 1);
     if (ioasdi == WorkerDataGeneral::DISABILITY) {
-      year1 = kbirth.year() + fullRetAgeDI.getYears() - 1;
-      if (fullRetAgeDI.getMonths() + kbirth.month() > 12) {
+      year1 = kbirthIndex.getYear() + fullRetAgeDI.getYears() - 1;
+      if (fullRetAgeDI.getMonths() + kbirthIndex.getMonth() > 12) {
         year1++;
       }
       year2 = disabPeriod.getWaitperDate().getYear() +
@@ -1025,7 +1032,7 @@ void PiaData::setIendTotal( const WorkerDataGeneral& workerData )
 /// <param name="workerData">Basic worker data.</param>
 void PiaData::setIbeginTotal( const WorkerDataGeneral& workerData )
 {
-  ibeginTotal = max(static_cast<int>(kbirth.year() + 22), YEAR37);
+  ibeginTotal = max(kbirthIndex.getYear() + 22, YEAR37);
   if (workerData.getIndearn() && ibeginTotal > workerData.getIbegin())
     ibeginTotal = workerData.getIbegin();
 }
@@ -1037,7 +1044,7 @@ void PiaData::setIbeginTotal( const WorkerDataGeneral& workerData )
 /// already been calculated.</remarks>
 void PiaData::setFullRetDate()
 {
-  fullRetDate = DateMoyr(getBirthDateMinus1()) + fullRetAge;
+  fullRetDate = getBirthIndexMinus1().toDateMoyr() + fullRetAge;
   if (fullRetDate < jan1937)
     fullRetDate = jan1937;
 }
@@ -1158,6 +1165,7 @@ void PiaData::qcCal( WorkerDataGeneral& workerData, const Qcamt& qcamt )
       workerData.qc.set(yr, qctemp);
       qcov.set(yr, qctemp);
     }
+    qcovBits.assign(qcov);
   } catch (PiaException& e) {
     throw PiaException(string(e.what()) + " in PiaData::qcCal");
   }
@@ -1328,8 +1336,13 @@ double PiaData::getChildCareMaxCredit( int yearOfCredit ) const
 
 /// <summary>Sets day before worker's birth.</summary>
 ///
+/// <remarks>The day is also saved as a month index and day, so the year and
+/// month of the day before birth, and the dates at which ages are attained,
+/// are found without converting the date again.</remarks>
+///
 /// <param name="birthDate">Worker's date of birth.</param>
 void PiaData::setBirthDateMinus1( const boost::gregorian::date& birthDate )
 {
   kbirth = birthDate - boost::gregorian::date_duration(1);
+  kbirthIndex = DateIndex(kbirth);
 }
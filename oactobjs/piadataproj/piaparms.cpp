@@ -32,24 +32,20 @@ const DateMoyr PiaParams::amend54 = DateMoyr(9, 1954);
 const DateMoyr PiaParams::amend56 = DateMoyr(11, 1956);
 /// <summary>First birth date for which age 62 is effective for females.
 /// </summary>
-const boost::gregorian::date PiaParams::amend561 =
-  boost::gregorian::date(1894, 10, 31);
+const DateIndex PiaParams::amend561 = DateIndex(10, 31, 1894);
 /// <summary>Second birth date for which age 62 is effective for females.
 /// </summary>
-const boost::gregorian::date PiaParams::amend562 =
-  boost::gregorian::date(1891, 11, 30);
+const DateIndex PiaParams::amend562 = DateIndex(11, 30, 1891);
 /// <summary>The date of 1958 amendments.</summary>
 const DateMoyr PiaParams::amend58 = DateMoyr(1, 1959);
 /// <summary>The date of 1961 amendments.</summary>
 const DateMoyr PiaParams::amend61 = DateMoyr(8, 1961);
 /// <summary>First birth date for which age 62 is effective for males.
 /// </summary>
-const boost::gregorian::date PiaParams::amend611 =
-  boost::gregorian::date(1899, 7, 31);
+const DateIndex PiaParams::amend611 = DateIndex(7, 31, 1899);
 /// <summary>Second birth date for which age 62 is effective for males.
 /// </summary>
-const boost::gregorian::date PiaParams::amend612 =
-  boost::gregorian::date(1896, 8, 31);
+const DateIndex PiaParams::amend612 = DateIndex(8, 31, 1896);
 /// <summary>The date of 1965 amendments for benefit increase.</summary>
 const DateMoyr PiaParams::amend651 = DateMoyr(1, 1965);
 /// <summary>The date of 1965 amendments for change to age 60.</summary>
@@ -80,8 +76,7 @@ const DateMoyr PiaParams::amend772 = DateMoyr(1, 1979);
 const DateMoyr PiaParams::amend80 = DateMoyr(7, 1980);
 /// <summary>The date of birth for age 62 and 1 month in 1981 amendments.
 /// </summary>
-const boost::gregorian::date PiaParams::amend811 =
-  boost::gregorian::date(1919, 8, 31);
+const DateIndex PiaParams::amend811 = DateIndex(8, 31, 1919);
 /// <summary>The date of 1981 amendments (month, day, and year).</summary>
 const boost::gregorian::date PiaParams::amend812 =
   boost::gregorian::date(1981, 9, 1);
@@ -206,7 +201,7 @@ qcamt(newMaxyear), bpMfbOut(newMaxyear), bpPiaOut(newMaxyear),
 percPiaOut(newMaxyear), baseHi(newMaxyear), monthBeninc(YEAR51, newMaxyear),
 noChange(YEAR37, newMaxyear), percSpecMin(YEAR37, newMaxyear),
 yocAmountSpecMin(YEAR37, newMaxyear), yocAmountWindfall(YEAR37, newMaxyear),
-cpiinc(YEAR51, newMaxyear), catchup(newIstart),
+cpiinc(YEAR51, newMaxyear), catchup(newIstart), colaTable(), ameIndex(),
 fq(YEAR37, newMaxyear), fqinc(newMaxyear), istart(newIstart),
 maxyear(newMaxyear), specMinPia(), specMinPia2001(), specMinMfb(),
 specMinMfb2001(), recalcInd(YEAR37, newMaxyear), titleAw(), titleBi()
@@ -225,7 +220,8 @@ percPiaOut(newMaxyear), baseHi(newMaxyear), monthBeninc(YEAR51, newMaxyear),
 noChange(YEAR37, newMaxyear), percSpecMin(YEAR37, newMaxyear),
 yocAmountSpecMin(YEAR37, newMaxyear), yocAmountWindfall(YEAR37, newMaxyear),
 cpiinc(YEAR51, newMaxyear), catchup(BaseYearNonFile::YEAR),
-fq(YEAR37, newMaxyear), fqinc(newMaxyear), istart(BaseYearNonFile::YEAR),
+colaTable(), ameIndex(), fq(YEAR37, newMaxyear), fqinc(newMaxyear),
+istart(BaseYearNonFile::YEAR),
 maxyear(newMaxyear), specMinPia(), specMinPia2001(), specMinMfb(),
 specMinMfb2001(), recalcInd(YEAR37, newMaxyear), titleAw(), titleBi()
 { }
@@ -307,6 +303,8 @@ void PiaParams::setData( AwbiData& awbiData )
 {
   const int year = awbiData.getLastYear();
   cpiinc.assign(awbiData.cpiinc, YEAR37, year - 1);
+  colaTable.clear();
+  ameIndex.clear();
   baseHi.assign(awbiData.baseHi, YEAR37, year);
   fq.assign(awbiData.fq, YEAR37, year - 2);
 }
@@ -484,15 +482,15 @@ double PiaParams::retCredit( int eligYear )
 /// <see cref="Sex::sex_type::FEMALE"/> for female).</param>
 /// <param name="kbirth">The date of birth, adjusted to previous day.</param>
 Age PiaParams::earlyAgeOabCalPL( Sex::sex_type sex,
- const boost::gregorian::date& kbirth )
+ const DateIndex& kbirth )
 {
   if (sex == Sex::MALE) {
     // change to age 62
     if (amend611 < kbirth) {
-      return (amend811 < kbirth && kbirth.day() != 1) ? age621 : age62;
+      return (amend811 < kbirth && kbirth.getDay() != 1) ? age621 : age62;
     }
-    else if (kbirth <= amend611 && amend612 < kbirth) {
-      return (amend61 - kbirth);
+    else if (amend612 < kbirth) {
+      return (DateIndex(amend61) - kbirth);
     }
     else {
       return age65;
@@ -501,10 +499,10 @@ Age PiaParams::earlyAgeOabCalPL( Sex::sex_type sex,
   else {
     // change to age 62
     if (amend561 < kbirth) {
-      return (amend811 < kbirth && kbirth.day() != 1) ? age621 : age62;
+      return (amend811 < kbirth && kbirth.getDay() != 1) ? age621 : age62;
     }
-    else if (kbirth <= amend561 && amend562 < kbirth) {
-      return (amend56 - kbirth);
+    else if (amend562 < kbirth) {
+      return (DateIndex(amend56) - kbirth);
     }
     else {
       return age65;
@@ -802,6 +800,8 @@ int lastYeart )
   catchup = userCatchup;
   titleBi = userTitle;
   projectCpiinc();
+  colaTable.build(getCpiincArray(), catchup);
+  ameIndex.clear();
 }
 
 /// <summary>Updates benefit increases.</summary>
@@ -829,6 +829,8 @@ const std::string& userTitle, int firstYeart, int lastYeart )
   catchup.deleteContents();
   titleBi = userTitle;
   projectCpiinc();
+  colaTable.build(getCpiincArray(), catchup);
+  ameIndex.clear();
 }
 
 /// <summary>Returns benefit amount decreased by cola.</summary>
@@ -893,6 +895,10 @@ const DateMoyr& benDate ) const
   // do not handle year of eligibility prior to 1979
   if (eligYear < YEAR79)
     return rv;
+  if (colaTable.isBuilt()) {
+    return(colaTable.unApply(rv, eligYear, eligYear + number - 1, eligYear,
+      isApplicableCola99(YEAR1999, benDate)));
+  }
   // divide out increases, starting with last one
   for (int year = eligYear + number - 1; year >= eligYear; year--) {
     // check for special 1999 increase (with extra 0.1 percent)
@@ -1015,7 +1021,7 @@ double PiaParams::factorArAgedSpouseCalPL( int monthsArdri )
 /// <param name="fullInsDate">The date fully insured status is attained.
 /// </param>
 int PiaParams::monthsDriCal( const DateMoyr& fullRetDate, int eligYear,
-const boost::gregorian::date& dobadj, const DateMoyr& entDate,
+const DateIndex& dobadj, const DateMoyr& entDate,
 const DateMoyr& benefitDate, const DateMoyr& fullInsDate )
 {
   int i2;  // index of month after last month to which delayed
@@ -1030,14 +1036,14 @@ const DateMoyr& benefitDate, const DateMoyr& fullInsDate )
   const int i1 = max(i3, 0);
   // decrease maximum age for DRI from 72 to 70 in Jan 1984
   if (eligYear <= 1975) {
-    tempDate = DateMoyr(dobadj) + age72;
+    tempDate = (dobadj + age72).toDateMoyr();
     i4 = tempDate.index();
     const int i8 = amend83.index();
     if (eligYear >= 1974 && i4 > i8)
       i4 = i8;
   }
   else {
-    tempDate = DateMoyr(dobadj) + age70;
+    tempDate = (dobadj + age70).toDateMoyr();
     i4 = tempDate.index();
   }
   // set index of month of entitlement
@@ -1442,6 +1448,43 @@ double pia ) const
   return max(mfbt, rv);
 }
 
+/// <summary>Applies the benefit increases for a range of years, saving the
+/// amount after each one.</summary>
+///
+/// <remarks>The amount before the first increase is taken from amounts at
+/// index (year1 - 1). The factors are taken from the table built when the
+/// benefit increases were updated, unless it has not been built or a cola
+/// cap is required, in which case <see cref="applyCola"/> and
+/// <see cref="applyCola99"/> are called for each year. Either way the
+/// amounts are the same.</remarks>
+///
+/// <returns>The amount after the last increase.</returns>
+///
+/// <param name="amounts">PIA or MFB to be increased.</param>
+/// <param name="year1">First year of benefit increases.</param>
+/// <param name="year3">Last year of benefit increases.</param>
+/// <param name="eligYear">Year of eligibility for catch-up benefit
+/// increases.</param>
+/// <param name="benDate">The date of benefit.</param>
+double PiaParams::applyColas( DoubleAnnual& amounts, int year1, int year3,
+int eligYear, const DateMoyr& benDate ) const
+{
+  if (colaTable.isBuilt() && !needColaCap()) {
+    return(colaTable.apply(amounts, year1, year3, eligYear,
+      isApplicableCola99(YEAR1999, benDate)));
+  }
+  for (int year = year1; year <= year3; year++) {
+    // check for special 1999 increase (with extra 0.1 percent)
+    if (isApplicableCola99(year, benDate)) {
+      amounts[year] = applyCola99(amounts[year-1]);
+    }
+    else {
+      amounts[year] = applyCola(amounts[year-1], year, eligYear);
+    }
+  }
+  return(amounts[year3]);
+}
+
 /// <summary>Returns maximum family benefit amount increased by special 1999
 /// cola (includes extra 0.1 percent increase), with check that result is at
 /// least 150 percent of pia.</summary>
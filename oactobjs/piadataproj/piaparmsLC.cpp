@@ -900,6 +900,7 @@ void PiaParamsLC::updateBases()
   // HI bases are always set automatically
   baseHi.project(fq, getCpiincArray(), getIstart() + 1,
     baseHi.getLastYear());
+  ameIndex.clear();
 }
 
 /// <summary>Updates wage bases.</summary>
@@ -930,6 +931,7 @@ int firstYeart, int lastYeart )
     // HI bases are always set automatically
     baseHi.project(fq, getCpiincArray(), getIstart() + 1,
       baseHi.getLastYear());
+    ameIndex.clear();
   }
   else {
     updateBases();
@@ -1066,7 +1068,7 @@ int PiaParamsLC::getMaxChildcareDropoutYears( int eligYear,
 /// <param name="sex">The sex of number holder.</param>
 /// <param name="kbirth">The date of birth, adjusted to previous day.</param>
 Age PiaParamsLC::earlyAgeOabCal( Sex::sex_type sex,
-const boost::gregorian::date& kbirth ) const
+const DateIndex& kbirth ) const
 {
   return(earlyAgeOabCalPL(sex, kbirth));
 }
@@ -181,7 +181,7 @@ Age PiaParamsPL::maxDibAge( int year ) const
 /// <see cref="Sex::sex_type::FEMALE"/> for female).</param>
 /// <param name="kbirth">The date of birth, adjusted to previous day.</param>
 Age PiaParamsPL::earlyAgeOabCal( Sex::sex_type sex,
-const boost::gregorian::date& kbirth ) const
+const DateIndex& kbirth ) const
 {
   return(earlyAgeOabCalPL(sex, kbirth));
 }
@@ -288,6 +288,7 @@ void PiaParamsPL::updateBases()
   baseHi.project(fq, getCpiincArray(), firstYeart, baseHi.getLastYear());
   // project old-law OASDI bases
   base77.project(fq, getCpiincArray(), firstYeart, base77.getLastYear());
+  ameIndex.clear();
 }
 
 
@@ -314,6 +315,7 @@ int firstYeart, int lastYeart )
     // HI bases are always set automatically
     baseHi.project(fq, getCpiincArray(), getIstart() + 1,
       baseHi.getLastYear());
+    ameIndex.clear();
   }
   else {
     updateBases();
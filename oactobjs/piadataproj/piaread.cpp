@@ -3,6 +3,9 @@
 
 // $Id: piaread.cpp 1.88 2011/08/08 09:16:42EDT 044579 Development  $
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <stdexcept>
 #include <fstream>
 #include <iomanip>
@@ -18,6 +21,7 @@
 #include "Resource.h"
 #include "AssumptionType.h"
 #include "DateFormatter.h"
+#include "PiaColumnRecord.h"
 
 using namespace std;
 
@@ -79,28 +83,11 @@ unsigned int PiaRead::read( std::istream& in )
   workerData.setMqge(false);
 
   // get next line(s), until a line type of 1
-  do {
+  for (;;) {
     getline(in, inputLine);
     if (in.eof() || inputLine.size() == 0) {
       unusedLine = false;
-      if (workerData.getJoasdi() == WorkerData::PEBS_CALC) {
-        userAssumptions.pebsasmCheck();
-        setPebsData();
-      }
-      // extend user assumptions to end of period, in case benefit date
-      // changes
-      if (userAssumptions.getIaltbi() == AssumptionType::OTHER_ASSUM) {
-        const int year = workerData.getBenefitDate().getYear();
-        const double temp = userAssumptions.biproj[year];
-        userAssumptions.biproj.assign(temp, year + 1,
-          WorkerData::getMaxyear());
-      }
-      if (userAssumptions.getIaltaw() == AssumptionType::OTHER_ASSUM) {
-        const int year = workerData.getBenefitDate().getYear();
-        const double temp = userAssumptions.awincproj[year];
-        userAssumptions.awincproj.assign(temp, year + 1,
-          WorkerData::getMaxyear());
-      }
+      finishRecord(true);
       return(PIA_IDS_READEOF);
     }
     if (in.fail()) {
@@ -108,200 +95,542 @@ unsigned int PiaRead::read( std::istream& in )
       return(PIA_IDS_READERR);
     }
     lineType = atoi(inputLine.substr(0, width).c_str());
-    switch (lineType)
-    {
-    case 1:  // starting new record
+    if (lineType == 1) {  // starting new record
       unusedLine = true;
-      if (workerData.getJoasdi() == WorkerData::PEBS_CALC) {
-        userAssumptions.pebsasmCheck();
-        setPebsData();
-      }
+      finishRecord(false);
       return(0);
-    case 2:  // date of death
-      parseDeath(inputLine.substr(width));
-      break;
-    case 3:  // type of benefit
-      parseTob(inputLine.substr(width));
-      break;
-    case 4:  // date of benefit
-      parseBendate(inputLine.substr(width));
-      break;
-    case 5:  // pebes information
-      parsePebes(inputLine.substr(width));
-      break;
-    case 6:  // years of earnings
+    }
+    const unsigned int ret = parseLine(inputLine.substr(width));
+    if (ret != 0)
+      return(ret);
+  }
+}
+
+/// <summary>Reads case from memory.</summary>
+///
+/// <remarks>This reads the same lines, with the same results, as
+/// <see cref="PiaRead::read(std::istream&)"/> does from a stream holding the
+/// same characters, but without allocating memory for each line. The
+/// characters usually run from the start of a case in a
+/// <see cref="PiaMappedFile"/> to the end of the file, so that, as from a
+/// stream, a case followed by another one stops at the first line of the
+/// next case and only the last case is finished as the end of the file.
+/// The end of the characters is treated as the end of the file, and
+/// <see cref="unusedLine"/> is neither used nor set.
+///
+/// Call <see cref="WorkerDataGeneral::deleteContents"/> for the worker and
+/// each family member before this function if reading more than one case.
+/// </remarks>
+///
+/// <returns>Returns the same values as
+/// <see cref="PiaRead::read(std::istream&)"/>.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_READERR"/> if error reading file.</exception>
+///
+/// <param name="begin">First character of case.</param>
+/// <param name="end">One past last character of case.</param>
+unsigned int PiaRead::read( const char *begin, const char *end )
+{
+  const char *lineEnd = findLineEnd(begin, end);
+  if (lineEnd == 0)
+    return(PIA_IDS_READERR);
+  if (lineTypeCal(begin, lineEnd) != 1)
+    return(PIA_IDS_READERR);
+  setInputLine(begin, lineEnd);
+  parseSsn(inputLine);
+  // assume first there are no regular earnings, until some are read
+  workerData.setIndearn(false);
+  workerData.setMqge(false);
+
+  // get next line(s), until a line type of 1
+  for (const char *next = lineEnd + 1; ; next = lineEnd + 1) {
+    lineEnd = findLineEnd(next, end);
+    if (lineEnd == 0 || lineEnd == next) {
+      finishRecord(true);
+      return(PIA_IDS_READEOF);
+    }
+    lineType = lineTypeCal(next, lineEnd);
+    if (lineType == 1) {  // starting new record
+      finishRecord(false);
+      return(0);
+    }
+    setInputLine(next, lineEnd);
+    const unsigned int ret = parseLine(inputLine);
+    if (ret != 0)
+      return(ret);
+  }
+}
+
+/// <summary>Reads case from the columns of a columnar population file.
+/// </summary>
+///
+/// <remarks>This sets the same data, with the same checks, as
+/// <see cref="PiaRead::read(std::istream&)"/> does for the lines of a pia
+/// file that are stored in columns, without parsing any text. Lines that
+/// are not stored in columns are then parsed as usual, and a case that is
+/// stored entirely as text is read with
+/// <see cref="PiaRead::read(const char*, const char*)"/>.
+///
+/// Call <see cref="WorkerDataGeneral::deleteContents"/> for the worker and
+/// each family member before this function if reading more than one case.
+/// </remarks>
+///
+/// <returns>Returns the same values as
+/// <see cref="PiaRead::read(std::istream&)"/>.</returns>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_READERR"/> if the number of values in a column does
+/// not match the years of earnings.</exception>
+///
+/// <param name="record">Values of the case, from
+/// <see cref="PiaColumnFile::getRecord"/>.</param>
+unsigned int PiaRead::read( const PiaColumnRecord& record )
+{
+  const unsigned flags = record.flags;
+  if (flags & PiaColumnRecord::TEXT_ONLY)
+    return(read(record.text, record.text + record.textLength));
+  try {
+    workerData.ssn.setSsnFull(string(record.ssn, 9));
+    workerData.setSex(static_cast<Sex::sex_type>(record.sex));
+    const boost::gregorian::date birthDate =
+      PiaColumnRecord::toDate(record.birthDate);
+    WorkerData::birth2Check(birthDate);
+    workerData.setBirthDate(birthDate);
+    // assume first there are no regular earnings, until some are read
+    workerData.setIndearn(false);
+    workerData.setMqge(false);
+    if (flags & PiaColumnRecord::DEATH) {
+      workerData.setDeathDate(PiaColumnRecord::toDate(record.deathDate));
+    }
+    if (flags & PiaColumnRecord::TOB) {
+      workerData.setJoasdi(record.joasdi);
+      // do not use date of entitlement in a survivor case
+      if (workerData.getJoasdi() != WorkerData::SURVIVOR) {
+        workerData.setEntDate(PiaColumnRecord::toDateMoyr(record.entDate));
+        workerData.setBenefitDate();
+      }
+    }
+    if (flags & PiaColumnRecord::BENDATE) {
+      workerData.setRecalc(true);
+      workerData.setBenefitDate(
+        PiaColumnRecord::toDateMoyr(record.benefitDate));
+    }
+    if (flags & PiaColumnRecord::YEARS) {
       workerData.setIndearn(true);
-      parseYears(inputLine.substr(width));
-      break;
-    case 7:  // backward projection amounts
-      parseBack(inputLine.substr(width));
-      break;
-    case 8:  // forward projection amounts
-      parseFwrd(inputLine.substr(width));
-      break;
-    case 9:  // disability information for most recent period
-      parseDisab1(inputLine.substr(width));
-      break;
-    case 10:  // disability information for second most recent period
-      parseDisab2(inputLine.substr(width));
-      break;
-    case 11:  // military service dates
-      parseMsdates(inputLine.substr(width));
-      break;
-    case 12:  // noncovered pension
-      parsePubpen(inputLine.substr(width));
-      break;
-    case 13:  // totalization indicator
-      parseTotalize(inputLine.substr(width));
-      break;
-    case 14:  // blind indicator
-      parseBlind(inputLine.substr(width));
-      break;
-    case 15:  // deemed insured indicator
-      parseDeemed(inputLine.substr(width));
-      break;
-    case 16:  // worker's name
-      parseNhname(inputLine.substr(width));
-      break;
-    case 17:  // worker's address
-    case 18:
-    case 19:
-      parseNhaddr(lineType - 17, inputLine.substr(width));
-      break;
-    case 20:  // annual type of earnings
-      parseEarnType(inputLine.substr(width));
-      break;
-    case 21:  // annual type of taxes
-      parseTaxType(inputLine.substr(width));
-      break;
-    case 22:  // earnings
-    case 23:
-    case 24:
-    case 25:
-    case 26:
-    case 27:
-    case 28:
-    case 29:
-      parseEarnOasdi(lineType - 22, inputLine.substr(width));
-      break;
-    case 30:  // Medicare earnings
-    case 31:
-    case 32:
-    case 33:
-    case 34:
-    case 35:
-    case 36:
-    case 37:
+      workerData.setIbegin(record.ibegin);
+      workerData.ibeginCheck();
+      workerData.setIend(record.iend);
+      setEarnProjectYears(record.ibegin, record.iend);
+    }
+    for (int i = 0; i < 2; i++) {
+      if (!(flags & ((i == 0) ? PiaColumnRecord::DISAB1 :
+        PiaColumnRecord::DISAB2)))
+        continue;
+      DisabPeriod disabPeriod;
+      disabPeriod.setOnsetDate(PiaColumnRecord::toDate(record.onsetDate[i]));
+      disabPeriod.setEntDate(
+        PiaColumnRecord::toDateMoyr(record.priorentDate[i]));
+      disabPeriod.setWaitperDate(
+        PiaColumnRecord::toDateMoyr(record.waitperDate[i]));
+      disabPeriod.setCessationDate(
+        PiaColumnRecord::toDateMoyr(record.cessationDate[i]));
+      disabPeriod.setCessationPia(record.cessationPia[i]);
+      disabPeriod.setCessationMfb(record.cessationMfb[i]);
+      if (i == 0)
+        setDisab1(disabPeriod);
+      else
+        setDisab2(disabPeriod);
+    }
+    if (flags & PiaColumnRecord::PUBPEN) {
+      workerData.setPubpen(record.pubpen);
+      if (record.pubpenDate != 0) {
+        workerData.setPubpenDate(
+          PiaColumnRecord::toDateMoyr(record.pubpenDate));
+      }
+    }
+    if (flags & PiaColumnRecord::TOTALIZE)
+      workerData.setTotalize(record.totalize);
+    if (flags & PiaColumnRecord::BLIND)
+      workerData.setBlindind(record.blind);
+    if (flags & PiaColumnRecord::DEEMED)
+      workerData.setDeemedind(record.deemed);
+    const int ibegin = workerData.getIbegin();
+    const int iend = workerData.getIend();
+    if (flags & PiaColumnRecord::TAXTYPE) {
+      columnCountCheck(record.taxTypeCount, ibegin, iend);
+      for (int yr = ibegin; yr <= iend; yr++) {
+        workerData.setTaxType(yr, record.taxType[yr - ibegin]);
+      }
+    }
+    if (flags & PiaColumnRecord::EARN_OASDI) {
+      columnCountCheck(record.earnOasdiCount, ibegin, iend);
+      for (int yr = ibegin; yr <= iend; yr++) {
+        setEarnOasdi(yr, record.earnOasdi[yr - ibegin]);
+      }
+    }
+    if (flags & PiaColumnRecord::EARN_HI) {
+      const int firstyear = workerData.firstEarnHiYear();
+      columnCountCheck(record.earnHiCount, firstyear, iend);
+      for (int yr = firstyear; yr <= iend; yr++) {
+        workerData.setEarnHi(yr, record.earnHi[yr - firstyear]);
+      }
       workerData.setMqge(true);
-      parseEarnHi(lineType - 30, inputLine.substr(width));
-      break;
-    case 38:  // noncovered pension after military reservist pension removal
-      parsePubpenReservist(inputLine.substr(width));
-      break;
-    case 39:  // oab entitlement before most recent dib
-      parseOabent(inputLine.substr(width));
-      break;
-    case 40:  // assumption indicators
-      parseAssump(inputLine.substr(width));
-      break;
-    case 41:  // projected benefit increases
-    case 42:
-    case 43:
-    case 44:
-      parseBi(lineType - 41, inputLine.substr(width));
-      break;
-    case 45:  // catch-up benefit increases
-    case 46:
-    case 47:
-    case 48:
-    case 49:
-    case 50:
-    case 51:
-    case 52:
-    case 53:
-    case 54:
-      parseCatchup(lineType - 45, inputLine.substr(width));
-      break;
-    case 55:  // title of projected benefit increases
-      parseTitlebi(inputLine.substr(width));
-      break;
-    case 56:
-    case 57:
-    case 58:
-    case 59:
-      parseAw(lineType - 56, inputLine.substr(width));
-      break;
-    case 60:  // title of projected average wage increases
-      parseTitleaw(inputLine.substr(width));
-      break;
-    case 61:  // parse OASDI bases
-    case 62:
-    case 63:
-    case 64:
-      parseBases(lineType - 61, inputLine.substr(width));
-      break;
-    case 65:  // parse old-law bases
-    case 66:
-    case 67:
-    case 68:
-      parseBases77(lineType - 65, inputLine.substr(width));
-      break;
-    case 69:  // family member information
-    case 70:
-    case 71:
-    case 72:
-    case 73:
-    case 74:
-    case 75:
-    case 76:
-    case 77:
-    case 78:
-    case 79:
-    case 80:
-    case 81:
-    case 82:
-    case 83:
-      parseFamilyMember(lineType - 69, inputLine.substr(width));
-      break;
-    case 84:  // railroad qcs and earnings 1937 to 1950
-      workerData.setIndrr(true);
-      workerData.railRoadData.parse3750(inputLine.substr(width), earnWidth);
-      break;
-    case 85:  // first and last years of railroad earnings
-      workerData.setIndrr(true);
-      workerData.railRoadData.parseYears(inputLine.substr(width));
-      break;
-    case 86:  // annual quarters of coverage, 1951 to 1977
-      workerData.railRoadData.parseQcs(inputLine.substr(width));
-      break;
-    case 87:  // first decade of earnings
-    case 88:  // second decade of earnings
-    case 89:  // third decade of earnings
-    case 90:  // fourth decade of earnings
-    case 91:  // fifth decade of earnings
-    case 92:  // sixth decade of earnings
-    case 93:  // seventh decade of earnings
-    case 94:  // eighth decade of earnings
-      workerData.railRoadData.parseEarnings(lineType - 87,
-        inputLine.substr(width), earnWidth);
-      break;
-    case 95:  // summary quarters of coverage
-      parseQc1(inputLine.substr(width));
-      break;
-    case 96:  // annual quarters of coverage
-      parseQc2(inputLine.substr(width));
-      break;
-    case 97:  // annual child care years
-      parseChildCareYears(inputLine.substr(width));
-      break;
-    default:
-      return((lineType > 99) ? PIA_IDS_READMORE : PIA_IDS_READERR);
     }
-  } while (lineType != 1);
-  // should never reach here, due to return in switch statements
+    if (flags & PiaColumnRecord::RESERVIST) {
+      workerData.setReservist(true);
+      workerData.setPubpenReservist(record.pubpenReservist);
+    }
+    if (flags & PiaColumnRecord::OABENT) {
+      workerData.setOabEntDate(PiaColumnRecord::toDateMoyr(record.oabEntDate));
+      workerData.setOabCessDate(
+        PiaColumnRecord::toDateMoyr(record.oabCessDate));
+    }
+    for (unsigned i = 0; i < record.famSize; i++) {
+      widowArray.setFamSize(static_cast<int>(i) + 1);
+      Secondary * secondaryptr = secondaryArray.secondary[i];
+      WorkerData * widowDataptr = widowDataArray.workerData[i];
+      secondaryptr->bic.set(string(record.famBic + 2 * i, 2));
+      const boost::gregorian::date dateModyyr =
+        PiaColumnRecord::toDate(record.famBirthDate[i]);
+      WorkerData::birth2Check(dateModyyr);
+      widowDataptr->setBirthDate(dateModyyr);
+      secondaryptr->entDate = PiaColumnRecord::toDateMoyr(record.famEntDate[i]);
+      if (secondaryptr->bic.getMajorBic() == 'W') {
+        widowDataptr->setOnsetDate(0,
+          PiaColumnRecord::toDate(record.famOnsetDate[i]));
+      }
+    }
+    if (flags & PiaColumnRecord::QC1) {
+      workerData.setQctd(record.qctd);
+      workerData.setQc51td(record.qc51td);
+      workerData.qctdCheck2();
+    }
+    if (flags & PiaColumnRecord::QC2) {
+      workerData.setQcsByYear(true);
+      const int lastyear = workerData.lastQcyr();
+      columnCountCheck(record.qcCount, ibegin, lastyear);
+      for (int yr = ibegin; yr <= lastyear; yr++) {
+        workerData.qc.set(yr, record.qc[yr - ibegin]);
+      }
+      workerData.setQctd(workerData.qc.accumulate(YEAR37, lastyear, 0u));
+      workerData.setQc51td(workerData.qc.accumulate(YEAR51, lastyear, 0u));
+    }
+    if (flags & PiaColumnRecord::CHILDCARE) {
+      columnCountCheck(record.childCareCount, ibegin, iend);
+      for (int yr = ibegin; yr <= iend; yr++) {
+        workerData.childCareYears.setBit(yr, record.childCare[yr - ibegin]);
+      }
+    }
+  } catch (out_of_range&) {
+    throw PiaException(PIA_IDS_READERR);
+  }
+  // parse the lines not stored in columns
+  const char *end = record.text + record.textLength;
+  for (const char *next = record.text; ; next = findLineEnd(next, end) + 1) {
+    const char *lineEnd = findLineEnd(next, end);
+    if (lineEnd == 0)
+      break;
+    lineType = lineTypeCal(next, lineEnd);
+    setInputLine(next, lineEnd);
+    const unsigned int ret = parseLine(inputLine);
+    if (ret != 0)
+      return(ret);
+  }
+  finishRecord(true);
   return(PIA_IDS_READEOF);
 }
 
+/// <summary>Checks the number of values of a case in a column of a
+/// columnar population file.</summary>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> of type
+/// <see cref="PIA_IDS_READERR"/> if the number of values is not the number
+/// of years.</exception>
+///
+/// <param name="count">Number of values.</param>
+/// <param name="firstYear">First year of values.</param>
+/// <param name="lastYear">Last year of values.</param>
+void PiaRead::columnCountCheck( unsigned count, int firstYear,
+int lastYear )
+{
+  if (static_cast<int>(count) != max(lastYear - firstYear + 1, 0))
+    throw PiaException(PIA_IDS_READERR);
+}
+
+/// <summary>Returns the end of a line in memory.</summary>
+///
+/// <returns>Pointer to the newline character at the end of the line, or
+/// null if there is no newline character before the end (in which case the
+/// line is not read, as in <see cref="PiaRead::read(std::istream&)"/>).
+/// </returns>
+///
+/// <param name="begin">First character of line.</param>
+/// <param name="end">One past last character available.</param>
+const char *PiaRead::findLineEnd( const char *begin, const char *end )
+{
+  return (begin < end) ?
+    static_cast<const char *>(memchr(begin, '\n', end - begin)) : 0;
+}
+
+/// <summary>Returns the type of a line in memory.</summary>
+///
+/// <returns>Type of line (the number in its first columns).</returns>
+///
+/// <param name="begin">First character of line.</param>
+/// <param name="lineEnd">End of line.</param>
+int PiaRead::lineTypeCal( const char *begin, const char *lineEnd )
+{
+  char field[16];
+  const int length = static_cast<int>(min<ptrdiff_t>(lineEnd - begin,
+    min(width, static_cast<int>(sizeof(field)) - 1)));
+  memcpy(field, begin, length);
+  field[length] = '\0';
+  return(atoi(field));
+}
+
+/// <summary>Sets <see cref="inputLine"/> to a line in memory, without its
+/// line type.</summary>
+///
+/// <remarks>The capacity of <see cref="inputLine"/> is reused, so no memory
+/// is allocated once it holds a line of the longest length.</remarks>
+///
+/// <exception cref="std::out_of_range">If the line is shorter than the line
+/// type (as from std::string::substr in
+/// <see cref="PiaRead::read(std::istream&)"/>).</exception>
+///
+/// <param name="begin">First character of line.</param>
+/// <param name="lineEnd">End of line.</param>
+void PiaRead::setInputLine( const char *begin, const char *lineEnd )
+{
+  if (lineEnd - begin < width)
+    throw out_of_range("PiaRead::setInputLine");
+  inputLine.assign(begin + width, lineEnd);
+}
+
+/// <summary>Finishes reading a case.</summary>
+///
+/// <param name="endOfFile">True if the case is followed by end of file,
+/// false if it is followed by another case.</param>
+void PiaRead::finishRecord( bool endOfFile )
+{
+  if (workerData.getJoasdi() == WorkerData::PEBS_CALC) {
+    userAssumptions.pebsasmCheck();
+    setPebsData();
+  }
+  if (!endOfFile)
+    return;
+  // extend user assumptions to end of period, in case benefit date
+  // changes
+  if (userAssumptions.getIaltbi() == AssumptionType::OTHER_ASSUM) {
+    const int year = workerData.getBenefitDate().getYear();
+    const double temp = userAssumptions.biproj[year];
+    userAssumptions.biproj.assign(temp, year + 1,
+      WorkerData::getMaxyear());
+  }
+  if (userAssumptions.getIaltaw() == AssumptionType::OTHER_ASSUM) {
+    const int year = workerData.getBenefitDate().getYear();
+    const double temp = userAssumptions.awincproj[year];
+    userAssumptions.awincproj.assign(temp, year + 1,
+      WorkerData::getMaxyear());
+  }
+}
+
+/// <summary>Parses one line of a case, other than its first line.</summary>
+///
+/// <returns>0 if the line was parsed, <see cref="PIA_IDS_READMORE"/> if the
+/// line is for a subclass, or <see cref="PIA_IDS_READERR"/> if the line
+/// type is not valid.</returns>
+///
+/// <param name="line">Line to parse, without its line type (which is in
+/// <see cref="lineType"/>).</param>
+unsigned int PiaRead::parseLine( const std::string& line )
+{
+  switch (lineType)
+  {
+  case 2:  // date of death
+    parseDeath(line);
+    break;
+  case 3:  // type of benefit
+    parseTob(line);
+    break;
+  case 4:  // date of benefit
+    parseBendate(line);
+    break;
+  case 5:  // pebes information
+    parsePebes(line);
+    break;
+  case 6:  // years of earnings
+    workerData.setIndearn(true);
+    parseYears(line);
+    break;
+  case 7:  // backward projection amounts
+    parseBack(line);
+    break;
+  case 8:  // forward projection amounts
+    parseFwrd(line);
+    break;
+  case 9:  // disability information for most recent period
+    parseDisab1(line);
+    break;
+  case 10:  // disability information for second most recent period
+    parseDisab2(line);
+    break;
+  case 11:  // military service dates
+    parseMsdates(line);
+    break;
+  case 12:  // noncovered pension
+    parsePubpen(line);
+    break;
+  case 13:  // totalization indicator
+    parseTotalize(line);
+    break;
+  case 14:  // blind indicator
+    parseBlind(line);
+    break;
+  case 15:  // deemed insured indicator
+    parseDeemed(line);
+    break;
+  case 16:  // worker's name
+    parseNhname(line);
+    break;
+  case 17:  // worker's address
+  case 18:
+  case 19:
+    parseNhaddr(lineType - 17, line);
+    break;
+  case 20:  // annual type of earnings
+    parseEarnType(line);
+    break;
+  case 21:  // annual type of taxes
+    parseTaxType(line);
+    break;
+  case 22:  // earnings
+  case 23:
+  case 24:
+  case 25:
+  case 26:
+  case 27:
+  case 28:
+  case 29:
+    parseEarnOasdi(lineType - 22, line);
+    break;
+  case 30:  // Medicare earnings
+  case 31:
+  case 32:
+  case 33:
+  case 34:
+  case 35:
+  case 36:
+  case 37:
+    workerData.setMqge(true);
+    parseEarnHi(lineType - 30, line);
+    break;
+  case 38:  // noncovered pension after military reservist pension removal
+    parsePubpenReservist(line);
+    break;
+  case 39:  // oab entitlement before most recent dib
+    parseOabent(line);
+    break;
+  case 40:  // assumption indicators
+    parseAssump(line);
+    break;
+  case 41:  // projected benefit increases
+  case 42:
+  case 43:
+  case 44:
+    parseBi(lineType - 41, line);
+    break;
+  case 45:  // catch-up benefit increases
+  case 46:
+  case 47:
+  case 48:
+  case 49:
+  case 50:
+  case 51:
+  case 52:
+  case 53:
+  case 54:
+    parseCatchup(lineType - 45, line);
+    break;
+  case 55:  // title of projected benefit increases
+    parseTitlebi(line);
+    break;
+  case 56:
+  case 57:
+  case 58:
+  case 59:
+    parseAw(lineType - 56, line);
+    break;
+  case 60:  // title of projected average wage increases
+    parseTitleaw(line);
+    break;
+  case 61:  // parse OASDI bases
+  case 62:
+  case 63:
+  case 64:
+    parseBases(lineType - 61, line);
+    break;
+  case 65:  // parse old-law bases
+  case 66:
+  case 67:
+  case 68:
+    parseBases77(lineType - 65, line);
+    break;
+  case 69:  // family member information
+  case 70:
+  case 71:
+  case 72:
+  case 73:
+  case 74:
+  case 75:
+  case 76:
+  case 77:
+  case 78:
+  case 79:
+  case 80:
+  case 81:
+  case 82:
+  case 83:
+    parseFamilyMember(lineType - 69, line);
+    break;
+  case 84:  // railroad qcs and earnings 1937 to 1950
+    workerData.setIndrr(true);
+    workerData.railRoadData.parse3750(line, earnWidth);
+    break;
+  case 85:  // first and last years of railroad earnings
+    workerData.setIndrr(true);
+    workerData.railRoadData.parseYears(line);
+    break;
+  case 86:  // annual quarters of coverage, 1951 to 1977
+    workerData.railRoadData.parseQcs(line);
+    break;
+  case 87:  // first decade of earnings
+  case 88:  // second decade of earnings
+  case 89:  // third decade of earnings
+  case 90:  // fourth decade of earnings
+  case 91:  // fifth decade of earnings
+  case 92:  // sixth decade of earnings
+  case 93:  // seventh decade of earnings
+  case 94:  // eighth decade of earnings
+    workerData.railRoadData.parseEarnings(lineType - 87,
+      line, earnWidth);
+    break;
+  case 95:  // summary quarters of coverage
+    parseQc1(line);
+    break;
+  case 96:  // annual quarters of coverage
+    parseQc2(line);
+    break;
+  case 97:  // annual child care years
+    parseChildCareYears(line);
+    break;
+  default:
+    return((lineType > 99) ? PIA_IDS_READMORE : PIA_IDS_READERR);
+  }
+  return(0);
+}
+
 /// <summary>Sets data for Social Security Statement.</summary>
 ///
 /// <remarks>Calls <see cref="WorkerDataGeneral::setPebsData"/>.</remarks>
@@ -436,6 +765,17 @@ void PiaRead::parseYears( const std::string& line )
 void PiaRead::setEarnProjectYears( int, int )
 { }
 
+/// <summary>Sets OASDI-covered earnings for one year.</summary>
+///
+/// <remarks>This version sets the earnings in the worker's data.</remarks>
+///
+/// <param name="year">Year of earnings.</param>
+/// <param name="earnings">Amount of earnings.</param>
+void PiaRead::setEarnOasdi( int year, double earnings )
+{
+  workerData.setEarnOasdi(year, earnings);
+}
+
 /// <summary>Parses backward projection amounts.</summary>
 ///
 /// <remarks>This version does nothing.</remarks>
@@ -457,41 +797,49 @@ void PiaRead::parseDisab1( const std::string& line )
     // fill in a temporary DisabPeriod
     DisabPeriod disabPeriod;
     disabPeriod.parseString(line);
-    // set date of onset
-    workerData.setOnsetDate(0, disabPeriod.getOnsetDate());
-    workerData.setValdi(1);
-    workerData.disCheck();
-    // set date of prior entitlement
-    if (workerData.getJoasdi() == WorkerData::NO_BEN) {
-      workerData.setPriorentDate(0, disabPeriod.getEntDate());
-    }
-    else {
-      workerData.setPriorentDateCheck(0, disabPeriod.getEntDate());
-      workerData.priorentCheck();
-    }
-    // set first month of waiting period
-    //if (workerData.getJoasdi() == WorkerData::DISABILITY ||
-    //    workerData.getJoasdi() == WorkerData::NO_BEN) {
-      DisabPeriod::waitperDateCheck(disabPeriod.getWaitperDate());
-      workerData.setWaitperDate(0, disabPeriod.getWaitperDate());
-      if (workerData.getJoasdi() == WorkerData::DISABILITY)
-        workerData.waitpdCheck();
-    //}
-    if (workerData.getJoasdi() != WorkerData::DISABILITY) {
-      // set month and year of disability cessation
-      if (disabPeriod.getCessationDate().getYear() != 0 ||
-        workerData.getJoasdi() != WorkerData::NO_BEN) {
-        DisabPeriod::cessationDateCheck(disabPeriod.getCessationDate());
-        workerData.setCessationDate(0, disabPeriod.getCessationDate());
-        workerData.setCessationPia(0, disabPeriod.getCessationPia());
-        workerData.setCessationMfb(0, disabPeriod.getCessationMfb());
-      }
-    }
+    setDisab1(disabPeriod);
   } catch (out_of_range&) {
     throw PiaException(PIA_IDS_READERR);
   }
 }
 
+/// <summary>Sets disability information for most recent period.</summary>
+///
+/// <param name="disabPeriod">Period of disability read.</param>
+void PiaRead::setDisab1( const DisabPeriod& disabPeriod )
+{
+  // set date of onset
+  workerData.setOnsetDate(0, disabPeriod.getOnsetDate());
+  workerData.setValdi(1);
+  workerData.disCheck();
+  // set date of prior entitlement
+  if (workerData.getJoasdi() == WorkerData::NO_BEN) {
+    workerData.setPriorentDate(0, disabPeriod.getEntDate());
+  }
+  else {
+    workerData.setPriorentDateCheck(0, disabPeriod.getEntDate());
+    workerData.priorentCheck();
+  }
+  // set first month of waiting period
+  //if (workerData.getJoasdi() == WorkerData::DISABILITY ||
+  //    workerData.getJoasdi() == WorkerData::NO_BEN) {
+    DisabPeriod::waitperDateCheck(disabPeriod.getWaitperDate());
+    workerData.setWaitperDate(0, disabPeriod.getWaitperDate());
+    if (workerData.getJoasdi() == WorkerData::DISABILITY)
+      workerData.waitpdCheck();
+  //}
+  if (workerData.getJoasdi() != WorkerData::DISABILITY) {
+    // set month and year of disability cessation
+    if (disabPeriod.getCessationDate().getYear() != 0 ||
+      workerData.getJoasdi() != WorkerData::NO_BEN) {
+      DisabPeriod::cessationDateCheck(disabPeriod.getCessationDate());
+      workerData.setCessationDate(0, disabPeriod.getCessationDate());
+      workerData.setCessationPia(0, disabPeriod.getCessationPia());
+      workerData.setCessationMfb(0, disabPeriod.getCessationMfb());
+    }
+  }
+}
+
 /// <summary>Parses disability information for second most recent period.
 /// </summary>
 ///
@@ -502,36 +850,45 @@ void PiaRead::parseDisab2( const std::string& line )
     // fill in a temporary DisabPeriod
     DisabPeriod disabPeriod;
     disabPeriod.parseString(line);
-    // set date of onset
-    workerData.setOnsetDate(1, disabPeriod.getOnsetDate());
-    workerData.setValdi(2);
-    workerData.dis1Check();
-    // set date of prior entitlement
-    if (workerData.getJoasdi() == WorkerData::NO_BEN) {
-      workerData.setPriorentDate(1, disabPeriod.getEntDate());
-    }
-    else {
-      workerData.setPriorentDateCheck(1, disabPeriod.getEntDate());
-      workerData.priorent1Check();
-    }
-    // set first month of prior waiting period
-    workerData.setWaitperDate(1, disabPeriod.getWaitperDate());
-    // set month and year of prior disability cessation
-    if (disabPeriod.getCessationDate().getYear() != 0 ||
-      workerData.getJoasdi() != WorkerData::NO_BEN) {
-      DisabPeriod::cessationDateCheck(disabPeriod.getCessationDate());
-      workerData.setCessationDate(1, disabPeriod.getCessationDate());
-      workerData.setCessationPia(1, disabPeriod.getCessationPia());
-      workerData.setCessationMfb(1, disabPeriod.getCessationMfb());
-    }
-    if (workerData.getJoasdi() == WorkerData::DISABILITY) {
-      workerData.waitpd1Check();
-    }
+    setDisab2(disabPeriod);
   } catch (out_of_range&) {
     throw PiaException(PIA_IDS_READERR);
   }
 }
 
+/// <summary>Sets disability information for second most recent period.
+/// </summary>
+///
+/// <param name="disabPeriod">Period of disability read.</param>
+void PiaRead::setDisab2( const DisabPeriod& disabPeriod )
+{
+  // set date of onset
+  workerData.setOnsetDate(1, disabPeriod.getOnsetDate());
+  workerData.setValdi(2);
+  workerData.dis1Check();
+  // set date of prior entitlement
+  if (workerData.getJoasdi() == WorkerData::NO_BEN) {
+    workerData.setPriorentDate(1, disabPeriod.getEntDate());
+  }
+  else {
+    workerData.setPriorentDateCheck(1, disabPeriod.getEntDate());
+    workerData.priorent1Check();
+  }
+  // set first month of prior waiting period
+  workerData.setWaitperDate(1, disabPeriod.getWaitperDate());
+  // set month and year of prior disability cessation
+  if (disabPeriod.getCessationDate().getYear() != 0 ||
+    workerData.getJoasdi() != WorkerData::NO_BEN) {
+    DisabPeriod::cessationDateCheck(disabPeriod.getCessationDate());
+    workerData.setCessationDate(1, disabPeriod.getCessationDate());
+    workerData.setCessationPia(1, disabPeriod.getCessationPia());
+    workerData.setCessationMfb(1, disabPeriod.getCessationMfb());
+  }
+  if (workerData.getJoasdi() == WorkerData::DISABILITY) {
+    workerData.waitpd1Check();
+  }
+}
+
 /// <summary>Parses family member's information.</summary>
 ///
 /// <param name="lineNumber">Family member number (0 to 14).</param>
@@ -736,7 +1093,7 @@ void PiaRead::parseEarnOasdi( int lineNumber, const std::string& line )
   const int lastYear = min(firstYear + 9, workerData.getIend());
   try {
     for (int yr = firstYear; yr <= lastYear; yr++) {
-      workerData.setEarnOasdi(yr, atof(
+      setEarnOasdi(yr, atof(
         line.substr(earnWidth * (yr - firstYear), earnWidth).c_str()));
     }
   } catch (out_of_range&) {
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <iomanip>
 #include "piareadAny.h"
+#include "CaseArchive.h"
 #include "WorkerDataArray.h"
 #include "PiadataArray.h"
 #include "UserAssumptions.h"
@@ -98,6 +99,18 @@ void PiaReadAny::setEarnProjectYears( int year1, int year2 )
   earnProject.yearsCheck(workerData.getIbegin(), workerData.getIend());
 }
 
+/// <summary>Sets OASDI-covered earnings for one year.</summary>
+///
+/// <remarks>This version sets the earnings in the projected earnings
+/// information, which includes projected earnings.</remarks>
+///
+/// <param name="year">Year of earnings.</param>
+/// <param name="earnings">Amount of earnings.</param>
+void PiaReadAny::setEarnOasdi( int year, double earnings )
+{
+  earnProject.setEarnpebs(year, earnings);
+}
+
 /// <summary>Parses backward projection amounts.</summary>
 ///
 /// <remarks>Parses the projection type, the percentage factor, and the
@@ -186,7 +199,7 @@ void PiaReadAny::parseEarnOasdi( int lineNumber, const std::string& line )
   const int lastYear = min(firstYear + 9, earnProject.getLastYear());
   try {
     for (int yr = firstYear; yr <= lastYear; yr++) {
-      earnProject.setEarnpebs(yr, atof(line.substr(getEarnWidth() *
+      setEarnOasdi(yr, atof(line.substr(getEarnWidth() *
         (yr - firstYear), getEarnWidth()).c_str()));
     }
   } catch (out_of_range&) {
@@ -196,3 +209,53 @@ void PiaReadAny::parseEarnOasdi( int lineNumber, const std::string& line )
     throw PiaException(PIA_IDS_READERR);
   }
 }
+
+/// <summary>Restores a case saved by <see cref="saveCase"/>.</summary>
+///
+/// <remarks>This gives the same data as reading the case the archive was
+/// saved from, without parsing it. Call
+/// <see cref="WorkerDataGeneral::deleteContents"/> for the worker and each
+/// family member before this function, as before reading a case. The
+/// archive has no header, so it must be read by the same version of the
+/// program that saved it (see <see cref="CaseCache"/>).</remarks>
+///
+/// <exception cref="PiaException"><see cref="PiaException"/> if the
+/// archive is not complete.</exception>
+///
+/// <param name="begin">First byte of the archive.</param>
+/// <param name="end">One past the last byte of the archive.</param>
+void PiaReadAny::loadCase( const char *begin, const char *end )
+{
+  CaseIArchive archive(begin, end);
+  int famSize = 0;
+  archive >> workerData >> userAssumptions >> earnProject >> pebs >> famSize;
+  PiaDataArray::famSizeCheck(famSize);
+  workerData.addChanges(WorkerDataGeneral::ALL_CHANGES);
+  for (int i = 0; i < famSize; i++) {
+    widowArray.setFamSize(i + 1);
+    archive >> *widowDataArray.workerData[i] >> *secondaryArray.secondary[i];
+    widowDataArray.workerData[i]->addChanges(WorkerDataGeneral::ALL_CHANGES);
+  }
+  if (!archive.atEnd())
+    throw PiaException("Extra data in case archive in PiaReadAny::loadCase");
+}
+
+/// <summary>Saves the case that has been read, so that it can be restored
+/// by <see cref="loadCase"/> without parsing it again.</summary>
+///
+/// <remarks>Call this right after reading the case, before it is
+/// calculated. The archive holds the worker's data, the user assumptions,
+/// the earnings projection, the Statement data, and the data of each
+/// family member.</remarks>
+///
+/// <param name="archive">Binary archive of the case (returned).</param>
+void PiaReadAny::saveCase( std::string& archive ) const
+{
+  archive.clear();
+  CaseOArchive oarchive(archive);
+  const int famSize = widowArray.getFamSize();
+  oarchive << workerData << userAssumptions << earnProject << pebs << famSize;
+  for (int i = 0; i < famSize; i++) {
+    oarchive << *widowDataArray.workerData[i] << *secondaryArray.secondary[i];
+  }
+}
@@ -72,8 +72,20 @@ const double Pib50Pib::pib50[] = {
 double Pib50Pib::getAt( int index )
 {
 #ifndef NDEBUG
-  if (index < 0 || index > 485)
+  if (index < 0 || index > LAST_INDEX)
     throw PiaException(PIA_IDS_PIB50PIB);
 #endif
   return(pib50[index]);
 }
+
+/// <summary>Finds a pib in the 1950 conversion table.</summary>
+///
+/// <returns>Index of the lowest pib in the table that the pib does not
+/// exceed by more than half a cent (<see cref="LAST_INDEX"/> if it exceeds
+/// them all).</returns>
+///
+/// <param name="pib">Pib to find.</param>
+int Pib50Pib::find( double pib )
+{
+  return(PibTableSearch::bracket(pib50, 0, LAST_INDEX, pib, .005));
+}
@@ -44,8 +44,22 @@ const double Pib52Ame::ame52[] = {
 double Pib52Ame::getAt( int index )
 {
 #ifndef NDEBUG
-  if (index < 0 || index > 205)
+  if (index < 0 || index > LAST_INDEX)
     throw PiaException(PIA_IDS_PIB52MFB);
 #endif
   return(ame52[index]);
 }
+
+/// <summary>Finds a pia in the 1952 pia-ame conversion table.</summary>
+///
+/// <remarks>The AME for the pia is $45 plus the index returned.</remarks>
+///
+/// <returns>Index of the lowest pia in the table that is not less than the
+/// pia, to within half a cent (<see cref="LAST_INDEX"/> if they are all
+/// less).</returns>
+///
+/// <param name="pia">Pia to find.</param>
+int Pib52Ame::find( double pia )
+{
+  return(PibTableSearch::bracket(ame52, 0, LAST_INDEX, pia - 0.005, 0.0));
+}
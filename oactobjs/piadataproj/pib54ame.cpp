@@ -43,8 +43,22 @@ const double Pib54Ame::ame54[] = {
 double Pib54Ame::getAt( int index )
 {
 #ifndef NDEBUG
-  if (index < 0 || index > 195)
+  if (index < 0 || index > LAST_INDEX)
     throw PiaException(PIA_IDS_PIB54PIA);
 #endif
   return(ame54[index]);
 }
+
+/// <summary>Finds a pia in the 1954 pia-ame conversion table.</summary>
+///
+/// <remarks>The AME for the pia is $55 plus the index returned.</remarks>
+///
+/// <returns>Index of the lowest pia in the table that is not less than the
+/// pia, to within half a cent (<see cref="LAST_INDEX"/> if they are all
+/// less).</returns>
+///
+/// <param name="pia">Pia to find.</param>
+int Pib54Ame::find( double pia )
+{
+  return(PibTableSearch::bracket(ame54, 0, LAST_INDEX, pia - 0.005, 0.0));
+}
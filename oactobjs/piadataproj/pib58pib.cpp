@@ -30,8 +30,21 @@ const double Pib58Pib::pib58[] = {
 double Pib58Pib::getAt( int index )
 {
 #ifndef NDEBUG
-  if (index < 0 || index > 62)
+  if (index < 0 || index > LAST_INDEX)
     throw PiaException(PIA_IDS_PIB58PIB);
 #endif
   return(pib58[index]);
 }
+
+/// <summary>Finds a pib in the 1958 conversion table.</summary>
+///
+/// <returns>Index of the lowest pib in the table, starting at the specified
+/// index, that is not less than the pib (<see cref="LAST_INDEX"/> if they
+/// are all less).</returns>
+///
+/// <param name="pib">Pib to find.</param>
+/// <param name="first">Index of the lowest pib to consider.</param>
+int Pib58Pib::find( double pib, int first )
+{
+  return(PibTableSearch::bracket(pib58, first, LAST_INDEX, pib, 0.0));
+}
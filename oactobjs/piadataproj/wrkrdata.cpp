@@ -50,6 +50,7 @@ void WorkerData::deleteContents()
   pubpenDate.deleteContents();
   oabCessDate.deleteContents();
   oabEntDate.deleteContents();
+  addChanges(ALL_CHANGES);
 }
 
 /// <summary>Zeroes out earnings and quarters of coverage before first year
@@ -77,6 +78,7 @@ void WorkerData::zeroEarnOasdi( int ibegint, int iendt )
 {
   earnOasdi.assign(0.0, YEAR37, ibegint - 1);
   earnOasdi.assign(0.0, iendt + 1, maxyear);
+  addChanges(EARN_CHANGE);
 }
 
 /// <summary>Zeroes out HI earnings before first year and after last year of
@@ -88,6 +90,7 @@ void WorkerData::zeroEarnHi( int ibegint, int iendt )
 {
   earnHi.assign(0.0, YEAR37, ibegint - 1);
   earnHi.assign(0.0, iendt + 1, maxyear);
+  addChanges(EARN_CHANGE);
 }
 
 /// <summary>Sets date of cessation of oab prior to most recent dib.</summary>
@@ -110,10 +113,15 @@ void WorkerData::setOabCessDate( const DateMoyr& datetemp )
 #ifndef NDEBUG
     DisabPeriod::cessationDateCheck(datetemp);
 #endif
-    oabCessDate = datetemp;
+    if (!(oabCessDate == datetemp)) {
+      oabCessDate = datetemp;
+      addChanges(DATE_CHANGE);
+    }
   }
-  else
+  else if (!(oabCessDate == DateMoyr(0,0))) {
     oabCessDate.deleteContents();
+    addChanges(DATE_CHANGE);
+  }
 }
 
 /// <summary>Sets date of oab entitlement prior to most recent dib.</summary>
@@ -136,10 +144,15 @@ void WorkerData::setOabEntDate( const DateMoyr& datetemp )
 #ifndef NDEBUG
     DisabPeriod::cessationDateCheck(datetemp);
 #endif
-    oabEntDate = datetemp;
+    if (!(oabEntDate == datetemp)) {
+      oabEntDate = datetemp;
+      addChanges(DATE_CHANGE);
+    }
   }
-  else
+  else if (!(oabEntDate == DateMoyr(0,0))) {
     oabEntDate.deleteContents();
+    addChanges(DATE_CHANGE);
+  }
 }
 
 /// <summary>Sets OASDI-covered earnings.</summary>
@@ -169,7 +182,10 @@ void WorkerData::setEarnOasdi( int year, double newEarn )
     Trace::writeLine(strm.str());
   }
 #endif
-  earnOasdi[year] = newEarn;
+  if (earnOasdi[year] != newEarn) {
+    earnOasdi[year] = newEarn;
+    addChanges(EARN_CHANGE);
+  }
 }
 
 /// <summary>Sets Medicare earnings for the specified year.</summary>
@@ -199,7 +215,10 @@ void WorkerData::setEarnHi( int year, double newEarnHi )
     Trace::writeLine(strm.str());
   }
 #endif
-  earnHi[year] = newEarnHi;
+  if (earnHi[year] != newEarnHi) {
+    earnHi[year] = newEarnHi;
+    addChanges(EARN_CHANGE);
+  }
 }
 
 /// <summary>Sets type of taxes for the specified year.</summary>
@@ -225,7 +244,10 @@ void WorkerData::setTaxType( int year, int newTaxType )
     Trace::writeLine(strm.str());
   }
 #endif
-  taxType.setBit(year, newTaxType);
+  if (taxType.getBit(year) != (newTaxType > 0)) {
+    taxType.setBit(year, newTaxType);
+    addChanges(EARN_CHANGE);
+  }
 }
 
 /// <summary>Sets amount of monthly noncovered pension.</summary>
@@ -249,7 +271,10 @@ void WorkerData::setPubpen( float newPubpen )
     Trace::writeLine(strm.str());
   }
 #endif
-  pubpen = newPubpen;
+  if (pubpen != newPubpen) {
+    pubpen = newPubpen;
+    addChanges(OTHER_CHANGE);
+  }
 }
 
 /// <summary>Checks the date of noncovered pension entitlement for
@@ -284,7 +309,10 @@ void WorkerData::setPubpenDate( const DateMoyr& newPubpenDate )
   }
 #endif
   pubpenDateCheck(newPubpenDate, getBirthDate(), getDeathDate());
-  pubpenDate = newPubpenDate;
+  if (!(pubpenDate == newPubpenDate)) {
+    pubpenDate = newPubpenDate;
+    addChanges(DATE_CHANGE);
+  }
 }
 
 /// <summary>Sets amount of monthly noncovered pension after December 1994,
@@ -311,5 +339,8 @@ void WorkerData::setPubpenReservist( float newPubpen )
     Trace::writeLine(strm.str());
   }
 #endif
-  pubpenReservist = newPubpen;
+  if (pubpenReservist != newPubpen) {
+    pubpenReservist = newPubpen;
+    addChanges(OTHER_CHANGE);
+  }
 }
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include "datemoyr.h"
+#include "DateIndex.h"
 #include "dbleann.h"
 #include "intann.h"
 #include "age.h"
@@ -21,6 +22,8 @@
 #include "WageBase.h"
 #include "Sex.h"
 #include "cachup.h"
+#include "ColaTable.h"
+#include "AmeIndex.h"
 #include "awinc.h"
 #include "qtryear.h"
 #include "BendPoints.h"
@@ -58,20 +61,20 @@ public:
   static const DateMoyr amend56;
   /// <summary>First birth date for which age 62 is effective for females.
   /// </summary>
-  static const boost::gregorian::date amend561;
+  static const DateIndex amend561;
   /// <summary>Second birth date for which age 62 is effective for females.
   /// </summary>
-  static const boost::gregorian::date amend562;
+  static const DateIndex amend562;
   /// <summary>The date of 1958 amendments.</summary>
   static const DateMoyr amend58;
   /// <summary>The date of 1961 amendments.</summary>
   static const DateMoyr amend61;
   /// <summary>First birth date for which age 62 is effective for males.
   /// </summary>
-  static const boost::gregorian::date amend611;
+  static const DateIndex amend611;
   /// <summary>Second birth date for which age 62 is effective for males.
   /// </summary>
-  static const boost::gregorian::date amend612;
+  static const DateIndex amend612;
   /// <summary>The date of 1965 amendments for benefit increase.</summary>
   static const DateMoyr amend651;
   /// <summary>The date of 1965 amendments for change to age 60.</summary>
@@ -103,7 +106,7 @@ public:
   static const DateMoyr amend80;
   /// <summary>The date of birth for age 62 and 1 month in 1981 amendments.
   /// </summary>
-  static const boost::gregorian::date amend811;
+  static const DateIndex amend811;
   /// <summary>The date of 1981 amendments (month, day, and year).</summary>
   static const boost::gregorian::date amend812;
   /// <summary>The date of 1981 amendments (month and year).</summary>
@@ -257,6 +260,12 @@ protected:
   DoubleAnnual cpiinc;
   /// <summary>Catch-up benefit increases.</summary>
   Catchup catchup;
+  /// <summary>Factors for the benefit increases, built when the benefit
+  /// increases are updated.</summary>
+  ColaTable colaTable;
+  /// <summary>Pias of the old pia tables by AME, added as they are needed
+  /// and cleared when the benefit increases or wage bases change.</summary>
+  mutable AmeIndex ameIndex;
   /// <summary>Array of annual average earnings.</summary>
   ///
   /// <remarks>The years go from 1937 to <see cref="maxyear"/>.</remarks>
@@ -296,6 +305,8 @@ public:
   virtual double applyColaMfb( double mfb, int year, int eligYear,
     double pia ) const;
   double applyColaMfb99( double mfb, double pia ) const;
+  double applyColas( DoubleAnnual& amounts, int year1, int year3,
+    int eligYear, const DateMoyr& benDate ) const;
   double benincCatchUp( double bcatch, int year, int eligYear ) const;
   /// <summary>Returns true if should recalculate PIAs this year because of
   /// a newly effective law change, else false.</summary>
@@ -313,7 +324,7 @@ public:
   /// <returns>Earliest possible retirement age for oab or aged spouse.
   /// </returns>
   virtual Age earlyAgeOabCal( Sex::sex_type,
-    const boost::gregorian::date& ) const = 0;
+    const DateIndex& ) const = 0;
   /// <summary>Returns factor for widow(er) benefit before age reduction.
   /// </summary>
   ///
@@ -391,6 +402,10 @@ public:
   ///
   /// <returns>Catch-up benefit increases.</returns>
   const Catchup& getCatchup() const { return catchup; }
+  /// <summary>Returns the pias of the old pia tables by AME.</summary>
+  ///
+  /// <returns>The pias of the old pia tables by AME.</returns>
+  AmeIndex& getAmeIndex() const { return ameIndex; }
   /// <summary>Returns maximum amount of earnings in a childcare dropout year.
   /// </summary>
   ///
@@ -621,7 +636,7 @@ public:
   static int deemedQcReqCal( int year );
   static Age earlyAgeDisWidCal( const DateMoyr& benefitDate );
   static Age earlyAgeOabCalPL( Sex::sex_type sex,
-    const boost::gregorian::date& kbirth );
+    const DateIndex& kbirth );
   static Age earlyAgeWidCal( const DateMoyr& benefitDate );
   /// <summary>Returns factor for wife/husband benefit before age
   /// reduction.</summary>
@@ -697,7 +712,7 @@ public:
   static int monthsArAgedSpouseCal( const Age& age,
     const DateMoyr& benefitDate, const Age& fullRetAge );
   static int monthsDriCal( const DateMoyr& fullRetDate, int eligYear,
-    const boost::gregorian::date& dobadj, const DateMoyr& entDate,
+    const DateIndex& dobadj, const DateMoyr& entDate,
     const DateMoyr& benefitDate, const DateMoyr& fullInsDate );
   static double retCredit( int eligYear );
   static double ribLimCalPL( double widowBen, double oabPia, double oabBen,
@@ -52,7 +52,7 @@ public:
   double applyColaMfb( double mfb, int year, int eligYear,
     double pia ) const;
   Age earlyAgeOabCal( Sex::sex_type sex,
-    const boost::gregorian::date& kbirth ) const;
+    const DateIndex& kbirth ) const;
   double factorAgedSpouseCal( int eligYear, int benYear ) const;
   double factorAgedWidCal( int monthsArdri, const Age& age,
     int eligYear, const DateMoyr& benefitDate ) const;
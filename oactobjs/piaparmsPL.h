@@ -25,7 +25,7 @@ public:
   explicit PiaParamsPL( int newMaxyear );
   ~PiaParamsPL();
   Age earlyAgeOabCal( Sex::sex_type sex,
-    const boost::gregorian::date& kbirth ) const;
+    const DateIndex& kbirth ) const;
   double factorAgedSpouseCal( int, int ) const;
   double factorAgedWidCal( int monthsArdri, const Age& age, int,
     const DateMoyr& benefitDate ) const;
@@ -11,6 +11,8 @@ class SecondaryArray;
 class PiaDataArray;
 class WorkerDataArray;
 class WorkerData;
+class DisabPeriod;
+class PiaColumnRecord;
 
 /// <summary>Reads the basic data required to calculate a Social Security
 /// benefit.</summary>
@@ -84,6 +86,7 @@ public:
   virtual void parseEarnType( const std::string& );
   void parseFamilyMember( int lineNumber, const std::string& line );
   virtual void parseFwrd( const std::string& );
+  unsigned int parseLine( const std::string& line );
   void parseMsdates( const std::string& line );
   void parseNhaddr( int lineNumber, const std::string& line );
   void parseNhname( const std::string& line );
@@ -101,6 +104,11 @@ public:
   void parseTotalize( const std::string& line );
   void parseYears( const std::string& line );
   unsigned int read( std::istream& in );
+  unsigned int read( const char *begin, const char *end );
+  unsigned int read( const PiaColumnRecord& record );
+  void setDisab1( const DisabPeriod& disabPeriod );
+  void setDisab2( const DisabPeriod& disabPeriod );
+  virtual void setEarnOasdi( int year, double earnings );
   virtual void setEarnProjectYears( int, int );
   /// <summary>Sets width of earnings or base field.</summary>
   ///
@@ -111,6 +119,12 @@ public:
   ///
   /// <param name="newWidth">New width of field for line number.</param>
   void setWidth( int newWidth ) { width = newWidth; }
+  static const char *findLineEnd( const char *begin, const char *end );
+  static int lineTypeCal( const char *begin, const char *lineEnd );
 private:
+  static void columnCountCheck( unsigned count, int firstYear,
+    int lastYear );
+  void finishRecord( bool endOfFile );
+  void setInputLine( const char *begin, const char *lineEnd );
   PiaRead operator=( const PiaRead& newPiaRead );
 };
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <string>
 #include "piaread.h"
 class EarnProject;
 class Pebs;
@@ -26,11 +27,14 @@ public:
     PiaDataArray& newWidowArray, UserAssumptions& newUserAssumptions,
     SecondaryArray& newSecondaryArray, EarnProject& newEarnProject,
     Pebs& newPebs );
+  void loadCase( const char *begin, const char *end );
   void parseBack( const std::string& line );
   void parseEarnOasdi( int lineNumber, const std::string& line );
   void parseEarnType( const std::string& line );
   void parseFwrd( const std::string& line );
   void parsePebes( const std::string& line );
+  void saveCase( std::string& archive ) const;
+  void setEarnOasdi( int year, double earnings );
   void setEarnProjectYears( int year1, int year2 );
   void setPebsData();
 private:
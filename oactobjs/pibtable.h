@@ -1,12 +1,30 @@
 // Declarations for the <see cref="Pib50Mfb"/>, <see cref="Pib50Pib"/>,
 // <see cref="Pib52Ame"/>, <see cref="Pib52Mfb"/>, <see cref="Pib54Ame"/>,
 // <see cref="Pib54Mfb"/>, <see cref="Pib54Pia"/>, <see cref="Pib58Ame"/>,
-// and <see cref="Pib58Pib"/> classes to manage pib-pia conversion tables.
+// and <see cref="Pib58Pib"/> classes to manage pib-pia conversion tables,
+// and the <see cref="PibTableSearch"/> class to search them.
 //
 // $Id: pibtable.h 1.9 2011/08/08 08:45:13EDT 044579 Development  $
 
 #pragma once
 
+/// <summary>Finds the bracket of an amount in one of the pib-pia conversion
+/// tables.</summary>
+///
+/// <remarks>The amounts searched in each table are in increasing order, so
+/// the bracket is found by a binary search, with the same result as trying
+/// each entry in turn from the first. This is used by
+/// <see cref="Pib50Pib::find"/>, <see cref="Pib52Ame::find"/>,
+/// <see cref="Pib54Ame::find"/>, and <see cref="Pib58Pib::find"/>; the
+/// other direction, from an entry to its amount, is the getAt function of
+/// each table.</remarks>
+class PibTableSearch
+{
+public:
+  static int bracket( const double table[], int first, int last,
+    double amount, double margin );
+};
+
 /// <summary>Manages the 1950 pib-mfb conversion figures.</summary>
 ///
 /// <remarks>This class is used in <see cref="OldStart::oldStart50Cal"/>.
@@ -26,10 +44,14 @@ public:
 /// </remarks>
 class Pib50Pib
 {
+public:
+  /// <summary>Index of the last pib.</summary>
+  static const int LAST_INDEX = 485;
 private:
   /// <summary>The 1950 pib's.</summary>
   static const double pib50[];
 public:
+  static int find( double pib );
   static double getAt( int index );
 };
 
@@ -39,10 +61,14 @@ public:
 /// </remarks>
 class Pib52Ame
 {
+public:
+  /// <summary>Index of the last ame.</summary>
+  static const int LAST_INDEX = 205;
 private:
   /// <summary>The 1952 Ame's.</summary>
   static const double ame52[];
 public:
+  static int find( double pia );
   static double getAt( int index );
 };
 
@@ -65,10 +91,14 @@ public:
 /// </remarks>
 class Pib54Ame
 {
+public:
+  /// <summary>Index of the last ame.</summary>
+  static const int LAST_INDEX = 195;
 private:
   /// <summary>The 1954 ame's.</summary>
   static const double ame54[];
 public:
+  static int find( double pia );
   static double getAt( int index );
 };
 
@@ -117,9 +147,13 @@ public:
 /// </remarks>
 class Pib58Pib
 {
+public:
+  /// <summary>Index of the last pib.</summary>
+  static const int LAST_INDEX = 62;
 private:
   /// <summary>The 1958 pib's.</summary>
   static const double pib58[];
 public:
+  static int find( double pib, int first );
   static double getAt( int index );
 };